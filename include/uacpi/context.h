@@ -21,6 +21,35 @@ extern "C" {
  */
 void uacpi_context_set_log_level(uacpi_log_level);
 
+/*
+ * Redirect all accepted log messages into an internal lock-free ring buffer
+ * instead of emitting them synchronously, so that a slow uacpi_kernel_log
+ * implementation (e.g. a serial console) doesn't stall whatever context the
+ * message originated from. The host is expected to call
+ * uacpi_flush_deferred_log periodically (or from a worker) to emit the
+ * accumulated records; disabling deferred logging flushes them as well.
+ *
+ * If the ring overflows before a flush, the newest records are dropped and a
+ * warning with the number of lost records is logged on the next flush. The
+ * ring capacity is configured via UACPI_DEFERRED_LOG_RING_SIZE.
+ *
+ * This is a no-op if UACPI_FORMATTED_LOGGING is enabled, as format arguments
+ * cannot be captured for deferred formatting.
+ */
+void uacpi_context_set_deferred_logging(uacpi_bool);
+
+/*
+ * Emit all log records accumulated in the deferred log ring buffer via
+ * uacpi_kernel_log. May be called from any thread, concurrent callers are
+ * reduced to one flusher.
+ *
+ * The ring is normally drained automatically from a work item scheduled via
+ * uacpi_kernel_schedule_work as records come in, calling this by hand is only
+ * needed where synchronous draining matters, e.g. right before shutdown or
+ * from a panic path.
+ */
+void uacpi_flush_deferred_log(void);
+
 /*
  * Set the maximum number of seconds a While loop is allowed to run for before
  * getting timed out.
@@ -239,6 +239,46 @@ uacpi_status uacpi_unmask_gpe(
     uacpi_namespace_node *gpe_device, uacpi_u16 idx
 ))
 
+#define UACPI_GPE_LATENCY_BUCKETS 32
+
+/*
+ * Latency breakdown of batched GPE dispatches (AML and implicit-notify
+ * handlers) as log2 histograms: bucket N counts samples that took at least
+ * 2^N but less than 2^(N+1) nanoseconds, with the last bucket also absorbing
+ * everything larger.
+ */
+typedef struct uacpi_gpe_latency_histograms {
+    // Detection in the interrupt handler -> handler batch starting to run
+    uacpi_u32 queue[UACPI_GPE_LATENCY_BUCKETS];
+
+    // Handler run time (_Lxx/_Exx method or implicit notify fan-out)
+    uacpi_u32 handler[UACPI_GPE_LATENCY_BUCKETS];
+
+    // Handler done -> event reached by the restore (re-enable) pass
+    uacpi_u32 restore[UACPI_GPE_LATENCY_BUCKETS];
+} uacpi_gpe_latency_histograms;
+
+/*
+ * Copy out (or zero) the latency histograms accumulated for the event 'idx'
+ * managed by 'gpe_device'.
+ *
+ * The counters are sampled without excluding concurrent dispatch, so a
+ * snapshot taken while events are firing may miss in-flight samples.
+ *
+ * Returns UACPI_STATUS_COMPILED_OUT unless UACPI_GPE_LATENCY_STATS is enabled.
+ *
+ * NOTE: 'gpe_device' may be null for GPEs managed by \_GPE
+ */
+UACPI_ALWAYS_ERROR_FOR_REDUCED_HARDWARE(
+uacpi_status uacpi_gpe_get_latency_histograms(
+    uacpi_namespace_node *gpe_device, uacpi_u16 idx,
+    uacpi_gpe_latency_histograms *out_histograms
+))
+UACPI_ALWAYS_ERROR_FOR_REDUCED_HARDWARE(
+uacpi_status uacpi_gpe_reset_latency_histograms(
+    uacpi_namespace_node *gpe_device, uacpi_u16 idx
+))
+
 /*
  * Disable all GPEs currently set up on the system.
  */
@@ -7,7 +7,23 @@
 #include <uacpi/internal/shareable.h>
 #include <uacpi/context.h>
 
+struct uacpi_sleep_plan {
+    uacpi_u8 sleep_typ_a;
+    uacpi_u8 sleep_typ_b;
+    uacpi_bool valid;
+};
+
 struct uacpi_runtime_context {
+    /*
+     * =======================================================================
+     * Read-mostly section: state consulted on every interpreter step and
+     * register access, written only during bring-up and by the (rare) context
+     * setters. Nothing in here may be written on a hot path, unrelated
+     * writers would invalidate the line that e.g. uacpi_eval reads on every
+     * call.
+     * =======================================================================
+     */
+
     /*
      * A local copy of FADT that has been verified & converted to most optimal
      * format for faster access to the registers.
@@ -30,33 +46,31 @@ struct uacpi_runtime_context {
 
     uacpi_u64 flags;
 
-#define UACPI_SLEEP_TYP_INVALID 0xFF
-    uacpi_u8 last_sleep_typ_a;
-    uacpi_u8 last_sleep_typ_b;
-
-    uacpi_u8 s0_sleep_typ_a;
-    uacpi_u8 s0_sleep_typ_b;
-
     /*
-     * This is a per-table value but we mimic the NT implementation:
-     * treat all other definition blocks as if they were the same revision
-     * as DSDT.
+     * The scalar state checked on the interpreter entry path, packed into a
+     * single aligned word so that one load pulls in all of it:
+     * - init_level: the current initialization level, see
+     *   UACPI_ENSURE_INIT_LEVEL_AT_LEAST and friends
+     * - log_level: the cutoff checked by uacpi_should_log
+     * - is_rev1: per-table value, but we mimic the NT implementation and
+     *   treat all other definition blocks as if they were the same revision
+     *   as DSDT
      */
-    uacpi_bool is_rev1;
-    uacpi_bool global_lock_acquired;
-
+    union {
+        uacpi_u32 state_word;
+        struct {
+            uacpi_u8 init_level;
+            uacpi_u8 log_level;
+            uacpi_bool is_rev1;
 #ifndef UACPI_REDUCED_HARDWARE
-    uacpi_bool is_hardware_reduced;
-    uacpi_bool has_global_lock;
-    uacpi_handle sci_handle;
+            uacpi_bool is_hardware_reduced;
 #endif
-    uacpi_u64 opcodes_executed;
+        };
+    };
 
     uacpi_u32 loop_timeout_seconds;
     uacpi_u32 max_call_stack_depth;
 
-    uacpi_u32 global_lock_seq_num;
-
     /*
      * These are stored here to protect against stuff like:
      * - CopyObject(JUNK, \)
@@ -66,13 +80,42 @@ struct uacpi_runtime_context {
     uacpi_object *root_object;
 
 #ifndef UACPI_REDUCED_HARDWARE
+    uacpi_bool has_global_lock;
+    uacpi_handle sci_handle;
+#endif
+
+#define UACPI_SLEEP_TYP_INVALID 0xFF
+    uacpi_u8 s0_sleep_typ_a;
+    uacpi_u8 s0_sleep_typ_b;
+
+    /*
+     * SLP_TYP values cached ahead of time by uacpi_precompute_sleep_plan so
+     * that uacpi_prepare_for_sleep_state doesn't have to evaluate \_Sx on the
+     * latency-critical suspend path. One entry per state, \_S0 through \_S5.
+     */
+    struct uacpi_sleep_plan sleep_plans[6];
+
+    /*
+     * =======================================================================
+     * Write-hot section: counters and bookkeeping mutated at runtime,
+     * isolated on its own cache line so that bumping them never invalidates
+     * the read-mostly state above.
+     * =======================================================================
+     */
+
+    UACPI_CACHE_ALIGNED uacpi_u64 opcodes_executed;
+
+    uacpi_u32 global_lock_seq_num;
+    uacpi_bool global_lock_acquired;
+
+#ifndef UACPI_REDUCED_HARDWARE
+    uacpi_bool global_lock_pending;
     uacpi_handle *global_lock_event;
     uacpi_handle *global_lock_spinlock;
-    uacpi_bool global_lock_pending;
 #endif
 
-    uacpi_u8 log_level;
-    uacpi_u8 init_level;
+    uacpi_u8 last_sleep_typ_a;
+    uacpi_u8 last_sleep_typ_b;
 };
 
 static inline const uacpi_char *uacpi_init_level_to_string(uacpi_u8 lvl)
@@ -139,3 +182,11 @@ static inline uacpi_bool uacpi_is_hardware_reduced(void)
     return UACPI_TRUE;
 #endif
 }
+
+/*
+ * Wait for an in-flight UACPI_FLAG_ASYNC_ACPI_MODE transition to finish.
+ * Must be called before anything that touches hardware which is only ours
+ * once ACPI mode has been fully entered (e.g. event bring-up). No-op if no
+ * transition is pending.
+ */
+void uacpi_join_acpi_mode_transition(void);
@@ -2,6 +2,7 @@
 
 #include <uacpi/types.h>
 #include <uacpi/internal/stdlib.h>
+#include <uacpi/internal/pool.h>
 #include <uacpi/kernel_api.h>
 
 #define DYNAMIC_ARRAY_WITH_INLINE_STORAGE(name, type, inline_capacity)       \
@@ -135,6 +136,13 @@
         return name##_at(arr, arr->size_including_inline - 1);               \
     }                                                                        \
                                                                              \
+    /* Same as name##_clear, but any dynamic capacity is kept around */      \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix void name##_reset(struct name *arr)                               \
+    {                                                                        \
+        arr->size_including_inline = 0;                                      \
+    }                                                                        \
+                                                                             \
     prefix void name##_clear(struct name *arr)                               \
     {                                                                        \
         uacpi_free(                                                          \
@@ -145,3 +153,136 @@
         arr->dynamic_capacity = 0;                                           \
         arr->dynamic_storage = UACPI_NULL;                                   \
     }
+
+/*
+ * Same as DYNAMIC_ARRAY_WITH_INLINE_STORAGE, except overflow past the inline
+ * capacity is drawn from a bump arena instead of the kernel heap. There are
+ * no individual frees: abandoned/cleared storage lives until the owner of
+ * the arena resets it in one shot. The 'arena' member must be pointed at a
+ * valid arena before the inline capacity is exceeded.
+ */
+#define DYNAMIC_ARRAY_WITH_INLINE_STORAGE_AND_ARENA(name, type,              \
+                                                    inline_capacity)         \
+    struct name {                                                            \
+        type inline_storage[inline_capacity];                                \
+        type *dynamic_storage;                                               \
+        uacpi_size dynamic_capacity;                                         \
+        uacpi_size size_including_inline;                                    \
+        struct uacpi_arena *arena;                                           \
+    };                                                                       \
+
+#define DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(name, type, prefix)     \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix uacpi_size name##_inline_capacity(struct name *arr)               \
+    {                                                                        \
+        return sizeof(arr->inline_storage) / sizeof(arr->inline_storage[0]); \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix uacpi_size name##_capacity(struct name *arr)                      \
+    {                                                                        \
+        return name##_inline_capacity(arr) + arr->dynamic_capacity;          \
+    }                                                                        \
+                                                                             \
+    prefix type *name##_at(struct name *arr, uacpi_size idx)                 \
+    {                                                                        \
+        if (idx >= arr->size_including_inline)                               \
+            return UACPI_NULL;                                               \
+                                                                             \
+        if (idx < name##_inline_capacity(arr))                               \
+            return &arr->inline_storage[idx];                                \
+                                                                             \
+        return &arr->dynamic_storage[idx - name##_inline_capacity(arr)];     \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix type *name##_alloc(struct name *arr)                              \
+    {                                                                        \
+        uacpi_size inline_cap;                                               \
+        type *out_ptr;                                                       \
+                                                                             \
+        inline_cap = name##_inline_capacity(arr);                            \
+                                                                             \
+        if (arr->size_including_inline >= inline_cap) {                      \
+            uacpi_size dynamic_size;                                         \
+                                                                             \
+            dynamic_size = arr->size_including_inline - inline_cap;          \
+            if (dynamic_size == arr->dynamic_capacity) {                     \
+                uacpi_size new_capacity, type_size;                          \
+                void *new_buf;                                               \
+                                                                             \
+                type_size = sizeof(*arr->dynamic_storage);                   \
+                                                                             \
+                if (arr->dynamic_capacity == 0)                              \
+                    new_capacity = inline_cap;                               \
+                else                                                         \
+                    new_capacity = arr->dynamic_capacity +                   \
+                                   UACPI_MAX(arr->dynamic_capacity / 2,      \
+                                             (uacpi_size)1);                 \
+                                                                             \
+                new_buf = uacpi_arena_alloc(arr->arena,                      \
+                                            new_capacity * type_size);       \
+                if (uacpi_unlikely(new_buf == UACPI_NULL))                   \
+                    return UACPI_NULL;                                       \
+                                                                             \
+                arr->dynamic_capacity = new_capacity;                        \
+                                                                             \
+                if (arr->dynamic_storage) {                                  \
+                    uacpi_memcpy(new_buf, arr->dynamic_storage,              \
+                                 dynamic_size * type_size);                  \
+                }                                                            \
+                /* The old buffer is abandoned until the arena dies */       \
+                arr->dynamic_storage = new_buf;                              \
+            }                                                                \
+                                                                             \
+            out_ptr = &arr->dynamic_storage[dynamic_size];                   \
+            goto ret;                                                        \
+        }                                                                    \
+                                                                             \
+                                                                             \
+        out_ptr = &arr->inline_storage[arr->size_including_inline];          \
+                                                                             \
+    ret:                                                                     \
+        arr->size_including_inline++;                                        \
+        return out_ptr;                                                      \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix type *name##_calloc(struct name *arr)                             \
+    {                                                                        \
+        type *ret;                                                           \
+                                                                             \
+        ret = name##_alloc(arr);                                             \
+        if (ret)                                                             \
+            uacpi_memzero(ret, sizeof(*ret));                                \
+                                                                             \
+        return ret;                                                          \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix void name##_pop(struct name *arr)                                 \
+    {                                                                        \
+        if (arr->size_including_inline == 0)                                 \
+            return;                                                          \
+                                                                             \
+        arr->size_including_inline--;                                        \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix uacpi_size name##_size(struct name *arr)                          \
+    {                                                                        \
+        return arr->size_including_inline;                                   \
+    }                                                                        \
+                                                                             \
+    UACPI_MAYBE_UNUSED                                                       \
+    prefix type *name##_last(struct name *arr)                               \
+    {                                                                        \
+        return name##_at(arr, arr->size_including_inline - 1);               \
+    }                                                                        \
+                                                                             \
+    prefix void name##_clear(struct name *arr)                               \
+    {                                                                        \
+        arr->size_including_inline = 0;                                      \
+        arr->dynamic_capacity = 0;                                           \
+        arr->dynamic_storage = UACPI_NULL;                                   \
+    }
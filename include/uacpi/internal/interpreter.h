@@ -11,10 +11,42 @@ enum uacpi_table_load_cause {
     UACPI_TABLE_LOAD_CAUSE_HOST,
 };
 
-uacpi_status uacpi_execute_table(void*, enum uacpi_table_load_cause cause);
+uacpi_status uacpi_initialize_interpreter(void);
+void uacpi_deinitialize_interpreter(void);
+
+uacpi_status uacpi_execute_table(
+    void*, uacpi_size table_idx, enum uacpi_table_load_cause cause
+);
+
+void uacpi_method_decode_cache_free(uacpi_control_method *method);
 uacpi_status uacpi_osi(uacpi_handle handle, uacpi_object *retval);
 
 uacpi_status uacpi_execute_control_method(
     uacpi_namespace_node *scope, uacpi_control_method *method,
     const uacpi_object_array *args, uacpi_object **ret
 );
+
+struct execution_context;
+
+/*
+ * Same as uacpi_execute_control_method, but the interpreter is allowed to
+ * suspend instead of blocking the calling thread inside Sleep/Acquire waits:
+ * UACPI_STATUS_SUSPENDED is returned with the parked context stored in
+ * 'out_suspended_ctx', to be continued via uacpi_resume_control_method (from
+ * any thread) or thrown away via uacpi_abort_suspended_control_method.
+ *
+ * All of these expect to be called under the namespace write lock, which is
+ * NOT held while a context is parked.
+ */
+uacpi_status uacpi_execute_control_method_suspendable(
+    uacpi_namespace_node *scope, uacpi_control_method *method,
+    const uacpi_object_array *args, uacpi_object **ret,
+    struct execution_context **out_suspended_ctx
+);
+uacpi_status uacpi_resume_control_method(
+    struct execution_context *ctx, uacpi_object **ret
+);
+uacpi_u64 uacpi_suspended_control_method_wake_deadline(
+    struct execution_context *ctx
+);
+void uacpi_abort_suspended_control_method(struct execution_context *ctx);
@@ -4,12 +4,36 @@
 #include <uacpi/acpi.h>
 #include <uacpi/io.h>
 
+struct uacpi_mapped_gas {
+    union {
+        void *virt;
+        uacpi_handle io;
+    } mapping;
+
+    uacpi_u8 access_bit_width;
+
+    // total width aligned up to the access width, 0 means unmapped
+    uacpi_u8 total_bit_width;
+
+    uacpi_u8 bit_offset;
+    uacpi_u8 address_space_id;
+};
+
+// Same as uacpi_map_gas, but without the allocation
+uacpi_status uacpi_map_gas_noalloc(
+    const struct acpi_gas *gas, struct uacpi_mapped_gas *out_mapped
+);
+
+// Same as uacpi_unmap_gas, but doesn't free the mapping itself. This is a
+// no-op for a zeroed-out (never mapped) structure.
+void uacpi_unmap_gas_nofree(struct uacpi_mapped_gas *mapped);
+
 uacpi_size uacpi_round_up_bits_to_bytes(uacpi_size bit_length);
 
 void uacpi_read_buffer_field(
     const uacpi_buffer_field *field, void *dst
 );
-void uacpi_write_buffer_field(
+uacpi_status uacpi_write_buffer_field(
     uacpi_buffer_field *field, const void *src, uacpi_size size
 );
 
@@ -2,6 +2,7 @@
 
 #include <uacpi/kernel_api.h>
 #include <uacpi/internal/context.h>
+#include <uacpi/platform/config.h>
 
 #ifdef UACPI_FORMATTED_LOGGING
 #define uacpi_log uacpi_kernel_log
@@ -10,8 +11,17 @@ UACPI_PRINTF_DECL(2, 3)
 void uacpi_log(uacpi_log_level, const uacpi_char*, ...);
 #endif
 
-#define uacpi_log_lvl(lvl, ...) \
-    do { if (uacpi_should_log(lvl)) uacpi_log(lvl, __VA_ARGS__); } while (0)
+/*
+ * Messages above UACPI_MAX_COMPILED_LOG_LEVEL produce no code whatsoever:
+ * the level check folds to a constant false and the entire call, including
+ * argument evaluation, is dropped by the compiler.
+ */
+#define uacpi_log_lvl(lvl, ...)                            \
+    do {                                                   \
+        if ((lvl) <= UACPI_MAX_COMPILED_LOG_LEVEL &&       \
+            uacpi_should_log(lvl))                         \
+            uacpi_log(lvl, __VA_ARGS__);                   \
+    } while (0)
 
 #define uacpi_debug(...) uacpi_log_lvl(UACPI_LOG_DEBUG, __VA_ARGS__)
 #define uacpi_trace(...) uacpi_log_lvl(UACPI_LOG_TRACE, __VA_ARGS__)
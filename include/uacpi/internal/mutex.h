@@ -63,9 +63,16 @@ uacpi_status uacpi_recursive_lock_acquire(struct uacpi_recursive_lock *lock);
 uacpi_status uacpi_recursive_lock_release(struct uacpi_recursive_lock *lock);
 
 struct uacpi_rw_lock {
-    uacpi_handle read_mutex;
     uacpi_handle write_mutex;
-    uacpi_size num_readers;
+
+    /*
+     * Bit 31 is set while a writer owns (or is draining readers out of) the
+     * lock, the bits below are the number of active readers. Readers
+     * manipulate their count with plain atomics and never touch any mutexes
+     * unless a writer is active, so the uncontended read path is entirely
+     * free of lock handoff.
+     */
+    uacpi_u32 state;
 };
 
 uacpi_status uacpi_rw_lock_init(struct uacpi_rw_lock *lock);
@@ -76,3 +83,31 @@ uacpi_status uacpi_rw_unlock_read(struct uacpi_rw_lock *lock);
 
 uacpi_status uacpi_rw_lock_write(struct uacpi_rw_lock *lock);
 uacpi_status uacpi_rw_unlock_write(struct uacpi_rw_lock *lock);
+
+/*
+ * A completion group for work scheduled via uacpi_kernel_schedule_work:
+ * every item belonging to the group is accounted with a begin/done pair, and
+ * uacpi_wait_for_group_work_completion blocks only until this group's items
+ * have retired, instead of barriering on every outstanding host work item
+ * the way uacpi_kernel_wait_for_work_completion does.
+ */
+struct uacpi_work_group {
+    uacpi_handle event;
+    uacpi_u32 counter;
+};
+
+void uacpi_work_group_init(struct uacpi_work_group *group);
+void uacpi_work_group_deinit(struct uacpi_work_group *group);
+
+// Call before scheduling a work item belonging to the group
+void uacpi_work_group_begin(struct uacpi_work_group *group);
+
+/*
+ * Call at the very end of the work item, or to take back a
+ * uacpi_work_group_begin after a failed schedule attempt.
+ */
+void uacpi_work_group_done(struct uacpi_work_group *group);
+
+uacpi_status uacpi_wait_for_group_work_completion(
+    struct uacpi_work_group *group
+);
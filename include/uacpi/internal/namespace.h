@@ -24,6 +24,8 @@
 
 #define UACPI_NAMESPACE_NODE_PREDEFINED (1u << 31)
 
+struct uacpi_namespace_node_child_index;
+
 typedef struct uacpi_namespace_node {
     struct uacpi_shareable shareable;
     uacpi_object_name name;
@@ -32,6 +34,13 @@ typedef struct uacpi_namespace_node {
     struct uacpi_namespace_node *parent;
     struct uacpi_namespace_node *child;
     struct uacpi_namespace_node *next;
+
+    /*
+     * Optional hash index on top of the child list, only maintained for wide
+     * scopes. Guarded by the namespace lock just like the child list itself.
+     */
+    struct uacpi_namespace_node_child_index *child_index;
+    uacpi_u32 child_count;
 } uacpi_namespace_node;
 
 uacpi_status uacpi_initialize_namespace(void);
@@ -75,6 +84,16 @@ uacpi_status uacpi_namespace_node_install(
 );
 uacpi_status uacpi_namespace_node_uninstall(uacpi_namespace_node *node);
 
+/*
+ * Uninstall 'count' nodes in reverse array order, batching the child index
+ * maintenance of the affected parent scopes. Used for the temporary node
+ * cleanup on method exit, where tearing the nodes down one by one would
+ * rebuild the same index once per removed sibling.
+ */
+void uacpi_namespace_node_uninstall_bulk(
+    uacpi_namespace_node **nodes, uacpi_size count
+);
+
 uacpi_namespace_node *uacpi_namespace_node_find_sub_node(
     uacpi_namespace_node *parent,
     uacpi_object_name name
@@ -112,6 +131,15 @@ uacpi_bool uacpi_namespace_node_is_dangling(uacpi_namespace_node *node);
 uacpi_bool uacpi_namespace_node_is_temporary(uacpi_namespace_node *node);
 uacpi_bool uacpi_namespace_node_is_predefined(uacpi_namespace_node *node);
 
+uacpi_u64 uacpi_namespace_generation(void);
+
+/*
+ * Build (or refresh) the flattened pre-order namespace index used to
+ * accelerate full-tree walks, so that the first post-load enumeration doesn't
+ * pay for the build. Purely an optimization, failure is not fatal.
+ */
+void uacpi_namespace_prime_flat_index(void);
+
 uacpi_status uacpi_namespace_read_lock(void);
 uacpi_status uacpi_namespace_read_unlock(void);
 
@@ -48,6 +48,14 @@ enum uacpi_parse_op {
      */
     UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED,
 
+    /*
+     * Same as UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED, but
+     * constant elements of a package living directly inside a mapped table
+     * are not parsed at all: their AML range is recorded and the object is
+     * only materialized on first access. Exclusively used by package ops.
+     */
+    UACPI_PARSE_OP_PACKAGE_ELEMENT,
+
     // Operand := TermArg => Integer
     UACPI_PARSE_OP_OPERAND,
 
@@ -260,7 +268,9 @@ enum uacpi_op_property {
 };
 
 struct uacpi_op_spec {
+#ifndef UACPI_COMPACT_OPCODE_TABLE
     uacpi_char *name;
+#endif
     union {
         uacpi_u8 decode_ops[16];
         uacpi_u8 *indirect_decode_ops;
@@ -271,6 +281,13 @@ struct uacpi_op_spec {
 
 const struct uacpi_op_spec *uacpi_get_op_spec(uacpi_aml_op);
 
+#ifdef UACPI_COMPACT_OPCODE_TABLE
+const uacpi_char *uacpi_get_op_name(uacpi_aml_op);
+#define uacpi_op_spec_name(spec) uacpi_get_op_name((spec)->code)
+#else
+#define uacpi_op_spec_name(spec) ((spec)->name)
+#endif
+
 #define UACPI_INTERNAL_OP(code) \
     UACPI_OP(Internal_##code, code, { UACPI_PARSE_OP_UNREACHABLE })
 
@@ -350,7 +367,7 @@ UACPI_OP(                                                          \
         ##__VA_ARGS__,                                             \
         UACPI_PARSE_OP_IF_HAS_DATA, 4,                             \
             UACPI_PARSE_OP_RECORD_AML_PC,                          \
-            UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED, \
+            UACPI_PARSE_OP_PACKAGE_ELEMENT,                        \
             UACPI_PARSE_OP_JMP, jmp_off,                           \
         UACPI_PARSE_OP_OBJECT_ALLOC_TYPED, UACPI_OBJECT_PACKAGE,   \
         UACPI_PARSE_OP_INVOKE_HANDLER,                             \
@@ -14,12 +14,6 @@ void uacpi_trace_region_io(
     uacpi_u64 offset, uacpi_u8 byte_size, uacpi_u64 ret
 );
 
-uacpi_status uacpi_install_address_space_handler_with_flags(
-    uacpi_namespace_node *device_node, enum uacpi_address_space space,
-    uacpi_region_handler handler, uacpi_handle handler_context,
-    uacpi_u16 flags
-);
-
 void uacpi_opregion_uninstall_handler(uacpi_namespace_node *node);
 
 uacpi_bool uacpi_address_space_handler_is_default(
@@ -35,8 +29,16 @@ uacpi_status uacpi_initialize_opregion_node(uacpi_namespace_node *node);
 uacpi_status uacpi_opregion_attach(uacpi_namespace_node *node);
 
 void uacpi_install_default_address_space_handlers(void);
+void uacpi_deinitialize_default_address_space_handlers(void);
 
 uacpi_status uacpi_dispatch_opregion_io(
     uacpi_namespace_node *region_node, uacpi_u32 offset, uacpi_u8 byte_width,
     uacpi_region_op op, uacpi_u64 *in_out
 );
+
+uacpi_bool uacpi_opregion_supports_rw_many(uacpi_namespace_node *region_node);
+
+uacpi_status uacpi_dispatch_opregion_rw_many(
+    uacpi_namespace_node *region_node, uacpi_u32 offset, uacpi_u8 byte_width,
+    uacpi_region_op op, uacpi_u64 *values, uacpi_size count
+);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <uacpi/types.h>
+#include <uacpi/status.h>
+
+/*
+ * A simple slab-style allocator for small fixed-size internal structures
+ * (namespace nodes and objects). Storage is carved out of larger chunks
+ * bulk-allocated from uacpi_kernel_alloc, so per-node/object churn during
+ * namespace load and method execution doesn't go through the host heap.
+ */
+struct uacpi_pool {
+    uacpi_size object_size;
+    uacpi_size objects_per_slab;
+    uacpi_handle lock;
+    struct uacpi_pool_slab *slabs;
+    void *free_list;
+};
+
+uacpi_status uacpi_initialize_pools(void);
+void uacpi_deinitialize_pools(void);
+
+void *uacpi_pool_alloc(struct uacpi_pool *pool);
+void *uacpi_pool_alloc_zeroed(struct uacpi_pool *pool);
+void uacpi_pool_free(struct uacpi_pool *pool, void *object);
+
+/*
+ * Grab 'count' zeroed objects with a single lock acquisition, refilling the
+ * pool as many times as needed. All-or-nothing: on failure no objects are
+ * handed out. Each object is still released individually via uacpi_pool_free.
+ */
+uacpi_bool uacpi_pool_alloc_zeroed_bulk(
+    struct uacpi_pool *pool, void **out_objects, uacpi_size count
+);
+
+struct uacpi_pool *uacpi_namespace_node_pool(void);
+struct uacpi_pool *uacpi_object_pool(void);
+
+/*
+ * A chunked bump allocator for short-lived allocations that all share one
+ * well-defined point of death (e.g. interpreter temporaries that die with
+ * their execution context). There is no per-allocation free, the entire
+ * arena is released in one shot via uacpi_arena_reset.
+ *
+ * Zero-initializing the structure is a valid empty arena.
+ */
+struct uacpi_arena {
+    struct uacpi_arena_chunk *chunks;
+};
+
+void *uacpi_arena_alloc(struct uacpi_arena *arena, uacpi_size size);
+void uacpi_arena_reset(struct uacpi_arena *arena);
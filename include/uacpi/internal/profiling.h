@@ -0,0 +1,19 @@
+#pragma once
+
+#include <uacpi/profiling.h>
+#include <uacpi/internal/namespace.h>
+#include <uacpi/internal/opcodes.h>
+
+#ifdef UACPI_PROFILING
+/*
+ * Both of these are only ever invoked by the interpreter, and thus rely on
+ * the namespace write lock for serialization against each other and against
+ * the public stats readers.
+ */
+void uacpi_profile_op(uacpi_aml_op op, uacpi_u64 elapsed_ns);
+void uacpi_profile_method(uacpi_namespace_node *node, uacpi_u64 elapsed_ns);
+#endif
+
+UACPI_STUB_IF_NO_PROFILING(
+    void uacpi_deinitialize_profiling(void)
+)
@@ -318,6 +318,13 @@ uacpi_status uacpi_native_resources_from_aml(
     uacpi_buffer *aml_buffer, uacpi_resources **out_resources
 );
 
+uacpi_status uacpi_native_resources_from_aml_in(
+    uacpi_buffer *aml_buffer, uacpi_resource_arena *arena,
+    uacpi_resources *out_resources
+);
+
 uacpi_status uacpi_native_resources_to_aml(
     uacpi_resources *resources, uacpi_object **out_template
 );
+
+void uacpi_free_srs_template_cache(void);
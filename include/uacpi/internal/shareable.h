@@ -11,6 +11,16 @@ void uacpi_shareable_init(uacpi_handle);
 uacpi_bool uacpi_bugged_shareable(uacpi_handle);
 void uacpi_make_shareable_bugged(uacpi_handle);
 
+/*
+ * Pin the object as permanently referenced: ref/unref become plain atomic
+ * loads with no contended read-modify-write, and the object is never handed
+ * to the do_free callback of uacpi_shareable_unref_and_delete_if_last.
+ * Only valid for objects whose lifetime is managed explicitly, e.g. the
+ * statically allocated predefined namespace nodes, which are instead torn
+ * down by uacpi_deinitialize_namespace directly.
+ */
+void uacpi_make_shareable_permanent(uacpi_handle);
+
 uacpi_u32 uacpi_shareable_ref(uacpi_handle);
 uacpi_u32 uacpi_shareable_unref(uacpi_handle);
 
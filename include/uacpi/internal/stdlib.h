@@ -47,11 +47,13 @@ uacpi_i32 uacpi_vsnprintf(
 );
 #endif
 
+#ifndef UACPI_MEMORY_ACCOUNTING
 #ifdef UACPI_SIZED_FREES
 #define uacpi_free(mem, size) uacpi_kernel_free(mem, size)
 #else
 #define uacpi_free(mem, _) uacpi_kernel_free(mem)
 #endif
+#endif
 
 #define uacpi_memzero(ptr, size) uacpi_memset(ptr, 0, size)
 
@@ -81,6 +83,47 @@ uacpi_u8 uacpi_bit_scan_backward(uacpi_u64);
 
 uacpi_u8 uacpi_popcount(uacpi_u64);
 
+extern const uacpi_char uacpi_hex_chars[16];
+
+/*
+ * Render an integer without a null terminator, returning the number of
+ * characters written. The buffer must fit the largest possible
+ * representation: 16 characters for hex (no leading zeros or 0x prefix),
+ * 20 for decimal.
+ */
+uacpi_size uacpi_u64_to_hex_string(
+    uacpi_u64 value, uacpi_char *buf, uacpi_bool uppercase
+);
+uacpi_size uacpi_u64_to_dec_string(uacpi_u64 value, uacpi_char *buf);
+
 #ifndef UACPI_NATIVE_ALLOC_ZEROED
 void *uacpi_kernel_alloc_zeroed(uacpi_size size);
 #endif
+
+#ifdef UACPI_MEMORY_ACCOUNTING
+#include <uacpi/memory.h>
+
+void *uacpi_tracked_alloc(uacpi_memory_subsystem subsystem, uacpi_size size);
+void *uacpi_tracked_alloc_zeroed(
+    uacpi_memory_subsystem subsystem, uacpi_size size
+);
+void uacpi_tracked_free(void *mem, uacpi_size size_hint);
+
+/*
+ * The subsystem every allocation in a translation unit is attributed to,
+ * resolved at the call site. Translation units with a dedicated subsystem
+ * redefine this right after their includes.
+ */
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_OTHER
+
+/*
+ * Route every allocation through the accounting wrappers. This is safe
+ * because every prototype of the allocation API is guaranteed to be fully
+ * processed at this point, so none of them see these macros.
+ */
+#define uacpi_kernel_alloc(size) \
+    uacpi_tracked_alloc(UACPI_TRACKED_SUBSYSTEM, size)
+#define uacpi_kernel_alloc_zeroed(size) \
+    uacpi_tracked_alloc_zeroed(UACPI_TRACKED_SUBSYSTEM, size)
+#define uacpi_free(mem, size) uacpi_tracked_free(mem, size)
+#endif
@@ -21,6 +21,13 @@ struct uacpi_installed_table {
 
     uacpi_u16 reference_count;
 
+    /*
+     * Index (offset by one, zero meaning end of chain) of the next installed
+     * table sharing this table's signature, maintained by the signature index
+     * in tables.c.
+     */
+    uacpi_u16 next_same_sig;
+
 #define UACPI_TABLE_LOADED (1 << 0)
 #define UACPI_TABLE_CSUM_VERIFIED (1 << 1)
 #define UACPI_TABLE_INVALID (1 << 2)
@@ -31,6 +38,13 @@ struct uacpi_installed_table {
 uacpi_status uacpi_initialize_tables(void);
 void uacpi_deinitialize_tables(void);
 
+/*
+ * Schedule a background work item verifying the checksums of all installed
+ * tables that don't have one verified yet. No-op unless
+ * UACPI_FLAG_DEFERRED_TBL_CSUM is set and the subsystem is initialized.
+ */
+void uacpi_tables_schedule_deferred_verification(void);
+
 uacpi_bool uacpi_signatures_match(const void *const lhs, const void *const rhs);
 uacpi_status uacpi_check_table_signature(void *table, const uacpi_char *expect);
 uacpi_status uacpi_verify_table_checksum(void *table, uacpi_size size);
@@ -55,6 +69,42 @@ uacpi_status uacpi_for_each_table(
     uacpi_size base_idx, uacpi_table_iteration_callback, void *user
 );
 
+/*
+ * A lightweight copy of an installed table descriptor, for consumers that
+ * want to iterate tables without holding the table lock across their own
+ * processing (uacpi_for_each_table runs the callback under it).
+ */
+struct uacpi_table_descriptor {
+    uacpi_char signature[4];
+    uacpi_phys_addr phys_addr;
+    uacpi_u32 length;
+    uacpi_size idx;
+
+    // Table array generation this descriptor was taken at
+    uacpi_u32 generation;
+};
+
+/*
+ * Copy the descriptors of every valid installed table starting at 'base_idx'
+ * into 'out_entries' under the table lock, then release it. 'in_out_count'
+ * is the capacity of the buffer on input and the number of copied entries on
+ * output; UACPI_STATUS_BUFFER_TOO_SMALL is returned (with the buffer filled
+ * to capacity) if it couldn't fit every table.
+ */
+uacpi_status uacpi_table_snapshot(
+    uacpi_size base_idx, struct uacpi_table_descriptor *out_entries,
+    uacpi_size *in_out_count
+);
+
+/*
+ * Same as uacpi_table_ref, but for a descriptor taken via
+ * uacpi_table_snapshot: fails cleanly with UACPI_STATUS_NOT_FOUND if any
+ * table was installed or invalidated since the snapshot was taken.
+ */
+uacpi_status uacpi_table_ref_snapshot(
+    const struct uacpi_table_descriptor *desc, uacpi_table *out_table
+);
+
 typedef uacpi_bool (*uacpi_table_match_callback)
     (struct uacpi_installed_table *tbl);
 
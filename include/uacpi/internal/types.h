@@ -27,14 +27,57 @@ typedef struct uacpi_buffer {
         uacpi_char *text;
     };
     uacpi_size size;
+
+    /*
+     * When set, data is not owned but points into the mapped table at
+     * aliased_table_idx, on which this buffer holds a reference. Writers must
+     * promote the buffer to an owned copy first, see
+     * uacpi_buffer_ensure_mutable.
+     */
+    uacpi_u32 aliased_table_idx;
+    uacpi_bool aliases_table;
 } uacpi_buffer;
 
+uacpi_status uacpi_buffer_ensure_mutable(uacpi_buffer *buf);
+
+/*
+ * Tracks package elements whose encoding is constant data living inside the
+ * mapped table at table_idx (on which this structure holds one reference).
+ * Such elements are left as uninitialized objects by the interpreter and only
+ * decoded on first access, see uacpi_package_materialize_element.
+ */
+struct uacpi_deferred_package_data {
+    uacpi_u32 table_idx;
+
+    // Number of elements not yet materialized, freed when this drops to zero
+    uacpi_u32 pending;
+
+    // Method code the element ranges below point into
+    const uacpi_u8 *code;
+
+    struct {
+        uacpi_u32 offset;
+
+        // 0 if this element is not deferred (or no longer is)
+        uacpi_u32 size;
+    } elements[];
+};
+
 typedef struct uacpi_package {
     struct uacpi_shareable shareable;
     uacpi_object **objects;
     uacpi_size count;
+
+    // Non-NULL while any element is still deferred
+    struct uacpi_deferred_package_data *deferred;
 } uacpi_package;
 
+uacpi_status uacpi_package_materialize_element(
+    uacpi_package *pkg, uacpi_size idx
+);
+uacpi_status uacpi_package_materialize(uacpi_package *pkg);
+void uacpi_package_release_deferred(uacpi_package *pkg);
+
 typedef struct uacpi_buffer_field {
     uacpi_buffer *backing;
     uacpi_size bit_index;
@@ -68,6 +111,7 @@ typedef struct uacpi_address_space_handler {
     struct uacpi_operation_region *regions;
     uacpi_u16 space;
 
+// Public handler flags (uacpi/opregion.h) occupy the remaining bits
 #define UACPI_ADDRESS_SPACE_HANDLER_DEFAULT (1 << 0)
     uacpi_u16 flags;
 } uacpi_address_space_handler;
@@ -164,6 +208,9 @@ typedef struct uacpi_control_method {
         uacpi_native_call_handler handler;
     };
     uacpi_mutex *mutex;
+
+    // Lazily allocated by the interpreter, see uacpi_method_decode_cache_free
+    struct uacpi_method_decode_cache *decode_cache;
     uacpi_u32 size;
     uacpi_u8 sync_level : 4;
     uacpi_u8 args : 3;
@@ -171,6 +218,10 @@ typedef struct uacpi_control_method {
     uacpi_u8 named_objects_persist: 1;
     uacpi_u8 native_call : 1;
     uacpi_u8 owns_code : 1;
+
+    // Set when code aliases the mapped table at table_idx (table loads)
+    uacpi_u8 code_in_table : 1;
+    uacpi_u32 table_idx;
 } uacpi_control_method;
 
 typedef enum uacpi_access_type {
@@ -40,6 +40,22 @@ uacpi_status uacpi_string_to_integer(
 
 uacpi_bool uacpi_is_valid_nameseg(uacpi_u8 *nameseg);
 
+// Marks the index built via uacpi_build_device_id_index as out-of-date
+void uacpi_invalidate_device_id_index(void);
+
+/*
+ * Bumped on every dynamic table load, lazily invalidates cached _PRT
+ * results, device IDs and _SRS templates.
+ */
+void uacpi_bump_namespace_generation(void);
+
+// The current value of the generation bumped above
+uacpi_u32 uacpi_dynamic_load_generation(void);
+
+void uacpi_free_pci_routing_table_cache(void);
+
+void uacpi_free_id_string_cache(void);
+
 void uacpi_free_dynamic_string(const uacpi_char *str);
 
 #define UACPI_NANOSECONDS_PER_SEC (1000ull * 1000ull * 1000ull)
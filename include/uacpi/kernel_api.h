@@ -59,6 +59,27 @@ uacpi_status uacpi_kernel_pci_write(
     uacpi_u8 byte_width, uacpi_u64 value
 );
 
+#ifdef UACPI_VECTORED_KERNEL_IO
+/*
+ * Optional vectored versions of the accessors above: perform 'count'
+ * consecutive accesses of 'byte_width' bytes each, the first at 'offset' and
+ * every subsequent one at the offset of the previous access plus
+ * 'byte_width', reading into/writing from one value per access.
+ *
+ * Hosts where every configuration space access has a fixed trap cost can
+ * implement these to pay that cost once per run instead of once per access.
+ * The same 'byte_width' rules as for the single accessors apply to each unit.
+ */
+uacpi_status uacpi_kernel_pci_read_many(
+    uacpi_handle device, uacpi_size offset,
+    uacpi_u8 byte_width, uacpi_u64 *values, uacpi_size count
+);
+uacpi_status uacpi_kernel_pci_write_many(
+    uacpi_handle device, uacpi_size offset,
+    uacpi_u8 byte_width, const uacpi_u64 *values, uacpi_size count
+);
+#endif
+
 /*
  * Map a SystemIO address at [base, base + len) and return a kernel-implemented
  * handle that can be used for reading and writing the IO range.
@@ -86,6 +107,23 @@ uacpi_status uacpi_kernel_io_write(
     uacpi_u8 byte_width, uacpi_u64 value
 );
 
+#ifdef UACPI_VECTORED_KERNEL_IO
+/*
+ * Optional vectored versions of the accessors above, with the same run
+ * semantics as uacpi_kernel_pci_read_many/uacpi_kernel_pci_write_many. Lets
+ * hosts where every port access is a hypervisor trap batch a multi-unit
+ * field access into a single exit.
+ */
+uacpi_status uacpi_kernel_io_read_many(
+    uacpi_handle, uacpi_size offset,
+    uacpi_u8 byte_width, uacpi_u64 *values, uacpi_size count
+);
+uacpi_status uacpi_kernel_io_write_many(
+    uacpi_handle, uacpi_size offset,
+    uacpi_u8 byte_width, const uacpi_u64 *values, uacpi_size count
+);
+#endif
+
 void *uacpi_kernel_map(uacpi_phys_addr addr, uacpi_size len);
 void uacpi_kernel_unmap(void *addr, uacpi_size len);
 
@@ -263,6 +301,20 @@ typedef enum uacpi_work_type {
      * This can run on any CPU.
      */
     UACPI_WORK_NOTIFICATION,
+
+    /*
+     * Schedule an asynchronous namespace load or dynamic table load (see
+     * uacpi_namespace_load_async and uacpi_table_load_async). This can run on
+     * any CPU, but is long-running and must not be executed inline from the
+     * scheduling call.
+     */
+    UACPI_WORK_NAMESPACE_LOAD,
+
+    /*
+     * Schedule a _STA/_INI walk of an independent device subtree, only used
+     * if UACPI_FLAG_CONCURRENT_NS_INIT is set. This can run on any CPU.
+     */
+    UACPI_WORK_NAMESPACE_INIT,
 } uacpi_work_type;
 
 typedef void (*uacpi_work_handler)(uacpi_handle);
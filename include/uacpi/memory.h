@@ -0,0 +1,87 @@
+#pragma once
+
+#include <uacpi/types.h>
+#include <uacpi/status.h>
+#include <uacpi/platform/config.h>
+
+#ifndef UACPI_MEMORY_ACCOUNTING
+#define UACPI_MAKE_STUB_FOR_NO_MEMORY_ACCOUNTING(fn, ret) \
+    UACPI_NO_UNUSED_PARAMETER_WARNINGS_BEGIN              \
+    static inline fn { return ret; }                      \
+    UACPI_NO_UNUSED_PARAMETER_WARNINGS_END
+
+#define UACPI_ALWAYS_ERROR_FOR_NO_MEMORY_ACCOUNTING(fn) \
+    UACPI_MAKE_STUB_FOR_NO_MEMORY_ACCOUNTING(fn, UACPI_STATUS_COMPILED_OUT)
+#else
+#define UACPI_ALWAYS_ERROR_FOR_NO_MEMORY_ACCOUNTING(fn) fn;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum uacpi_memory_subsystem {
+    // Runtime objects: integers, strings, buffers, packages, etc.
+    UACPI_MEMORY_SUBSYSTEM_OBJECTS = 0,
+
+    // Namespace nodes
+    UACPI_MEMORY_SUBSYSTEM_NAMESPACE,
+
+    // Table descriptors and related bookkeeping
+    UACPI_MEMORY_SUBSYSTEM_TABLES,
+
+    // Execution contexts, call frames and other interpreter state
+    UACPI_MEMORY_SUBSYSTEM_INTERPRETER,
+
+    // GPE and notify dispatch state
+    UACPI_MEMORY_SUBSYSTEM_EVENTS,
+
+    // Everything else
+    UACPI_MEMORY_SUBSYSTEM_OTHER,
+
+    UACPI_MEMORY_SUBSYSTEM_COUNT,
+} uacpi_memory_subsystem;
+
+typedef struct uacpi_memory_subsystem_stats {
+    // Bytes currently allocated, and the highest this value has ever been
+    uacpi_u64 bytes_in_use;
+    uacpi_u64 peak_bytes_in_use;
+
+    // Number of currently live allocations
+    uacpi_u64 live_allocations;
+
+    // Number of allocations ever made, including since-freed ones
+    uacpi_u64 total_allocations;
+} uacpi_memory_subsystem_stats;
+
+typedef struct uacpi_memory_stats {
+    // Indexed by uacpi_memory_subsystem
+    uacpi_memory_subsystem_stats subsystems[UACPI_MEMORY_SUBSYSTEM_COUNT];
+
+    // Aggregate over every subsystem
+    uacpi_memory_subsystem_stats total;
+} uacpi_memory_stats;
+
+const uacpi_char *uacpi_memory_subsystem_to_string(
+    uacpi_memory_subsystem subsystem
+);
+
+/*
+ * Fill out a snapshot of uACPI's current heap usage, per subsystem as well as
+ * aggregated. The reported byte counts do not include the per-allocation
+ * accounting header (two pointers' worth of overhead each).
+ *
+ * The peak watermarks make it possible to size a dedicated heap reservation
+ * by sampling after the high-pressure phases (e.g. right after namespace
+ * load and initialization) instead of guessing.
+ *
+ * Returns UACPI_STATUS_COMPILED_OUT if UACPI_MEMORY_ACCOUNTING is not
+ * enabled.
+ */
+UACPI_ALWAYS_ERROR_FOR_NO_MEMORY_ACCOUNTING(
+    uacpi_status uacpi_get_memory_stats(uacpi_memory_stats *out_stats)
+)
+
+#ifdef __cplusplus
+}
+#endif
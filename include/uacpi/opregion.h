@@ -19,6 +19,25 @@ uacpi_status uacpi_install_address_space_handler(
     uacpi_region_handler handler, uacpi_handle handler_context
 );
 
+/*
+ * The handler understands the UACPI_REGION_OP_READ_MANY and
+ * UACPI_REGION_OP_WRITE_MANY region ops and may be handed a run of contiguous
+ * equally-sized accesses in a single invocation instead of one call per
+ * access.
+ */
+#define UACPI_ADDRESS_SPACE_HANDLER_RW_MANY (1 << 1)
+
+/*
+ * Same as uacpi_install_address_space_handler, but also takes a set of
+ * UACPI_ADDRESS_SPACE_HANDLER_* flags describing the optional capabilities
+ * of this handler. Note that bit 0 is reserved for internal use.
+ */
+uacpi_status uacpi_install_address_space_handler_with_flags(
+    uacpi_namespace_node *device_node, enum uacpi_address_space space,
+    uacpi_region_handler handler, uacpi_handle handler_context,
+    uacpi_u16 flags
+);
+
 /*
  * Uninstall the handler of type 'space' from a given device node.
  */
@@ -38,6 +57,35 @@ uacpi_status uacpi_reg_all_opregions(
     enum uacpi_address_space space
 );
 
+typedef void (*uacpi_reg_all_opregions_callback)(
+    uacpi_status ret, uacpi_handle user
+);
+
+/*
+ * Same as uacpi_reg_all_opregions, except the _REG batch is executed from a
+ * host worker thread (via uacpi_kernel_schedule_work) instead of the calling
+ * thread, with 'callback' invoked from the worker once the entire batch is
+ * done. Useful during early boot when a handler controls many operation
+ * regions (e.g. an EC handler) and the install path is latency-sensitive.
+ */
+uacpi_status uacpi_reg_all_opregions_async(
+    uacpi_namespace_node *device_node, enum uacpi_address_space space,
+    uacpi_reg_all_opregions_callback callback, uacpi_handle user
+);
+
+/*
+ * Log the most recent operation region accesses: every dispatch through a
+ * region handler records its address space, offset, width and latency into a
+ * fixed-size trace ring (sized via UACPI_OPREGION_TRACE_RING_SIZE). The
+ * recording is always compiled in and cheap enough to stay enabled in
+ * production, so this can be used to diagnose e.g. slow EC transactions
+ * after the fact.
+ *
+ * Records are best-effort: a dispatch racing with a dump (or a ring
+ * wrap-around) may yield a partially updated record.
+ */
+void uacpi_dump_opregion_trace(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,22 +9,36 @@
 #include "uacpi_compiler.h"
 #else
 
-#define UACPI_ALIGN(x) __declspec(align(x))
-
 #ifdef _MSC_VER
     #include <intrin.h>
 
     #define UACPI_ALWAYS_INLINE __forceinline
 
+    #define UACPI_ALIGN(x) __declspec(align(x))
+
     #define UACPI_PACKED(decl)  \
         __pragma(pack(push, 1)) \
         decl;                   \
         __pragma(pack(pop))
 #else
     #define UACPI_ALWAYS_INLINE inline __attribute__((always_inline))
+
+    #define UACPI_ALIGN(x) __attribute__((aligned(x)))
+
     #define UACPI_PACKED(decl) decl __attribute__((packed));
 #endif
 
+/*
+ * The assumed size of a CPU cache line, used to keep write-hot state from
+ * sharing a line with read-mostly state. Purely a performance knob, any
+ * power of two is correct.
+ */
+#ifndef UACPI_CACHE_LINE_SIZE
+    #define UACPI_CACHE_LINE_SIZE 64
+#endif
+
+#define UACPI_CACHE_ALIGNED UACPI_ALIGN(UACPI_CACHE_LINE_SIZE)
+
 #ifdef __GNUC__
     #define uacpi_unlikely(expr) __builtin_expect(!!(expr), 0)
     #define uacpi_likely(expr)   __builtin_expect(!!(expr), 1)
@@ -35,6 +49,15 @@
 
     #define UACPI_MAYBE_UNUSED __attribute__ ((unused))
 
+    /*
+     * Labels-as-values is supported, which the interpreter uses to build a
+     * direct-threaded dispatch table instead of going through a generic
+     * switch. Define UACPI_NO_COMPUTED_GOTO to force the portable dispatch.
+     */
+    #ifndef UACPI_NO_COMPUTED_GOTO
+        #define UACPI_COMPUTED_GOTO
+    #endif
+
     #define UACPI_NO_UNUSED_PARAMETER_WARNINGS_BEGIN             \
         _Pragma("GCC diagnostic push")                           \
         _Pragma("GCC diagnostic ignored \"-Wunused-parameter\"")
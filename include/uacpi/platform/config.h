@@ -22,6 +22,22 @@ UACPI_BUILD_BUG_ON_WITH_MSG(
     "configured default log level is invalid"
 );
 
+/*
+ * The maximum log level compiled into the library. Messages above this level
+ * are stripped at build time: the level check folds to a constant false, so
+ * they cost nothing at runtime, including on the interpreter hot path. The
+ * default keeps every level compiled in.
+ */
+#ifndef UACPI_MAX_COMPILED_LOG_LEVEL
+    #define UACPI_MAX_COMPILED_LOG_LEVEL UACPI_LOG_DEBUG
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_MAX_COMPILED_LOG_LEVEL < UACPI_LOG_ERROR ||
+    UACPI_MAX_COMPILED_LOG_LEVEL > UACPI_LOG_DEBUG,
+    "configured maximum compiled log level is invalid"
+);
+
 #ifndef UACPI_DEFAULT_LOOP_TIMEOUT_SECONDS
     #define UACPI_DEFAULT_LOOP_TIMEOUT_SECONDS 30
 #endif
@@ -100,6 +116,46 @@ UACPI_BUILD_BUG_ON_WITH_MSG(
  * =============
  */
 
+/*
+ * Enables heap usage accounting: every allocation is tagged with its size and
+ * owning subsystem, and per-subsystem byte counters, live object counts and
+ * peak watermarks become queryable via uacpi_get_memory_stats. Costs two
+ * pointers' worth of overhead per allocation plus a few atomic updates on
+ * every allocation and free.
+ */
+// #define UACPI_MEMORY_ACCOUNTING
+
+/*
+ * Enables the built-in execution profiler: the interpreter accumulates hit
+ * counts and execution times per opcode, and every control method invocation
+ * records its wall time into a per-method table. The accumulated counters are
+ * queryable via uacpi_get_profile_stats.
+ *
+ * This adds two timestamp reads around every dispatched opcode, so it is
+ * intended for diagnostics builds rather than production use.
+ */
+// #define UACPI_PROFILING
+
+/*
+ * Enables per-GPE dispatch latency histograms: every batched GPE dispatch is
+ * timestamped at detection, around the handler run, and when the restore pass
+ * reaches the event, and the three resulting latencies (work queue, handler,
+ * restore) are accumulated into log2 histograms queryable via
+ * uacpi_gpe_get_latency_histograms. This costs a few
+ * uacpi_kernel_get_nanoseconds_since_boot reads per dispatched event (one of
+ * them from the interrupt handler, so the host clock must be callable from
+ * interrupt context), cheap enough to stay enabled in production.
+ */
+// #define UACPI_GPE_LATENCY_STATS
+
+/*
+ * Shrinks the opcode dispatch tables by stripping the opcode name strings out
+ * of the hot per-opcode entries and into a separate cold table, so the
+ * metadata accessed on every dispatched op packs into fewer cache lines.
+ * Opcode names remain available for diagnostics via uacpi_get_op_name.
+ */
+// #define UACPI_COMPACT_OPCODE_TABLE
+
 /*
  * If UACPI_FORMATTED_LOGGING is not enabled, this is the maximum length of the
  * pre-formatted message that is passed to the logging callback.
@@ -113,6 +169,38 @@ UACPI_BUILD_BUG_ON_WITH_MSG(
     "configured log buffer size is too small (expecting at least 16 bytes)"
 );
 
+/*
+ * The number of records in the deferred log ring buffer, see
+ * uacpi_context_set_deferred_logging. Only meaningful if
+ * UACPI_FORMATTED_LOGGING is not enabled. Must be a power of two.
+ */
+#ifndef UACPI_DEFERRED_LOG_RING_SIZE
+    #define UACPI_DEFERRED_LOG_RING_SIZE 32
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_DEFERRED_LOG_RING_SIZE < 2 ||
+    (UACPI_DEFERRED_LOG_RING_SIZE & (UACPI_DEFERRED_LOG_RING_SIZE - 1)) != 0,
+    "configured deferred log ring size is invalid "
+    "(expecting a power of two of at least 2)"
+);
+
+/*
+ * The number of records in the operation region access trace ring, see
+ * uacpi_dump_opregion_trace. Must be a power of two.
+ */
+#ifndef UACPI_OPREGION_TRACE_RING_SIZE
+    #define UACPI_OPREGION_TRACE_RING_SIZE 64
+#endif
+
+UACPI_BUILD_BUG_ON_WITH_MSG(
+    UACPI_OPREGION_TRACE_RING_SIZE < 2 ||
+    (UACPI_OPREGION_TRACE_RING_SIZE &
+     (UACPI_OPREGION_TRACE_RING_SIZE - 1)) != 0,
+    "configured opregion trace ring size is invalid "
+    "(expecting a power of two of at least 2)"
+);
+
 /*
  * The size of the table descriptor inline storage. All table descriptors past
  * this length will be stored in a dynamically allocated heap array. The size
@@ -127,4 +215,15 @@ UACPI_BUILD_BUG_ON_WITH_MSG(
     "configured static table array length is too small (expecting at least 1)"
 );
 
+/*
+ * The maximum number of physically-backed table mappings kept around after
+ * their last reference is dropped, so that re-acquiring a frequently used
+ * table doesn't pay for a remap every time. Once the cache is full, the least
+ * recently used mapping is evicted. Set to 0 to unmap tables as soon as the
+ * last reference is gone, as was always the case previously.
+ */
+#ifndef UACPI_TABLE_MAPPING_CACHE_SIZE
+    #define UACPI_TABLE_MAPPING_CACHE_SIZE 8
+#endif
+
 #endif
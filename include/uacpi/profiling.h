@@ -0,0 +1,99 @@
+#pragma once
+
+#include <uacpi/types.h>
+#include <uacpi/status.h>
+#include <uacpi/platform/config.h>
+
+#ifndef UACPI_PROFILING
+#define UACPI_MAKE_STUB_FOR_NO_PROFILING(fn, ret) \
+    UACPI_NO_UNUSED_PARAMETER_WARNINGS_BEGIN      \
+    static inline fn { return ret; }              \
+    UACPI_NO_UNUSED_PARAMETER_WARNINGS_END
+
+#define UACPI_STUB_IF_NO_PROFILING(fn) \
+    UACPI_MAKE_STUB_FOR_NO_PROFILING(fn,)
+#define UACPI_ALWAYS_ERROR_FOR_NO_PROFILING(fn) \
+    UACPI_MAKE_STUB_FOR_NO_PROFILING(fn, UACPI_STATUS_COMPILED_OUT)
+#else
+#define UACPI_STUB_IF_NO_PROFILING(fn) fn;
+#define UACPI_ALWAYS_ERROR_FOR_NO_PROFILING(fn) fn;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct uacpi_opcode_profile_entry {
+    // Static spec name of the opcode, e.g. "AddOp", never freed
+    const uacpi_char *name;
+
+    // Raw opcode, extended opcodes are encoded as 0x5BXX
+    uacpi_u16 op;
+
+    // Number of times the interpreter dispatched this opcode
+    uacpi_u64 hits;
+
+    // Total nanoseconds spent executing this opcode
+    uacpi_u64 total_ns;
+} uacpi_opcode_profile_entry;
+
+typedef struct uacpi_method_profile_entry {
+    /*
+     * Absolute path of the method. May be UACPI_NULL if allocating it failed
+     * at record time.
+     */
+    const uacpi_char *path;
+
+    // Number of native invocations of this method
+    uacpi_u64 calls;
+
+    // Total/shortest/longest wall time of an invocation, in nanoseconds
+    uacpi_u64 total_ns;
+    uacpi_u64 min_ns;
+    uacpi_u64 max_ns;
+} uacpi_method_profile_entry;
+
+typedef struct uacpi_profile_stats {
+    uacpi_opcode_profile_entry *opcodes;
+    uacpi_size num_opcodes;
+
+    uacpi_method_profile_entry *methods;
+    uacpi_size num_methods;
+} uacpi_profile_stats;
+
+/*
+ * Take a self-contained snapshot of the execution profile accumulated so far:
+ * one entry per opcode that was dispatched at least once, and one entry per
+ * control method invoked via uacpi_execute_control_method (table loads are
+ * not recorded). The snapshot must be released via uacpi_free_profile_stats.
+ *
+ * Opcode timings attribute the entire dispatch of an instruction to its
+ * opcode, including any preempted time spent executing nested instructions,
+ * so the per-opcode totals overlap and do not sum up to wall time. Method
+ * wall times include any time the invocation spent parked if it was
+ * suspendable.
+ *
+ * Note that this briefly acquires the namespace read lock to get a stable
+ * view of the counters.
+ *
+ * Returns UACPI_STATUS_COMPILED_OUT if UACPI_PROFILING is not enabled.
+ */
+UACPI_ALWAYS_ERROR_FOR_NO_PROFILING(
+    uacpi_status uacpi_get_profile_stats(uacpi_profile_stats **out_stats)
+)
+
+UACPI_STUB_IF_NO_PROFILING(
+    void uacpi_free_profile_stats(uacpi_profile_stats *stats)
+)
+
+/*
+ * Zero out all accumulated counters, e.g. to profile only a specific workload.
+ * Acquires the namespace write lock to exclude concurrent execution.
+ */
+UACPI_ALWAYS_ERROR_FOR_NO_PROFILING(
+    uacpi_status uacpi_reset_profile_stats(void)
+)
+
+#ifdef __cplusplus
+}
+#endif
@@ -656,6 +656,52 @@ uacpi_status uacpi_get_possible_resources(
     uacpi_namespace_node *device, uacpi_resources **out_resources
 );
 
+struct uacpi_resource_arena;
+
+/*
+ * Invoked when the arena capacity is not enough for the converted resource
+ * list. Expected to make 'buffer' at least 'required_capacity' bytes large
+ * (the old contents don't have to be preserved) and to update the arena
+ * fields accordingly.
+ */
+typedef uacpi_status (*uacpi_resource_arena_grow_callback)(
+    struct uacpi_resource_arena *arena, uacpi_size required_capacity
+);
+
+/*
+ * Caller-owned storage for converted resource lists, reusable across any
+ * number of calls. uACPI never allocates or frees anything through it,
+ * releasing 'buffer' (in whatever way it was originally acquired) is entirely
+ * up to the caller.
+ */
+typedef struct uacpi_resource_arena {
+    void *buffer;
+    uacpi_size capacity;
+
+    // Optional, the conversion fails with UACPI_STATUS_BUFFER_TOO_SMALL if
+    // 'capacity' is not enough and this is not provided
+    uacpi_resource_arena_grow_callback grow;
+
+    // Free for use by the grow callback
+    void *user;
+} uacpi_resource_arena;
+
+/*
+ * Same as uacpi_get_current_resources/uacpi_get_possible_resources, but the
+ * converted list is placed into the caller-owned arena instead of a per-call
+ * heap allocation. 'out_resources' ends up pointing into the arena buffer and
+ * must not be passed to uacpi_free_resources.
+ */
+uacpi_status uacpi_get_current_resources_in(
+    uacpi_namespace_node *device, uacpi_resource_arena *arena,
+    uacpi_resources *out_resources
+);
+
+uacpi_status uacpi_get_possible_resources_in(
+    uacpi_namespace_node *device, uacpi_resource_arena *arena,
+    uacpi_resources *out_resources
+);
+
 uacpi_status uacpi_set_resources(
     uacpi_namespace_node *device, uacpi_resources *resources
 );
@@ -669,6 +715,57 @@ uacpi_status uacpi_for_each_device_resource(
     uacpi_resource_iteration_callback cb, void *user
 );
 
+/*
+ * A streaming iterator over a raw (unconverted) AML resource buffer.
+ *
+ * Unlike uacpi_get_current_resources and friends, this doesn't materialize
+ * the entire native resource list upfront, instead only the descriptor
+ * currently under the cursor is converted, into caller-provided storage.
+ *
+ * All fields are implementation details and must not be touched directly.
+ */
+typedef struct uacpi_resource_iterator {
+    uacpi_object *aml_buffer_obj;
+    uacpi_u8 *cursor;
+    uacpi_size bytes_left;
+} uacpi_resource_iterator;
+
+/*
+ * Evaluate a device's resource template method ("_CRS", "_PRS", etc.) and
+ * initialize an iterator over the returned raw buffer.
+ *
+ * The iterator must be disposed of via uacpi_resource_iterator_deinit once
+ * the caller is done with it, no matter how many descriptors were consumed.
+ */
+uacpi_status uacpi_device_resource_iterator_init(
+    uacpi_namespace_node *device, const uacpi_char *method,
+    uacpi_resource_iterator *it
+);
+
+/*
+ * Convert the descriptor under the cursor into the caller-provided storage
+ * at 'out_resource' ('capacity' bytes large) and advance the iterator past it.
+ *
+ * A plain uacpi_resource is big enough for any fixed-size descriptor, those
+ * carrying variable-length data (resource source strings, vendor data, pin
+ * tables) need extra trailing bytes, e.g.:
+ *     union {
+ *         uacpi_resource resource;
+ *         uacpi_u8 storage[512];
+ *     } buf;
+ *
+ * Returns UACPI_STATUS_BUFFER_TOO_SMALL (leaving the cursor in place so that
+ * the call may be retried with bigger storage) if 'capacity' is not enough
+ * for the current descriptor, and UACPI_STATUS_NOT_FOUND once the buffer is
+ * exhausted. The end tag is handed out to the caller as a normal descriptor.
+ */
+uacpi_status uacpi_resource_iterator_next(
+    uacpi_resource_iterator *it, uacpi_resource *out_resource,
+    uacpi_size capacity
+);
+
+void uacpi_resource_iterator_deinit(uacpi_resource_iterator *it);
+
 #ifdef __cplusplus
 }
 #endif
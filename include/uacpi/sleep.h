@@ -29,6 +29,16 @@ typedef enum uacpi_sleep_state {
     UACPI_SLEEP_STATE_MAX = UACPI_SLEEP_STATE_S5,
 } uacpi_sleep_state;
 
+/*
+ * Evaluate the \_Sx package for the given sleep state ahead of time (e.g. at
+ * boot) and cache the SLP_TYP values, so that a later
+ * uacpi_prepare_for_sleep_state for that state runs off the cache instead of
+ * invoking the AML interpreter on the latency-critical suspend path. _PTS and
+ * _SST take the target state as an argument and are still evaluated at
+ * transition time.
+ */
+uacpi_status uacpi_precompute_sleep_plan(uacpi_sleep_state);
+
 /*
  * Prepare for a given sleep state.
  * Must be caled with interrupts ENABLED.
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <uacpi/types.h>
+#include <uacpi/status.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Serialize the current namespace into a compact relocatable image that can
+ * later be fed to uacpi_namespace_snapshot_load instead of re-interpreting
+ * the same AML byte code, e.g. on the next boot of an identical machine.
+ *
+ * The image records the identity (signature, OEM ids, revision, length and
+ * checksum) of every loaded table so that a snapshot taken against different
+ * firmware is rejected at load time.
+ *
+ * Only the static result of a table load is captured: any runtime state such
+ * as installed handlers, _REG status, mutex owners or pending notifications
+ * is not part of the image. The intended usage is to call this right after
+ * uacpi_namespace_load() on a reference machine.
+ *
+ * The returned image is heap-allocated and must be released via
+ * uacpi_namespace_snapshot_free().
+ *
+ * NOTE: a namespace containing constructs that cannot be relocated (e.g.
+ * native methods installed by the host, or DataTableRegion-backed operation
+ * regions) cannot be snapshotted, in which case UACPI_STATUS_UNIMPLEMENTED
+ * is returned and the offending object is logged.
+ */
+uacpi_status uacpi_namespace_snapshot_save(
+    void **out_image, uacpi_size *out_size
+);
+
+/*
+ * Release an image previously returned by uacpi_namespace_snapshot_save.
+ */
+void uacpi_namespace_snapshot_free(void *image, uacpi_size size);
+
+/*
+ * Reconstruct the namespace from a snapshot image, replacing the call to
+ * uacpi_namespace_load() entirely. Expects the same initialization state as
+ * uacpi_namespace_load(), that is, a successful uacpi_initialize() call with
+ * no tables loaded yet.
+ *
+ * Every table recorded in the image must match a currently installed table
+ * exactly, otherwise UACPI_STATUS_NOT_FOUND is returned and the caller is
+ * expected to fall back to a regular uacpi_namespace_load().
+ *
+ * The image is only read during this call and does not have to be kept
+ * around afterwards.
+ */
+uacpi_status uacpi_namespace_snapshot_load(const void *image, uacpi_size size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,6 +29,8 @@ typedef enum uacpi_status {
     UACPI_STATUS_TIMEOUT = 18,
     UACPI_STATUS_OVERRIDDEN = 19,
     UACPI_STATUS_DENIED = 20,
+    UACPI_STATUS_BUFFER_TOO_SMALL = 21,
+    UACPI_STATUS_SUSPENDED = 22,
 
     // All errors that have bytecode-related origin should go here
     UACPI_STATUS_AML_UNDEFINED_REFERENCE = 0x0EFF0000,
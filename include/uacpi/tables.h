@@ -53,6 +53,23 @@ uacpi_status uacpi_table_install_physical(
  */
 uacpi_status uacpi_table_load(uacpi_size index);
 
+typedef void (*uacpi_table_load_callback)(
+    uacpi_status ret, uacpi_handle user
+);
+
+/*
+ * Same as uacpi_table_load(), but the interpretation of the table runs on a
+ * host worker thread (via uacpi_kernel_schedule_work with
+ * UACPI_WORK_NAMESPACE_LOAD). Useful for hotplug-triggered SSDT loads, where
+ * executing a large table inline would stall the invoking context (e.g. a GPE
+ * handler) for the entire interpretation.
+ *
+ * 'callback' is invoked from the worker thread with the final load status.
+ */
+uacpi_status uacpi_table_load_async(
+    uacpi_size index, uacpi_table_load_callback callback, uacpi_handle user
+);
+
 /*
  * Helpers for finding tables.
  *
@@ -359,6 +359,15 @@ typedef enum uacpi_region_op {
     UACPI_REGION_OP_READ = 2,
     UACPI_REGION_OP_WRITE = 3,
     UACPI_REGION_OP_DETACH = 4,
+
+    /*
+     * Batched versions of UACPI_REGION_OP_READ/UACPI_REGION_OP_WRITE, only
+     * ever dispatched to handlers installed with the
+     * UACPI_ADDRESS_SPACE_HANDLER_RW_MANY flag. op_data is a pointer to
+     * uacpi_region_rw_many_data.
+     */
+    UACPI_REGION_OP_READ_MANY = 5,
+    UACPI_REGION_OP_WRITE_MANY = 6,
 } uacpi_region_op;
 
 typedef struct uacpi_region_attach_data {
@@ -378,6 +387,25 @@ typedef struct uacpi_region_rw_data {
     uacpi_u8 byte_width;
 } uacpi_region_rw_data;
 
+/*
+ * A run of contiguous equally-sized accesses to a region. The first access
+ * targets 'offset', every subsequent access targets the offset of the
+ * previous one plus 'byte_width'. For UACPI_REGION_OP_READ_MANY the handler
+ * fills in one value per access, for UACPI_REGION_OP_WRITE_MANY it consumes
+ * one value per access instead.
+ */
+typedef struct uacpi_region_rw_many_data {
+    void *handler_context;
+    void *region_context;
+    union {
+        uacpi_phys_addr address;
+        uacpi_u64 offset;
+    };
+    uacpi_u64 *values;
+    uacpi_size count;
+    uacpi_u8 byte_width;
+} uacpi_region_rw_many_data;
+
 typedef struct uacpi_region_detach_data {
     void *handler_context;
     void *region_context;
@@ -88,6 +88,40 @@ uacpi_status uacpi_setup_early_table_access(
  */
 #define UACPI_FLAG_PROACTIVE_TBL_CSUM (1ull << 5)
 
+/*
+ * Run the _STA/_INI device initialization walk concurrently: independent
+ * sibling subtrees (e.g. separate PCI root bridges) are dispatched to host
+ * worker threads via uacpi_kernel_schedule_work, while parent-before-child
+ * ordering is still preserved within every subtree. Only enable this if the
+ * host work queue is backed by more than one thread, otherwise this is just
+ * overhead.
+ */
+#define UACPI_FLAG_CONCURRENT_NS_INIT (1ull << 6)
+
+/*
+ * Verify table checksums from a background work item instead of synchronously,
+ * moving the summing of large firmware tables off the boot critical path.
+ * Tables are installed immediately with verification still pending, and a
+ * table that later fails verification is invalidated via the normal
+ * bad-checksum handling. Tables used before the background sweep gets to them
+ * are still verified on first use as usual. This overrides the synchronous
+ * installation-time verification otherwise requested by
+ * UACPI_FLAG_PROACTIVE_TBL_CSUM.
+ */
+#define UACPI_FLAG_DEFERRED_TBL_CSUM (1ull << 7)
+
+/*
+ * Enter ACPI mode from a host work item instead of synchronously inside
+ * uacpi_initialize. The SMI_CMD handshake involves polling hardware (up to
+ * multiple seconds on slow firmware), so this overlaps it with whatever the
+ * host does between uacpi_initialize and uacpi_namespace_load, e.g. AML
+ * parsing via uacpi_namespace_load_async. The transition is joined before
+ * event bring-up at the end of uacpi_namespace_load, since SCI delivery
+ * requires the hardware to have fully entered ACPI mode. Ignored if
+ * UACPI_FLAG_NO_ACPI_MODE is set.
+ */
+#define UACPI_FLAG_ASYNC_ACPI_MODE (1ull << 8)
+
 /*
  * Initializes the uACPI subsystem, iterates & records all relevant RSDT/XSDT
  * tables. Enters ACPI mode.
@@ -102,6 +136,24 @@ uacpi_status uacpi_initialize(uacpi_u64 flags);
  */
 uacpi_status uacpi_namespace_load(void);
 
+typedef void (*uacpi_namespace_load_callback)(
+    uacpi_status ret, uacpi_handle user
+);
+
+/*
+ * Same as uacpi_namespace_load(), but the load is executed on a host worker
+ * thread (via uacpi_kernel_schedule_work with UACPI_WORK_NAMESPACE_LOAD) so
+ * that AML execution can be overlapped with other kernel bring-up work.
+ * AML blobs are still executed in install order, since later tables routinely
+ * reference objects defined by earlier ones.
+ *
+ * 'callback' is invoked from the worker thread with the final status once the
+ * load is done; only then is it valid to call uacpi_namespace_initialize().
+ */
+uacpi_status uacpi_namespace_load_async(
+    uacpi_namespace_load_callback callback, uacpi_handle user
+);
+
 /*
  * Initializes all the necessary objects in the namespaces by calling
  * _STA/_INI etc.
@@ -125,6 +177,22 @@ uacpi_status uacpi_eval_simple(
     uacpi_namespace_node *parent, const uacpi_char *path, uacpi_object **ret
 );
 
+/*
+ * Same as uacpi_eval(), but ownership of every object in 'args' is
+ * transferred to uACPI: the caller's references are consumed by the call
+ * (on failure as well) and the array slots are set to UACPI_NULL. Useful
+ * when the arguments are built specifically for one evaluation, e.g. a large
+ * request buffer passed to a _DSM, where keeping a caller-side reference
+ * only to immediately drop it is pointless.
+ *
+ * Note that argument objects are never deep-copied in either variant, the
+ * method operates on caller-provided objects directly.
+ */
+uacpi_status uacpi_eval_take_args(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    uacpi_object_array *args, uacpi_object **ret
+);
+
 /*
  * Same as uacpi_eval() but without a return value.
  */
@@ -136,6 +204,132 @@ uacpi_status uacpi_execute_simple(
     uacpi_namespace_node *parent, const uacpi_char *path
 );
 
+typedef struct uacpi_async_eval uacpi_async_eval;
+
+/*
+ * Invoked once an asynchronous evaluation completes, 'ret' being the result
+ * of the evaluation itself. 'ret_obj' may be UACPI_NULL (e.g. for methods
+ * without a return value) and is only valid for the duration of the callback,
+ * take an extra reference via uacpi_object_ref to keep it alive.
+ */
+typedef void (*uacpi_eval_async_callback)(
+    void *user, uacpi_status ret, uacpi_object *ret_obj
+);
+
+/*
+ * Same as uacpi_eval(), except the evaluation is queued to a uACPI-managed
+ * worker instead of running on the calling thread, with 'callback' invoked
+ * on completion. Useful for firmware methods known to stall for extended
+ * periods of time (e.g. _BST on some EC implementations).
+ *
+ * The queue is bounded: UACPI_STATUS_OUT_OF_MEMORY is returned if there's
+ * too many evaluations already pending.
+ *
+ * 'out_request' optionally receives a handle that may be passed to
+ * uacpi_eval_async_cancel. The handle is owned by uACPI and becomes invalid
+ * as soon as the request leaves the queue (for execution or via a cancel).
+ */
+uacpi_status uacpi_eval_async(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_eval_async_callback callback,
+    void *user, uacpi_async_eval **out_request
+);
+
+/*
+ * Retract a not-yet-started asynchronous evaluation, its callback is never
+ * invoked. UACPI_STATUS_NOT_FOUND means the request was too far along to be
+ * cancelled (the worker has already picked it up or finished it).
+ */
+uacpi_status uacpi_eval_async_cancel(uacpi_async_eval *request);
+
+typedef struct uacpi_eval_continuation uacpi_eval_continuation;
+
+/*
+ * Same as uacpi_eval(), except the interpreter suspends instead of blocking
+ * the calling thread when the method hits a Sleep or a contended Acquire:
+ * UACPI_STATUS_SUSPENDED is returned with a continuation handle stored in
+ * 'out_cont', and the evaluation is picked up again by passing that handle to
+ * uacpi_eval_resume.
+ *
+ * uacpi_eval_continuation_wake_deadline tells the caller when the suspended
+ * method wants to run again, in nanoseconds since boot (the same clock as
+ * uacpi_kernel_get_nanoseconds_since_boot), with 0 meaning "whenever the
+ * resource it's waiting for might have become available". Resuming earlier
+ * is always safe, the interpreter simply suspends again.
+ *
+ * A continuation may be resumed from any thread: uACPI transfers ownership
+ * of any AML mutexes held by the suspended method to the resuming thread, so
+ * hosts whose mutex implementation enforces same-thread release must not use
+ * this API. A continuation that is no longer wanted must be disposed of via
+ * uacpi_eval_continuation_abort, which unwinds the method as if it had failed.
+ *
+ * Note that the namespace write lock is dropped while a method is suspended,
+ * so namespace modifications it has already made are visible to other threads.
+ */
+uacpi_status uacpi_eval_suspendable(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_eval_continuation **out_cont,
+    uacpi_object **out_obj
+);
+uacpi_status uacpi_eval_resume(
+    uacpi_eval_continuation *cont, uacpi_object **out_obj
+);
+uacpi_u64 uacpi_eval_continuation_wake_deadline(uacpi_eval_continuation *cont);
+void uacpi_eval_continuation_abort(uacpi_eval_continuation *cont);
+
+typedef struct uacpi_method_handle uacpi_method_handle;
+
+/*
+ * Resolve 'path' relative to 'parent' once and pin the resulting method so
+ * that it can be repeatedly evaluated via uacpi_eval_prepared without paying
+ * for path resolution on every call. Only methods can be prepared this way,
+ * UACPI_STATUS_TYPE_MISMATCH is returned for any other object type.
+ *
+ * The returned handle must be released via uacpi_method_handle_release.
+ */
+uacpi_status uacpi_method_handle_acquire(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    uacpi_method_handle **out_handle
+);
+void uacpi_method_handle_release(uacpi_method_handle *handle);
+
+/*
+ * Same as uacpi_eval() for a method prepared via uacpi_method_handle_acquire,
+ * except path resolution is skipped entirely. The handle stays safe to
+ * evaluate for as long as it is held: if the underlying node is removed from
+ * the namespace in the meantime, UACPI_STATUS_NAMESPACE_NODE_DANGLING is
+ * returned instead.
+ */
+uacpi_status uacpi_eval_prepared(
+    uacpi_method_handle *handle, const uacpi_object_array *args,
+    uacpi_object **out_obj
+);
+
+typedef struct uacpi_eval_batch_entry {
+    // Evaluated the same way 'parent' and 'path' are for uacpi_eval
+    uacpi_namespace_node *parent;
+    const uacpi_char *path;
+    const uacpi_object_array *args;
+
+    // Filled in by uacpi_eval_batch
+    uacpi_object *ret;
+    uacpi_status status;
+} uacpi_eval_batch_entry;
+
+/*
+ * Evaluate 'num_entries' objects back to back while only acquiring the
+ * namespace lock once for the entire batch instead of once per evaluation.
+ *
+ * Entries are evaluated in order with uacpi_eval semantics, and every entry
+ * is attempted regardless of the outcome of those before it: the result of
+ * each is recorded in its 'status' (and 'ret' for successful evaluations,
+ * which must be unref'd by the caller). The return value only indicates
+ * whether the batch itself was able to run.
+ */
+uacpi_status uacpi_eval_batch(
+    uacpi_eval_batch_entry *entries, uacpi_size num_entries
+);
+
 /*
  * Same as uacpi_eval, but the return value type is validated against
  * the 'ret_mask'. UACPI_STATUS_TYPE_MISMATCH is returned on error.
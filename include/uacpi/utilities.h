@@ -43,6 +43,33 @@ uacpi_status uacpi_find_devices(
     void *user
 );
 
+/*
+ * Build (or rebuild) an index of every device in the namespace keyed by the
+ * values returned from its _HID and _CID. While the index is up-to-date, the
+ * find_devices API above is answered straight from it instead of evaluating
+ * _HID/_CID for every device in the subtree, turning repeated lookups into
+ * plain hash queries.
+ *
+ * The index is automatically marked out-of-date whenever AML dynamically loads
+ * another table (which may define new devices), in which case the find_devices
+ * API transparently falls back to a full namespace walk until the index is
+ * rebuilt via another call to this API.
+ *
+ * NOTES:
+ * - Indexed lookups report matches in an unspecified order, and
+ *   UACPI_ITERATION_DECISION_NEXT_PEER is treated the same as
+ *   UACPI_ITERATION_DECISION_CONTINUE as there is no tree walk to prune.
+ * - This API, as well as uacpi_free_device_id_index, must not be invoked
+ *   concurrently with the find_devices API.
+ */
+uacpi_status uacpi_build_device_id_index(void);
+
+/*
+ * Free the index built via uacpi_build_device_id_index.
+ * This is also done automatically during uacpi_state_reset.
+ */
+void uacpi_free_device_id_index(void);
+
 typedef enum uacpi_interrupt_model {
     UACPI_INTERRUPT_MODEL_PIC = 0,
     UACPI_INTERRUPT_MODEL_IOAPIC = 1,
@@ -179,6 +206,24 @@ uacpi_status uacpi_get_namespace_node_info(
     uacpi_namespace_node *node, uacpi_namespace_node_info **out_info
 );
 
+/*
+ * Same as uacpi_get_namespace_node_info, but fills a caller-provided buffer
+ * of 'capacity' bytes instead of allocating one, so a loop enumerating many
+ * nodes can reuse a single (e.g. stack) buffer with no per-node allocations.
+ *
+ * 'capacity' must be at least sizeof(uacpi_namespace_node_info); the variable
+ * part (the _CID list and ID strings) is placed in the remaining space. If the
+ * buffer is too small, UACPI_STATUS_BUFFER_TOO_SMALL is returned with
+ * info->size set to the number of bytes required for this node.
+ *
+ * The buffer is owned by the caller and must not be passed to
+ * uacpi_free_namespace_node_info.
+ */
+uacpi_status uacpi_get_namespace_node_info_into(
+    uacpi_namespace_node *node, uacpi_namespace_node_info *info,
+    uacpi_u32 capacity
+);
+
 #ifdef __cplusplus
 }
 #endif
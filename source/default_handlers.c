@@ -4,6 +4,8 @@
 #include <uacpi/internal/helpers.h>
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/io.h>
+#include <uacpi/internal/mutex.h>
+#include <uacpi/internal/stdlib.h>
 #include <uacpi/kernel_api.h>
 #include <uacpi/uacpi.h>
 
@@ -38,10 +40,145 @@ static uacpi_namespace_node *find_pci_root(uacpi_namespace_node *node)
     return node;
 }
 
+/*
+ * Open PCI device handles are shared between all regions living on the same
+ * segment/bus/device/function, and up to PCI_DEV_HANDLE_MAX_IDLE handles with
+ * no attached regions left are kept open for reuse (evicted least recently
+ * used first). This way config-space-heavy AML doesn't pay a host device
+ * open/close round trip every time a region is detached and reattached, e.g.
+ * because of _REG or handler churn.
+ */
+#define PCI_DEV_HANDLE_MAX_IDLE 8
+
+struct pci_dev_handle {
+    struct pci_dev_handle *next;
+    uacpi_pci_address address;
+    uacpi_handle handle;
+    uacpi_u32 refcount;
+    uacpi_u64 last_used;
+};
+
+static struct pci_dev_handle *pci_dev_handles;
+static uacpi_size pci_dev_handles_idle;
+static uacpi_u64 pci_dev_handle_stamp;
+static uacpi_handle pci_dev_handle_mutex;
+
+static uacpi_bool pci_addresses_match(
+    const uacpi_pci_address *lhs, const uacpi_pci_address *rhs
+)
+{
+    return lhs->segment == rhs->segment && lhs->bus == rhs->bus &&
+           lhs->device == rhs->device && lhs->function == rhs->function;
+}
+
+static uacpi_status pci_dev_handle_open(
+    uacpi_pci_address address, struct pci_dev_handle **out_dev
+)
+{
+    struct pci_dev_handle *dev;
+    uacpi_status ret;
+
+    // No mutex means no cache, simply wrap a private handle
+    if (uacpi_unlikely(pci_dev_handle_mutex == UACPI_NULL)) {
+        dev = uacpi_kernel_alloc_zeroed(sizeof(*dev));
+        if (uacpi_unlikely(dev == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        ret = uacpi_kernel_pci_device_open(address, &dev->handle);
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_free(dev, sizeof(*dev));
+            return ret;
+        }
+
+        *out_dev = dev;
+        return UACPI_STATUS_OK;
+    }
+
+    ret = uacpi_acquire_native_mutex(pci_dev_handle_mutex);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (dev = pci_dev_handles; dev != UACPI_NULL; dev = dev->next) {
+        if (!pci_addresses_match(&dev->address, &address))
+            continue;
+
+        if (dev->refcount++ == 0)
+            pci_dev_handles_idle--;
+        dev->last_used = ++pci_dev_handle_stamp;
+
+        *out_dev = dev;
+        goto out;
+    }
+
+    dev = uacpi_kernel_alloc_zeroed(sizeof(*dev));
+    if (uacpi_unlikely(dev == UACPI_NULL)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    ret = uacpi_kernel_pci_device_open(address, &dev->handle);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free(dev, sizeof(*dev));
+        goto out;
+    }
+
+    dev->address = address;
+    dev->refcount = 1;
+    dev->last_used = ++pci_dev_handle_stamp;
+    dev->next = pci_dev_handles;
+    pci_dev_handles = dev;
+
+    *out_dev = dev;
+
+out:
+    uacpi_release_native_mutex(pci_dev_handle_mutex);
+    return ret;
+}
+
+static void pci_dev_handle_close(struct pci_dev_handle *dev)
+{
+    struct pci_dev_handle *victim = UACPI_NULL;
+
+    if (uacpi_unlikely(pci_dev_handle_mutex == UACPI_NULL)) {
+        uacpi_kernel_pci_device_close(dev->handle);
+        uacpi_free(dev, sizeof(*dev));
+        return;
+    }
+
+    uacpi_acquire_native_mutex(pci_dev_handle_mutex);
+
+    if (--dev->refcount == 0 &&
+        ++pci_dev_handles_idle > PCI_DEV_HANDLE_MAX_IDLE) {
+        struct pci_dev_handle *iter, **victim_link = UACPI_NULL, **link;
+
+        for (link = &pci_dev_handles; (iter = *link) != UACPI_NULL;
+             link = &iter->next) {
+            if (iter->refcount != 0)
+                continue;
+
+            if (victim == UACPI_NULL || iter->last_used < victim->last_used) {
+                victim = iter;
+                victim_link = link;
+            }
+        }
+
+        *victim_link = victim->next;
+        pci_dev_handles_idle--;
+    }
+
+    uacpi_release_native_mutex(pci_dev_handle_mutex);
+
+    if (victim != UACPI_NULL) {
+        uacpi_kernel_pci_device_close(victim->handle);
+        uacpi_free(victim, sizeof(*victim));
+    }
+}
+
 static uacpi_status pci_region_attach(uacpi_region_attach_data *data)
 {
     uacpi_namespace_node *node, *pci_root, *device;
     uacpi_pci_address address = { 0 };
+    struct pci_dev_handle *dev;
     uacpi_u64 value;
     uacpi_status ret;
 
@@ -94,12 +231,15 @@ static uacpi_status pci_region_attach(uacpi_region_attach_data *data)
         address.device, address.function
     );
 
-    return uacpi_kernel_pci_device_open(address, &data->out_region_context);
+    ret = pci_dev_handle_open(address, &dev);
+    if (uacpi_likely_success(ret))
+        data->out_region_context = dev;
+    return ret;
 }
 
 static uacpi_status pci_region_detach(uacpi_region_detach_data *data)
 {
-    uacpi_kernel_pci_device_close(data->region_context);
+    pci_dev_handle_close(data->region_context);
     return UACPI_STATUS_OK;
 }
 
@@ -107,7 +247,7 @@ static uacpi_status pci_region_do_rw(
     uacpi_region_op op, uacpi_region_rw_data *data
 )
 {
-    uacpi_handle dev = data->region_context;
+    struct pci_dev_handle *dev = data->region_context;
     uacpi_u8 width;
     uacpi_size offset;
 
@@ -115,10 +255,29 @@ static uacpi_status pci_region_do_rw(
     width = data->byte_width;
 
     return op == UACPI_REGION_OP_READ ?
-        uacpi_kernel_pci_read(dev, offset, width, &data->value) :
-        uacpi_kernel_pci_write(dev, offset, width, data->value);
+        uacpi_kernel_pci_read(dev->handle, offset, width, &data->value) :
+        uacpi_kernel_pci_write(dev->handle, offset, width, data->value);
 }
 
+#ifdef UACPI_VECTORED_KERNEL_IO
+static uacpi_status pci_region_do_rw_many(
+    uacpi_region_op op, uacpi_region_rw_many_data *data
+)
+{
+    struct pci_dev_handle *dev = data->region_context;
+
+    return op == UACPI_REGION_OP_READ_MANY ?
+        uacpi_kernel_pci_read_many(
+            dev->handle, data->offset, data->byte_width, data->values,
+            data->count
+        ) :
+        uacpi_kernel_pci_write_many(
+            dev->handle, data->offset, data->byte_width, data->values,
+            data->count
+        );
+}
+#endif
+
 static uacpi_status handle_pci_region(uacpi_region_op op, uacpi_handle op_data)
 {
     switch (op) {
@@ -129,6 +288,11 @@ static uacpi_status handle_pci_region(uacpi_region_op op, uacpi_handle op_data)
     case UACPI_REGION_OP_READ:
     case UACPI_REGION_OP_WRITE:
         return pci_region_do_rw(op, op_data);
+#ifdef UACPI_VECTORED_KERNEL_IO
+    case UACPI_REGION_OP_READ_MANY:
+    case UACPI_REGION_OP_WRITE_MANY:
+        return pci_region_do_rw_many(op, op_data);
+#endif
     default:
         return UACPI_STATUS_INVALID_ARGUMENT;
     }
@@ -306,6 +470,24 @@ static uacpi_status io_region_do_rw(
         uacpi_kernel_io_write(ctx->handle, offset, width, data->value);
 }
 
+#ifdef UACPI_VECTORED_KERNEL_IO
+static uacpi_status io_region_do_rw_many(
+    uacpi_region_op op, uacpi_region_rw_many_data *data
+)
+{
+    struct io_region_ctx *ctx = data->region_context;
+    uacpi_size offset = data->offset - ctx->base;
+
+    return op == UACPI_REGION_OP_READ_MANY ?
+        uacpi_kernel_io_read_many(
+            ctx->handle, offset, data->byte_width, data->values, data->count
+        ) :
+        uacpi_kernel_io_write_many(
+            ctx->handle, offset, data->byte_width, data->values, data->count
+        );
+}
+#endif
+
 static uacpi_status handle_io_region(uacpi_region_op op, uacpi_handle op_data)
 {
     switch (op) {
@@ -316,15 +498,35 @@ static uacpi_status handle_io_region(uacpi_region_op op, uacpi_handle op_data)
     case UACPI_REGION_OP_READ:
     case UACPI_REGION_OP_WRITE:
         return io_region_do_rw(op, op_data);
+#ifdef UACPI_VECTORED_KERNEL_IO
+    case UACPI_REGION_OP_READ_MANY:
+    case UACPI_REGION_OP_WRITE_MANY:
+        return io_region_do_rw_many(op, op_data);
+#endif
     default:
         return UACPI_STATUS_INVALID_ARGUMENT;
     }
 }
 
+/*
+ * With vectored kernel IO available the built-in IO/PCI handlers understand
+ * the batched region ops, so multi-unit field accesses reach the host as a
+ * single call.
+ */
+#ifdef UACPI_VECTORED_KERNEL_IO
+#define KERNEL_IO_HANDLER_FLAGS \
+    (UACPI_ADDRESS_SPACE_HANDLER_DEFAULT | UACPI_ADDRESS_SPACE_HANDLER_RW_MANY)
+#else
+#define KERNEL_IO_HANDLER_FLAGS UACPI_ADDRESS_SPACE_HANDLER_DEFAULT
+#endif
+
 void uacpi_install_default_address_space_handlers(void)
 {
     uacpi_namespace_node *root;
 
+    // Failure is fine, the PCI handler just won't share device handles
+    pci_dev_handle_mutex = uacpi_kernel_create_mutex();
+
     root = uacpi_namespace_root();
 
     uacpi_install_address_space_handler_with_flags(
@@ -336,13 +538,13 @@ void uacpi_install_default_address_space_handlers(void)
     uacpi_install_address_space_handler_with_flags(
         root, UACPI_ADDRESS_SPACE_SYSTEM_IO,
         handle_io_region, UACPI_NULL,
-        UACPI_ADDRESS_SPACE_HANDLER_DEFAULT
+        KERNEL_IO_HANDLER_FLAGS
     );
 
     uacpi_install_address_space_handler_with_flags(
         root, UACPI_ADDRESS_SPACE_PCI_CONFIG,
         handle_pci_region, UACPI_NULL,
-        UACPI_ADDRESS_SPACE_HANDLER_DEFAULT
+        KERNEL_IO_HANDLER_FLAGS
     );
 
     uacpi_install_address_space_handler_with_flags(
@@ -351,3 +553,24 @@ void uacpi_install_default_address_space_handlers(void)
         UACPI_ADDRESS_SPACE_HANDLER_DEFAULT
     );
 }
+
+void uacpi_deinitialize_default_address_space_handlers(void)
+{
+    struct pci_dev_handle *dev, *next;
+
+    // All regions are detached by now, close whatever was kept open for reuse
+    for (dev = pci_dev_handles; dev != UACPI_NULL; dev = next) {
+        next = dev->next;
+        uacpi_kernel_pci_device_close(dev->handle);
+        uacpi_free(dev, sizeof(*dev));
+    }
+
+    pci_dev_handles = UACPI_NULL;
+    pci_dev_handles_idle = 0;
+    pci_dev_handle_stamp = 0;
+
+    if (pci_dev_handle_mutex != UACPI_NULL) {
+        uacpi_kernel_free_mutex(pci_dev_handle_mutex);
+        pci_dev_handle_mutex = UACPI_NULL;
+    }
+}
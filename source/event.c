@@ -9,17 +9,49 @@
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/mutex.h>
 #include <uacpi/internal/stdlib.h>
+#include <uacpi/platform/atomic.h>
 #include <uacpi/acpi.h>
 
+// Attribute allocations in this file under UACPI_MEMORY_ACCOUNTING
+#undef UACPI_TRACKED_SUBSYSTEM
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_EVENTS
+
 #define UACPI_EVENT_DISABLED 0
 #define UACPI_EVENT_ENABLED 1
 
 #ifndef UACPI_REDUCED_HARDWARE
 
-static uacpi_handle g_gpe_state_slock;
 static struct uacpi_recursive_lock g_event_lock;
 static uacpi_bool g_gpes_finalized;
 
+/*
+ * All GPE execution & restore work items are tagged with this group so that
+ * the mask/uninstall paths can drain just them, instead of barriering on
+ * every outstanding host work item (e.g. the entire notification queue).
+ */
+static struct uacpi_work_group g_gpe_work_group;
+
+/*
+ * Number of currently executing event interrupt handlers, either the SCI or
+ * any dedicated GPE IRQ. Interrupt handlers are short, so waiters spin
+ * rather than park on an event.
+ */
+static uacpi_u32 g_irqs_inflight;
+
+#define EVENT_IRQ_DRAIN_SPINS 100
+
+static void wait_for_inflight_irqs(void)
+{
+    uacpi_size spins = 0;
+
+    while (uacpi_atomic_load32(&g_irqs_inflight) != 0) {
+        if (++spins < EVENT_IRQ_DRAIN_SPINS)
+            uacpi_kernel_stall(1);
+        else
+            uacpi_kernel_sleep(1);
+    }
+}
+
 struct fixed_event {
     uacpi_u8 enable_field;
     uacpi_u8 status_field;
@@ -68,6 +100,31 @@ static const struct fixed_event fixed_events[UACPI_FIXED_EVENT_MAX + 1] = {
 static struct fixed_event_handler
 fixed_event_handlers[UACPI_FIXED_EVENT_MAX + 1];
 
+/*
+ * Software mirror of the fixed event bits currently set in PM1_EN, expressed
+ * in PM1_STS bit positions. Kept in sync by every enable register write below,
+ * and lets the SCI path skip the PM1_EN read entirely as well as bail out
+ * early when nothing we care about is pending.
+ */
+static uacpi_u32 fixed_event_enable_mask;
+
+/*
+ * The mirror is updated from both thread context (set_event) and the SCI
+ * handler's no-handler disable path, so a plain read-modify-write could lose
+ * an enable bit, leaving a level-triggered event filtered out forever.
+ */
+static void fixed_event_mask_update(uacpi_u32 mask, uacpi_bool set)
+{
+    uacpi_u32 value, new_value;
+
+    value = uacpi_atomic_load32(&fixed_event_enable_mask);
+    do {
+        new_value = set ? value | mask : value & ~mask;
+    } while (!uacpi_atomic_cmpxchg32(
+        &fixed_event_enable_mask, &value, new_value
+    ));
+}
+
 static uacpi_status initialize_fixed_events(void)
 {
     uacpi_size i;
@@ -77,6 +134,7 @@ static uacpi_status initialize_fixed_events(void)
             fixed_events[i].enable_field, UACPI_EVENT_DISABLED
         );
     }
+    uacpi_atomic_store32(&fixed_event_enable_mask, 0);
 
     return UACPI_STATUS_OK;
 }
@@ -101,6 +159,8 @@ static uacpi_status set_event(uacpi_u8 event, uacpi_u8 value)
         return UACPI_STATUS_HARDWARE_TIMEOUT;
     }
 
+    fixed_event_mask_update(ev->status_mask, value != 0);
+
     uacpi_trace("fixed event %d %sabled successfully\n",
                 event, value ? "en" : "dis");
     return UACPI_STATUS_OK;
@@ -189,6 +249,7 @@ static uacpi_interrupt_ret dispatch_fixed_event(
             event
         );
         uacpi_write_register_field(ev->enable_field, UACPI_EVENT_DISABLED);
+        fixed_event_mask_update(ev->status_mask, UACPI_FALSE);
         return UACPI_INTERRUPT_NOT_HANDLED;
     }
 
@@ -199,24 +260,25 @@ static uacpi_interrupt_ret handle_fixed_events(void)
 {
     uacpi_interrupt_ret int_ret = UACPI_INTERRUPT_NOT_HANDLED;
     uacpi_status ret;
-    uacpi_u64 enable_mask, status_mask;
+    uacpi_u64 status_mask;
+    uacpi_u16 pending;
     uacpi_size i;
 
     ret = uacpi_read_register(UACPI_REGISTER_PM1_STS, &status_mask);
     if (uacpi_unlikely_error(ret))
         return int_ret;
 
-    ret = uacpi_read_register(UACPI_REGISTER_PM1_EN, &enable_mask);
-    if (uacpi_unlikely_error(ret))
+    pending = status_mask & uacpi_atomic_load32(&fixed_event_enable_mask);
+    if (pending == 0)
         return int_ret;
 
-    for (i = 0; i < UACPI_FIXED_EVENT_MAX; ++i)
+    for (i = 0; i < UACPI_FIXED_EVENT_MAX && pending; ++i)
     {
         const struct fixed_event *ev = &fixed_events[i];
 
-        if (!(status_mask & ev->status_mask) ||
-            !(enable_mask & ev->enable_mask))
+        if (!(pending & ev->status_mask))
             continue;
+        pending &= ~ev->status_mask;
 
         int_ret |= dispatch_fixed_event(ev, i);
     }
@@ -269,6 +331,10 @@ struct gp_event {
     };
 
     struct gpe_register *reg;
+
+    // Link in the dispatch batch this event is currently queued on, if any
+    struct gp_event *next_in_batch;
+
     uacpi_u16 idx;
 
     // "reference count" of the number of times this event has been enabled
@@ -278,18 +344,40 @@ struct gp_event {
     uacpi_u8 triggering : 1;
     uacpi_u8 wake : 1;
     uacpi_u8 block_interrupts : 1;
+
+#ifdef UACPI_GPE_LATENCY_STATS
+    /*
+     * Timestamps of the in-flight dispatch, only meaningful while the event
+     * sits in a batch. Safe to keep here unguarded since an event is never
+     * part of more than one batch at a time (it stays disabled until the
+     * restore pass gets to it).
+     */
+    uacpi_u64 detect_ts;
+    uacpi_u64 handler_done_ts;
+
+    uacpi_gpe_latency_histograms latency;
+#endif
 };
 
 struct gpe_register {
-    struct acpi_gas status;
-    struct acpi_gas enable;
+    // Mapped once at GPE block creation so that every access doesn't have to
+    // pay for a map/unmap round trip, which also makes them IRQ-safe
+    struct uacpi_mapped_gas status;
+    struct uacpi_mapped_gas enable;
 
     uacpi_u8 runtime_mask;
     uacpi_u8 wake_mask;
     uacpi_u8 masked_mask;
     uacpi_u8 current_mask;
 
+    // Software copy of the hardware enable register, guarded by the state
+    // lock of the owning GPE block. Makes state transitions a single
+    // register write instead of a read-modify-write.
+    uacpi_u8 enable_shadow;
+
     uacpi_u16 base_idx;
+
+    struct gpe_block *block;
 };
 
 struct gpe_block {
@@ -307,6 +395,14 @@ struct gpe_block {
     struct gp_event *events;
     struct gpe_interrupt_ctx *irq_ctx;
 
+    /*
+     * Guards the enable shadows of every register in this block. Per-block
+     * so that GPE dispatch on one interrupt line doesn't contend with GPE
+     * management on another; block add/remove itself is serialized by the
+     * event lock.
+     */
+    uacpi_handle state_lock;
+
     uacpi_u16 num_registers;
     uacpi_u16 num_events;
     uacpi_u16 base_idx;
@@ -351,11 +447,9 @@ static uacpi_status set_gpe_state(struct gp_event *event, enum gpe_state state)
         state = GPE_STATE_ENABLED;
     }
 
-    flags = uacpi_kernel_lock_spinlock(g_gpe_state_slock);
+    flags = uacpi_kernel_lock_spinlock(reg->block->state_lock);
 
-    ret = uacpi_gas_read(&reg->enable, &enable_mask);
-    if (uacpi_unlikely_error(ret))
-        goto out;
+    enable_mask = reg->enable_shadow;
 
     switch (state) {
     case GPE_STATE_ENABLED:
@@ -369,9 +463,38 @@ static uacpi_status set_gpe_state(struct gp_event *event, enum gpe_state state)
         goto out;
     }
 
-    ret = uacpi_gas_write(&reg->enable, enable_mask);
+    if (enable_mask == reg->enable_shadow) {
+        ret = UACPI_STATUS_OK;
+        goto out;
+    }
+
+    ret = uacpi_gas_write_mapped(&reg->enable, enable_mask);
+    if (uacpi_likely_success(ret))
+        reg->enable_shadow = enable_mask;
 out:
-    uacpi_kernel_unlock_spinlock(g_gpe_state_slock, flags);
+    uacpi_kernel_unlock_spinlock(reg->block->state_lock, flags);
+    return ret;
+}
+
+/*
+ * Flush a new enable mask to the hardware (unless it already matches the
+ * shadow) and keep the shadow coherent. Takes the block state lock, so
+ * must not be called by anyone already holding it.
+ */
+static uacpi_status set_gpe_enable_mask(struct gpe_register *reg, uacpi_u8 value)
+{
+    uacpi_status ret = UACPI_STATUS_OK;
+    uacpi_cpu_flags flags;
+
+    flags = uacpi_kernel_lock_spinlock(reg->block->state_lock);
+
+    if (reg->enable_shadow != value) {
+        ret = uacpi_gas_write_mapped(&reg->enable, value);
+        if (uacpi_likely_success(ret))
+            reg->enable_shadow = value;
+    }
+
+    uacpi_kernel_unlock_spinlock(reg->block->state_lock, flags);
     return ret;
 }
 
@@ -379,7 +502,7 @@ static uacpi_status clear_gpe(struct gp_event *event)
 {
     struct gpe_register *reg = event->reg;
 
-    return uacpi_gas_write(&reg->status, gpe_get_mask(event));
+    return uacpi_gas_write_mapped(&reg->status, gpe_get_mask(event));
 }
 
 static uacpi_status restore_gpe(struct gp_event *event)
@@ -398,26 +521,105 @@ static uacpi_status restore_gpe(struct gp_event *event)
     return ret;
 }
 
-static void async_restore_gpe(uacpi_handle opaque)
+#ifdef UACPI_GPE_LATENCY_STATS
+static void gpe_latency_record(
+    uacpi_u32 *histogram, uacpi_u64 begin_ts, uacpi_u64 end_ts
+)
+{
+    uacpi_u64 elapsed = end_ts - begin_ts;
+    uacpi_size bucket = 0;
+
+    if (elapsed != 0)
+        bucket = uacpi_bit_scan_backward(elapsed) - 1;
+    if (bucket >= UACPI_GPE_LATENCY_BUCKETS)
+        bucket = UACPI_GPE_LATENCY_BUCKETS - 1;
+
+    histogram[bucket]++;
+}
+#endif
+
+/*
+ * Restore a chain of events accumulated over one detection pass.
+ *
+ * detect_gpes chains fired events in register order, so coalescing
+ * consecutive runs sharing a register lets each register be re-enabled with
+ * a single write of its enable shadow instead of one read-modify-write per
+ * event.
+ */
+static void async_restore_gpe_batch(uacpi_handle opaque)
 {
     uacpi_status ret;
-    struct gp_event *event = opaque;
+    struct gp_event *event = opaque, *next;
+    struct gpe_register *reg;
+    uacpi_u8 pending_mask, event_bit;
+    uacpi_u64 enable_mask;
+    uacpi_cpu_flags flags;
 
-    ret = restore_gpe(event);
-    if (uacpi_unlikely_error(ret)) {
-        uacpi_error("unable to restore GPE(%02X): %s\n",
-                    event->idx, uacpi_status_to_string(ret));
+    while (event != UACPI_NULL) {
+        reg = event->reg;
+        pending_mask = 0;
+
+        do {
+            next = event->next_in_batch;
+            event->next_in_batch = UACPI_NULL;
+
+            if (event->triggering == UACPI_GPE_TRIGGERING_LEVEL) {
+                ret = clear_gpe(event);
+                if (uacpi_unlikely_error(ret)) {
+                    // Keep this event disabled, same as the non-batched path
+                    uacpi_error("unable to restore GPE(%02X): %s\n",
+                                event->idx, uacpi_status_to_string(ret));
+                    event = next;
+                    continue;
+                }
+            }
+
+            event_bit = gpe_get_mask(event);
+            if (!(reg->masked_mask & event_bit) &&
+                (reg->current_mask & event_bit))
+                pending_mask |= event_bit;
+
+#ifdef UACPI_GPE_LATENCY_STATS
+            /*
+             * Stamped as the restore pass reaches the event, the final
+             * enable write below only adds one register access on top.
+             */
+            gpe_latency_record(
+                event->latency.restore, event->handler_done_ts,
+                uacpi_kernel_get_nanoseconds_since_boot()
+            );
+#endif
+
+            event->block_interrupts = UACPI_FALSE;
+            event = next;
+        } while (event != UACPI_NULL && event->reg == reg);
+
+        if (pending_mask == 0)
+            continue;
+
+        flags = uacpi_kernel_lock_spinlock(reg->block->state_lock);
+
+        enable_mask = reg->enable_shadow | pending_mask;
+        if (enable_mask != reg->enable_shadow) {
+            ret = uacpi_gas_write_mapped(&reg->enable, enable_mask);
+            if (uacpi_likely_success(ret))
+                reg->enable_shadow = enable_mask;
+            else
+                uacpi_error("unable to re-enable GPE register: %s\n",
+                            uacpi_status_to_string(ret));
+        }
+
+        uacpi_kernel_unlock_spinlock(reg->block->state_lock, flags);
     }
+
+    // The restore pass is the last stage of a batch, retire it here
+    uacpi_work_group_done(&g_gpe_work_group);
 }
 
-static void async_run_gpe_handler(uacpi_handle opaque)
+// Must be called with the namespace write lock held
+static void run_gpe_handler(struct gp_event *event)
 {
     uacpi_status ret;
-    struct gp_event *event = opaque;
-
-    ret = uacpi_namespace_write_lock();
-    if (uacpi_unlikely_error(ret))
-        goto out_no_unlock;
 
     switch (event->handler_type) {
     case GPE_HANDLER_TYPE_AML_HANDLER: {
@@ -468,26 +670,85 @@ static void async_run_gpe_handler(uacpi_handle opaque)
     default:
         break;
     }
+}
+
+static void async_run_gpe_batch(uacpi_handle opaque)
+{
+    uacpi_status ret;
+    struct gp_event *event;
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        goto out_no_unlock;
+
+    // Run every handler in the batch under one lock acquisition
+    for (event = opaque; event != UACPI_NULL; event = event->next_in_batch) {
+#ifdef UACPI_GPE_LATENCY_STATS
+        uacpi_u64 begin_ts;
+
+        begin_ts = uacpi_kernel_get_nanoseconds_since_boot();
+        gpe_latency_record(event->latency.queue, event->detect_ts, begin_ts);
+#endif
+
+        run_gpe_handler(event);
+
+#ifdef UACPI_GPE_LATENCY_STATS
+        event->handler_done_ts = uacpi_kernel_get_nanoseconds_since_boot();
+        gpe_latency_record(
+            event->latency.handler, begin_ts, event->handler_done_ts
+        );
+#endif
+    }
 
     uacpi_namespace_write_unlock();
 
 out_no_unlock:
     /*
      * We schedule the work as NOTIFICATION to make sure all other notifications
-     * finish before this GPE is re-enabled.
+     * finish before these GPEs are re-enabled.
      */
     ret = uacpi_kernel_schedule_work(
-        UACPI_WORK_NOTIFICATION, async_restore_gpe, event
+        UACPI_WORK_NOTIFICATION, async_restore_gpe_batch, opaque
     );
     if (uacpi_unlikely_error(ret)) {
-        uacpi_error("unable to schedule GPE(%02X) restore: %s\n",
-                    event->idx, uacpi_status_to_string(ret));
-        async_restore_gpe(event);
+        uacpi_error("unable to schedule GPE batch restore: %s\n",
+                    uacpi_status_to_string(ret));
+        async_restore_gpe_batch(opaque);
+    }
+}
+
+/*
+ * Fired events accumulated over one detection pass, linked through
+ * gp_event->next_in_batch and handed to the work queue as a single item. A
+ * burst of N GPEs (common with shared GPE lines) thus costs one work-queue
+ * round trip and one restore pass instead of one of each per event.
+ */
+struct gpe_batch {
+    struct gp_event *head, *tail;
+};
+
+static void schedule_gpe_batch(struct gpe_batch *batch)
+{
+    uacpi_status ret;
+
+    if (batch->head == UACPI_NULL)
+        return;
+
+    uacpi_work_group_begin(&g_gpe_work_group);
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_GPE_EXECUTION, async_run_gpe_batch, batch->head
+    );
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_warn("unable to schedule GPE batch for execution: %s\n",
+                   uacpi_status_to_string(ret));
+        uacpi_work_group_done(&g_gpe_work_group);
     }
 }
 
 static uacpi_interrupt_ret dispatch_gpe(
-    uacpi_namespace_node *device_node, struct gp_event *event
+    uacpi_namespace_node *device_node, struct gp_event *event,
+    struct gpe_batch *batch
 )
 {
     uacpi_status ret;
@@ -540,15 +801,16 @@ static uacpi_interrupt_ret dispatch_gpe(
 
     case GPE_HANDLER_TYPE_AML_HANDLER:
     case GPE_HANDLER_TYPE_IMPLICIT_NOTIFY:
-        ret = uacpi_kernel_schedule_work(
-            UACPI_WORK_GPE_EXECUTION, async_run_gpe_handler, event
-        );
-        if (uacpi_unlikely_error(ret)) {
-            uacpi_warn(
-                "unable to schedule GPE(%02X) for execution: %s\n",
-                event->idx, uacpi_status_to_string(ret)
-            );
-        }
+#ifdef UACPI_GPE_LATENCY_STATS
+        event->detect_ts = uacpi_kernel_get_nanoseconds_since_boot();
+#endif
+        event->next_in_batch = UACPI_NULL;
+
+        if (batch->head == UACPI_NULL)
+            batch->head = event;
+        else
+            batch->tail->next_in_batch = event;
+        batch->tail = event;
         break;
 
     default:
@@ -566,7 +828,8 @@ static uacpi_interrupt_ret detect_gpes(struct gpe_block *block)
     uacpi_interrupt_ret int_ret = UACPI_INTERRUPT_NOT_HANDLED;
     struct gpe_register *reg;
     struct gp_event *event;
-    uacpi_u64 status, enable;
+    struct gpe_batch batch = { 0 };
+    uacpi_u64 status, enable, pending;
     uacpi_size i, j;
 
     while (block) {
@@ -576,29 +839,32 @@ static uacpi_interrupt_ret detect_gpes(struct gpe_block *block)
             if (!reg->runtime_mask && !reg->wake_mask)
                 continue;
 
-            ret = uacpi_gas_read(&reg->status, &status);
+            ret = uacpi_gas_read_mapped(&reg->status, &status);
             if (uacpi_unlikely_error(ret))
-                return int_ret;
+                goto out;
 
-            ret = uacpi_gas_read(&reg->enable, &enable);
+            ret = uacpi_gas_read_mapped(&reg->enable, &enable);
             if (uacpi_unlikely_error(ret))
-                return int_ret;
+                goto out;
 
-            if (status == 0)
-                continue;
+            pending = status & enable;
 
-            for (j = 0; j < EVENTS_PER_GPE_REGISTER; ++j) {
-                if (!((status & enable) & (1ull << j)))
-                    continue;
+            // Dispatch one set bit at a time so that the cost of this loop
+            // scales with the number of pending events, not the GPE count
+            while (pending) {
+                j = uacpi_bit_scan_forward(pending) - 1;
+                pending &= pending - 1;
 
                 event = &block->events[j + i * EVENTS_PER_GPE_REGISTER];
-                int_ret |= dispatch_gpe(block->device_node, event);
+                int_ret |= dispatch_gpe(block->device_node, event, &batch);
             }
         }
 
         block = block->next;
     }
 
+out:
+    schedule_gpe_batch(&batch);
     return int_ret;
 }
 
@@ -608,27 +874,34 @@ static uacpi_status maybe_dispatch_gpe(
 {
     uacpi_status ret;
     struct gpe_register *reg = event->reg;
+    struct gpe_batch batch = { 0 };
     uacpi_u64 status;
 
-    ret = uacpi_gas_read(&reg->status, &status);
+    ret = uacpi_gas_read_mapped(&reg->status, &status);
     if (uacpi_unlikely_error(ret))
         return ret;
 
     if (!(status & gpe_get_mask(event)))
         return ret;
 
-    dispatch_gpe(gpe_device, event);
+    dispatch_gpe(gpe_device, event, &batch);
+    schedule_gpe_batch(&batch);
     return ret;
 }
 
 static uacpi_interrupt_ret handle_gpes(uacpi_handle opaque)
 {
     struct gpe_interrupt_ctx *ctx = opaque;
+    uacpi_interrupt_ret int_ret;
 
     if (uacpi_unlikely(ctx == UACPI_NULL))
         return UACPI_INTERRUPT_NOT_HANDLED;
 
-    return detect_gpes(ctx->gpe_head);
+    uacpi_atomic_inc32(&g_irqs_inflight);
+    int_ret = detect_gpes(ctx->gpe_head);
+    uacpi_atomic_dec32(&g_irqs_inflight);
+
+    return int_ret;
 }
 
 static uacpi_status find_or_create_gpe_interrupt_ctx(
@@ -718,7 +991,7 @@ static uacpi_status gpe_block_apply_action(
             value = reg->wake_mask;
             break;
         case GPE_BLOCK_ACTION_CLEAR_ALL:
-            ret = uacpi_gas_write(&reg->status, 0xFF);
+            ret = uacpi_gas_write_mapped(&reg->status, 0xFF);
             if (uacpi_unlikely_error(ret))
                 return ret;
             continue;
@@ -727,7 +1000,7 @@ static uacpi_status gpe_block_apply_action(
         }
 
         reg->current_mask = value;
-        ret = uacpi_gas_write(&reg->enable, value);
+        ret = set_gpe_enable_mask(reg, value);
         if (uacpi_unlikely_error(ret))
             return ret;
     }
@@ -751,11 +1024,13 @@ static void gpe_block_mask_safe(struct gpe_block *block)
         reg->masked_mask = 0xFF;
 
         /*
-         * 2. Wait for in-flight work & IRQs to finish, these might already
-         *    be past the respective "if (masked)" check and therefore may
-         *    try to re-enable a masked GPE.
+         * 2. Wait for in-flight GPE work & IRQs to finish, these might
+         *    already be past the respective "if (masked)" check and therefore
+         *    may try to re-enable a masked GPE. IRQs are drained first since
+         *    they are what schedules the work.
          */
-        uacpi_kernel_wait_for_work_completion();
+        wait_for_inflight_irqs();
+        uacpi_wait_for_group_work_completion(&g_gpe_work_group);
 
         /*
          * 3. Now that this GPE's state is unmodifyable and we know that
@@ -763,13 +1038,14 @@ static void gpe_block_mask_safe(struct gpe_block *block)
          *    safely disable all events knowing they won't be re-enabled by
          *    a racing IRQ.
          */
-        uacpi_gas_write(&reg->enable, 0x00);
+        set_gpe_enable_mask(reg, 0x00);
 
         /*
-         * 4. Wait for the last possible IRQ to finish, now that this event is
-         *    disabled.
+         * 4. Wait for the last possible IRQ (and any batch it managed to
+         *    schedule) to finish, now that this event is disabled.
          */
-        uacpi_kernel_wait_for_work_completion();
+        wait_for_inflight_irqs();
+        uacpi_wait_for_group_work_completion(&g_gpe_work_group);
     }
 }
 
@@ -846,6 +1122,21 @@ static void uninstall_gpe_block(struct gpe_block *block)
 
     }
 
+    if (block->registers != UACPI_NULL) {
+        uacpi_size i;
+        struct gpe_register *reg;
+
+        for (i = 0; i < block->num_registers; ++i) {
+            reg = &block->registers[i];
+
+            uacpi_unmap_gas_nofree(&reg->status);
+            uacpi_unmap_gas_nofree(&reg->enable);
+        }
+    }
+
+    if (block->state_lock != UACPI_NULL)
+        uacpi_kernel_free_spinlock(block->state_lock);
+
     uacpi_free(block->registers,
                sizeof(*block->registers) * block->num_registers);
     uacpi_free(block->events,
@@ -1000,8 +1291,12 @@ static uacpi_status create_gpe_block(
     struct gpe_block *block;
     struct gpe_register *reg;
     struct gp_event *event;
+    struct acpi_gas gas = { 0 };
     uacpi_size i, j;
 
+    gas.address_space_id = address_space_id;
+    gas.register_bit_width = 8;
+
     block = uacpi_kernel_alloc_zeroed(sizeof(*block));
     if (uacpi_unlikely(block == UACPI_NULL))
         return ret;
@@ -1009,6 +1304,10 @@ static uacpi_status create_gpe_block(
     block->device_node = device_node;
     block->base_idx = base_idx;
 
+    block->state_lock = uacpi_kernel_create_spinlock();
+    if (uacpi_unlikely(block->state_lock == UACPI_NULL))
+        goto error_out;
+
     block->num_registers = num_registers;
     block->registers = uacpi_kernel_alloc_zeroed(
         num_registers * sizeof(*block->registers)
@@ -1033,14 +1332,17 @@ static uacpi_status create_gpe_block(
          * Each bit corresponds to one event that we initialize below.
          */
         reg->base_idx = base_idx + (i * EVENTS_PER_GPE_REGISTER);
+        reg->block = block;
 
-        reg->status.address = address + i;
-        reg->status.address_space_id = address_space_id;
-        reg->status.register_bit_width = 8;
+        gas.address = address + i;
+        ret = uacpi_map_gas_noalloc(&gas, &reg->status);
+        if (uacpi_unlikely_error(ret))
+            goto error_out;
 
-        reg->enable.address = address + num_registers + i;
-        reg->enable.address_space_id = address_space_id;
-        reg->enable.register_bit_width = 8;
+        gas.address = address + num_registers + i;
+        ret = uacpi_map_gas_noalloc(&gas, &reg->enable);
+        if (uacpi_unlikely_error(ret))
+            goto error_out;
 
         for (j = 0; j < EVENTS_PER_GPE_REGISTER; ++j, ++event) {
             event->idx = reg->base_idx + j;
@@ -1049,13 +1351,15 @@ static uacpi_status create_gpe_block(
 
         /*
          * Disable all GPEs in this register & clear anything that might be
-         * pending from earlier.
+         * pending from earlier. Note that this is a raw write on purpose:
+         * the hardware state is unknown at this point, and it leaves the
+         * register in sync with the zero-initialized enable shadow.
          */
-        ret = uacpi_gas_write(&reg->enable, 0x00);
+        ret = uacpi_gas_write_mapped(&reg->enable, 0x00);
         if (uacpi_unlikely_error(ret))
             goto error_out;
 
-        ret = uacpi_gas_write(&reg->status, 0xFF);
+        ret = uacpi_gas_write_mapped(&reg->status, 0xFF);
         if (uacpi_unlikely_error(ret))
             goto error_out;
     }
@@ -1251,11 +1555,13 @@ static uacpi_status gpe_mask_unmask(
         reg->masked_mask |= mask;
 
         /*
-         * 2. Wait for in-flight work & IRQs to finish, these might already
-         *    be past the respective "if (masked)" check and therefore may
-         *    try to re-enable a masked GPE.
+         * 2. Wait for in-flight GPE work & IRQs to finish, these might
+         *    already be past the respective "if (masked)" check and therefore
+         *    may try to re-enable a masked GPE. IRQs are drained first since
+         *    they are what schedules the work.
          */
-        uacpi_kernel_wait_for_work_completion();
+        wait_for_inflight_irqs();
+        uacpi_wait_for_group_work_completion(&g_gpe_work_group);
 
         /*
          * 3. Now that this GPE's state is unmodifyable and we know that currently
@@ -1265,10 +1571,11 @@ static uacpi_status gpe_mask_unmask(
         set_gpe_state(event, GPE_STATE_DISABLED);
 
         /*
-         * 4. Wait for the last possible IRQ to finish, now that this event is
-         *    disabled.
+         * 4. Wait for the last possible IRQ (and any batch it managed to
+         *    schedule) to finish, now that this event is disabled.
          */
-        uacpi_kernel_wait_for_work_completion();
+        wait_for_inflight_irqs();
+        uacpi_wait_for_group_work_completion(&g_gpe_work_group);
 
         return UACPI_STATUS_OK;
     }
@@ -1719,6 +2026,76 @@ uacpi_status uacpi_unmask_gpe(
     return gpe_get_mask_unmask(gpe_device, idx, UACPI_FALSE);
 }
 
+#ifdef UACPI_GPE_LATENCY_STATS
+static uacpi_status do_gpe_latency_histograms(
+    uacpi_namespace_node *gpe_device, uacpi_u16 idx,
+    uacpi_gpe_latency_histograms *out_histograms, uacpi_bool reset
+)
+{
+    uacpi_status ret;
+    struct gp_event *event;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    ret = uacpi_recursive_lock_acquire(&g_event_lock);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = sanitize_device_and_find_gpe(&gpe_device, idx, &event);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    if (out_histograms != UACPI_NULL)
+        uacpi_memcpy(out_histograms, &event->latency, sizeof(event->latency));
+    if (reset)
+        uacpi_memzero(&event->latency, sizeof(event->latency));
+
+out:
+    uacpi_recursive_lock_release(&g_event_lock);
+    return ret;
+}
+
+uacpi_status uacpi_gpe_get_latency_histograms(
+    uacpi_namespace_node *gpe_device, uacpi_u16 idx,
+    uacpi_gpe_latency_histograms *out_histograms
+)
+{
+    if (uacpi_unlikely(out_histograms == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    return do_gpe_latency_histograms(
+        gpe_device, idx, out_histograms, UACPI_FALSE
+    );
+}
+
+uacpi_status uacpi_gpe_reset_latency_histograms(
+    uacpi_namespace_node *gpe_device, uacpi_u16 idx
+)
+{
+    return do_gpe_latency_histograms(gpe_device, idx, UACPI_NULL, UACPI_TRUE);
+}
+#else
+uacpi_status uacpi_gpe_get_latency_histograms(
+    uacpi_namespace_node *gpe_device, uacpi_u16 idx,
+    uacpi_gpe_latency_histograms *out_histograms
+)
+{
+    UACPI_UNUSED(gpe_device);
+    UACPI_UNUSED(idx);
+    UACPI_UNUSED(out_histograms);
+    return UACPI_STATUS_COMPILED_OUT;
+}
+
+uacpi_status uacpi_gpe_reset_latency_histograms(
+    uacpi_namespace_node *gpe_device, uacpi_u16 idx
+)
+{
+    UACPI_UNUSED(gpe_device);
+    UACPI_UNUSED(idx);
+    return UACPI_STATUS_COMPILED_OUT;
+}
+#endif
+
 uacpi_status uacpi_setup_gpe_for_wake(
     uacpi_namespace_node *gpe_device, uacpi_u16 idx,
     uacpi_namespace_node *wake_device
@@ -2096,9 +2473,13 @@ static uacpi_interrupt_ret handle_sci(uacpi_handle ctx)
 {
     uacpi_interrupt_ret int_ret = UACPI_INTERRUPT_NOT_HANDLED;
 
+    uacpi_atomic_inc32(&g_irqs_inflight);
+
     int_ret |= handle_fixed_events();
     int_ret |= handle_gpes(ctx);
 
+    uacpi_atomic_dec32(&g_irqs_inflight);
+
     return int_ret;
 }
 
@@ -2109,10 +2490,6 @@ uacpi_status uacpi_initialize_events_early(void)
     if (uacpi_is_hardware_reduced())
         return UACPI_STATUS_OK;
 
-    g_gpe_state_slock = uacpi_kernel_create_spinlock();
-    if (uacpi_unlikely(g_gpe_state_slock == UACPI_NULL))
-        return UACPI_STATUS_OUT_OF_MEMORY;
-
     ret = uacpi_recursive_lock_init(&g_event_lock);
     if (uacpi_unlikely_error(ret))
         return ret;
@@ -2131,6 +2508,8 @@ uacpi_status uacpi_initialize_events(void)
     if (uacpi_is_hardware_reduced())
         return UACPI_STATUS_OK;
 
+    uacpi_work_group_init(&g_gpe_work_group);
+
     ret = initialize_gpes();
     if (uacpi_unlikely_error(ret))
         return ret;
@@ -2198,13 +2577,9 @@ void uacpi_deinitialize_events(void)
             uacpi_uninstall_fixed_event_handler(i);
     }
 
-    if (g_gpe_state_slock != UACPI_NULL) {
-        uacpi_kernel_free_spinlock(g_gpe_state_slock);
-        g_gpe_state_slock = UACPI_NULL;
-    }
-
     uacpi_recursive_lock_deinit(&g_event_lock);
 
+    uacpi_work_group_deinit(&g_gpe_work_group);
     g_gpe_interrupt_head = UACPI_NULL;
 }
 
@@ -2272,7 +2647,8 @@ uacpi_status uacpi_uninstall_fixed_event_handler(
     if (uacpi_unlikely_error(ret))
         goto out;
 
-    uacpi_kernel_wait_for_work_completion();
+    // Fixed event handlers only ever run from interrupt context
+    wait_for_inflight_irqs();
 
     ev->handler = UACPI_NULL;
     ev->ctx = UACPI_NULL;
@@ -2359,13 +2735,13 @@ uacpi_status uacpi_gpe_info(
     if (reg->wake_mask & mask)
         info |= UACPI_EVENT_INFO_ENABLED_FOR_WAKE;
 
-    ret = uacpi_gas_read(&reg->enable, &raw_value);
+    ret = uacpi_gas_read_mapped(&reg->enable, &raw_value);
     if (uacpi_unlikely_error(ret))
         goto out;
     if (raw_value & mask)
         info |= UACPI_EVENT_INFO_HW_ENABLED;
 
-    ret = uacpi_gas_read(&reg->status, &raw_value);
+    ret = uacpi_gas_read_mapped(&reg->status, &raw_value);
     if (uacpi_unlikely_error(ret))
         goto out;
     if (raw_value & mask)
@@ -18,4 +18,7 @@ uacpi_add_sources(
     event.c
     mutex.c
     osi.c
+    pool.c
+    profiling.c
+    snapshot.c
 )
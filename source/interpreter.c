@@ -17,6 +17,11 @@
 #include <uacpi/internal/event.h>
 #include <uacpi/internal/mutex.h>
 #include <uacpi/internal/osi.h>
+#include <uacpi/internal/profiling.h>
+
+// Attribute allocations in this file under UACPI_MEMORY_ACCOUNTING
+#undef UACPI_TRACKED_SUBSYSTEM
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_INTERPRETER
 
 enum item_type {
     ITEM_NONE = 0,
@@ -44,8 +49,14 @@ struct item {
     };
 };
 
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE(item_array, struct item, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(item_array, struct item, static)
+/*
+ * Interpreter temporaries (pending items, op contexts, temporary nodes) are
+ * all freed in bulk when the execution context dies, so their overflow
+ * storage is drawn from the per-execution-context bump arena instead of the
+ * kernel heap.
+ */
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_AND_ARENA(item_array, struct item, 8)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(item_array, struct item, static)
 
 struct op_context {
     uacpi_u8 pc;
@@ -61,8 +72,10 @@ struct op_context {
     struct item_array items;
 };
 
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE(op_context_array, struct op_context, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_AND_ARENA(
+    op_context_array, struct op_context, 8
+)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(
     op_context_array, struct op_context, static
 )
 
@@ -96,6 +109,9 @@ struct code_block {
     };
 };
 
+// How many iterations of the same While to run between loop timeout checks
+#define WHILE_TIMEOUT_CHECK_INTERVAL 32
+
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(code_block_array, struct code_block, 8)
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
     code_block_array, struct code_block, static
@@ -240,9 +256,9 @@ do_release:
     return UACPI_STATUS_OK;
 }
 
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_AND_ARENA(
     temp_namespace_node_array, uacpi_namespace_node*, 8)
-DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_ARENA_IMPL(
     temp_namespace_node_array, uacpi_namespace_node*, static
 )
 
@@ -272,6 +288,7 @@ struct call_frame {
     struct code_block *last_while;
     uacpi_u64 prev_while_expiration;
     uacpi_u32 prev_while_code_offset;
+    uacpi_u32 while_iteration_counter;
 
     uacpi_u32 code_offset;
 
@@ -321,6 +338,9 @@ struct execution_context {
     struct call_frame_array call_stack;
     struct held_mutexes_array held_mutexes;
 
+    // Backing storage for all method-local temporaries, dies with us
+    struct uacpi_arena arena;
+
     struct call_frame *cur_frame;
     struct code_block *cur_block;
     const struct uacpi_op_spec *cur_op;
@@ -329,6 +349,49 @@ struct execution_context {
 
     uacpi_bool skip_else;
     uacpi_u8 sync_level;
+
+    /*
+     * Only relevant for suspendable invocations: why the context is currently
+     * parked waiting for a resume, and the absolute time (in nanoseconds
+     * since boot, 0 if waiting indefinitely) after which it wants to be woken
+     * up. The op that suspended is re-invoked upon resumption and re-checks
+     * these to decide whether this wakeup is spurious.
+     */
+    uacpi_u8 suspend_reason;
+    uacpi_u64 wake_deadline_ns;
+
+    uacpi_bool suspendable;
+
+    /*
+     * Set whenever an op that may block for wall time (Sleep, Stall, Acquire,
+     * Wait) runs, consumed by the While back-edge to force a loop timeout
+     * check regardless of the batching interval.
+     */
+    uacpi_bool blocked_since_timeout_check;
+
+    /*
+     * Dead interpreter temporaries (integers and typeless objects) kept
+     * around for reuse, linked through their inner_object field. Contexts
+     * are single-threaded, so recycling through here skips the global
+     * object pool lock for the majority of intermediate results.
+     */
+    uacpi_object *object_cache;
+    uacpi_u8 object_cache_depth;
+
+#ifdef UACPI_PROFILING
+    // The method node this invocation is recorded under, NULL for table loads
+    uacpi_namespace_node *prof_node;
+    uacpi_u64 prof_begin_ts;
+#endif
+
+    // Links retired contexts parked on the freelist
+    struct execution_context *next_free;
+};
+
+enum suspend_reason {
+    SUSPEND_REASON_NONE = 0,
+    SUSPEND_REASON_SLEEP,
+    SUSPEND_REASON_ACQUIRE,
 };
 
 #define AML_READ(ptr, offset) (*(((uacpi_u8*)(ptr)) + offset))
@@ -358,6 +421,94 @@ static uacpi_status parse_nameseg(uacpi_u8 *cursor,
  * MultiNamePath := MultiNamePrefix SegCount NameSeg(SegCount)
  */
 
+/*
+ * A small per-method cache memoizing decode work that is re-done on every
+ * execution of a control method: PkgLength boundaries and namespace nodes
+ * resolved from static name paths. Keyed by AML code offset, which uniquely
+ * identifies the encoding (and, for name paths, the lexical scope it is
+ * resolved against) for as long as the method is alive.
+ *
+ * Node entries additionally record the namespace generation at resolution
+ * time and are ignored once the namespace changes shape, so targets removed
+ * by e.g. a table unload can never be returned stale.
+ */
+#define METHOD_DECODE_CACHE_ENTRIES 32
+
+enum decode_cache_entry_kind {
+    DECODE_CACHE_ENTRY_EMPTY = 0,
+    DECODE_CACHE_ENTRY_PKGLEN,
+    DECODE_CACHE_ENTRY_NODE,
+};
+
+struct method_decode_cache_entry {
+    uacpi_u32 offset;
+    uacpi_u8 kind;
+
+    // Bytes this encoding occupies in the instruction stream
+    uacpi_u16 encoded_length;
+
+    union {
+        uacpi_u32 pkg_end;
+        uacpi_namespace_node *node;
+    };
+    uacpi_u64 generation;
+};
+
+struct uacpi_method_decode_cache {
+    struct method_decode_cache_entry entries[METHOD_DECODE_CACHE_ENTRIES];
+};
+
+void uacpi_method_decode_cache_free(uacpi_control_method *method)
+{
+    uacpi_free(method->decode_cache, sizeof(*method->decode_cache));
+    method->decode_cache = UACPI_NULL;
+}
+
+static struct method_decode_cache_entry *method_decode_cache_lookup(
+    struct uacpi_control_method *method, uacpi_u32 offset,
+    enum decode_cache_entry_kind kind
+)
+{
+    struct method_decode_cache_entry *entry;
+
+    if (method->decode_cache == UACPI_NULL)
+        return UACPI_NULL;
+
+    entry = &method->decode_cache->entries[
+        (offset * 2654435769u) >> (32 - 5)
+    ];
+    UACPI_BUILD_BUG_ON(METHOD_DECODE_CACHE_ENTRIES != (1 << 5));
+
+    if (entry->kind != kind || entry->offset != offset)
+        return UACPI_NULL;
+
+    return entry;
+}
+
+static struct method_decode_cache_entry *method_decode_cache_entry_for_store(
+    struct uacpi_control_method *method, uacpi_u32 offset
+)
+{
+    /*
+     * Table-level "methods" are executed exactly once, don't waste memory
+     * memoizing their decode work.
+     */
+    if (method->named_objects_persist)
+        return UACPI_NULL;
+
+    if (method->decode_cache == UACPI_NULL) {
+        method->decode_cache = uacpi_kernel_alloc_zeroed(
+            sizeof(*method->decode_cache)
+        );
+
+        // The cache is purely an optimization, skip it if we're low on memory
+        if (uacpi_unlikely(method->decode_cache == UACPI_NULL))
+            return UACPI_NULL;
+    }
+
+    return &method->decode_cache->entries[(offset * 2654435769u) >> (32 - 5)];
+}
+
 static uacpi_status name_string_to_path(
     struct call_frame *frame, uacpi_size offset,
     uacpi_char **out_string, uacpi_size *out_size
@@ -481,9 +632,31 @@ static uacpi_status resolve_name_string(
     uacpi_u8 *cursor;
     uacpi_size bytes_left, namesegs = 0;
     struct uacpi_namespace_node *parent, *cur_node = frame->cur_scope;
+    struct method_decode_cache_entry *entry;
+    uacpi_u32 start_offset = frame->code_offset;
     uacpi_char prev_char = 0;
     uacpi_bool just_one_nameseg = UACPI_TRUE;
 
+    if (behavior == RESOLVE_FAIL_IF_DOESNT_EXIST) {
+        entry = method_decode_cache_lookup(
+            frame->method, start_offset, DECODE_CACHE_ENTRY_NODE
+        );
+
+        /*
+         * The cached target is only valid if the namespace hasn't changed
+         * shape since it was resolved, both because the node might be gone
+         * and because a newly installed node might shadow it.
+         */
+        if (entry != UACPI_NULL &&
+            entry->generation == uacpi_namespace_generation()) {
+            frame->code_offset += entry->encoded_length;
+
+            uacpi_shareable_ref(entry->node);
+            *out_node = entry->node;
+            return UACPI_STATUS_OK;
+        }
+    }
+
     bytes_left = call_frame_code_bytes_left(frame);
     cursor = call_frame_cursor(frame);
 
@@ -619,9 +792,25 @@ out:
     cursor += namesegs * 4;
     frame->code_offset = cursor - frame->method->code;
 
-    if (uacpi_likely_success(ret) && behavior == RESOLVE_FAIL_IF_DOESNT_EXIST)
+    if (uacpi_likely_success(ret) && behavior == RESOLVE_FAIL_IF_DOESNT_EXIST) {
+        uacpi_u32 encoded_length = frame->code_offset - start_offset;
+
         uacpi_shareable_ref(cur_node);
 
+        if (cur_node != UACPI_NULL && encoded_length <= 0xFFFF) {
+            entry = method_decode_cache_entry_for_store(
+                frame->method, start_offset
+            );
+            if (entry != UACPI_NULL) {
+                entry->kind = DECODE_CACHE_ENTRY_NODE;
+                entry->offset = start_offset;
+                entry->encoded_length = encoded_length;
+                entry->node = cur_node;
+                entry->generation = uacpi_namespace_generation();
+            }
+        }
+    }
+
     *out_node = cur_node;
     return ret;
 }
@@ -669,7 +858,7 @@ static uacpi_status get_op(struct execution_context *ctx)
     if (uacpi_unlikely(ctx->cur_op->properties & UACPI_OP_PROPERTY_RESERVED)) {
         uacpi_error(
             "invalid opcode '%s' encountered in bytestream\n",
-            ctx->cur_op->name
+            uacpi_op_spec_name(ctx->cur_op)
         );
         return UACPI_STATUS_AML_INVALID_OPCODE;
     }
@@ -677,6 +866,9 @@ static uacpi_status get_op(struct execution_context *ctx)
     return UACPI_STATUS_OK;
 }
 
+// Static-initializer buffers at least this large alias table memory directly
+#define ZERO_COPY_BUFFER_MIN_SIZE 64
+
 static uacpi_status handle_buffer(struct execution_context *ctx)
 {
     struct package_length *pkg;
@@ -721,6 +913,31 @@ static uacpi_status handle_buffer(struct execution_context *ctx)
     }
 
     dst = item_array_at(&op_ctx->items, 3)->obj;
+
+    /*
+     * A fully initialized buffer declared directly in a table body can
+     * reference the initializer bytes in place instead of copying them: the
+     * buffer takes a reference on the table, pinning its mapping, and any
+     * later store promotes the buffer to an owned copy first (see
+     * uacpi_buffer_ensure_mutable). Tiny buffers aren't worth the table
+     * refcounting, those just get copied as before.
+     */
+    if (init_size == buffer_size &&
+        buffer_size >= ZERO_COPY_BUFFER_MIN_SIZE &&
+        ctx->cur_frame->method->code_in_table) {
+        uacpi_table tbl = { 0 };
+
+        tbl.index = ctx->cur_frame->method->table_idx;
+
+        if (uacpi_table_ref(&tbl) == UACPI_STATUS_OK) {
+            dst->buffer->data = src;
+            dst->buffer->size = buffer_size;
+            dst->buffer->aliases_table = UACPI_TRUE;
+            dst->buffer->aliased_table_idx = tbl.index;
+            return UACPI_STATUS_OK;
+        }
+    }
+
     dst->buffer->data = uacpi_kernel_alloc(buffer_size);
     if (uacpi_unlikely(dst->buffer->data == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
@@ -758,6 +975,63 @@ static uacpi_status handle_string(struct execution_context *ctx)
     return UACPI_STATUS_OK;
 }
 
+/*
+ * Deep-copy 'src' into 'dst', but steal the underlying buffer storage
+ * instead of copying it when 'src' is a dying temporary that nothing else
+ * aliases, e.g. the intermediate result of a Concatenate or ToBuffer being
+ * flushed to its target. The temporary drops its last reference right after
+ * the assignment, so the storage would otherwise be copied only to be
+ * immediately freed. Buffers borrowed by a buffer field or buffer index
+ * (or shared in any other way) are still copied.
+ */
+static uacpi_status object_assign_or_move(uacpi_object *dst, uacpi_object *src)
+{
+    enum uacpi_assign_behavior behavior = UACPI_ASSIGN_BEHAVIOR_DEEP_COPY;
+
+    switch (src->type) {
+    case UACPI_OBJECT_BUFFER:
+    case UACPI_OBJECT_STRING:
+        if (uacpi_shareable_refcount(src) == 1 &&
+            uacpi_shareable_refcount(src->buffer) == 1)
+            behavior = UACPI_ASSIGN_BEHAVIOR_SHALLOW_COPY;
+        break;
+    default:
+        break;
+    }
+
+    return uacpi_object_assign(dst, src, behavior);
+}
+
+static uacpi_status package_init_deferred(
+    struct execution_context *ctx, uacpi_package *pkg
+)
+{
+    struct uacpi_deferred_package_data *deferred;
+    uacpi_control_method *method = ctx->cur_frame->method;
+    uacpi_table tbl = { 0 };
+    uacpi_status ret;
+    uacpi_size size;
+
+    size = sizeof(*deferred) + pkg->count * sizeof(deferred->elements[0]);
+
+    deferred = uacpi_kernel_alloc_zeroed(size);
+    if (uacpi_unlikely(deferred == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    // Pin the table mapping the element ranges point into
+    tbl.index = method->table_idx;
+    ret = uacpi_table_ref(&tbl);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free(deferred, size);
+        return ret;
+    }
+
+    deferred->table_idx = method->table_idx;
+    deferred->code = method->code;
+    pkg->deferred = deferred;
+    return UACPI_STATUS_OK;
+}
+
 static uacpi_status handle_package(struct execution_context *ctx)
 {
     struct op_context *op_ctx = ctx->cur_op_ctx;
@@ -814,6 +1088,26 @@ static uacpi_status handle_package(struct execution_context *ctx)
 
         base_pkg_index = (i * 2) + 2;
         item = item_array_at(&op_ctx->items, base_pkg_index + 1);
+
+        if (item->type == ITEM_IMMEDIATE) {
+            /*
+             * A constant element skipped at parse time: remember its AML
+             * range and leave the object uninitialized until first access,
+             * see uacpi_package_materialize_element.
+             */
+            if (package->deferred == UACPI_NULL) {
+                ret = package_init_deferred(ctx, package);
+                if (uacpi_unlikely_error(ret))
+                    return ret;
+            }
+
+            package->deferred->elements[i].offset =
+                item_array_at(&op_ctx->items, base_pkg_index)->immediate;
+            package->deferred->elements[i].size = item->immediate;
+            package->deferred->pending++;
+            continue;
+        }
+
         obj = item->obj;
 
         if (obj != UACPI_NULL && obj->type == UACPI_OBJECT_REFERENCE) {
@@ -858,8 +1152,7 @@ static uacpi_status handle_package(struct execution_context *ctx)
             item->type = ITEM_OBJECT;
         }
 
-        ret = uacpi_object_assign(package->objects[i], obj,
-                                  UACPI_ASSIGN_BEHAVIOR_DEEP_COPY);
+        ret = object_assign_or_move(package->objects[i], obj);
         if (uacpi_unlikely_error(ret))
             return ret;
     }
@@ -934,11 +1227,18 @@ static uacpi_u8 *buffer_index_cursor(uacpi_buffer_index *buf_idx)
     return out_cursor;
 }
 
-static void write_buffer_index(uacpi_buffer_index *buf_idx,
-                               struct object_storage_as_buffer *src_buf)
+static uacpi_status write_buffer_index(uacpi_buffer_index *buf_idx,
+                                       struct object_storage_as_buffer *src_buf)
 {
+    uacpi_status ret;
+
+    ret = uacpi_buffer_ensure_mutable(buf_idx->buffer);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
     uacpi_memcpy_zerout(buffer_index_cursor(buf_idx), src_buf->ptr,
                         1, src_buf->len);
+    return UACPI_STATUS_OK;
 }
 
 /*
@@ -962,6 +1262,12 @@ static uacpi_status object_assign_with_implicit_cast(uacpi_object *dst,
     case UACPI_OBJECT_BUFFER: {
         struct object_storage_as_buffer dst_buf;
 
+        if (dst->type == UACPI_OBJECT_BUFFER) {
+            ret = uacpi_buffer_ensure_mutable(dst->buffer);
+            if (uacpi_unlikely_error(ret))
+                return ret;
+        }
+
         ret = get_object_storage(dst, &dst_buf, UACPI_FALSE);
         if (uacpi_unlikely_error(ret))
             goto out_bad_cast;
@@ -971,7 +1277,9 @@ static uacpi_status object_assign_with_implicit_cast(uacpi_object *dst,
     }
 
     case UACPI_OBJECT_BUFFER_FIELD:
-        uacpi_write_buffer_field(&dst->buffer_field, src_buf.ptr, src_buf.len);
+        ret = uacpi_write_buffer_field(
+            &dst->buffer_field, src_buf.ptr, src_buf.len
+        );
         break;
 
     case UACPI_OBJECT_FIELD_UNIT:
@@ -980,7 +1288,7 @@ static uacpi_status object_assign_with_implicit_cast(uacpi_object *dst,
         );
 
     case UACPI_OBJECT_BUFFER_INDEX:
-        write_buffer_index(&dst->buffer_index, &src_buf);
+        ret = write_buffer_index(&dst->buffer_index, &src_buf);
         break;
 
     default:
@@ -1233,7 +1541,8 @@ static uacpi_bool is_dynamic_table_load(enum uacpi_table_load_cause cause)
 }
 
 static void prepare_table_load(
-    void *ptr, enum uacpi_table_load_cause cause, uacpi_control_method *in_method
+    void *ptr, uacpi_size table_idx, enum uacpi_table_load_cause cause,
+    uacpi_control_method *in_method
 )
 {
     struct acpi_dsdt *dsdt = ptr;
@@ -1254,24 +1563,29 @@ static void prepare_table_load(
     in_method->code = dsdt->definition_block;
     in_method->size = dsdt->hdr.length - sizeof(dsdt->hdr);
     in_method->named_objects_persist = UACPI_TRUE;
+    in_method->code_in_table = UACPI_TRUE;
+    in_method->table_idx = table_idx;
 }
 
 static uacpi_status do_load_table(
     uacpi_namespace_node *parent, struct acpi_sdt_hdr *tbl,
-    enum uacpi_table_load_cause cause
+    uacpi_size table_idx, enum uacpi_table_load_cause cause
 )
 {
     struct uacpi_control_method method = { 0 };
     uacpi_status ret;
 
-    prepare_table_load(tbl, cause, &method);
+    prepare_table_load(tbl, table_idx, cause, &method);
 
     ret = uacpi_execute_control_method(parent, &method, UACPI_NULL, UACPI_NULL);
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    if (is_dynamic_table_load(cause))
+    if (is_dynamic_table_load(cause)) {
+        uacpi_invalidate_device_id_index();
+        uacpi_bump_namespace_generation();
         uacpi_events_match_post_dynamic_table_load();
+    }
 
     return ret;
 }
@@ -1315,6 +1629,8 @@ static uacpi_status handle_load_table(struct execution_context *ctx)
             return UACPI_STATUS_OK;
         }
 
+        uacpi_invalidate_device_id_index();
+        uacpi_bump_namespace_generation();
         uacpi_events_match_post_dynamic_table_load();
         return UACPI_STATUS_OK;
     }
@@ -1382,7 +1698,9 @@ static uacpi_status handle_load_table(struct execution_context *ctx)
 
     item_array_at(items, 2)->immediate = table.index;
     method = item_array_at(items, 1)->obj->method;
-    prepare_table_load(table.hdr, UACPI_TABLE_LOAD_CAUSE_LOAD_TABLE_OP, method);
+    prepare_table_load(
+        table.hdr, table.index, UACPI_TABLE_LOAD_CAUSE_LOAD_TABLE_OP, method
+    );
 
     return UACPI_STATUS_OK;
 }
@@ -1513,7 +1831,9 @@ static uacpi_status handle_load(struct execution_context *ctx)
     item_array_at(items, 0)->node = uacpi_namespace_root();
 
     method = item_array_at(items, 1)->obj->method;
-    prepare_table_load(table.ptr, UACPI_TABLE_LOAD_CAUSE_LOAD_OP, method);
+    prepare_table_load(
+        table.ptr, table.index, UACPI_TABLE_LOAD_CAUSE_LOAD_OP, method
+    );
 
     return UACPI_STATUS_OK;
 
@@ -1523,7 +1843,9 @@ error_out:
     return UACPI_STATUS_OK;
 }
 
-uacpi_status uacpi_execute_table(void *tbl, enum uacpi_table_load_cause cause)
+uacpi_status uacpi_execute_table(
+    void *tbl, uacpi_size table_idx, enum uacpi_table_load_cause cause
+)
 {
     uacpi_status ret;
 
@@ -1531,7 +1853,7 @@ uacpi_status uacpi_execute_table(void *tbl, enum uacpi_table_load_cause cause)
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    ret = do_load_table(uacpi_namespace_root(), tbl, cause);
+    ret = do_load_table(uacpi_namespace_root(), tbl, table_idx, cause);
 
     uacpi_namespace_write_unlock();
     return ret;
@@ -1852,6 +2174,360 @@ static uacpi_u64 ones(void)
     return g_uacpi_rt_ctx.is_rev1 ? 0xFFFFFFFF : 0xFFFFFFFFFFFFFFFF;
 }
 
+/*
+ * Everything below implements deferred (lazily materialized) package
+ * elements, see UACPI_PARSE_OP_PACKAGE_ELEMENT.
+ *
+ * The scanner runs at parse time and decides whether an element can be
+ * skipped: it accepts the exact subset of AML the materializer knows how to
+ * decode and validates all bounds/sizes upfront, so that materialization
+ * later on can only fail with an out-of-memory condition.
+ */
+
+// Maximum nesting of constant packages the scanner is willing to look into
+#define CONSTANT_SCAN_MAX_DEPTH 8
+
+// Standalone PkgLength decoder for code not attached to a call frame
+static uacpi_u32 decode_pkglen_raw(
+    const uacpi_u8 *code, uacpi_u32 offset, uacpi_u32 end, uacpi_u32 *out_size
+)
+{
+    uacpi_u32 left = end - offset, size;
+    uacpi_u8 marker_length;
+
+    marker_length = 1 + (code[offset] >> 6);
+    if (uacpi_unlikely(left < marker_length))
+        return 0;
+
+    if (marker_length == 1) {
+        size = code[offset] & 0b111111;
+    } else {
+        uacpi_u32 temp_byte = 0;
+
+        size = code[offset] & 0b1111;
+        uacpi_memcpy(&temp_byte, &code[offset + 1], marker_length - 1);
+
+        // If we're here there's at least one extra byte, so this can't be 0
+        size |= temp_byte << 4;
+    }
+
+    if (uacpi_unlikely(size < marker_length || size > left))
+        return 0;
+
+    *out_size = size;
+    return marker_length;
+}
+
+static uacpi_u32 scan_integer_constant(
+    const uacpi_u8 *code, uacpi_u32 offset, uacpi_u32 end, uacpi_u64 *out_value
+)
+{
+    uacpi_u32 size;
+    uacpi_u64 value = 0;
+
+    switch (code[offset]) {
+    case UACPI_AML_OP_ZeroOp:
+        *out_value = 0;
+        return 1;
+    case UACPI_AML_OP_OneOp:
+        *out_value = 1;
+        return 1;
+    case UACPI_AML_OP_OnesOp:
+        *out_value = ones();
+        return 1;
+    case UACPI_AML_OP_BytePrefix:
+        size = 1;
+        break;
+    case UACPI_AML_OP_WordPrefix:
+        size = 2;
+        break;
+    case UACPI_AML_OP_DWordPrefix:
+        size = 4;
+        break;
+    case UACPI_AML_OP_QWordPrefix:
+        size = 8;
+        break;
+    default:
+        return 0;
+    }
+
+    if (uacpi_unlikely((end - offset) < (1 + size)))
+        return 0;
+
+    uacpi_memcpy_zerout(&value, &code[offset + 1], sizeof(value), size);
+    *out_value = value;
+    return 1 + size;
+}
+
+static uacpi_u32 scan_constant_element(
+    const uacpi_u8 *code, uacpi_u32 offset, uacpi_u32 end, uacpi_u8 depth
+)
+{
+    uacpi_u32 size, pkglen, marker_length, cursor, elem_end;
+    uacpi_u64 value;
+
+    if (uacpi_unlikely(offset >= end))
+        return 0;
+
+    size = scan_integer_constant(code, offset, end, &value);
+    if (size != 0)
+        return size;
+
+    switch (code[offset]) {
+    case UACPI_AML_OP_StringPrefix: {
+        uacpi_size length;
+
+        cursor = offset + 1;
+        length = uacpi_strnlen((const uacpi_char*)&code[cursor], end - cursor);
+
+        if (uacpi_unlikely(length == (end - cursor) ||
+                           code[cursor + length] != 0x00))
+            return 0;
+
+        return 2 + length;
+    }
+    case UACPI_AML_OP_BufferOp: {
+        uacpi_u32 init_size;
+
+        marker_length = decode_pkglen_raw(code, offset + 1, end, &pkglen);
+        if (marker_length == 0)
+            return 0;
+
+        elem_end = offset + 1 + pkglen;
+        cursor = offset + 1 + marker_length;
+
+        size = scan_integer_constant(code, cursor, elem_end, &value);
+        if (size == 0)
+            return 0;
+        cursor += size;
+
+        // Mirror the sanity checking done by handle_buffer
+        if (uacpi_unlikely(value == 0 || value > 0xE0000000))
+            return 0;
+
+        init_size = elem_end - cursor;
+        if (uacpi_unlikely(init_size > value))
+            return 0;
+
+        return elem_end - offset;
+    }
+    case UACPI_AML_OP_PackageOp: {
+        uacpi_u32 num_defined = 0;
+        uacpi_u8 num_elements;
+
+        if (depth == 0)
+            return 0;
+
+        marker_length = decode_pkglen_raw(code, offset + 1, end, &pkglen);
+        if (marker_length == 0)
+            return 0;
+
+        elem_end = offset + 1 + pkglen;
+        cursor = offset + 1 + marker_length;
+
+        if (uacpi_unlikely(cursor >= elem_end))
+            return 0;
+        num_elements = code[cursor++];
+
+        while (cursor < elem_end) {
+            size = scan_constant_element(code, cursor, elem_end, depth - 1);
+            if (size == 0)
+                return 0;
+
+            cursor += size;
+            num_defined++;
+        }
+
+        // The eager path warns & truncates here, don't bother
+        if (uacpi_unlikely(num_defined > num_elements))
+            return 0;
+
+        return elem_end - offset;
+    }
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Decode the constant element at *offset into 'obj' (an uninitialized object
+ * that is filled in place). The encoding has already been validated by
+ * scan_constant_element, so the only possible failure here is OOM.
+ */
+static uacpi_status materialize_constant_element(
+    const uacpi_u8 *code, uacpi_u32 *offset, uacpi_u32 end,
+    uacpi_u32 table_idx, uacpi_object *obj
+)
+{
+    uacpi_status ret;
+    uacpi_u32 size, pkglen, marker_length, cursor, elem_end;
+    uacpi_u64 value;
+    uacpi_object *tmp;
+
+    size = scan_integer_constant(code, *offset, end, &value);
+    if (size != 0) {
+        obj->type = UACPI_OBJECT_INTEGER;
+        obj->integer = value;
+        *offset += size;
+        return UACPI_STATUS_OK;
+    }
+
+    switch (code[*offset]) {
+    case UACPI_AML_OP_StringPrefix: {
+        uacpi_size length;
+
+        cursor = *offset + 1;
+        length = uacpi_strnlen(
+            (const uacpi_char*)&code[cursor], end - cursor
+        ) + 1;
+
+        tmp = uacpi_create_object(UACPI_OBJECT_STRING);
+        if (uacpi_unlikely(tmp == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        tmp->buffer->text = uacpi_kernel_alloc(length);
+        if (uacpi_unlikely(tmp->buffer->text == UACPI_NULL)) {
+            uacpi_object_unref(tmp);
+            return UACPI_STATUS_OUT_OF_MEMORY;
+        }
+
+        uacpi_memcpy(tmp->buffer->text, &code[cursor], length);
+        tmp->buffer->size = length;
+
+        *offset = cursor + length;
+        break;
+    }
+    case UACPI_AML_OP_BufferOp: {
+        uacpi_u32 init_size;
+
+        marker_length = decode_pkglen_raw(code, *offset + 1, end, &pkglen);
+        elem_end = *offset + 1 + pkglen;
+        cursor = *offset + 1 + marker_length;
+
+        cursor += scan_integer_constant(code, cursor, elem_end, &value);
+        init_size = elem_end - cursor;
+
+        tmp = uacpi_create_object(UACPI_OBJECT_BUFFER);
+        if (uacpi_unlikely(tmp == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        // Same zero-copy criteria as handle_buffer
+        if (init_size == value && value >= ZERO_COPY_BUFFER_MIN_SIZE) {
+            uacpi_table tbl = { 0 };
+
+            tbl.index = table_idx;
+
+            if (uacpi_table_ref(&tbl) == UACPI_STATUS_OK) {
+                tmp->buffer->data = (void*)&code[cursor];
+                tmp->buffer->size = value;
+                tmp->buffer->aliases_table = UACPI_TRUE;
+                tmp->buffer->aliased_table_idx = tbl.index;
+
+                *offset = elem_end;
+                break;
+            }
+        }
+
+        tmp->buffer->data = uacpi_kernel_alloc(value);
+        if (uacpi_unlikely(tmp->buffer->data == UACPI_NULL)) {
+            uacpi_object_unref(tmp);
+            return UACPI_STATUS_OUT_OF_MEMORY;
+        }
+        tmp->buffer->size = value;
+
+        uacpi_memcpy_zerout(
+            tmp->buffer->data, &code[cursor], value, init_size
+        );
+
+        *offset = elem_end;
+        break;
+    }
+    case UACPI_AML_OP_PackageOp: {
+        uacpi_size i;
+        uacpi_u8 num_elements;
+
+        marker_length = decode_pkglen_raw(code, *offset + 1, end, &pkglen);
+        elem_end = *offset + 1 + pkglen;
+        cursor = *offset + 1 + marker_length;
+
+        num_elements = code[cursor++];
+
+        tmp = uacpi_create_object(UACPI_OBJECT_PACKAGE);
+        if (uacpi_unlikely(tmp == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        if (uacpi_unlikely(!uacpi_package_fill(tmp->package, num_elements,
+                                               UACPI_PREALLOC_OBJECTS_YES))) {
+            uacpi_object_unref(tmp);
+            return UACPI_STATUS_OUT_OF_MEMORY;
+        }
+
+        for (i = 0; cursor < elem_end; ++i) {
+            ret = materialize_constant_element(
+                code, &cursor, elem_end, table_idx, tmp->package->objects[i]
+            );
+            if (uacpi_unlikely_error(ret)) {
+                uacpi_object_unref(tmp);
+                return ret;
+            }
+        }
+
+        *offset = elem_end;
+        break;
+    }
+    default:
+        return UACPI_STATUS_INTERNAL_ERROR;
+    }
+
+    ret = uacpi_object_assign(obj, tmp, UACPI_ASSIGN_BEHAVIOR_SHALLOW_COPY);
+    uacpi_object_unref(tmp);
+    return ret;
+}
+
+uacpi_status uacpi_package_materialize_element(
+    uacpi_package *pkg, uacpi_size idx
+)
+{
+    struct uacpi_deferred_package_data *deferred = pkg->deferred;
+    uacpi_status ret;
+    uacpi_u32 offset;
+
+    if (deferred == UACPI_NULL || idx >= pkg->count ||
+        deferred->elements[idx].size == 0)
+        return UACPI_STATUS_OK;
+
+    offset = deferred->elements[idx].offset;
+    ret = materialize_constant_element(
+        deferred->code, &offset, offset + deferred->elements[idx].size,
+        deferred->table_idx, pkg->objects[idx]
+    );
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    deferred->elements[idx].size = 0;
+    if (--deferred->pending == 0)
+        uacpi_package_release_deferred(pkg);
+
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_package_materialize(uacpi_package *pkg)
+{
+    uacpi_status ret;
+    uacpi_size i;
+
+    if (uacpi_likely(pkg->deferred == UACPI_NULL))
+        return UACPI_STATUS_OK;
+
+    for (i = 0; i < pkg->count; ++i) {
+        ret = uacpi_package_materialize_element(pkg, i);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
 static uacpi_status method_get_ret_target(struct execution_context *ctx,
                                           uacpi_object **out_operand)
 {
@@ -1963,19 +2639,37 @@ static uacpi_status begin_block_execution(struct execution_context *ctx)
         block->type = CODE_BLOCK_WHILE;
 
         if (pkg->begin == cur_frame->prev_while_code_offset) {
-            uacpi_u64 cur_ticks;
-
-            cur_ticks = uacpi_kernel_get_nanoseconds_since_boot();
+            block->expiration_point = cur_frame->prev_while_expiration;
 
-            if (uacpi_unlikely(cur_ticks > block->expiration_point)) {
-                uacpi_error("loop time out after running for %u seconds\n",
-                            g_uacpi_rt_ctx.loop_timeout_seconds);
-                code_block_array_pop(&cur_frame->code_blocks);
-                return UACPI_STATUS_AML_LOOP_TIMEOUT;
+            /*
+             * Only consult the host clock once per batch of iterations, as
+             * reading it dominates the per-iteration overhead of tight
+             * busy-poll loops. The timeout is specified in seconds, so the
+             * coarser granularity is not observable.
+             *
+             * A loop body that blocked (Sleep, Stall, Acquire, Wait) is the
+             * exception: each iteration may take arbitrary wall time, so
+             * batching would overshoot the timeout by an unbounded amount.
+             * Always consult the clock on the back-edge after one of those.
+             */
+            if ((++cur_frame->while_iteration_counter %
+                 WHILE_TIMEOUT_CHECK_INTERVAL) == 0 ||
+                ctx->blocked_since_timeout_check) {
+                uacpi_u64 cur_ticks;
+
+                ctx->blocked_since_timeout_check = UACPI_FALSE;
+                cur_ticks = uacpi_kernel_get_nanoseconds_since_boot();
+
+                if (uacpi_unlikely(cur_ticks > block->expiration_point)) {
+                    uacpi_error("loop time out after running for %u seconds\n",
+                                g_uacpi_rt_ctx.loop_timeout_seconds);
+                    code_block_array_pop(&cur_frame->code_blocks);
+                    return UACPI_STATUS_AML_LOOP_TIMEOUT;
+                }
             }
-
-            block->expiration_point = cur_frame->prev_while_expiration;
         } else {
+            cur_frame->while_iteration_counter = 0;
+
             /*
              * Calculate the expiration point for this loop.
              * If a loop is executed past this point, it will get aborted.
@@ -2132,9 +2826,14 @@ static uacpi_status debug_store(uacpi_object *src)
     debug_store_no_recurse("[AML DEBUG]", src);
 
     if (src->type == UACPI_OBJECT_PACKAGE) {
+        uacpi_status ret;
         uacpi_package *pkg = src->package;
         uacpi_size i;
 
+        ret = uacpi_package_materialize(pkg);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
         for (i = 0; i < pkg->count; ++i) {
             uacpi_object *obj = pkg->objects[i];
             if (obj->type == UACPI_OBJECT_REFERENCE &&
@@ -2247,8 +2946,7 @@ static void object_replace_child(uacpi_object *parent, uacpi_object *new_child)
     if (uacpi_unlikely(new_obj == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
-    ret = uacpi_object_assign(new_obj, src_obj,
-                              UACPI_ASSIGN_BEHAVIOR_DEEP_COPY);
+    ret = object_assign_or_move(new_obj, src_obj);
     if (uacpi_unlikely_error(ret))
         return ret;
 
@@ -2312,8 +3010,7 @@ static uacpi_status store_to_reference(uacpi_object *dst,
         if (uacpi_unlikely(new_obj == UACPI_NULL))
             return UACPI_STATUS_OUT_OF_MEMORY;
 
-        ret = uacpi_object_assign(new_obj, src_obj,
-                                  UACPI_ASSIGN_BEHAVIOR_DEEP_COPY);
+        ret = object_assign_or_move(new_obj, src_obj);
         if (uacpi_unlikely_error(ret)) {
             uacpi_object_unref(new_obj);
             return ret;
@@ -2384,79 +3081,102 @@ static uacpi_status handle_ref_or_deref_of(struct execution_context *ctx)
     return UACPI_STATUS_OK;
 }
 
+/*
+ * Tables with a revision below 2 mandate 32-bit integer arithmetic. Generate
+ * a width-specialized copy of the math core for each mode so that revision 1
+ * firmware does all of its arithmetic on native 32-bit integers, where the
+ * shift/multiply/divide ops don't have to be emulated on 32-bit hosts and
+ * results never need a truncation fixup.
+ */
+#define DO_BINARY_MATH_IMPL(width)                                         \
+    static uacpi_status do_binary_math##width(                             \
+        uacpi_object *arg0, uacpi_object *arg1,                            \
+        uacpi_object *tgt0, uacpi_object *tgt1,                            \
+        uacpi_aml_op op                                                    \
+    )                                                                      \
+    {                                                                      \
+        uacpi_u##width lhs, rhs, res;                                      \
+        uacpi_bool should_negate = UACPI_FALSE;                            \
+                                                                           \
+        lhs = arg0->integer;                                               \
+        rhs = arg1->integer;                                               \
+                                                                           \
+        switch (op)                                                        \
+        {                                                                  \
+        case UACPI_AML_OP_AddOp:                                           \
+            res = lhs + rhs;                                               \
+            break;                                                         \
+        case UACPI_AML_OP_SubtractOp:                                      \
+            res = lhs - rhs;                                               \
+            break;                                                         \
+        case UACPI_AML_OP_MultiplyOp:                                      \
+            res = lhs * rhs;                                               \
+            break;                                                         \
+        case UACPI_AML_OP_ShiftLeftOp:                                     \
+        case UACPI_AML_OP_ShiftRightOp:                                    \
+            if (rhs <= (width - 1)) {                                      \
+                if (op == UACPI_AML_OP_ShiftLeftOp)                        \
+                    res = lhs << rhs;                                      \
+                else                                                       \
+                    res = lhs >> rhs;                                      \
+            } else {                                                       \
+                res = 0;                                                   \
+            }                                                              \
+            break;                                                         \
+        case UACPI_AML_OP_NandOp:                                          \
+            should_negate = UACPI_TRUE;                                    \
+            UACPI_FALLTHROUGH;                                             \
+        case UACPI_AML_OP_AndOp:                                           \
+            res = rhs & lhs;                                               \
+            break;                                                         \
+        case UACPI_AML_OP_NorOp:                                           \
+            should_negate = UACPI_TRUE;                                    \
+            UACPI_FALLTHROUGH;                                             \
+        case UACPI_AML_OP_OrOp:                                            \
+            res = rhs | lhs;                                               \
+            break;                                                         \
+        case UACPI_AML_OP_XorOp:                                           \
+            res = rhs ^ lhs;                                               \
+            break;                                                         \
+        case UACPI_AML_OP_DivideOp:                                        \
+            if (uacpi_unlikely(rhs == 0)) {                                \
+                uacpi_error("attempted to divide by zero\n");              \
+                return UACPI_STATUS_AML_BAD_ENCODING;                      \
+            }                                                              \
+            tgt1->integer = lhs / rhs;                                     \
+            res = lhs % rhs;                                               \
+            break;                                                         \
+        case UACPI_AML_OP_ModOp:                                           \
+            if (uacpi_unlikely(rhs == 0)) {                                \
+                uacpi_error("attempted to calculate modulo of zero\n");    \
+                return UACPI_STATUS_AML_BAD_ENCODING;                      \
+            }                                                              \
+            res = lhs % rhs;                                               \
+            break;                                                         \
+        default:                                                           \
+            return UACPI_STATUS_INVALID_ARGUMENT;                          \
+        }                                                                  \
+                                                                           \
+        if (should_negate)                                                 \
+            res = ~res;                                                    \
+                                                                           \
+        tgt0->integer = res;                                               \
+        return UACPI_STATUS_OK;                                            \
+    }
+
+DO_BINARY_MATH_IMPL(32)
+DO_BINARY_MATH_IMPL(64)
+
 static uacpi_status do_binary_math(
     uacpi_object *arg0, uacpi_object *arg1,
     uacpi_object *tgt0, uacpi_object *tgt1,
     uacpi_aml_op op
 )
 {
-    uacpi_u64 lhs, rhs, res;
-    uacpi_bool should_negate = UACPI_FALSE;
+    if (g_uacpi_rt_ctx.is_rev1)
+        return do_binary_math32(arg0, arg1, tgt0, tgt1, op);
 
-    lhs = arg0->integer;
-    rhs = arg1->integer;
-
-    switch (op)
-    {
-    case UACPI_AML_OP_AddOp:
-        res = lhs + rhs;
-        break;
-    case UACPI_AML_OP_SubtractOp:
-        res = lhs - rhs;
-        break;
-    case UACPI_AML_OP_MultiplyOp:
-        res = lhs * rhs;
-        break;
-    case UACPI_AML_OP_ShiftLeftOp:
-    case UACPI_AML_OP_ShiftRightOp:
-        if (rhs <= (g_uacpi_rt_ctx.is_rev1 ? 31 : 63)) {
-            if (op == UACPI_AML_OP_ShiftLeftOp)
-                res = lhs << rhs;
-            else
-                res = lhs >> rhs;
-        } else {
-            res = 0;
-        }
-        break;
-    case UACPI_AML_OP_NandOp:
-        should_negate = UACPI_TRUE;
-        UACPI_FALLTHROUGH;
-    case UACPI_AML_OP_AndOp:
-        res = rhs & lhs;
-        break;
-    case UACPI_AML_OP_NorOp:
-        should_negate = UACPI_TRUE;
-        UACPI_FALLTHROUGH;
-    case UACPI_AML_OP_OrOp:
-        res = rhs | lhs;
-        break;
-    case UACPI_AML_OP_XorOp:
-        res = rhs ^ lhs;
-        break;
-    case UACPI_AML_OP_DivideOp:
-        if (uacpi_unlikely(rhs == 0)) {
-            uacpi_error("attempted to divide by zero\n");
-            return UACPI_STATUS_AML_BAD_ENCODING;
-        }
-        tgt1->integer = lhs / rhs;
-        res = lhs % rhs;
-        break;
-    case UACPI_AML_OP_ModOp:
-        if (uacpi_unlikely(rhs == 0)) {
-            uacpi_error("attempted to calculate modulo of zero\n");
-            return UACPI_STATUS_AML_BAD_ENCODING;
-        }
-        res = lhs % rhs;
-        break;
-    default:
-        return UACPI_STATUS_INVALID_ARGUMENT;
-    }
-
-    if (should_negate)
-        res = ~res;
-
-    tgt0->integer = res;
-    return UACPI_STATUS_OK;
+    return do_binary_math64(arg0, arg1, tgt0, tgt1, op);
 }
 
 static uacpi_status handle_binary_math(struct execution_context *ctx)
@@ -2562,6 +3282,10 @@ static uacpi_status handle_index(struct execution_context *ctx)
         if (uacpi_unlikely_error(ret))
             return ret;
 
+        ret = uacpi_package_materialize_element(pkg, idx);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
         /*
          * Lazily transform the package element into an internal reference
          * to itself of type PKG_INDEX. This is needed to support stuff like
@@ -2636,17 +3360,11 @@ static uacpi_status integer_to_string(
     uacpi_u64 integer, uacpi_buffer *str, uacpi_bool is_hex
 )
 {
-    int repr_len;
-    uacpi_char int_buf[21];
-    uacpi_size final_size;
+    uacpi_char int_buf[20];
+    uacpi_size repr_len, final_size;
 
-    repr_len = uacpi_snprintf(
-        int_buf, sizeof(int_buf),
-        is_hex ? "%"UACPI_PRIX64 : "%"UACPI_PRIu64,
-        UACPI_FMT64(integer)
-    );
-    if (uacpi_unlikely(repr_len < 0))
-        return UACPI_STATUS_INVALID_ARGUMENT;
+    repr_len = is_hex ? uacpi_u64_to_hex_string(integer, int_buf, UACPI_TRUE) :
+                        uacpi_u64_to_dec_string(integer, int_buf);
 
     // 0x prefix + repr + \0
     final_size = (is_hex ? 2 : 0) + repr_len + 1;
@@ -2659,7 +3377,8 @@ static uacpi_status integer_to_string(
         str->text[0] = '0';
         str->text[1] = 'x';
     }
-    uacpi_memcpy(str->text + (is_hex ? 2 : 0), int_buf, repr_len + 1);
+    uacpi_memcpy(str->text + (is_hex ? 2 : 0), int_buf, repr_len);
+    str->text[final_size - 1] = '\0';
     str->size = final_size;
 
     return UACPI_STATUS_OK;
@@ -2669,8 +3388,6 @@ static uacpi_status buffer_to_string(
     uacpi_buffer *buf, uacpi_buffer *str, uacpi_bool is_hex
 )
 {
-    int repr_len;
-    uacpi_char int_buf[5];
     uacpi_size i, final_size;
     uacpi_char *cursor;
 
@@ -2704,24 +3421,23 @@ static uacpi_status buffer_to_string(
     cursor = str->data;
 
     for (i = 0; i < buf->size; ++i) {
-        repr_len = uacpi_snprintf(
-            int_buf, sizeof(int_buf),
-            is_hex ? "0x%02X" : "%d",
-            ((uacpi_u8*)buf->data)[i]
-        );
-        if (uacpi_unlikely(repr_len < 0)) {
-            uacpi_free(str->data, final_size);
-            str->data = UACPI_NULL;
-            return UACPI_STATUS_INVALID_ARGUMENT;
+        uacpi_u8 value = ((uacpi_u8*)buf->data)[i];
+
+        if (is_hex) {
+            cursor[0] = '0';
+            cursor[1] = 'x';
+            cursor[2] = uacpi_hex_chars[value >> 4];
+            cursor[3] = uacpi_hex_chars[value & 0xF];
+            cursor += 4;
+        } else {
+            cursor += uacpi_u64_to_dec_string(value, cursor);
         }
 
-        uacpi_memcpy(cursor, int_buf, repr_len + 1);
-        cursor += repr_len;
-
         if (i != buf->size - 1)
             *cursor++ = ',';
     }
 
+    *cursor = '\0';
     str->size = final_size;
     return UACPI_STATUS_OK;
 }
@@ -2947,11 +3663,10 @@ static uacpi_status handle_concatenate(struct execution_context *ctx)
 
         switch (arg1->type) {
         case UACPI_OBJECT_INTEGER: {
-            int size;
-            size = uacpi_snprintf(int_buf, sizeof(int_buf), "%"UACPI_PRIx64,
-                                  UACPI_FMT64(arg1->integer));
-            if (size < 0)
-                return UACPI_STATUS_INVALID_ARGUMENT;
+            uacpi_size size;
+
+            size = uacpi_u64_to_hex_string(arg1->integer, int_buf, UACPI_FALSE);
+            int_buf[size] = '\0';
 
             arg1_ptr = int_buf;
             arg1_size = size + 1;
@@ -3121,6 +3836,7 @@ static uacpi_status handle_stall_or_sleep(struct execution_context *ctx)
     uacpi_u64 time;
 
     time = item_array_at(&op_ctx->items, 0)->obj->integer;
+    ctx->blocked_since_timeout_check = UACPI_TRUE;
 
     if (op_ctx->op->code == UACPI_AML_OP_SleepOp) {
         /*
@@ -3130,6 +3846,25 @@ static uacpi_status handle_stall_or_sleep(struct execution_context *ctx)
         if (time > 2000)
             time = 2000;
 
+        if (ctx->suspendable) {
+            uacpi_u64 now = uacpi_kernel_get_nanoseconds_since_boot();
+
+            if (ctx->suspend_reason == SUSPEND_REASON_NONE) {
+                ctx->suspend_reason = SUSPEND_REASON_SLEEP;
+                ctx->wake_deadline_ns =
+                    now + time * (UACPI_NANOSECONDS_PER_SEC / 1000);
+                return UACPI_STATUS_SUSPENDED;
+            }
+
+            // Resumed before the deadline, go back to sleep
+            if (now < ctx->wake_deadline_ns)
+                return UACPI_STATUS_SUSPENDED;
+
+            ctx->suspend_reason = SUSPEND_REASON_NONE;
+            ctx->wake_deadline_ns = 0;
+            return UACPI_STATUS_OK;
+        }
+
         uacpi_namespace_write_unlock();
         uacpi_kernel_sleep(time);
         uacpi_namespace_write_lock();
@@ -3328,12 +4063,17 @@ static uacpi_bool match_one(enum match_op op, uacpi_u64 lhs, uacpi_u64 rhs)
 static uacpi_status handle_match(struct execution_context *ctx)
 {
     struct op_context *op_ctx = ctx->cur_op_ctx;
+    uacpi_status ret;
     uacpi_package *pkg;
     uacpi_u64 operand0, operand1, start_idx, i;
     enum match_op mop0, mop1;
     uacpi_object *dst;
 
     pkg = item_array_at(&op_ctx->items, 0)->obj->package;
+
+    ret = uacpi_package_materialize(pkg);
+    if (uacpi_unlikely_error(ret))
+        return ret;
     mop0 = item_array_at(&op_ctx->items, 1)->immediate;
     operand0 = item_array_at(&op_ctx->items, 2)->obj->integer;
     mop1 = item_array_at(&op_ctx->items, 3)->immediate;
@@ -3375,8 +4115,19 @@ static uacpi_status parse_package_length(struct call_frame *frame,
 {
     uacpi_u32 left, size;
     uacpi_u8 *data, marker_length;
+    struct method_decode_cache_entry *entry;
 
     out_pkg->begin = frame->code_offset;
+
+    entry = method_decode_cache_lookup(
+        frame->method, out_pkg->begin, DECODE_CACHE_ENTRY_PKGLEN
+    );
+    if (entry != UACPI_NULL) {
+        out_pkg->end = entry->pkg_end;
+        frame->code_offset += entry->encoded_length;
+        return UACPI_STATUS_OK;
+    }
+
     marker_length = 1;
 
     left = call_frame_code_bytes_left(frame);
@@ -3417,6 +4168,14 @@ static uacpi_status parse_package_length(struct call_frame *frame,
         return UACPI_STATUS_AML_BAD_ENCODING;
     }
 
+    entry = method_decode_cache_entry_for_store(frame->method, out_pkg->begin);
+    if (entry != UACPI_NULL) {
+        entry->kind = DECODE_CACHE_ENTRY_PKGLEN;
+        entry->offset = out_pkg->begin;
+        entry->encoded_length = marker_length;
+        entry->pkg_end = out_pkg->end;
+    }
+
     return UACPI_STATUS_OK;
 }
 
@@ -3527,7 +4286,8 @@ static uacpi_status handle_event_ctl(struct execution_context *ctx)
     if (uacpi_unlikely(obj->type != UACPI_OBJECT_EVENT)) {
         uacpi_error(
             "%s: invalid argument '%s', expected an Event object\n",
-            op_ctx->op->name, uacpi_object_type_to_string(obj->type)
+            uacpi_op_spec_name(op_ctx->op),
+            uacpi_object_type_to_string(obj->type)
         );
         return UACPI_STATUS_AML_INCOMPATIBLE_OBJECT_TYPE;
     }
@@ -3548,6 +4308,8 @@ static uacpi_status handle_event_ctl(struct execution_context *ctx)
         if (timeout > 0xFFFF)
             timeout = 0xFFFF;
 
+        ctx->blocked_since_timeout_check = UACPI_TRUE;
+
         uacpi_namespace_write_unlock();
         ret = uacpi_kernel_wait_for_event(obj->event->handle, timeout);
         uacpi_namespace_write_lock();
@@ -3578,7 +4340,8 @@ static uacpi_status handle_mutex_ctl(struct execution_context *ctx)
     if (uacpi_unlikely(obj->type != UACPI_OBJECT_MUTEX)) {
         uacpi_error(
             "%s: invalid argument '%s', expected a Mutex object\n",
-            op_ctx->op->name, uacpi_object_type_to_string(obj->type)
+            uacpi_op_spec_name(op_ctx->op),
+            uacpi_object_type_to_string(obj->type)
         );
         return UACPI_STATUS_AML_INCOMPATIBLE_OBJECT_TYPE;
     }
@@ -3605,6 +4368,8 @@ static uacpi_status handle_mutex_ctl(struct execution_context *ctx)
         if (timeout > 0xFFFF)
             timeout = 0xFFFF;
 
+        ctx->blocked_since_timeout_check = UACPI_TRUE;
+
         if (uacpi_this_thread_owns_aml_mutex(obj->mutex)) {
             ret = uacpi_acquire_aml_mutex(obj->mutex, timeout);
             if (uacpi_likely_success(ret))
@@ -3612,9 +4377,39 @@ static uacpi_status handle_mutex_ctl(struct execution_context *ctx)
             break;
         }
 
-        ret = uacpi_acquire_aml_mutex(obj->mutex, timeout);
-        if (uacpi_unlikely_error(ret))
-            break;
+        if (ctx->suspendable) {
+            ret = uacpi_acquire_aml_mutex(obj->mutex, 0);
+            if (uacpi_unlikely_error(ret)) {
+                uacpi_u64 now = uacpi_kernel_get_nanoseconds_since_boot();
+
+                if (ctx->suspend_reason == SUSPEND_REASON_NONE) {
+                    // Contended, park us instead of blocking this thread
+                    if (timeout == 0)
+                        break;
+
+                    ctx->suspend_reason = SUSPEND_REASON_ACQUIRE;
+                    ctx->wake_deadline_ns = timeout == 0xFFFF ?
+                        0 : now + timeout * (UACPI_NANOSECONDS_PER_SEC / 1000);
+                    return UACPI_STATUS_SUSPENDED;
+                }
+
+                // Resumed, but the mutex is still unavailable
+                if (ctx->wake_deadline_ns == 0 || now < ctx->wake_deadline_ns)
+                    return UACPI_STATUS_SUSPENDED;
+
+                // Waited for the entire timeout, give up
+                ctx->suspend_reason = SUSPEND_REASON_NONE;
+                ctx->wake_deadline_ns = 0;
+                break;
+            }
+
+            ctx->suspend_reason = SUSPEND_REASON_NONE;
+            ctx->wake_deadline_ns = 0;
+        } else {
+            ret = uacpi_acquire_aml_mutex(obj->mutex, timeout);
+            if (uacpi_unlikely_error(ret))
+                break;
+        }
 
         ret = held_mutexes_array_push(&ctx->held_mutexes, obj->mutex);
         if (uacpi_unlikely_error(ret)) {
@@ -4026,14 +4821,11 @@ static uacpi_status handle_return(struct execution_context *ctx)
         return UACPI_STATUS_OK;
 
     /*
-     * Should be possible to move here if method returns a literal
-     * like Return(Buffer { ... }), otherwise we have to copy just to
-     * be safe.
+     * Moves here if the method returns a last-reference literal like
+     * Return(Buffer { ... }), otherwise we have to copy just to be safe.
      */
-    return uacpi_object_assign(
-        dst,
-        item_array_at(&ctx->cur_op_ctx->items, 0)->obj,
-        UACPI_ASSIGN_BEHAVIOR_DEEP_COPY
+    return object_assign_or_move(
+        dst, item_array_at(&ctx->cur_op_ctx->items, 0)->obj
     );
 }
 
@@ -4076,7 +4868,7 @@ static inline void trace_op(
 {
     uacpi_debug(
         "%s OP '%s' (0x%04X)\n",
-        op_trace_action_types[action], op->name, op->code
+        op_trace_action_types[action], uacpi_op_spec_name(op), op->code
     );
 }
 
@@ -4143,6 +4935,9 @@ static uacpi_status push_new_frame(struct execution_context *ctx,
     if (uacpi_unlikely(*out_frame == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
+    (*out_frame)->pending_ops.arena = &ctx->arena;
+    (*out_frame)->temp_nodes.arena = &ctx->arena;
+
     /*
      * Allocating a new frame might have reallocated the dynamic buffer so our
      * execution_context members might now be pointing to freed memory.
@@ -4352,12 +5147,96 @@ static uacpi_status push_op(struct execution_context *ctx)
     if (op_ctx == UACPI_NULL)
         return UACPI_STATUS_OUT_OF_MEMORY;
 
+    op_ctx->items.arena = &ctx->arena;
     op_ctx->op = ctx->cur_op;
     refresh_ctx_pointers(ctx);
     return UACPI_STATUS_OK;
 }
 
-static uacpi_bool pop_item(struct op_context *op_ctx)
+#define OBJECT_CACHE_MAX_DEPTH 16
+
+/*
+ * Most intermediate results are plain integers (or typeless objects that are
+ * about to become integers), which carry no out-of-line storage and don't
+ * need any constructor/destructor work. Those are the only kinds we recycle,
+ * everything else goes through the regular object machinery.
+ */
+static uacpi_bool object_is_cacheable(uacpi_object *obj)
+{
+    if (uacpi_shareable_refcount(obj) != 1)
+        return UACPI_FALSE;
+
+    switch (obj->type) {
+    case UACPI_OBJECT_UNINITIALIZED:
+    case UACPI_OBJECT_INTEGER:
+        return UACPI_TRUE;
+    default:
+        return UACPI_FALSE;
+    }
+}
+
+static void cache_or_unref_object(
+    struct execution_context *ctx, uacpi_object *obj
+)
+{
+    if (ctx->object_cache_depth < OBJECT_CACHE_MAX_DEPTH &&
+        object_is_cacheable(obj)) {
+        obj->type = UACPI_OBJECT_UNINITIALIZED;
+        obj->inner_object = ctx->object_cache;
+        ctx->object_cache = obj;
+        ctx->object_cache_depth++;
+        return;
+    }
+
+    uacpi_object_unref(obj);
+}
+
+static uacpi_object *alloc_item_object(
+    struct execution_context *ctx, enum uacpi_object_type type
+)
+{
+    uacpi_object *obj;
+
+    switch (type) {
+    case UACPI_OBJECT_UNINITIALIZED:
+    case UACPI_OBJECT_INTEGER:
+        obj = ctx->object_cache;
+        if (obj == UACPI_NULL)
+            break;
+
+        ctx->object_cache = obj->inner_object;
+        ctx->object_cache_depth--;
+
+        uacpi_memzero(obj, sizeof(*obj));
+        uacpi_shareable_init(obj);
+        obj->type = type;
+        return obj;
+    default:
+        break;
+    }
+
+    return uacpi_create_object(type);
+}
+
+static void drain_object_cache(struct execution_context *ctx)
+{
+    uacpi_object *obj, *next_obj;
+
+    obj = ctx->object_cache;
+    while (obj != UACPI_NULL) {
+        next_obj = obj->inner_object;
+        obj->inner_object = UACPI_NULL;
+        uacpi_object_unref(obj);
+        obj = next_obj;
+    }
+
+    ctx->object_cache = UACPI_NULL;
+    ctx->object_cache_depth = 0;
+}
+
+static uacpi_bool pop_item(
+    struct execution_context *ctx, struct op_context *op_ctx
+)
 {
     struct item *item;
 
@@ -4367,7 +5246,7 @@ static uacpi_bool pop_item(struct op_context *op_ctx)
     item = item_array_last(&op_ctx->items);
 
     if (item->type == ITEM_OBJECT)
-        uacpi_object_unref(item->obj);
+        cache_or_unref_object(ctx, item->obj);
 
     if (item->type == ITEM_NAMESPACE_NODE)
         uacpi_namespace_node_unref(item->node);
@@ -4381,7 +5260,7 @@ static void pop_op(struct execution_context *ctx)
     struct call_frame *frame = ctx->cur_frame;
     struct op_context *cur_op_ctx = ctx->cur_op_ctx;
 
-    while (pop_item(cur_op_ctx));
+    while (pop_item(ctx, cur_op_ctx));
 
     item_array_clear(&cur_op_ctx->items);
     op_context_array_pop(&frame->pending_ops);
@@ -4394,12 +5273,31 @@ static void call_frame_clear(struct call_frame *frame)
     op_context_array_clear(&frame->pending_ops);
     code_block_array_clear(&frame->code_blocks);
 
-    while (temp_namespace_node_array_size(&frame->temp_nodes) != 0) {
-        uacpi_namespace_node *node;
+    {
+        uacpi_size count, inline_cap;
+
+        count = temp_namespace_node_array_size(&frame->temp_nodes);
+        inline_cap = temp_namespace_node_array_inline_capacity(
+            &frame->temp_nodes
+        );
 
-        node = *temp_namespace_node_array_last(&frame->temp_nodes);
-        uacpi_namespace_node_uninstall(node);
-        temp_namespace_node_array_pop(&frame->temp_nodes);
+        /*
+         * The array storage is split between the inline part and the arena
+         * spillover, uninstall one contiguous chunk at a time, newest nodes
+         * (the spillover) first.
+         */
+        if (count > inline_cap) {
+            uacpi_namespace_node_uninstall_bulk(
+                temp_namespace_node_array_at(&frame->temp_nodes, inline_cap),
+                count - inline_cap
+            );
+            count = inline_cap;
+        }
+        if (count != 0) {
+            uacpi_namespace_node_uninstall_bulk(
+                temp_namespace_node_array_at(&frame->temp_nodes, 0), count
+            );
+        }
     }
     temp_namespace_node_array_clear(&frame->temp_nodes);
 
@@ -4419,6 +5317,7 @@ static uacpi_u8 parse_op_generates_item[0x100] = {
     [UACPI_PARSE_OP_TERM_ARG_UNWRAP_INTERNAL] = ITEM_EMPTY_OBJECT,
     [UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT] = ITEM_EMPTY_OBJECT,
     [UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED] = ITEM_EMPTY_OBJECT,
+    [UACPI_PARSE_OP_PACKAGE_ELEMENT] = ITEM_EMPTY_OBJECT,
     [UACPI_PARSE_OP_OPERAND] = ITEM_EMPTY_OBJECT,
     [UACPI_PARSE_OP_STRING] = ITEM_EMPTY_OBJECT,
     [UACPI_PARSE_OP_COMPUTATIONAL_DATA] = ITEM_EMPTY_OBJECT,
@@ -4468,7 +5367,7 @@ static uacpi_u8 op_decode_byte(struct op_context *ctx)
 // MSVC doesn't support __VA_OPT__ so we do this weirdness
 #define EXEC_OP_DO_LVL(lvl, reason, ...)                              \
     uacpi_##lvl("Op 0x%04X ('%s'): "reason"\n",                       \
-                op_ctx->op->code, op_ctx->op->name __VA_ARGS__)
+                op_ctx->op->code, uacpi_op_spec_name(op_ctx->op) __VA_ARGS__)
 
 #define EXEC_OP_DO_ERR(reason, ...) EXEC_OP_DO_LVL(error, reason, __VA_ARGS__)
 #define EXEC_OP_DO_WARN(reason, ...) EXEC_OP_DO_LVL(warn, reason, __VA_ARGS__)
@@ -4524,6 +5423,7 @@ static uacpi_bool op_allows_unresolved(enum uacpi_parse_op op)
     switch (op) {
     case UACPI_PARSE_OP_SUPERNAME_OR_UNRESOLVED:
     case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED:
+    case UACPI_PARSE_OP_PACKAGE_ELEMENT:
     case UACPI_PARSE_OP_EXISTING_NAMESTRING_OR_NULL:
         return UACPI_TRUE;
     default:
@@ -4574,6 +5474,7 @@ static uacpi_status op_typecheck(const struct op_context *op_ctx,
     case UACPI_PARSE_OP_TERM_ARG_UNWRAP_INTERNAL:
     case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT:
     case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED:
+    case UACPI_PARSE_OP_PACKAGE_ELEMENT:
     case UACPI_PARSE_OP_OPERAND:
     case UACPI_PARSE_OP_STRING:
     case UACPI_PARSE_OP_COMPUTATIONAL_DATA:
@@ -4586,7 +5487,7 @@ static uacpi_status op_typecheck(const struct op_context *op_ctx,
 
     if (!(props & ok_mask)) {
         EXEC_OP_ERR_2("invalid argument: '%s', expected a %s",
-                      cur_op_ctx->op->name, expected_type_str);
+                      uacpi_op_spec_name(cur_op_ctx->op), expected_type_str);
         return UACPI_STATUS_AML_INCOMPATIBLE_OBJECT_TYPE;
     }
 
@@ -5057,6 +5958,25 @@ method_dispatch_error:
     return ret;
 }
 
+/*
+ * When the compiler supports labels-as-values, every parse-op case below
+ * doubles as a jump label and dispatch becomes a single indexed goto off a
+ * fully populated 256-entry table, with no bounds check or fallback branch.
+ * Otherwise this compiles down to the plain portable switch.
+ */
+#ifdef UACPI_COMPUTED_GOTO
+#define PARSE_OP_TABLE_ENTRY(parse_op) \
+    [UACPI_PARSE_OP_##parse_op] = &&parse_op_##parse_op
+#define PARSE_OP_CASE(parse_op) \
+    case UACPI_PARSE_OP_##parse_op: parse_op_##parse_op:
+#define PARSE_OP_DEFAULT_CASE default: parse_op_DEFAULT:
+#define PARSE_OP_DISPATCH(op) goto *parse_op_jump_table[op]
+#else
+#define PARSE_OP_CASE(parse_op) case UACPI_PARSE_OP_##parse_op:
+#define PARSE_OP_DEFAULT_CASE default:
+#define PARSE_OP_DISPATCH(op) ((void)0)
+#endif
+
 static uacpi_status exec_op(struct execution_context *ctx)
 {
     uacpi_status ret = UACPI_STATUS_OK;
@@ -5065,6 +5985,67 @@ static uacpi_status exec_op(struct execution_context *ctx)
     struct item *item = UACPI_NULL;
     enum uacpi_parse_op prev_op = 0, op;
 
+#ifdef UACPI_COMPUTED_GOTO
+    static const void *const parse_op_jump_table[256] = {
+        PARSE_OP_TABLE_ENTRY(END),
+        PARSE_OP_TABLE_ENTRY(SKIP_WITH_WARN_IF_NULL),
+        PARSE_OP_TABLE_ENTRY(SIMPLE_NAME),
+        PARSE_OP_TABLE_ENTRY(SUPERNAME),
+        PARSE_OP_TABLE_ENTRY(SUPERNAME_OR_UNRESOLVED),
+        PARSE_OP_TABLE_ENTRY(TERM_ARG),
+        PARSE_OP_TABLE_ENTRY(TERM_ARG_UNWRAP_INTERNAL),
+        PARSE_OP_TABLE_ENTRY(TERM_ARG_OR_NAMED_OBJECT),
+        PARSE_OP_TABLE_ENTRY(TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED),
+        PARSE_OP_TABLE_ENTRY(PACKAGE_ELEMENT),
+        PARSE_OP_TABLE_ENTRY(OPERAND),
+        PARSE_OP_TABLE_ENTRY(STRING),
+        PARSE_OP_TABLE_ENTRY(COMPUTATIONAL_DATA),
+        PARSE_OP_TABLE_ENTRY(TARGET),
+        PARSE_OP_TABLE_ENTRY(PKGLEN),
+        PARSE_OP_TABLE_ENTRY(TRACKED_PKGLEN),
+        PARSE_OP_TABLE_ENTRY(CREATE_NAMESTRING),
+        PARSE_OP_TABLE_ENTRY(CREATE_NAMESTRING_OR_NULL_IF_LOAD),
+        PARSE_OP_TABLE_ENTRY(EXISTING_NAMESTRING),
+        PARSE_OP_TABLE_ENTRY(EXISTING_NAMESTRING_OR_NULL),
+        PARSE_OP_TABLE_ENTRY(EXISTING_NAMESTRING_OR_NULL_IF_LOAD),
+        PARSE_OP_TABLE_ENTRY(INVOKE_HANDLER),
+        PARSE_OP_TABLE_ENTRY(OBJECT_ALLOC),
+        PARSE_OP_TABLE_ENTRY(EMPTY_OBJECT_ALLOC),
+        PARSE_OP_TABLE_ENTRY(OBJECT_CONVERT_TO_SHALLOW_COPY),
+        PARSE_OP_TABLE_ENTRY(OBJECT_CONVERT_TO_DEEP_COPY),
+        PARSE_OP_TABLE_ENTRY(OBJECT_ALLOC_TYPED),
+        PARSE_OP_TABLE_ENTRY(RECORD_AML_PC),
+        PARSE_OP_TABLE_ENTRY(LOAD_INLINE_IMM_AS_OBJECT),
+        PARSE_OP_TABLE_ENTRY(LOAD_INLINE_IMM),
+        PARSE_OP_TABLE_ENTRY(LOAD_ZERO_IMM),
+        PARSE_OP_TABLE_ENTRY(LOAD_IMM),
+        PARSE_OP_TABLE_ENTRY(LOAD_IMM_AS_OBJECT),
+        PARSE_OP_TABLE_ENTRY(LOAD_FALSE_OBJECT),
+        PARSE_OP_TABLE_ENTRY(LOAD_TRUE_OBJECT),
+        PARSE_OP_TABLE_ENTRY(TRUNCATE_NUMBER),
+        PARSE_OP_TABLE_ENTRY(TYPECHECK),
+        PARSE_OP_TABLE_ENTRY(INSTALL_NAMESPACE_NODE),
+        PARSE_OP_TABLE_ENTRY(OBJECT_TRANSFER_TO_PREV),
+        PARSE_OP_TABLE_ENTRY(OBJECT_COPY_TO_PREV),
+        PARSE_OP_TABLE_ENTRY(STORE_TO_TARGET),
+        PARSE_OP_TABLE_ENTRY(STORE_TO_TARGET_INDIRECT),
+        PARSE_OP_TABLE_ENTRY(UNREACHABLE),
+        PARSE_OP_TABLE_ENTRY(BAD_OPCODE),
+        PARSE_OP_TABLE_ENTRY(AML_PC_DECREMENT),
+        PARSE_OP_TABLE_ENTRY(IMM_DECREMENT),
+        PARSE_OP_TABLE_ENTRY(ITEM_POP),
+        PARSE_OP_TABLE_ENTRY(DISPATCH_METHOD_CALL),
+        PARSE_OP_TABLE_ENTRY(DISPATCH_TABLE_LOAD),
+        PARSE_OP_TABLE_ENTRY(CONVERT_NAMESTRING),
+        PARSE_OP_TABLE_ENTRY(IF_HAS_DATA),
+        PARSE_OP_TABLE_ENTRY(IF_NULL),
+        PARSE_OP_TABLE_ENTRY(IF_NOT_NULL),
+        PARSE_OP_TABLE_ENTRY(IF_EQUALS),
+        PARSE_OP_TABLE_ENTRY(JMP),
+        [UACPI_PARSE_OP_MAX + 1 ... 255] = &&parse_op_DEFAULT,
+    };
+#endif
+
     /*
      * Allocate a new op context if previous is preempted (looking for a
      * dynamic argument), or doesn't exist at all.
@@ -5114,7 +6095,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
                 if (op == UACPI_PARSE_OP_OBJECT_ALLOC_TYPED)
                     type = op_decode_byte(op_ctx);
 
-                item->obj = uacpi_create_object(type);
+                item->obj = alloc_item_object(ctx, type);
                 if (uacpi_unlikely(item->obj == UACPI_NULL))
                     return UACPI_STATUS_OUT_OF_MEMORY;
             } else {
@@ -5124,9 +6105,11 @@ static uacpi_status exec_op(struct execution_context *ctx)
             item = item_array_last(&op_ctx->items);
         }
 
+        PARSE_OP_DISPATCH(op);
+
         switch (op) {
-        case UACPI_PARSE_OP_END:
-        case UACPI_PARSE_OP_SKIP_WITH_WARN_IF_NULL: {
+        PARSE_OP_CASE(END)
+        PARSE_OP_CASE(SKIP_WITH_WARN_IF_NULL) {
             trace_op(ctx->cur_op_ctx->op, OP_TRACE_ACTION_END);
 
             if (op == UACPI_PARSE_OP_SKIP_WITH_WARN_IF_NULL) {
@@ -5153,17 +6136,45 @@ static uacpi_status exec_op(struct execution_context *ctx)
             return UACPI_STATUS_OK;
         }
 
-        case UACPI_PARSE_OP_SIMPLE_NAME:
-        case UACPI_PARSE_OP_SUPERNAME:
-        case UACPI_PARSE_OP_SUPERNAME_OR_UNRESOLVED:
-        case UACPI_PARSE_OP_TERM_ARG:
-        case UACPI_PARSE_OP_TERM_ARG_UNWRAP_INTERNAL:
-        case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT:
-        case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED:
-        case UACPI_PARSE_OP_OPERAND:
-        case UACPI_PARSE_OP_STRING:
-        case UACPI_PARSE_OP_COMPUTATIONAL_DATA:
-        case UACPI_PARSE_OP_TARGET:
+        PARSE_OP_CASE(PACKAGE_ELEMENT)
+            /*
+             * A constant element of a package living directly inside a mapped
+             * table doesn't have to be turned into an object right now:
+             * remember its AML range and skip it, handle_package then records
+             * the range for on-demand materialization. Anything non-constant
+             * takes the regular TermArg route below.
+             */
+            if (frame->method->code_in_table) {
+                uacpi_u32 end, size;
+
+                end = item_array_at(
+                    &op_ctx->items, op_ctx->tracked_pkg_idx - 1
+                )->pkg.end;
+                end = UACPI_MIN(end, frame->method->size);
+
+                size = scan_constant_element(
+                    frame->method->code, frame->code_offset, end,
+                    CONSTANT_SCAN_MAX_DEPTH
+                );
+                if (size != 0) {
+                    item->type = ITEM_IMMEDIATE;
+                    item->immediate = size;
+                    frame->code_offset += size;
+                    break;
+                }
+            }
+            UACPI_FALLTHROUGH;
+        PARSE_OP_CASE(SIMPLE_NAME)
+        PARSE_OP_CASE(SUPERNAME)
+        PARSE_OP_CASE(SUPERNAME_OR_UNRESOLVED)
+        PARSE_OP_CASE(TERM_ARG)
+        PARSE_OP_CASE(TERM_ARG_UNWRAP_INTERNAL)
+        PARSE_OP_CASE(TERM_ARG_OR_NAMED_OBJECT)
+        PARSE_OP_CASE(TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED)
+        PARSE_OP_CASE(OPERAND)
+        PARSE_OP_CASE(STRING)
+        PARSE_OP_CASE(COMPUTATIONAL_DATA)
+        PARSE_OP_CASE(TARGET)
             /*
              * Preempt this op parsing for now as we wait for the dynamic arg
              * to be parsed.
@@ -5172,15 +6183,15 @@ static uacpi_status exec_op(struct execution_context *ctx)
             op_ctx->pc--;
             return UACPI_STATUS_OK;
 
-        case UACPI_PARSE_OP_TRACKED_PKGLEN:
+        PARSE_OP_CASE(TRACKED_PKGLEN)
             op_ctx->tracked_pkg_idx = item_array_size(&op_ctx->items);
             UACPI_FALLTHROUGH;
-        case UACPI_PARSE_OP_PKGLEN:
+        PARSE_OP_CASE(PKGLEN)
             ret = parse_package_length(frame, &item->pkg);
             break;
 
-        case UACPI_PARSE_OP_LOAD_INLINE_IMM:
-        case UACPI_PARSE_OP_LOAD_INLINE_IMM_AS_OBJECT: {
+        PARSE_OP_CASE(LOAD_INLINE_IMM)
+        PARSE_OP_CASE(LOAD_INLINE_IMM_AS_OBJECT) {
             void *dst;
             uacpi_u8 src_width;
 
@@ -5201,11 +6212,11 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_LOAD_ZERO_IMM:
+        PARSE_OP_CASE(LOAD_ZERO_IMM)
             break;
 
-        case UACPI_PARSE_OP_LOAD_IMM:
-        case UACPI_PARSE_OP_LOAD_IMM_AS_OBJECT: {
+        PARSE_OP_CASE(LOAD_IMM)
+        PARSE_OP_CASE(LOAD_IMM_AS_OBJECT) {
             uacpi_u8 width;
             void *dst;
 
@@ -5226,23 +6237,23 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_LOAD_FALSE_OBJECT:
-        case UACPI_PARSE_OP_LOAD_TRUE_OBJECT: {
+        PARSE_OP_CASE(LOAD_FALSE_OBJECT)
+        PARSE_OP_CASE(LOAD_TRUE_OBJECT) {
             uacpi_object *obj = item->obj;
             obj->type = UACPI_OBJECT_INTEGER;
             obj->integer = op == UACPI_PARSE_OP_LOAD_FALSE_OBJECT ? 0 : ones();
             break;
         }
 
-        case UACPI_PARSE_OP_RECORD_AML_PC:
+        PARSE_OP_CASE(RECORD_AML_PC)
             item->immediate = frame->code_offset;
             break;
 
-        case UACPI_PARSE_OP_TRUNCATE_NUMBER:
+        PARSE_OP_CASE(TRUNCATE_NUMBER)
             truncate_number_if_needed(item->obj);
             break;
 
-        case UACPI_PARSE_OP_TYPECHECK: {
+        PARSE_OP_CASE(TYPECHECK) {
             enum uacpi_object_type expected_type;
 
             expected_type = op_decode_byte(op_ctx);
@@ -5257,25 +6268,25 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_BAD_OPCODE:
-        case UACPI_PARSE_OP_UNREACHABLE:
+        PARSE_OP_CASE(BAD_OPCODE)
+        PARSE_OP_CASE(UNREACHABLE)
             EXEC_OP_ERR("invalid/unexpected opcode");
             ret = UACPI_STATUS_AML_INVALID_OPCODE;
             break;
 
-        case UACPI_PARSE_OP_AML_PC_DECREMENT:
+        PARSE_OP_CASE(AML_PC_DECREMENT)
             frame->code_offset--;
             break;
 
-        case UACPI_PARSE_OP_IMM_DECREMENT:
+        PARSE_OP_CASE(IMM_DECREMENT)
             item_array_at(&op_ctx->items, op_decode_byte(op_ctx))->immediate--;
             break;
 
-        case UACPI_PARSE_OP_ITEM_POP:
-            pop_item(op_ctx);
+        PARSE_OP_CASE(ITEM_POP)
+            pop_item(ctx, op_ctx);
             break;
 
-        case UACPI_PARSE_OP_IF_HAS_DATA: {
+        PARSE_OP_CASE(IF_HAS_DATA) {
             uacpi_size pkg_idx = op_ctx->tracked_pkg_idx - 1;
             struct package_length *pkg;
             uacpi_u8 bytes_skip;
@@ -5289,8 +6300,8 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_IF_NOT_NULL:
-        case UACPI_PARSE_OP_IF_NULL: {
+        PARSE_OP_CASE(IF_NOT_NULL)
+        PARSE_OP_CASE(IF_NULL) {
             uacpi_u8 idx, bytes_skip;
             uacpi_bool is_null, skip_if_null;
 
@@ -5306,7 +6317,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_IF_EQUALS: {
+        PARSE_OP_CASE(IF_EQUALS) {
             uacpi_u8 value, bytes_skip;
 
             value = op_decode_byte(op_ctx);
@@ -5318,16 +6329,16 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_JMP: {
+        PARSE_OP_CASE(JMP) {
             op_ctx->pc = op_decode_byte(op_ctx);
             break;
         }
 
-        case UACPI_PARSE_OP_CREATE_NAMESTRING:
-        case UACPI_PARSE_OP_CREATE_NAMESTRING_OR_NULL_IF_LOAD:
-        case UACPI_PARSE_OP_EXISTING_NAMESTRING:
-        case UACPI_PARSE_OP_EXISTING_NAMESTRING_OR_NULL:
-        case UACPI_PARSE_OP_EXISTING_NAMESTRING_OR_NULL_IF_LOAD: {
+        PARSE_OP_CASE(CREATE_NAMESTRING)
+        PARSE_OP_CASE(CREATE_NAMESTRING_OR_NULL_IF_LOAD)
+        PARSE_OP_CASE(EXISTING_NAMESTRING)
+        PARSE_OP_CASE(EXISTING_NAMESTRING_OR_NULL)
+        PARSE_OP_CASE(EXISTING_NAMESTRING_OR_NULL_IF_LOAD) {
             uacpi_size offset = frame->code_offset;
             enum resolve_behavior behavior;
 
@@ -5386,7 +6397,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_INVOKE_HANDLER: {
+        PARSE_OP_CASE(INVOKE_HANDLER) {
             uacpi_aml_op code = op_ctx->op->code;
             uacpi_u8 idx;
 
@@ -5396,16 +6407,20 @@ static uacpi_status exec_op(struct execution_context *ctx)
                 idx = handler_idx_of_ext_op[EXT_OP_IDX(code)];
 
             ret = op_handlers[idx](ctx);
+
+            // Rewind so that the handler is re-invoked upon resumption
+            if (ret == UACPI_STATUS_SUSPENDED)
+                op_ctx->pc--;
             break;
         }
 
-        case UACPI_PARSE_OP_INSTALL_NAMESPACE_NODE:
+        PARSE_OP_CASE(INSTALL_NAMESPACE_NODE)
             item = item_array_at(&op_ctx->items, op_decode_byte(op_ctx));
             ret = do_install_node_item(frame, item);
             break;
 
-        case UACPI_PARSE_OP_OBJECT_TRANSFER_TO_PREV:
-        case UACPI_PARSE_OP_OBJECT_COPY_TO_PREV: {
+        PARSE_OP_CASE(OBJECT_TRANSFER_TO_PREV)
+        PARSE_OP_CASE(OBJECT_COPY_TO_PREV) {
             uacpi_object *src;
             struct item *dst;
 
@@ -5436,6 +6451,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
             case UACPI_PARSE_OP_TERM_ARG:
             case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT:
             case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED:
+            case UACPI_PARSE_OP_PACKAGE_ELEMENT:
             case UACPI_PARSE_OP_TARGET:
                 src = item->obj;
                 break;
@@ -5468,8 +6484,8 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_STORE_TO_TARGET:
-        case UACPI_PARSE_OP_STORE_TO_TARGET_INDIRECT: {
+        PARSE_OP_CASE(STORE_TO_TARGET)
+        PARSE_OP_CASE(STORE_TO_TARGET_INDIRECT) {
             uacpi_object *dst, *src;
 
             dst = item_array_at(&op_ctx->items, op_decode_byte(op_ctx))->obj;
@@ -5486,25 +6502,26 @@ static uacpi_status exec_op(struct execution_context *ctx)
         }
 
         // Nothing to do here, object is allocated automatically
-        case UACPI_PARSE_OP_OBJECT_ALLOC:
-        case UACPI_PARSE_OP_OBJECT_ALLOC_TYPED:
-        case UACPI_PARSE_OP_EMPTY_OBJECT_ALLOC:
+        PARSE_OP_CASE(OBJECT_ALLOC)
+        PARSE_OP_CASE(OBJECT_ALLOC_TYPED)
+        PARSE_OP_CASE(EMPTY_OBJECT_ALLOC)
             break;
 
-        case UACPI_PARSE_OP_OBJECT_CONVERT_TO_SHALLOW_COPY:
-        case UACPI_PARSE_OP_OBJECT_CONVERT_TO_DEEP_COPY: {
+        PARSE_OP_CASE(OBJECT_CONVERT_TO_SHALLOW_COPY)
+        PARSE_OP_CASE(OBJECT_CONVERT_TO_DEEP_COPY) {
             uacpi_object *temp = item->obj;
-            enum uacpi_assign_behavior behavior;
 
             item_array_pop(&op_ctx->items);
             item = item_array_last(&op_ctx->items);
 
-            if (op == UACPI_PARSE_OP_OBJECT_CONVERT_TO_SHALLOW_COPY)
-                behavior = UACPI_ASSIGN_BEHAVIOR_SHALLOW_COPY;
-            else
-                behavior = UACPI_ASSIGN_BEHAVIOR_DEEP_COPY;
-
-            ret = uacpi_object_assign(temp, item->obj, behavior);
+            if (op == UACPI_PARSE_OP_OBJECT_CONVERT_TO_SHALLOW_COPY) {
+                ret = uacpi_object_assign(
+                    temp, item->obj, UACPI_ASSIGN_BEHAVIOR_SHALLOW_COPY
+                );
+            } else {
+                // item->obj loses its last reference right below, try to move
+                ret = object_assign_or_move(temp, item->obj);
+            }
             if (uacpi_unlikely_error(ret))
                 break;
 
@@ -5513,7 +6530,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        case UACPI_PARSE_OP_DISPATCH_METHOD_CALL: {
+        PARSE_OP_CASE(DISPATCH_METHOD_CALL) {
             struct uacpi_namespace_node *node;
             struct uacpi_control_method *method;
 
@@ -5526,7 +6543,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
             return ret;
         }
 
-        case UACPI_PARSE_OP_DISPATCH_TABLE_LOAD: {
+        PARSE_OP_CASE(DISPATCH_TABLE_LOAD) {
             struct uacpi_namespace_node *node;
             struct uacpi_control_method *method;
 
@@ -5539,7 +6556,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
             return ret;
         }
 
-        case UACPI_PARSE_OP_CONVERT_NAMESTRING: {
+        PARSE_OP_CASE(CONVERT_NAMESTRING) {
             uacpi_aml_op new_op = UACPI_AML_OP_InternalOpNamedObject;
             uacpi_object *obj;
 
@@ -5558,6 +6575,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
                 switch (prev_op) {
                 case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT:
                 case UACPI_PARSE_OP_TERM_ARG_OR_NAMED_OBJECT_OR_UNRESOLVED:
+                case UACPI_PARSE_OP_PACKAGE_ELEMENT:
                     should_invoke = UACPI_FALSE;
                     break;
                 default:
@@ -5598,7 +6616,7 @@ static uacpi_status exec_op(struct execution_context *ctx)
             break;
         }
 
-        default:
+        PARSE_OP_DEFAULT_CASE
             EXEC_OP_ERR_1("unhandled parser op '%d'", op);
             ret = UACPI_STATUS_UNIMPLEMENTED;
             break;
@@ -5685,8 +6703,91 @@ static void stack_unwind(struct execution_context *ctx)
     }
 }
 
+/*
+ * Freelist of retired execution contexts, kept along with any dynamic call
+ * stack and held mutex storage they may have grown. Methods that invoke
+ * helper methods in a loop retire and reacquire contexts at a high rate, so
+ * parking a few here makes steady-state invocations free of any dynamic
+ * allocations for interpreter bookkeeping.
+ */
+#define EXECUTION_CONTEXT_FREELIST_MAX_DEPTH 4
+
+static uacpi_handle execution_context_freelist_lock;
+static struct execution_context *execution_context_freelist;
+static uacpi_u8 execution_context_freelist_depth;
+
+uacpi_status uacpi_initialize_interpreter(void)
+{
+    execution_context_freelist_lock = uacpi_kernel_create_spinlock();
+    if (uacpi_unlikely(execution_context_freelist_lock == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    return UACPI_STATUS_OK;
+}
+
+static void free_execution_context(struct execution_context *ctx)
+{
+    call_frame_array_clear(&ctx->call_stack);
+    held_mutexes_array_clear(&ctx->held_mutexes);
+    uacpi_free(ctx, sizeof(*ctx));
+}
+
+void uacpi_deinitialize_interpreter(void)
+{
+    struct execution_context *ctx, *next_ctx;
+
+    ctx = execution_context_freelist;
+    while (ctx != UACPI_NULL) {
+        next_ctx = ctx->next_free;
+        free_execution_context(ctx);
+        ctx = next_ctx;
+    }
+
+    execution_context_freelist = UACPI_NULL;
+    execution_context_freelist_depth = 0;
+
+    if (execution_context_freelist_lock != UACPI_NULL) {
+        uacpi_kernel_free_spinlock(execution_context_freelist_lock);
+        execution_context_freelist_lock = UACPI_NULL;
+    }
+}
+
+static struct execution_context *execution_context_acquire(void)
+{
+    struct call_frame_array call_stack;
+    struct held_mutexes_array held_mutexes;
+    struct execution_context *ctx = UACPI_NULL;
+    uacpi_cpu_flags flags;
+
+    if (uacpi_likely(execution_context_freelist_lock != UACPI_NULL)) {
+        flags = uacpi_kernel_lock_spinlock(execution_context_freelist_lock);
+
+        ctx = execution_context_freelist;
+        if (ctx != UACPI_NULL) {
+            execution_context_freelist = ctx->next_free;
+            execution_context_freelist_depth--;
+        }
+
+        uacpi_kernel_unlock_spinlock(execution_context_freelist_lock, flags);
+    }
+
+    if (ctx == UACPI_NULL)
+        return uacpi_kernel_alloc_zeroed(sizeof(*ctx));
+
+    // Wipe everything except for the retained array storage
+    call_stack = ctx->call_stack;
+    held_mutexes = ctx->held_mutexes;
+    uacpi_memzero(ctx, sizeof(*ctx));
+    ctx->call_stack = call_stack;
+    ctx->held_mutexes = held_mutexes;
+
+    return ctx;
+}
+
 static void execution_context_release(struct execution_context *ctx)
 {
+    uacpi_cpu_flags flags;
+
     if (ctx->ret)
         uacpi_object_unref(ctx->ret);
 
@@ -5698,34 +6799,35 @@ static void execution_context_release(struct execution_context *ctx)
         );
     }
 
-    call_frame_array_clear(&ctx->call_stack);
-    held_mutexes_array_clear(&ctx->held_mutexes);
-    uacpi_free(ctx, sizeof(*ctx));
-}
-
-uacpi_status uacpi_execute_control_method(
-    uacpi_namespace_node *scope, uacpi_control_method *method,
-    const uacpi_object_array *args, uacpi_object **out_obj
-)
-{
-    uacpi_status ret = UACPI_STATUS_OK;
-    struct execution_context *ctx;
+    drain_object_cache(ctx);
+    uacpi_arena_reset(&ctx->arena);
 
-    ctx = uacpi_kernel_alloc_zeroed(sizeof(*ctx));
-    if (uacpi_unlikely(ctx == UACPI_NULL))
-        return UACPI_STATUS_OUT_OF_MEMORY;
+    if (uacpi_likely(execution_context_freelist_lock != UACPI_NULL)) {
+        call_frame_array_reset(&ctx->call_stack);
+        held_mutexes_array_reset(&ctx->held_mutexes);
 
-    if (out_obj != UACPI_NULL) {
-        ctx->ret = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
-        if (uacpi_unlikely(ctx->ret == UACPI_NULL)) {
-            ret = UACPI_STATUS_OUT_OF_MEMORY;
-            goto out;
+        flags = uacpi_kernel_lock_spinlock(execution_context_freelist_lock);
+        if (execution_context_freelist_depth <
+            EXECUTION_CONTEXT_FREELIST_MAX_DEPTH) {
+            ctx->next_free = execution_context_freelist;
+            execution_context_freelist = ctx;
+            execution_context_freelist_depth++;
+            ctx = UACPI_NULL;
         }
+        uacpi_kernel_unlock_spinlock(execution_context_freelist_lock, flags);
     }
 
-    ret = prepare_method_call(ctx, scope, method, METHOD_CALL_NATIVE, args);
-    if (uacpi_unlikely_error(ret))
-        goto out;
+    if (ctx != UACPI_NULL)
+        free_execution_context(ctx);
+}
+
+static uacpi_status run_execution_loop(struct execution_context *ctx)
+{
+    uacpi_status ret = UACPI_STATUS_OK;
+#ifdef UACPI_PROFILING
+    uacpi_aml_op profiled_op;
+    uacpi_u64 op_begin_ts;
+#endif
 
     for (;;) {
         if (!ctx_has_non_preempted_op(ctx)) {
@@ -5747,7 +6849,29 @@ uacpi_status uacpi_execute_control_method(
             trace_op(ctx->cur_op, OP_TRACE_ACTION_BEGIN);
         }
 
+#ifdef UACPI_PROFILING
+        /*
+         * A preempted instruction resumes via its op context, cur_op may
+         * already refer to whatever was parsed after it.
+         */
+        profiled_op = ctx->cur_op_ctx != UACPI_NULL ?
+            ctx->cur_op_ctx->op->code : ctx->cur_op->code;
+        op_begin_ts = uacpi_kernel_get_nanoseconds_since_boot();
+#endif
+
         ret = exec_op(ctx);
+
+#ifdef UACPI_PROFILING
+        uacpi_profile_op(
+            profiled_op,
+            uacpi_kernel_get_nanoseconds_since_boot() - op_begin_ts
+        );
+#endif
+
+        // Park this context, everything stays as-is until the resume
+        if (ret == UACPI_STATUS_SUSPENDED)
+            return ret;
+
         if (uacpi_unlikely_error(ret))
             goto handle_method_abort;
 
@@ -5775,7 +6899,20 @@ uacpi_status uacpi_execute_control_method(
         }
     }
 
-out:
+    return ret;
+}
+
+static uacpi_status finalize_execution_context(
+    struct execution_context *ctx, uacpi_status ret, uacpi_object **out_obj
+)
+{
+#ifdef UACPI_PROFILING
+    uacpi_profile_method(
+        ctx->prof_node,
+        uacpi_kernel_get_nanoseconds_since_boot() - ctx->prof_begin_ts
+    );
+#endif
+
     if (ctx->ret != UACPI_NULL) {
         uacpi_object *ret_obj = UACPI_NULL;
 
@@ -5791,6 +6928,120 @@ out:
     return ret;
 }
 
+static uacpi_status do_execute_control_method(
+    uacpi_namespace_node *scope, uacpi_control_method *method,
+    const uacpi_object_array *args, uacpi_object **out_obj,
+    struct execution_context **out_suspended_ctx
+)
+{
+    uacpi_status ret = UACPI_STATUS_OK;
+    struct execution_context *ctx;
+
+    /*
+     * The init level shares a packed word (and cache line) with the rest of
+     * the scalar state the execution loop consults on every step, so this
+     * check doubles as a warm-up load for all of it.
+     */
+    if (uacpi_unlikely(g_uacpi_rt_ctx.init_level <
+                       UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED))
+        return UACPI_STATUS_INIT_LEVEL_MISMATCH;
+
+    ctx = execution_context_acquire();
+    if (uacpi_unlikely(ctx == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    ctx->suspendable = out_suspended_ctx != UACPI_NULL;
+
+#ifdef UACPI_PROFILING
+    if (!method->named_objects_persist)
+        ctx->prof_node = scope;
+    ctx->prof_begin_ts = uacpi_kernel_get_nanoseconds_since_boot();
+#endif
+
+    if (out_obj != UACPI_NULL) {
+        ctx->ret = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
+        if (uacpi_unlikely(ctx->ret == UACPI_NULL)) {
+            ret = UACPI_STATUS_OUT_OF_MEMORY;
+            goto out;
+        }
+    }
+
+    ret = prepare_method_call(ctx, scope, method, METHOD_CALL_NATIVE, args);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    ret = run_execution_loop(ctx);
+    if (ret == UACPI_STATUS_SUSPENDED) {
+        *out_suspended_ctx = ctx;
+        return ret;
+    }
+
+out:
+    return finalize_execution_context(ctx, ret, out_obj);
+}
+
+uacpi_status uacpi_execute_control_method(
+    uacpi_namespace_node *scope, uacpi_control_method *method,
+    const uacpi_object_array *args, uacpi_object **out_obj
+)
+{
+    return do_execute_control_method(scope, method, args, out_obj, UACPI_NULL);
+}
+
+uacpi_status uacpi_execute_control_method_suspendable(
+    uacpi_namespace_node *scope, uacpi_control_method *method,
+    const uacpi_object_array *args, uacpi_object **out_obj,
+    struct execution_context **out_suspended_ctx
+)
+{
+    return do_execute_control_method(
+        scope, method, args, out_obj, out_suspended_ctx
+    );
+}
+
+uacpi_status uacpi_resume_control_method(
+    struct execution_context *ctx, uacpi_object **out_obj
+)
+{
+    uacpi_status ret;
+    uacpi_size i;
+    uacpi_thread_id this_id;
+
+    /*
+     * We may be getting resumed on a different thread than the one this
+     * context last ran on, transfer ownership of every AML mutex it holds
+     * (including the implicit one of a serialized method) over to us.
+     */
+    this_id = uacpi_kernel_get_thread_id();
+    for (i = 0; i < held_mutexes_array_size(&ctx->held_mutexes); ++i) {
+        UACPI_ATOMIC_STORE_THREAD_ID(
+            &(*held_mutexes_array_at(&ctx->held_mutexes, i))->owner, this_id
+        );
+    }
+
+    ret = run_execution_loop(ctx);
+    if (ret == UACPI_STATUS_SUSPENDED)
+        return ret;
+
+    return finalize_execution_context(ctx, ret, out_obj);
+}
+
+uacpi_u64 uacpi_suspended_control_method_wake_deadline(
+    struct execution_context *ctx
+)
+{
+    return ctx->wake_deadline_ns;
+}
+
+void uacpi_abort_suspended_control_method(struct execution_context *ctx)
+{
+    ctx->suspend_reason = SUSPEND_REASON_NONE;
+    ctx->wake_deadline_ns = 0;
+
+    stack_unwind(ctx);
+    execution_context_release(ctx);
+}
+
 uacpi_status uacpi_osi(uacpi_handle handle, uacpi_object *retval)
 {
     struct execution_context *ctx = handle;
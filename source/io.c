@@ -43,6 +43,31 @@ static uacpi_size bit_span_offset(struct bit_span *span, uacpi_size bits)
     return delta;
 }
 
+/*
+ * Byte order within a bit span is fixed by AML (first byte holds the lowest
+ * bits), so words are composed/decomposed explicitly instead of type-punned,
+ * keeping this correct regardless of host endianness. Compilers reduce these
+ * to single loads/stores on little-endian targets.
+ */
+static uacpi_u64 bit_span_load64(const uacpi_u8 *bytes)
+{
+    uacpi_u64 out = 0;
+    uacpi_u8 i;
+
+    for (i = 0; i < 8; ++i)
+        out |= (uacpi_u64)bytes[i] << (i * 8);
+
+    return out;
+}
+
+static void bit_span_store64(uacpi_u8 *bytes, uacpi_u64 value)
+{
+    uacpi_u8 i;
+
+    for (i = 0; i < 8; ++i)
+        bytes[i] = value >> (i * 8);
+}
+
 static void bit_copy(struct bit_span *dst, struct bit_span *src)
 {
     uacpi_u8 src_shift, dst_shift, bits = 0;
@@ -59,6 +84,57 @@ static void bit_copy(struct bit_span *dst, struct bit_span *src)
     src_count = src->length;
     src_shift = src->index & 7;
 
+    /*
+     * Move the bulk of the span 64 bits at a time whenever at least one side
+     * is byte-aligned, leaving at most a tail for the bit-granular loop
+     * below. This is the hot configuration for field unit reads/writes that
+     * stream large buffers (the misaligned side being the field offset), as
+     * well as byte-aligned copies with a length that isn't a multiple of 8.
+     */
+    if (src_shift == 0 && dst_shift == 0) {
+        uacpi_size bytes;
+
+        bytes = (UACPI_MIN(dst_count, src_count) / 8);
+        uacpi_memcpy(dst_ptr, src_ptr, bytes);
+
+        dst_ptr += bytes;
+        src_ptr += bytes;
+        dst_count -= bytes * 8;
+        src_count -= bytes * 8;
+    } else if (dst_shift == 0) {
+        // Reading at a misaligned bit offset into an aligned buffer
+        while (dst_count >= 64 && src_count >= 72) {
+            uacpi_u64 word;
+
+            word = bit_span_load64(src_ptr) >> src_shift;
+            word |= (uacpi_u64)src_ptr[8] << (64 - src_shift);
+            bit_span_store64(dst_ptr, word);
+
+            dst_ptr += 8;
+            src_ptr += 8;
+            dst_count -= 64;
+            src_count -= 64;
+        }
+    } else if (src_shift == 0) {
+        // Writing an aligned buffer at a misaligned bit offset
+        while (src_count >= 64 && dst_count >= 72) {
+            uacpi_u64 word, cur;
+            uacpi_u8 low_mask = (1u << dst_shift) - 1;
+
+            word = bit_span_load64(src_ptr);
+
+            cur = bit_span_load64(dst_ptr) & low_mask;
+            bit_span_store64(dst_ptr, cur | (word << dst_shift));
+            dst_ptr[8] &= ~low_mask;
+            dst_ptr[8] |= word >> (64 - dst_shift);
+
+            dst_ptr += 8;
+            src_ptr += 8;
+            dst_count -= 64;
+            src_count -= 64;
+        }
+    }
+
     while (dst_count)
     {
         bits = 0;
@@ -144,11 +220,17 @@ static void do_write_misaligned_buffer_field(
     bit_copy(&dst_span, &src_span);
 }
 
-void uacpi_write_buffer_field(
+uacpi_status uacpi_write_buffer_field(
     uacpi_buffer_field *field,
     const void *src, uacpi_size size
 )
 {
+    uacpi_status ret;
+
+    ret = uacpi_buffer_ensure_mutable(field->backing);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
     if (!(field->bit_index & 7)) {
         uacpi_u8 *dst, last_byte, tail_shift;
         uacpi_size count;
@@ -168,10 +250,11 @@ void uacpi_write_buffer_field(
             dst[count - 1] |= (last_byte >> tail_shift) << tail_shift;
         }
 
-        return;
+        return UACPI_STATUS_OK;
     }
 
     do_write_misaligned_buffer_field(field, src, size);
+    return UACPI_STATUS_OK;
 }
 
 static uacpi_status access_field_unit(
@@ -243,6 +326,68 @@ out:
     return ret;
 }
 
+/*
+ * Whether every access unit of this field can be handed to the underlying
+ * region handler as one batched UACPI_REGION_OP_{READ,WRITE}_MANY call.
+ * Index fields serialize every access through the index register and thus
+ * can never be batched.
+ */
+static uacpi_bool field_unit_supports_rw_many(uacpi_field_unit *field)
+{
+    switch (field->kind) {
+    case UACPI_FIELD_UNIT_KIND_NORMAL:
+        return uacpi_opregion_supports_rw_many(field->region);
+    case UACPI_FIELD_UNIT_KIND_BANK:
+        return uacpi_opregion_supports_rw_many(field->bank_region);
+    default:
+        return UACPI_FALSE;
+    }
+}
+
+static uacpi_status access_field_unit_many(
+    uacpi_field_unit *field, uacpi_u32 offset, uacpi_region_op op,
+    uacpi_u64 *values, uacpi_size count
+)
+{
+    uacpi_status ret = UACPI_STATUS_OK;
+    uacpi_namespace_node *region_node;
+
+    if (field->lock_rule) {
+        ret = uacpi_acquire_aml_mutex(
+            g_uacpi_rt_ctx.global_lock_mutex, 0xFFFF
+        );
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    }
+
+    switch (field->kind) {
+    case UACPI_FIELD_UNIT_KIND_BANK:
+        ret = uacpi_write_field_unit(
+            field->bank_selection, &field->bank_value, sizeof(field->bank_value)
+        );
+        region_node = field->bank_region;
+        break;
+    case UACPI_FIELD_UNIT_KIND_NORMAL:
+        region_node = field->region;
+        break;
+    default:
+        uacpi_error("invalid field unit kind %d for batched IO\n", field->kind);
+        ret = UACPI_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    ret = uacpi_dispatch_opregion_rw_many(
+        region_node, offset, field->access_width_bytes, op, values, count
+    );
+
+out:
+    if (field->lock_rule)
+        uacpi_release_aml_mutex(g_uacpi_rt_ctx.global_lock_mutex);
+    return ret;
+}
+
 static uacpi_status do_read_misaligned_field_unit(
     uacpi_field_unit *field, uacpi_u8 *dst, uacpi_size size
 )
@@ -271,6 +416,39 @@ static uacpi_status do_read_misaligned_field_unit(
     );
     reads_to_do /= width_access_bits;
 
+    if (reads_to_do > 1 && field_unit_supports_rw_many(field)) {
+        uacpi_u64 *values;
+
+        values = uacpi_kernel_alloc(reads_to_do * sizeof(*values));
+
+        // Just take the per-unit path below if we're out of memory
+        if (values != UACPI_NULL) {
+            uacpi_size i;
+
+            ret = access_field_unit_many(
+                field, byte_offset, UACPI_REGION_OP_READ_MANY,
+                values, reads_to_do
+            );
+            if (uacpi_likely_success(ret)) {
+                for (i = 0; i < reads_to_do; ++i) {
+                    out = values[i];
+                    src_span.length = UACPI_MIN(
+                        bits_left, width_access_bits - src_span.index
+                    );
+
+                    bit_copy(&dst_span, &src_span);
+                    bits_left -= src_span.length;
+                    src_span.index = 0;
+
+                    bit_span_offset(&dst_span, src_span.length);
+                }
+            }
+
+            uacpi_free(values, reads_to_do * sizeof(*values));
+            return ret;
+        }
+    }
+
     while (reads_to_do-- > 0) {
         src_span.length = UACPI_MIN(
             bits_left, width_access_bits - src_span.index
@@ -335,10 +513,11 @@ uacpi_status uacpi_write_field_unit(
     uacpi_field_unit *field, const void *src, uacpi_size size
 )
 {
-    uacpi_status ret;
+    uacpi_status ret = UACPI_STATUS_OK;
     uacpi_u32 bits_left, byte_offset = field->byte_offset;
     uacpi_u8 width_access_bits = field->access_width_bytes * 8;
-    uacpi_u64 in;
+    uacpi_u64 in, *values = UACPI_NULL;
+    uacpi_size writes_to_do, value_idx = 0;
 
     struct bit_span src_span = {
         .const_data = src,
@@ -352,6 +531,23 @@ uacpi_status uacpi_write_field_unit(
 
     bits_left = field->bit_length;
 
+    writes_to_do = UACPI_ALIGN_UP(
+        field->bit_offset_within_first_byte + field->bit_length,
+        width_access_bits,
+        uacpi_u32
+    );
+    writes_to_do /= width_access_bits;
+
+    /*
+     * Compose all of the access words upfront and hand them to the region
+     * handler as one batch if it is able to consume it. Note that any
+     * read-backs mandated by the preserve update rule still happen one unit
+     * at a time before the batch is issued, but there are at most two of
+     * those (the partial head and tail units).
+     */
+    if (writes_to_do > 1 && field_unit_supports_rw_many(field))
+        values = uacpi_kernel_alloc(writes_to_do * sizeof(*values));
+
     while (bits_left) {
         in = 0;
         dst_span.length = UACPI_MIN(
@@ -365,7 +561,7 @@ uacpi_status uacpi_write_field_unit(
                     field, byte_offset, UACPI_REGION_OP_READ, &in
                 );
                 if (uacpi_unlikely_error(ret))
-                    return ret;
+                    goto out;
                 break;
             case UACPI_UPDATE_RULE_WRITE_AS_ONES:
                 in = ~in;
@@ -375,25 +571,40 @@ uacpi_status uacpi_write_field_unit(
             default:
                 uacpi_error("invalid field@%p update rule %d\n",
                             field, field->update_rule);
-                return UACPI_STATUS_INVALID_ARGUMENT;
+                ret = UACPI_STATUS_INVALID_ARGUMENT;
+                goto out;
             }
         }
 
         bit_copy(&dst_span, &src_span);
         bit_span_offset(&src_span, dst_span.length);
 
-        ret = access_field_unit(
-            field, byte_offset, UACPI_REGION_OP_WRITE, &in
-        );
-        if (uacpi_unlikely_error(ret))
-            return ret;
+        if (values != UACPI_NULL) {
+            values[value_idx++] = in;
+        } else {
+            ret = access_field_unit(
+                field, byte_offset, UACPI_REGION_OP_WRITE, &in
+            );
+            if (uacpi_unlikely_error(ret))
+                goto out;
+        }
 
         bits_left -= dst_span.length;
         dst_span.index = 0;
         byte_offset += field->access_width_bytes;
     }
 
-    return UACPI_STATUS_OK;
+    if (values != UACPI_NULL) {
+        ret = access_field_unit_many(
+            field, field->byte_offset, UACPI_REGION_OP_WRITE_MANY,
+            values, writes_to_do
+        );
+    }
+
+out:
+    if (values != UACPI_NULL)
+        uacpi_free(values, writes_to_do * sizeof(*values));
+    return ret;
 }
 
 static uacpi_u8 gas_get_access_bit_width(const struct acpi_gas *gas)
@@ -443,10 +654,10 @@ static uacpi_u8 gas_get_access_bit_width(const struct acpi_gas *gas)
 }
 
 static uacpi_status gas_validate(
-    const struct acpi_gas *gas, uacpi_u8 *access_bit_width
+    const struct acpi_gas *gas, uacpi_u8 *access_bit_width,
+    uacpi_size *total_width
 )
 {
-    uacpi_size total_width;
 
     if (uacpi_unlikely(gas == UACPI_NULL))
         return UACPI_STATUS_INVALID_ARGUMENT;
@@ -470,13 +681,13 @@ static uacpi_status gas_validate(
 
     *access_bit_width = gas_get_access_bit_width(gas);
 
-    total_width = UACPI_ALIGN_UP(
+    *total_width = UACPI_ALIGN_UP(
         gas->register_bit_offset + gas->register_bit_width,
         *access_bit_width, uacpi_size
     );
-    if (total_width > 64) {
+    if (*total_width > 64) {
         uacpi_warn(
-            "GAS register total width is too large: %zu\n", total_width
+            "GAS register total width is too large: %zu\n", *total_width
         );
         return UACPI_STATUS_UNIMPLEMENTED;
     }
@@ -484,6 +695,80 @@ static uacpi_status gas_validate(
     return UACPI_STATUS_OK;
 }
 
+uacpi_status uacpi_map_gas_noalloc(
+    const struct acpi_gas *gas, struct uacpi_mapped_gas *out_mapped
+)
+{
+    uacpi_status ret;
+    uacpi_u8 access_bit_width;
+    uacpi_size total_width;
+
+    ret = gas_validate(gas, &access_bit_width, &total_width);
+    if (ret != UACPI_STATUS_OK)
+        return ret;
+
+    if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO) {
+        ret = uacpi_kernel_io_map(
+            gas->address, total_width / 8, &out_mapped->mapping.io
+        );
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    } else {
+        out_mapped->mapping.virt = uacpi_kernel_map(
+            gas->address, total_width / 8
+        );
+        if (uacpi_unlikely(out_mapped->mapping.virt == UACPI_NULL))
+            return UACPI_STATUS_MAPPING_FAILED;
+    }
+
+    out_mapped->access_bit_width = access_bit_width;
+    out_mapped->total_bit_width = total_width;
+    out_mapped->bit_offset = gas->register_bit_offset;
+    out_mapped->address_space_id = gas->address_space_id;
+
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_map_gas(
+    const struct acpi_gas *gas, uacpi_mapped_gas **out_mapped
+)
+{
+    uacpi_status ret;
+    uacpi_mapped_gas *mapping;
+
+    mapping = uacpi_kernel_alloc(sizeof(*mapping));
+    if (uacpi_unlikely(mapping == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    ret = uacpi_map_gas_noalloc(gas, mapping);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free(mapping, sizeof(*mapping));
+        return ret;
+    }
+
+    *out_mapped = mapping;
+    return ret;
+}
+
+void uacpi_unmap_gas_nofree(struct uacpi_mapped_gas *mapped)
+{
+    if (mapped->total_bit_width == 0)
+        return;
+
+    if (mapped->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO)
+        uacpi_kernel_io_unmap(mapped->mapping.io);
+    else
+        uacpi_kernel_unmap(mapped->mapping.virt, mapped->total_bit_width / 8);
+
+    mapped->total_bit_width = 0;
+}
+
+void uacpi_unmap_gas(uacpi_mapped_gas *mapped)
+{
+    uacpi_unmap_gas_nofree(mapped);
+    uacpi_free(mapped, sizeof(*mapped));
+}
+
 /*
  * Apparently both reading and writing GAS works differently from operation
  * region in that bit offsets are not respected when writing the data.
@@ -492,107 +777,182 @@ static uacpi_status gas_validate(
  * break any quirky hardware.
  */
 
-uacpi_status uacpi_gas_read(const struct acpi_gas *gas, uacpi_u64 *out_value)
+uacpi_status uacpi_gas_read_mapped(
+    const uacpi_mapped_gas *gas, uacpi_u64 *out_value
+)
 {
     uacpi_status ret;
-    uacpi_u8 access_bit_width, access_byte_width;
+    uacpi_u8 access_byte_width;
     uacpi_u8 bit_offset, bits_left, index = 0;
     uacpi_u64 data, mask = 0xFFFFFFFFFFFFFFFF;
 
-    ret = gas_validate(gas, &access_bit_width);
-    if (ret != UACPI_STATUS_OK)
-        return ret;
-
-    bit_offset = gas->register_bit_offset;
-    bits_left = bit_offset + gas->register_bit_width;
+    bit_offset = gas->bit_offset;
+    bits_left = gas->total_bit_width;
 
-    access_byte_width = access_bit_width / 8;
+    access_byte_width = gas->access_bit_width / 8;
 
     if (access_byte_width < 8)
-        mask = ~(mask << access_bit_width);
+        mask = ~(mask << gas->access_bit_width);
 
     *out_value = 0;
 
+#ifdef UACPI_VECTORED_KERNEL_IO
+    /*
+     * Every unit past the skipped bit offset forms one contiguous run, so a
+     * multi-unit SystemIO read can be handed to the host as a single
+     * vectored call.
+     */
+    if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO &&
+        bits_left > gas->access_bit_width) {
+        // Total width is capped at 64 bits, so at most 8 byte-wide units
+        uacpi_u64 values[8];
+        uacpi_u8 skip, count;
+
+        skip = bit_offset / gas->access_bit_width;
+        count = (bits_left / gas->access_bit_width) - skip;
+
+        ret = uacpi_kernel_io_read_many(
+            gas->mapping.io, skip * access_byte_width, access_byte_width,
+            values, count
+        );
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        for (index = 0; index < count; ++index) {
+            *out_value |= (values[index] & mask)
+                << ((index + skip) * gas->access_bit_width);
+        }
+
+        return UACPI_STATUS_OK;
+    }
+#endif
+
     while (bits_left) {
-        if (bit_offset >= access_bit_width) {
+        if (bit_offset >= gas->access_bit_width) {
             data = 0;
-            bit_offset -= access_bit_width;
+            bit_offset -= gas->access_bit_width;
         } else {
-            uacpi_u64 address = gas->address + (index * access_byte_width);
+            uacpi_size offset = index * access_byte_width;
 
             if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO) {
-                ret = uacpi_system_io_read(address, access_byte_width, &data);
+                ret = uacpi_kernel_io_read(
+                    gas->mapping.io, offset, access_byte_width, &data
+                );
             } else {
-                void *virt;
-
-                virt = uacpi_kernel_map(address, access_byte_width);
-                if (uacpi_unlikely(virt == UACPI_NULL))
-                    return UACPI_STATUS_MAPPING_FAILED;
-
-                ret = uacpi_system_memory_read(virt, access_byte_width, &data);
-                uacpi_kernel_unmap(virt, access_bit_width);
+                ret = uacpi_system_memory_read(
+                    UACPI_PTR_ADD(gas->mapping.virt, offset),
+                    access_byte_width, &data
+                );
             }
             if (uacpi_unlikely_error(ret))
                 return ret;
         }
 
-        *out_value |= (data & mask) << (index * access_bit_width);
-        bits_left -= UACPI_MIN(bits_left, access_bit_width);
+        *out_value |= (data & mask) << (index * gas->access_bit_width);
+        bits_left -= UACPI_MIN(bits_left, gas->access_bit_width);
         ++index;
     }
 
     return UACPI_STATUS_OK;
 }
 
-uacpi_status uacpi_gas_write(const struct acpi_gas *gas, uacpi_u64 in_value)
+uacpi_status uacpi_gas_read(const struct acpi_gas *gas, uacpi_u64 *out_value)
 {
     uacpi_status ret;
-    uacpi_u8 access_bit_width, access_byte_width;
-    uacpi_u8 bit_offset, bits_left, index = 0;
-    uacpi_u64 data, mask = 0xFFFFFFFFFFFFFFFF;
+    struct uacpi_mapped_gas mapping;
 
-    ret = gas_validate(gas, &access_bit_width);
+    ret = uacpi_map_gas_noalloc(gas, &mapping);
     if (ret != UACPI_STATUS_OK)
         return ret;
 
-    bit_offset = gas->register_bit_offset;
-    bits_left = bit_offset + gas->register_bit_width;
-    access_byte_width = access_bit_width / 8;
+    ret = uacpi_gas_read_mapped(&mapping, out_value);
+    uacpi_unmap_gas_nofree(&mapping);
+
+    return ret;
+}
+
+uacpi_status uacpi_gas_write_mapped(
+    const uacpi_mapped_gas *gas, uacpi_u64 in_value
+)
+{
+    uacpi_status ret;
+    uacpi_u8 access_byte_width;
+    uacpi_u8 bit_offset, bits_left, index = 0;
+    uacpi_u64 data, mask = 0xFFFFFFFFFFFFFFFF;
+
+    bit_offset = gas->bit_offset;
+    bits_left = gas->total_bit_width;
+    access_byte_width = gas->access_bit_width / 8;
 
     if (access_byte_width < 8)
-        mask = ~(mask << access_bit_width);
+        mask = ~(mask << gas->access_bit_width);
+
+#ifdef UACPI_VECTORED_KERNEL_IO
+    // Same batching as in uacpi_gas_read_mapped, see the comment there
+    if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO &&
+        bits_left > gas->access_bit_width) {
+        uacpi_u64 values[8];
+        uacpi_u8 skip, count;
+
+        skip = bit_offset / gas->access_bit_width;
+        count = (bits_left / gas->access_bit_width) - skip;
+
+        for (index = 0; index < count; ++index) {
+            values[index] =
+                (in_value >> ((index + skip) * gas->access_bit_width)) & mask;
+        }
+
+        return uacpi_kernel_io_write_many(
+            gas->mapping.io, skip * access_byte_width, access_byte_width,
+            values, count
+        );
+    }
+#endif
 
     while (bits_left) {
-        data = (in_value >> (index * access_bit_width)) & mask;
+        data = (in_value >> (index * gas->access_bit_width)) & mask;
 
-        if (bit_offset >= access_bit_width) {
-            bit_offset -= access_bit_width;
+        if (bit_offset >= gas->access_bit_width) {
+            bit_offset -= gas->access_bit_width;
         } else {
-            uacpi_u64 address = gas->address + (index * access_byte_width);
+            uacpi_size offset = index * access_byte_width;
 
             if (gas->address_space_id == UACPI_ADDRESS_SPACE_SYSTEM_IO) {
-                ret = uacpi_system_io_write(address, access_byte_width, data);
+                ret = uacpi_kernel_io_write(
+                    gas->mapping.io, offset, access_byte_width, data
+                );
             } else {
-                void *virt;
-
-                virt = uacpi_kernel_map(address, access_byte_width);
-                if (uacpi_unlikely(virt == UACPI_NULL))
-                    return UACPI_STATUS_MAPPING_FAILED;
-
-                ret = uacpi_system_memory_write(virt, access_byte_width, data);
-                uacpi_kernel_unmap(virt, access_bit_width);
+                ret = uacpi_system_memory_write(
+                    UACPI_PTR_ADD(gas->mapping.virt, offset),
+                    access_byte_width, data
+                );
             }
             if (uacpi_unlikely_error(ret))
                 return ret;
         }
 
-        bits_left -= UACPI_MIN(bits_left, access_bit_width);
+        bits_left -= UACPI_MIN(bits_left, gas->access_bit_width);
         ++index;
     }
 
     return UACPI_STATUS_OK;
 }
 
+uacpi_status uacpi_gas_write(const struct acpi_gas *gas, uacpi_u64 in_value)
+{
+    uacpi_status ret;
+    struct uacpi_mapped_gas mapping;
+
+    ret = uacpi_map_gas_noalloc(gas, &mapping);
+    if (ret != UACPI_STATUS_OK)
+        return ret;
+
+    ret = uacpi_gas_write_mapped(&mapping, in_value);
+    uacpi_unmap_gas_nofree(&mapping);
+
+    return ret;
+}
+
 uacpi_status uacpi_system_io_read(
     uacpi_io_addr address, uacpi_u8 width, uacpi_u64 *out
 )
@@ -196,6 +196,44 @@ uacpi_bool uacpi_this_thread_owns_aml_mutex(uacpi_mutex *mutex)
     return id == uacpi_kernel_get_thread_id();
 }
 
+/*
+ * Most AML mutex holds (e.g. EC field accesses guarded by the field lock
+ * rule) last well under a microsecond, so going straight to a sleeping
+ * kernel mutex pays for a context switch that dwarfs the critical section
+ * itself. Spin for a few exponentially growing windows watching the owner
+ * field, try-locking whenever the mutex looks free, before the caller falls
+ * back to a blocking acquire.
+ *
+ * The owner field is only a contention hint here: ownership is still
+ * arbitrated exclusively by the kernel mutex via the zero-timeout acquire.
+ */
+#define AML_MUTEX_MAX_SPIN_ROUNDS 8
+
+static uacpi_status try_acquire_aml_mutex_spinning(uacpi_mutex *mutex)
+{
+    uacpi_status ret;
+    uacpi_u32 round, i, backoff = 1;
+
+    for (round = 0; round < AML_MUTEX_MAX_SPIN_ROUNDS; round++) {
+        if (UACPI_ATOMIC_LOAD_THREAD_ID(&mutex->owner) ==
+            UACPI_THREAD_ID_NONE) {
+            ret = uacpi_kernel_acquire_mutex(mutex->handle, 0);
+            if (ret != UACPI_STATUS_TIMEOUT)
+                return ret;
+        }
+
+        for (i = 0; i < backoff; i++) {
+            if (UACPI_ATOMIC_LOAD_THREAD_ID(&mutex->owner) ==
+                UACPI_THREAD_ID_NONE)
+                break;
+        }
+
+        backoff <<= 1;
+    }
+
+    return UACPI_STATUS_TIMEOUT;
+}
+
 uacpi_status uacpi_acquire_aml_mutex(uacpi_mutex *mutex, uacpi_u16 timeout)
 {
     uacpi_thread_id this_id;
@@ -216,7 +254,16 @@ uacpi_status uacpi_acquire_aml_mutex(uacpi_mutex *mutex, uacpi_u16 timeout)
     }
 
     uacpi_namespace_write_unlock();
-    ret = uacpi_acquire_native_mutex_with_timeout(mutex->handle, timeout);
+
+    /*
+     * A zero timeout means check-and-fail, which the blocking path below
+     * already implements exactly, don't stretch it by spinning.
+     */
+    ret = UACPI_STATUS_TIMEOUT;
+    if (timeout != 0)
+        ret = try_acquire_aml_mutex_spinning(mutex);
+    if (ret != UACPI_STATUS_OK)
+        ret = uacpi_acquire_native_mutex_with_timeout(mutex->handle, timeout);
     if (ret != UACPI_STATUS_OK)
         goto out;
 
@@ -311,35 +358,38 @@ uacpi_status uacpi_recursive_lock_release(struct uacpi_recursive_lock *lock)
     return uacpi_release_native_mutex(lock->mutex);
 }
 
+#define RW_LOCK_WRITER (1u << 31)
+#define RW_LOCK_READER_MASK (RW_LOCK_WRITER - 1)
+
+/*
+ * The number of times a writer polls the reader count back to back before
+ * starting to yield the CPU in between the polls. Read-side critical sections
+ * are short (namespace walks between lock breaks), so draining them out
+ * rarely gets past the stall phase.
+ */
+#define RW_LOCK_DRAIN_SPINS 100
+
 uacpi_status uacpi_rw_lock_init(struct uacpi_rw_lock *lock)
 {
-    lock->read_mutex = uacpi_kernel_create_mutex();
-    if (uacpi_unlikely(lock->read_mutex == UACPI_NULL))
-        return UACPI_STATUS_OUT_OF_MEMORY;
-
     lock->write_mutex = uacpi_kernel_create_mutex();
-    if (uacpi_unlikely(lock->write_mutex == UACPI_NULL)) {
-        uacpi_kernel_free_mutex(lock->read_mutex);
-        lock->read_mutex = UACPI_NULL;
+    if (uacpi_unlikely(lock->write_mutex == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
-    }
 
-    lock->num_readers = 0;
+    lock->state = 0;
     return UACPI_STATUS_OK;
 }
 
 uacpi_status uacpi_rw_lock_deinit(struct uacpi_rw_lock *lock)
 {
-    if (uacpi_unlikely(lock->num_readers)) {
-        uacpi_warn("de-initializing rw_lock %p with %zu active readers\n",
-                   lock, lock->num_readers);
-        lock->num_readers = 0;
-    }
+    uacpi_u32 state;
 
-    if (lock->read_mutex != UACPI_NULL) {
-        uacpi_kernel_free_mutex(lock->read_mutex);
-        lock->read_mutex = UACPI_NULL;
+    state = uacpi_atomic_load32(&lock->state);
+    if (uacpi_unlikely(state & RW_LOCK_READER_MASK)) {
+        uacpi_warn("de-initializing rw_lock %p with %u active readers\n",
+                   lock, state & RW_LOCK_READER_MASK);
     }
+    lock->state = 0;
+
     if (lock->write_mutex != UACPI_NULL) {
         uacpi_kernel_free_mutex(lock->write_mutex);
         lock->write_mutex = UACPI_NULL;
@@ -351,42 +401,122 @@ uacpi_status uacpi_rw_lock_deinit(struct uacpi_rw_lock *lock)
 uacpi_status uacpi_rw_lock_read(struct uacpi_rw_lock *lock)
 {
     uacpi_status ret;
+    uacpi_u32 state;
 
-    ret = uacpi_acquire_native_mutex(lock->read_mutex);
-    if (uacpi_unlikely_error(ret))
-        return ret;
+    for (;;) {
+        state = uacpi_atomic_load32(&lock->state);
+
+        if (uacpi_likely(!(state & RW_LOCK_WRITER))) {
+            /*
+             * All updates go through this one word, so a successful publish
+             * here is definitive proof no writer snuck in before us: a writer
+             * would have had to set its bit in between our load and this
+             * exchange, which would simply fail the exchange.
+             */
+            if (uacpi_atomic_cmpxchg32(&lock->state, &state, state + 1))
+                return UACPI_STATUS_OK;
+
+            continue;
+        }
 
-    if (lock->num_readers++ == 0) {
+        /*
+         * A writer owns the lock, or is waiting for the last readers to get
+         * out. Park on the write mutex until it's done instead of burning
+         * cycles re-polling the state.
+         */
         ret = uacpi_acquire_native_mutex(lock->write_mutex);
         if (uacpi_unlikely_error(ret))
-            lock->num_readers = 0;
-    }
+            return ret;
 
-    uacpi_kernel_release_mutex(lock->read_mutex);
-    return ret;
+        uacpi_release_native_mutex(lock->write_mutex);
+    }
 }
 
 uacpi_status uacpi_rw_unlock_read(struct uacpi_rw_lock *lock)
+{
+    uacpi_atomic_dec32(&lock->state);
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_rw_lock_write(struct uacpi_rw_lock *lock)
 {
     uacpi_status ret;
+    uacpi_u32 state;
+    uacpi_size spins = 0;
 
-    ret = uacpi_acquire_native_mutex(lock->read_mutex);
+    ret = uacpi_acquire_native_mutex(lock->write_mutex);
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    if (lock->num_readers-- == 1)
-        uacpi_release_native_mutex(lock->write_mutex);
+    // Announce ourselves so that no new readers are let through
+    for (;;) {
+        state = uacpi_atomic_load32(&lock->state);
+        if (uacpi_atomic_cmpxchg32(&lock->state, &state, state | RW_LOCK_WRITER))
+            break;
+    }
 
-    uacpi_kernel_release_mutex(lock->read_mutex);
-    return ret;
-}
+    // Wait for the readers that got in before us to drain out
+    while (uacpi_atomic_load32(&lock->state) & RW_LOCK_READER_MASK) {
+        if (++spins < RW_LOCK_DRAIN_SPINS)
+            uacpi_kernel_stall(1);
+        else
+            uacpi_kernel_sleep(1);
+    }
 
-uacpi_status uacpi_rw_lock_write(struct uacpi_rw_lock *lock)
-{
-    return uacpi_acquire_native_mutex(lock->write_mutex);
+    return UACPI_STATUS_OK;
 }
 
 uacpi_status uacpi_rw_unlock_write(struct uacpi_rw_lock *lock)
 {
+    uacpi_atomic_store32(&lock->state, 0);
     return uacpi_release_native_mutex(lock->write_mutex);
 }
+
+void uacpi_work_group_init(struct uacpi_work_group *group)
+{
+    /*
+     * Failure is fine: waits on an event-less group simply degrade to the
+     * global uacpi_kernel_wait_for_work_completion barrier.
+     */
+    group->event = uacpi_kernel_create_event();
+    group->counter = 0;
+}
+
+void uacpi_work_group_deinit(struct uacpi_work_group *group)
+{
+    if (group->event != UACPI_NULL)
+        uacpi_kernel_free_event(group->event);
+
+    group->event = UACPI_NULL;
+    group->counter = 0;
+}
+
+void uacpi_work_group_begin(struct uacpi_work_group *group)
+{
+    uacpi_atomic_inc32(&group->counter);
+}
+
+void uacpi_work_group_done(struct uacpi_work_group *group)
+{
+    // Only the last item out signals, waiters re-check the counter anyway
+    if (uacpi_atomic_dec32(&group->counter) == 0 &&
+        group->event != UACPI_NULL)
+        uacpi_kernel_signal_event(group->event);
+}
+
+uacpi_status uacpi_wait_for_group_work_completion(
+    struct uacpi_work_group *group
+)
+{
+    if (uacpi_unlikely(group->event == UACPI_NULL))
+        return uacpi_kernel_wait_for_work_completion();
+
+    /*
+     * The timeout covers signals lost to racing waiters, the counter is
+     * always the source of truth.
+     */
+    while (uacpi_atomic_load32(&group->counter) != 0)
+        uacpi_kernel_wait_for_event(group->event, 10);
+
+    return UACPI_STATUS_OK;
+}
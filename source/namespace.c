@@ -7,8 +7,14 @@
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/mutex.h>
+#include <uacpi/internal/pool.h>
+#include <uacpi/internal/helpers.h>
 #include <uacpi/kernel_api.h>
 
+// Attribute allocations in this file under UACPI_MEMORY_ACCOUNTING
+#undef UACPI_TRACKED_SUBSYSTEM
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_NAMESPACE
+
 #define UACPI_REV_VALUE 2
 #define UACPI_OS_VALUE "Microsoft Windows NT"
 
@@ -34,6 +40,117 @@ predefined_namespaces[UACPI_PREDEFINED_NAMESPACE_MAX + 1] = {
 
 static struct uacpi_rw_lock namespace_lock;
 
+/*
+ * Bumped on every structural change to the namespace (node install or
+ * uninstall). Lets consumers that cache resolved nodes (e.g. the interpreter
+ * decode cache) cheaply detect that a cached target may no longer be valid.
+ * Modified under the namespace write lock.
+ */
+static uacpi_u64 namespace_generation;
+
+/*
+ * Same, but only bumped for permanent nodes: temporary method-scoped nodes
+ * come and go on every method execution and are invisible to consumers that
+ * only care about the permanent tree (e.g. the flat pre-order index below,
+ * which skips them at build time).
+ */
+static uacpi_u64 permanent_namespace_generation;
+
+uacpi_u64 uacpi_namespace_generation(void)
+{
+    return namespace_generation;
+}
+
+static void drop_flat_index(void);
+
+/*
+ * Once a scope accumulates this many children we build a hash index on top of
+ * the regular child list so that nameseg lookup becomes O(1). Below this
+ * threshold a linear walk is both smaller and faster than hashing.
+ */
+#define CHILD_INDEX_MIN_CHILDREN 16
+
+struct uacpi_namespace_node_child_index {
+    // Always a power of two, at most half full
+    uacpi_size capacity;
+    uacpi_size used;
+    uacpi_namespace_node *slots[];
+};
+
+static uacpi_size child_index_size_bytes(uacpi_size capacity)
+{
+    return sizeof(struct uacpi_namespace_node_child_index) +
+           capacity * sizeof(uacpi_namespace_node*);
+}
+
+static uacpi_size child_index_home_slot(
+    struct uacpi_namespace_node_child_index *index, uacpi_object_name name
+)
+{
+    // Fibonacci hash of the 4-byte nameseg, folded to table capacity
+    return ((uacpi_u32)(name.id * 2654435769u)) & (index->capacity - 1);
+}
+
+static void child_index_insert(
+    struct uacpi_namespace_node_child_index *index, uacpi_namespace_node *node
+)
+{
+    uacpi_size slot;
+
+    slot = child_index_home_slot(index, node->name);
+    while (index->slots[slot] != UACPI_NULL)
+        slot = (slot + 1) & (index->capacity - 1);
+
+    index->slots[slot] = node;
+    index->used++;
+}
+
+static void namespace_node_drop_child_index(uacpi_namespace_node *node)
+{
+    struct uacpi_namespace_node_child_index *index = node->child_index;
+
+    if (index == UACPI_NULL)
+        return;
+
+    uacpi_free(index, child_index_size_bytes(index->capacity));
+    node->child_index = UACPI_NULL;
+}
+
+/*
+ * (Re)build the child index of 'parent' from its current child list. Since
+ * the index is purely an optimization, allocation failure here is not an
+ * error: we simply drop the index and fall back to linear lookup.
+ */
+static void namespace_node_rebuild_child_index(uacpi_namespace_node *parent)
+{
+    struct uacpi_namespace_node_child_index *index;
+    uacpi_namespace_node *child;
+    uacpi_size capacity;
+
+    /*
+     * Pick the smallest power-of-two capacity that keeps the table at most
+     * half full so that linear probing stays short.
+     */
+    capacity = (uacpi_size)1 << uacpi_bit_scan_backward(
+        ((uacpi_u64)parent->child_count * 2) - 1
+    );
+
+    index = uacpi_kernel_alloc_zeroed(child_index_size_bytes(capacity));
+    namespace_node_drop_child_index(parent);
+    if (uacpi_unlikely(index == UACPI_NULL))
+        return;
+
+    index->capacity = capacity;
+
+    child = parent->child;
+    while (child != UACPI_NULL) {
+        child_index_insert(index, child);
+        child = child->next;
+    }
+
+    parent->child_index = index;
+}
+
 uacpi_status uacpi_namespace_read_lock(void)
 {
     return uacpi_rw_lock_read(&namespace_lock);
@@ -142,8 +259,10 @@ static void free_namespace_node(uacpi_handle handle)
 {
     uacpi_namespace_node *node = handle;
 
+    namespace_node_drop_child_index(node);
+
     if (uacpi_likely(!uacpi_namespace_node_is_predefined(node))) {
-        uacpi_free(node, sizeof(*node));
+        uacpi_pool_free(uacpi_namespace_node_pool(), node);
         return;
     }
 
@@ -152,6 +271,7 @@ static void free_namespace_node(uacpi_handle handle)
     node->parent = UACPI_NULL;
     node->child = UACPI_NULL;
     node->next = UACPI_NULL;
+    node->child_count = 0;
 }
 
 uacpi_status uacpi_initialize_namespace(void)
@@ -169,6 +289,13 @@ uacpi_status uacpi_initialize_namespace(void)
         node = &predefined_namespaces[ns];
         uacpi_shareable_init(node);
 
+        /*
+         * Predefined nodes live in static storage and are torn down explicitly
+         * in uacpi_deinitialize_namespace, so their (very hot) refcounts don't
+         * have to be maintained at all.
+         */
+        uacpi_make_shareable_permanent(node);
+
         obj = make_object_for_predefined(ns);
         if (uacpi_unlikely(obj == UACPI_NULL))
             return UACPI_STATUS_OUT_OF_MEMORY;
@@ -207,12 +334,16 @@ void uacpi_deinitialize_namespace(void)
 {
     uacpi_status ret;
     uacpi_namespace_node *current, *next = UACPI_NULL;
+    enum uacpi_predefined_namespace ns;
     uacpi_u32 depth = 1;
 
     current = uacpi_namespace_root();
 
     ret = uacpi_namespace_write_lock();
 
+    // Release the index's node references before the tree is torn down
+    drop_flat_index();
+
     while (depth) {
         next = next == UACPI_NULL ? current->child : next->next;
 
@@ -247,8 +378,15 @@ void uacpi_deinitialize_namespace(void)
         // This node has no children, move on to its peer
     }
 
-    namespace_node_detach_object(uacpi_namespace_root());
-    free_namespace_node(uacpi_namespace_root());
+    /*
+     * Predefined nodes are pinned as permanently referenced, so the tree wipe
+     * above never frees them, do it by hand. This also covers nodes that were
+     * never installed in the first place, e.g. \_OSI under UACPI_FLAG_NO_OSI.
+     */
+    for (ns = 0; ns <= UACPI_PREDEFINED_NAMESPACE_MAX; ns++) {
+        namespace_node_detach_object(&predefined_namespaces[ns]);
+        free_namespace_node(&predefined_namespaces[ns]);
+    }
 
     if (ret == UACPI_STATUS_OK)
         uacpi_namespace_write_unlock();
@@ -283,7 +421,7 @@ uacpi_namespace_node *uacpi_namespace_node_alloc(uacpi_object_name name)
 {
     uacpi_namespace_node *ret;
 
-    ret = uacpi_kernel_alloc_zeroed(sizeof(*ret));
+    ret = uacpi_pool_alloc_zeroed(uacpi_namespace_node_pool());
     if (uacpi_unlikely(ret == UACPI_NULL))
         return ret;
 
@@ -323,6 +461,23 @@ uacpi_status uacpi_namespace_node_install(
     }
 
     node->parent = parent;
+    parent->child_count++;
+    namespace_generation++;
+    if (!uacpi_namespace_node_is_temporary(node))
+        permanent_namespace_generation++;
+
+    if (parent->child_index != UACPI_NULL) {
+        struct uacpi_namespace_node_child_index *index = parent->child_index;
+
+        // Keep the table at most half full, rebuild at double capacity
+        if (index->used + 1 > index->capacity / 2)
+            namespace_node_rebuild_child_index(parent);
+        else
+            child_index_insert(index, node);
+    } else if (parent->child_count >= CHILD_INDEX_MIN_CHILDREN) {
+        namespace_node_rebuild_child_index(parent);
+    }
+
     return UACPI_STATUS_OK;
 }
 
@@ -346,7 +501,60 @@ uacpi_bool uacpi_namespace_node_is_predefined(uacpi_namespace_node *node)
     return node->flags & UACPI_NAMESPACE_NODE_PREDEFINED;
 }
 
-uacpi_status uacpi_namespace_node_uninstall(uacpi_namespace_node *node)
+/*
+ * Parents whose child index is stale because one or more children were
+ * removed from under them during a bulk uninstall. Index maintenance is
+ * deferred until the end of the batch (or until this fills up) so that
+ * removing N temporary siblings costs one rebuild instead of N.
+ */
+struct dirty_index_parents {
+    uacpi_namespace_node *nodes[8];
+    uacpi_size count;
+};
+
+static void dirty_index_parents_flush(struct dirty_index_parents *dirty)
+{
+    uacpi_namespace_node *parent;
+    uacpi_size i;
+
+    for (i = 0; i < dirty->count; ++i) {
+        parent = dirty->nodes[i];
+
+        if (parent->child_index != UACPI_NULL) {
+            if (parent->child_count < CHILD_INDEX_MIN_CHILDREN / 2)
+                namespace_node_drop_child_index(parent);
+            else
+                namespace_node_rebuild_child_index(parent);
+        }
+
+        uacpi_namespace_node_unref(parent);
+    }
+
+    dirty->count = 0;
+}
+
+static void dirty_index_parents_add(
+    struct dirty_index_parents *dirty, uacpi_namespace_node *parent
+)
+{
+    uacpi_size i;
+
+    for (i = 0; i < dirty->count; ++i) {
+        if (dirty->nodes[i] == parent)
+            return;
+    }
+
+    if (dirty->count == UACPI_ARRAY_SIZE(dirty->nodes))
+        dirty_index_parents_flush(dirty);
+
+    // The parent might be uninstalled later in the batch, keep it alive
+    uacpi_shareable_ref(parent);
+    dirty->nodes[dirty->count++] = parent;
+}
+
+static uacpi_status do_namespace_node_uninstall(
+    uacpi_namespace_node *node, struct dirty_index_parents *dirty
+)
 {
     uacpi_namespace_node *prev;
 
@@ -437,21 +645,85 @@ uacpi_status uacpi_namespace_node_uninstall(uacpi_namespace_node *node)
         prev->next = node->next;
     }
 
+    node->parent->child_count--;
+    namespace_generation++;
+    if (!uacpi_namespace_node_is_temporary(node))
+        permanent_namespace_generation++;
+
+    if (node->parent->child_index != UACPI_NULL) {
+        /*
+         * Linear probing doesn't support cheap removal, so rebuild the index
+         * from the remaining children, or drop it entirely if this scope has
+         * shrunk enough for linear lookup to win again. For bulk uninstalls
+         * the rebuild is deferred until the end of the batch instead.
+         */
+        if (dirty != UACPI_NULL) {
+            dirty_index_parents_add(dirty, node->parent);
+        } else if (node->parent->child_count < CHILD_INDEX_MIN_CHILDREN / 2) {
+            namespace_node_drop_child_index(node->parent);
+        } else {
+            namespace_node_rebuild_child_index(node->parent);
+        }
+    }
+
     node->flags |= UACPI_NAMESPACE_NODE_FLAG_DANGLING;
     uacpi_namespace_node_unref(node);
 
     return UACPI_STATUS_OK;
 }
 
+uacpi_status uacpi_namespace_node_uninstall(uacpi_namespace_node *node)
+{
+    return do_namespace_node_uninstall(node, UACPI_NULL);
+}
+
+void uacpi_namespace_node_uninstall_bulk(
+    uacpi_namespace_node **nodes, uacpi_size count
+)
+{
+    struct dirty_index_parents dirty = { 0 };
+    uacpi_size i;
+
+    /*
+     * Uninstall in reverse creation order: a node is only removable once
+     * every child created after it is gone.
+     */
+    for (i = count; i-- > 0;)
+        do_namespace_node_uninstall(nodes[i], &dirty);
+
+    dirty_index_parents_flush(&dirty);
+}
+
 uacpi_namespace_node *uacpi_namespace_node_find_sub_node(
     uacpi_namespace_node *parent,
     uacpi_object_name name
 )
 {
+    uacpi_namespace_node *node;
+
     if (parent == UACPI_NULL)
         parent = uacpi_namespace_root();
 
-    uacpi_namespace_node *node = parent->child;
+    if (parent->child_index != UACPI_NULL) {
+        struct uacpi_namespace_node_child_index *index = parent->child_index;
+        uacpi_size slot;
+
+        /*
+         * The table is never more than half full and removals rebuild it, so
+         * an empty slot terminates the probe sequence.
+         */
+        slot = child_index_home_slot(index, name);
+        while ((node = index->slots[slot]) != UACPI_NULL) {
+            if (node->name.id == name.id)
+                return node;
+
+            slot = (slot + 1) & (index->capacity - 1);
+        }
+
+        return UACPI_NULL;
+    }
+
+    node = parent->child;
 
     while (node) {
         if (node->name.id == name.id)
@@ -829,6 +1101,218 @@ uacpi_status uacpi_namespace_node_is(
     );
 }
 
+/*
+ * Flattened pre-order index of the permanent namespace, used to accelerate
+ * full-tree walks: device enumeration repeatedly touches every node, and a
+ * linear scan over contiguous {node, depth, type} records is considerably
+ * more cache friendly than chasing child/next/parent links.
+ *
+ * The index holds a reference to every recorded node and is stamped with the
+ * permanent-node generation it was built at, so any structural change to the
+ * permanent tree invalidates it and the next full-tree walk rebuilds it
+ * (temporary method-scoped nodes are skipped at build time, so their churn
+ * can't change the contents). The pointer is swapped under
+ * the namespace write lock and the block itself is refcounted, letting
+ * in-flight walks keep their copy alive across a concurrent rebuild. Nodes
+ * uninstalled after the build are detected via their dangling flag and
+ * skipped.
+ */
+struct uacpi_flat_namespace_entry {
+    uacpi_namespace_node *node;
+    uacpi_u32 depth;
+};
+
+struct uacpi_flat_namespace_index {
+    struct uacpi_shareable shareable;
+    uacpi_u64 generation;
+    uacpi_size count;
+    struct uacpi_flat_namespace_entry entries[];
+};
+
+static struct uacpi_flat_namespace_index *flat_index;
+
+static void free_flat_index(uacpi_handle handle)
+{
+    struct uacpi_flat_namespace_index *idx = handle;
+    uacpi_size i;
+
+    for (i = 0; i < idx->count; ++i)
+        uacpi_namespace_node_unref(idx->entries[i].node);
+
+    uacpi_free(idx, sizeof(*idx) + idx->count * sizeof(*idx->entries));
+}
+
+/*
+ * Pre-order walk over the permanent namespace recording every node, or just
+ * counting them when 'entries' is null. Temporary subtrees are skipped
+ * entirely, the index only ever serves permanent-only iteration.
+ */
+static uacpi_size flat_index_fill(struct uacpi_flat_namespace_entry *entries)
+{
+    uacpi_size count = 0;
+    uacpi_u32 depth = 1;
+    uacpi_namespace_node *node = uacpi_namespace_root()->child;
+
+    while (node != UACPI_NULL) {
+        if (uacpi_namespace_node_is_temporary(node))
+            goto next_peer;
+
+        if (entries != UACPI_NULL) {
+            uacpi_shareable_ref(node);
+            entries[count].node = node;
+            entries[count].depth = depth;
+        }
+        count++;
+
+        if (node->child != UACPI_NULL) {
+            node = node->child;
+            depth++;
+            continue;
+        }
+
+    next_peer:
+        while (node->next == UACPI_NULL) {
+            node = node->parent;
+            if (--depth == 0)
+                return count;
+        }
+        node = node->next;
+    }
+
+    return count;
+}
+
+// Must be called with the namespace write lock held
+static struct uacpi_flat_namespace_index *flat_index_rebuild(void)
+{
+    struct uacpi_flat_namespace_index *idx;
+    uacpi_size count;
+
+    count = flat_index_fill(UACPI_NULL);
+
+    idx = uacpi_kernel_alloc(sizeof(*idx) + count * sizeof(*idx->entries));
+    if (uacpi_unlikely(idx == UACPI_NULL))
+        return UACPI_NULL;
+
+    uacpi_shareable_init(idx);
+    idx->count = flat_index_fill(idx->entries);
+    idx->generation = permanent_namespace_generation;
+
+    if (flat_index != UACPI_NULL)
+        uacpi_shareable_unref_and_delete_if_last(flat_index, free_flat_index);
+    flat_index = idx;
+
+    return idx;
+}
+
+static struct uacpi_flat_namespace_index *acquire_flat_index(void)
+{
+    uacpi_status ret;
+    struct uacpi_flat_namespace_index *idx;
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return UACPI_NULL;
+
+    idx = flat_index;
+    if (idx == UACPI_NULL || idx->generation != permanent_namespace_generation)
+        idx = flat_index_rebuild();
+
+    if (uacpi_likely(idx != UACPI_NULL))
+        uacpi_shareable_ref(idx);
+
+    uacpi_namespace_write_unlock();
+    return idx;
+}
+
+static void release_flat_index(struct uacpi_flat_namespace_index *idx)
+{
+    uacpi_shareable_unref_and_delete_if_last(idx, free_flat_index);
+}
+
+static void drop_flat_index(void)
+{
+    if (flat_index == UACPI_NULL)
+        return;
+
+    release_flat_index(flat_index);
+    flat_index = UACPI_NULL;
+}
+
+void uacpi_namespace_prime_flat_index(void)
+{
+    struct uacpi_flat_namespace_index *idx;
+
+    idx = acquire_flat_index();
+    if (uacpi_likely(idx != UACPI_NULL))
+        release_flat_index(idx);
+}
+
+static uacpi_status do_flat_for_each(
+    struct uacpi_flat_namespace_index *idx,
+    uacpi_iteration_callback descending_callback,
+    uacpi_object_type_bits type_mask, void *user
+)
+{
+    uacpi_status ret;
+    uacpi_size i = 0;
+    uacpi_iteration_decision decision;
+
+    ret = uacpi_namespace_read_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    while (i < idx->count) {
+        struct uacpi_flat_namespace_entry *entry = &idx->entries[i];
+        uacpi_bool matches = UACPI_FALSE;
+
+        /*
+         * The type has to be read back live rather than cached at index
+         * build time: objects can be retyped in place (e.g. via CopyObject)
+         * without any install/uninstall bumping the generation.
+         */
+        if (!uacpi_namespace_node_is_dangling(entry->node))
+            uacpi_namespace_node_is_one_of_unlocked(
+                entry->node, type_mask, &matches
+            );
+
+        if (!matches) {
+            i++;
+            continue;
+        }
+
+        ret = uacpi_namespace_read_unlock();
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        decision = descending_callback(user, entry->node, entry->depth);
+        if (decision == UACPI_ITERATION_DECISION_BREAK)
+            return UACPI_STATUS_OK;
+
+        ret = uacpi_namespace_read_lock();
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        if (decision == UACPI_ITERATION_DECISION_NEXT_PEER) {
+            uacpi_u32 depth = entry->depth;
+
+            for (i++; i < idx->count && idx->entries[i].depth > depth; i++)
+                ;
+            continue;
+        }
+
+        if (uacpi_unlikely(decision != UACPI_ITERATION_DECISION_CONTINUE)) {
+            ret = UACPI_STATUS_INVALID_ARGUMENT;
+            break;
+        }
+
+        i++;
+    }
+
+    uacpi_namespace_read_unlock();
+    return ret;
+}
+
 uacpi_status uacpi_namespace_do_for_each_child(
     uacpi_namespace_node *node, uacpi_iteration_callback descending_callback,
     uacpi_iteration_callback ascending_callback,
@@ -852,6 +1336,26 @@ uacpi_status uacpi_namespace_do_for_each_child(
     if (uacpi_unlikely(node == UACPI_NULL || max_depth == 0))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
+    /*
+     * A full-depth descending-only walk over the entire tree is the shape of
+     * device enumeration, which is hot at boot: serve it from the flattened
+     * pre-order index whenever possible. Failure to acquire the index simply
+     * falls through to the pointer walk below.
+     */
+    if (should_lock == UACPI_SHOULD_LOCK_YES &&
+        permanent_only == UACPI_PERMANENT_ONLY_YES &&
+        ascending_callback == UACPI_NULL &&
+        node == uacpi_namespace_root() && max_depth == UACPI_MAX_DEPTH_ANY) {
+        struct uacpi_flat_namespace_index *idx;
+
+        idx = acquire_flat_index();
+        if (uacpi_likely(idx != UACPI_NULL)) {
+            ret = do_flat_for_each(idx, descending_callback, type_mask, user);
+            release_flat_index(idx);
+            return ret;
+        }
+    }
+
     if (should_lock == UACPI_SHOULD_LOCK_YES) {
         ret = uacpi_namespace_read_lock();
         if (uacpi_unlikely_error(ret))
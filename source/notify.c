@@ -5,25 +5,104 @@
 #include <uacpi/internal/mutex.h>
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/stdlib.h>
+#include <uacpi/platform/atomic.h>
 #include <uacpi/kernel_api.h>
 
+// Attribute allocations in this file under UACPI_MEMORY_ACCOUNTING
+#undef UACPI_TRACKED_SUBSYSTEM
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_EVENTS
+
 static uacpi_handle notify_mutex;
 
+/*
+ * Notifications are delivered out of a fixed lock-free multi-producer
+ * single-consumer ring, so that a Notify storm coming from
+ * interrupt-adjacent context (e.g. the EC GPE during dock/undock) costs a
+ * few atomic operations per event instead of an allocation, a mutex
+ * acquisition, and a work item each. Duplicate (node, value) pairs that
+ * are still awaiting delivery are coalesced. The heap-allocated work item
+ * path is kept as a fallback for when the ring is full.
+ */
+#define NOTIFY_QUEUE_SIZE 64
+
+/*
+ * Slot phases live in the low bits of the slot state word, the rest is a
+ * generation counter bumped once per slot reuse so that two equal reads of
+ * the state guarantee the payload fields were stable in between.
+ */
+#define SLOT_PHASE_MASK 0x3u
+#define SLOT_PHASE_EMPTY 0x0u
+#define SLOT_PHASE_READY 0x1u
+#define SLOT_PHASE_CONSUMING 0x2u
+#define SLOT_NEXT_GENERATION (SLOT_PHASE_MASK + 1u)
+
+struct notification_slot {
+    uacpi_namespace_node *node;
+    uacpi_object *node_object;
+    uacpi_u64 value;
+    uacpi_u32 state;
+};
+
+static struct notification_slot notify_queue[NOTIFY_QUEUE_SIZE];
+
+// Producer claim cursor, only ever grows. The slot for a claim is its
+// value modulo the queue size.
+static uacpi_u32 notify_queue_head;
+
+// Consumer cursor, written by the drain worker only
+static uacpi_u32 notify_queue_tail;
+
+// Number of published-but-undelivered slots. The producer that bumps this
+// zero to one schedules the drain worker.
+static uacpi_u32 notify_queue_pending;
+
+/*
+ * Every notification delivery work item is tagged with this group, so that
+ * handler uninstall only has to drain in-flight deliveries instead of
+ * barriering on every outstanding host work item.
+ */
+static struct uacpi_work_group notify_work_group;
+
 uacpi_status uacpi_initialize_notify(void)
 {
     notify_mutex = uacpi_kernel_create_mutex();
     if (uacpi_unlikely(notify_mutex == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
+    uacpi_work_group_init(&notify_work_group);
     return UACPI_STATUS_OK;
 }
 
+static void release_notification_refs(
+    uacpi_object *node_object, uacpi_namespace_node *node
+)
+{
+    uacpi_namespace_node_release_object(node_object);
+    uacpi_namespace_node_unref(node);
+}
+
 void uacpi_deinitialize_notify(void)
 {
+    uacpi_size i;
+
+    // Drop anything that never got delivered
+    for (i = 0; i < NOTIFY_QUEUE_SIZE; ++i) {
+        struct notification_slot *slot = &notify_queue[i];
+
+        if ((slot->state & SLOT_PHASE_MASK) == SLOT_PHASE_READY)
+            release_notification_refs(slot->node_object, slot->node);
+    }
+
+    uacpi_memzero(notify_queue, sizeof(notify_queue));
+    notify_queue_head = 0;
+    notify_queue_tail = 0;
+    notify_queue_pending = 0;
+
     if (notify_mutex != UACPI_NULL)
         uacpi_kernel_free_mutex(notify_mutex);
 
     notify_mutex = UACPI_NULL;
+    uacpi_work_group_deinit(&notify_work_group);
 }
 
 struct notification_ctx {
@@ -34,34 +113,181 @@ struct notification_ctx {
 
 static void free_notification_ctx(struct notification_ctx *ctx)
 {
-    uacpi_namespace_node_release_object(ctx->node_object);
-    uacpi_namespace_node_unref(ctx->node);
+    release_notification_refs(ctx->node_object, ctx->node);
     uacpi_free(ctx, sizeof(*ctx));
 }
 
-static void do_notify(uacpi_handle opaque)
+static void deliver_notification(
+    uacpi_namespace_node *node, uacpi_object *node_object, uacpi_u64 value
+)
 {
-    struct notification_ctx *ctx = opaque;
     uacpi_device_notify_handler *handler;
     uacpi_bool did_notify_root = UACPI_FALSE;
 
-    handler = ctx->node_object->handlers->notify_head;
+    handler = uacpi_atomic_load_ptr(&node_object->handlers->notify_head);
 
     for (;;) {
         if (handler == UACPI_NULL) {
-            if (did_notify_root) {
-                free_notification_ctx(ctx);
+            if (did_notify_root)
                 return;
-            }
 
-            handler = g_uacpi_rt_ctx.root_object->handlers->notify_head;
+            handler = uacpi_atomic_load_ptr(
+                &g_uacpi_rt_ctx.root_object->handlers->notify_head
+            );
             did_notify_root = UACPI_TRUE;
             continue;
         }
 
-        handler->callback(handler->user_context, ctx->node, ctx->value);
-        handler = handler->next;
+        handler->callback(handler->user_context, node, value);
+        handler = uacpi_atomic_load_ptr(&handler->next);
+    }
+}
+
+static void do_notify(uacpi_handle opaque)
+{
+    struct notification_ctx *ctx = opaque;
+
+    deliver_notification(ctx->node, ctx->node_object, ctx->value);
+    free_notification_ctx(ctx);
+
+    uacpi_work_group_done(&notify_work_group);
+}
+
+static void drain_notify_queue(uacpi_handle unused)
+{
+    UACPI_UNUSED(unused);
+
+    for (;;) {
+        struct notification_slot *slot;
+        uacpi_namespace_node *node;
+        uacpi_object *node_object;
+        uacpi_u64 value;
+        uacpi_u32 state;
+
+        slot = &notify_queue[notify_queue_tail % NOTIFY_QUEUE_SIZE];
+
+        /*
+         * The pending counter is bumped only after a slot is published, so
+         * this slot may still be mid-fill by a producer that claimed it
+         * right before another producer published a later one. Wait it
+         * out, the window is a few stores wide at most.
+         */
+        for (;;) {
+            state = uacpi_atomic_load32(&slot->state);
+            if ((state & SLOT_PHASE_MASK) == SLOT_PHASE_READY)
+                break;
+
+            uacpi_kernel_stall(1);
+        }
+
+        node = slot->node;
+        node_object = slot->node_object;
+        value = slot->value;
+
+        // Bump the generation so that coalescing attempts no longer match
+        state = (state & ~SLOT_PHASE_MASK) + SLOT_NEXT_GENERATION;
+        uacpi_atomic_store32(&slot->state, state | SLOT_PHASE_CONSUMING);
+
+        deliver_notification(node, node_object, value);
+        release_notification_refs(node_object, node);
+
+        // Hand the slot back before publishing the new tail
+        uacpi_atomic_store32(&slot->state, state | SLOT_PHASE_EMPTY);
+        uacpi_atomic_store32(&notify_queue_tail, notify_queue_tail + 1);
+
+        if (uacpi_atomic_dec32(&notify_queue_pending) == 0)
+            break;
+    }
+
+    uacpi_work_group_done(&notify_work_group);
+}
+
+static uacpi_bool try_coalesce_notification(
+    uacpi_namespace_node *node, uacpi_u64 value
+)
+{
+    uacpi_size i;
+
+    for (i = 0; i < NOTIFY_QUEUE_SIZE; ++i) {
+        struct notification_slot *slot = &notify_queue[i];
+        uacpi_u32 state;
+
+        state = uacpi_atomic_load32(&slot->state);
+        if ((state & SLOT_PHASE_MASK) != SLOT_PHASE_READY)
+            continue;
+        if (slot->node != node || slot->value != value)
+            continue;
+
+        /*
+         * The fields matched an undelivered slot that was still pending on
+         * the re-read, meaning delivery of this exact pair is guaranteed
+         * to happen after this point: the new notification coalesces into
+         * it. The generation bits make sure the slot wasn't consumed and
+         * refilled with a different pair between the two reads.
+         */
+        if (uacpi_atomic_load32(&slot->state) == state)
+            return UACPI_TRUE;
     }
+
+    return UACPI_FALSE;
+}
+
+static uacpi_bool try_enqueue_notification(
+    uacpi_namespace_node *node, uacpi_object *node_object, uacpi_u64 value
+)
+{
+    struct notification_slot *slot;
+    uacpi_u32 head, tail, state;
+    uacpi_status ret;
+
+    if (try_coalesce_notification(node, value))
+        return UACPI_TRUE;
+
+    for (;;) {
+        head = uacpi_atomic_load32(&notify_queue_head);
+        tail = uacpi_atomic_load32(&notify_queue_tail);
+
+        if (head - tail >= NOTIFY_QUEUE_SIZE)
+            return UACPI_FALSE;
+        if (uacpi_atomic_cmpxchg32(&notify_queue_head, &head, head + 1))
+            break;
+    }
+
+    slot = &notify_queue[head % NOTIFY_QUEUE_SIZE];
+
+    slot->node = node;
+    // In case this node goes out of scope
+    uacpi_shareable_ref(node);
+
+    slot->value = value;
+    slot->node_object = node_object;
+    uacpi_object_ref(node_object);
+
+    state = uacpi_atomic_load32(&slot->state);
+    uacpi_atomic_store32(
+        &slot->state, (state & ~SLOT_PHASE_MASK) | SLOT_PHASE_READY
+    );
+
+    if (uacpi_atomic_inc32(&notify_queue_pending) != 1)
+        return UACPI_TRUE;
+
+    uacpi_work_group_begin(&notify_work_group);
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_NOTIFICATION, drain_notify_queue, UACPI_NULL
+    );
+    if (uacpi_unlikely_error(ret)) {
+        /*
+         * Leave the slot parked in the ring, the next successfully
+         * scheduled drain will pick it up.
+         */
+        uacpi_atomic_dec32(&notify_queue_pending);
+        uacpi_work_group_done(&notify_work_group);
+        uacpi_warn("unable to schedule notification work: %s\n",
+                   uacpi_status_to_string(ret));
+    }
+
+    return UACPI_TRUE;
 }
 
 uacpi_status uacpi_notify_all(uacpi_namespace_node *node, uacpi_u64 value)
@@ -77,21 +303,19 @@ uacpi_status uacpi_notify_all(uacpi_namespace_node *node, uacpi_u64 value)
     if (uacpi_unlikely(node_object == UACPI_NULL))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
-    ret = uacpi_acquire_native_mutex(notify_mutex);
-    if (uacpi_unlikely_error(ret))
-        return ret;
+    if (uacpi_atomic_load_ptr(&node_object->handlers->notify_head) ==
+            UACPI_NULL &&
+        uacpi_atomic_load_ptr(&g_uacpi_rt_ctx.root_object->handlers->notify_head) ==
+            UACPI_NULL)
+        return UACPI_STATUS_NO_HANDLER;
 
-    if (node_object->handlers->notify_head == UACPI_NULL &&
-        g_uacpi_rt_ctx.root_object->handlers->notify_head == UACPI_NULL) {
-        ret = UACPI_STATUS_NO_HANDLER;
-        goto out;
-    }
+    if (uacpi_likely(try_enqueue_notification(node, node_object, value)))
+        return UACPI_STATUS_OK;
 
+    // The ring is full, fall back to a heap-allocated work item
     ctx = uacpi_kernel_alloc(sizeof(*ctx));
-    if (uacpi_unlikely(ctx == UACPI_NULL)) {
-        ret = UACPI_STATUS_OUT_OF_MEMORY;
-        goto out;
-    }
+    if (uacpi_unlikely(ctx == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
 
     ctx->node = node;
     // In case this node goes out of scope
@@ -101,15 +325,16 @@ uacpi_status uacpi_notify_all(uacpi_namespace_node *node, uacpi_u64 value)
     ctx->node_object = uacpi_namespace_node_get_object(node);
     uacpi_object_ref(ctx->node_object);
 
+    uacpi_work_group_begin(&notify_work_group);
+
     ret = uacpi_kernel_schedule_work(UACPI_WORK_NOTIFICATION, do_notify, ctx);
     if (uacpi_unlikely_error(ret)) {
         uacpi_warn("unable to schedule notification work: %s\n",
                    uacpi_status_to_string(ret));
         free_notification_ctx(ctx);
+        uacpi_work_group_done(&notify_work_group);
     }
 
-out:
-    uacpi_release_native_mutex(notify_mutex);
     return ret;
 }
 
@@ -156,8 +381,6 @@ uacpi_status uacpi_install_notify_handler(
     if (uacpi_unlikely_error(ret))
         goto out_no_mutex;
 
-    uacpi_kernel_wait_for_work_completion();
-
     handlers = obj->handlers;
 
     if (handler_container(handlers, handler) != UACPI_NULL) {
@@ -173,7 +396,8 @@ uacpi_status uacpi_install_notify_handler(
     new_handler->user_context = handler_context;
     new_handler->next = handlers->notify_head;
 
-    handlers->notify_head = new_handler;
+    // Publish atomically, deliveries walk this list without the mutex
+    uacpi_atomic_store_ptr(&handlers->notify_head, new_handler);
 
 out:
     uacpi_release_native_mutex(notify_mutex);
@@ -210,8 +434,6 @@ uacpi_status uacpi_uninstall_notify_handler(
     if (uacpi_unlikely_error(ret))
         goto out_no_mutex;
 
-    uacpi_kernel_wait_for_work_completion();
-
     handlers = obj->handlers;
 
     containing = handler_container(handlers, handler);
@@ -224,14 +446,14 @@ uacpi_status uacpi_uninstall_notify_handler(
 
     // Are we the last linked handler?
     if (prev_handler == containing) {
-        handlers->notify_head = containing->next;
+        uacpi_atomic_store_ptr(&handlers->notify_head, containing->next);
         goto out;
     }
 
     // Nope, we're somewhere in the middle. Do a search.
     while (prev_handler) {
         if (prev_handler->next == containing) {
-            prev_handler->next = containing->next;
+            uacpi_atomic_store_ptr(&prev_handler->next, containing->next);
             goto out;
         }
 
@@ -244,8 +466,15 @@ out_no_mutex:
     if (node != uacpi_namespace_root())
         uacpi_object_unref(obj);
 
-    if (uacpi_likely_success(ret))
+    if (uacpi_likely_success(ret)) {
+        /*
+         * Deliveries don't take the notify mutex, so an in-flight one may
+         * have grabbed this handler right before it got unlinked. Wait for
+         * it to finish before freeing the memory.
+         */
+        uacpi_wait_for_group_work_completion(&notify_work_group);
         uacpi_free(containing, sizeof(*containing));
+    }
 
     return ret;
 }
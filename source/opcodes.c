@@ -1,5 +1,19 @@
 #include <uacpi/internal/opcodes.h>
 
+#ifdef UACPI_COMPACT_OPCODE_TABLE
+
+#define UACPI_OP(opname, opcode, ...) \
+    { .decode_ops = __VA_ARGS__, .code = opcode },
+
+#define UACPI_OUT_OF_LINE_OP(opname, opcode, out_of_line_buf, props) \
+    {                                                                \
+      .indirect_decode_ops = out_of_line_buf,                        \
+      .properties = props,                                           \
+      .code = opcode,                                                \
+    },
+
+#else
+
 #define UACPI_OP(opname, opcode, ...) \
     { #opname, .decode_ops = __VA_ARGS__, .code = opcode },
 
@@ -11,6 +25,8 @@
       .code = opcode,                                                \
     },
 
+#endif
+
 static const struct uacpi_op_spec opcode_table[0x100] = {
     UACPI_ENUMERATE_OPCODES
 };
@@ -46,6 +62,37 @@ const struct uacpi_op_spec *uacpi_get_op_spec(uacpi_aml_op op)
     return &opcode_table[op];
 }
 
+#ifdef UACPI_COMPACT_OPCODE_TABLE
+
+/*
+ * Opcode names live in cold tables of their own so that they don't dilute the
+ * dispatch metadata above, which is read on every op. The expansion order here
+ * matches opcode_table/ext_opcode_table exactly.
+ */
+#undef UACPI_OP
+#undef UACPI_OUT_OF_LINE_OP
+
+#define UACPI_OP(opname, opcode, ...) #opname,
+#define UACPI_OUT_OF_LINE_OP(opname, opcode, out_of_line_buf, props) #opname,
+
+static const uacpi_char *const opcode_name_table[0x100] = {
+    UACPI_ENUMERATE_OPCODES
+};
+
+static const uacpi_char *const ext_opcode_name_table[] = {
+    UACPI_ENUMERATE_EXT_OPCODES
+};
+
+const uacpi_char *uacpi_get_op_name(uacpi_aml_op op)
+{
+    if (op > 0xFF)
+        return ext_opcode_name_table[ext_op_to_idx[_(op)]];
+
+    return opcode_name_table[op];
+}
+
+#endif
+
 #define PARSE_FIELD_ELEMENTS(parse_loop_pc)                            \
     /* Parse every field element found inside */                       \
     UACPI_PARSE_OP_IF_HAS_DATA, 44,                                    \
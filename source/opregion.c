@@ -7,6 +7,8 @@
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/mutex.h>
 #include <uacpi/internal/interpreter.h>
+#include <uacpi/internal/dynamic_array.h>
+#include <uacpi/platform/atomic.h>
 
 struct uacpi_recursive_lock g_opregion_lock;
 
@@ -86,6 +88,86 @@ void uacpi_trace_region_io(
 #endif
 }
 
+struct opregion_trace_record {
+    uacpi_u64 offset;
+    uacpi_u64 latency_ns;
+    uacpi_u32 count;
+    uacpi_u8 space;
+    uacpi_u8 byte_width;
+    uacpi_u8 op;
+};
+
+static struct opregion_trace_record
+    opregion_trace_ring[UACPI_OPREGION_TRACE_RING_SIZE];
+static uacpi_u32 opregion_trace_cursor;
+
+static void trace_opregion_access(
+    uacpi_u8 space, uacpi_region_op op, uacpi_u64 offset,
+    uacpi_u8 byte_width, uacpi_u32 count, uacpi_u64 latency_ns
+)
+{
+    struct opregion_trace_record *rec;
+    uacpi_u32 slot;
+
+    /*
+     * A single atomic increment claims the slot, no publish handshake: a
+     * writer that gets lapped by the ring may produce a torn record, which is
+     * tolerable for a diagnostic facility and keeps the cost per access down
+     * to the increment and a few stores.
+     */
+    slot = (uacpi_atomic_inc32(&opregion_trace_cursor) - 1) &
+           (UACPI_OPREGION_TRACE_RING_SIZE - 1);
+
+    rec = &opregion_trace_ring[slot];
+    rec->offset = offset;
+    rec->latency_ns = latency_ns;
+    rec->count = count;
+    rec->space = space;
+    rec->byte_width = byte_width;
+    rec->op = op;
+}
+
+void uacpi_dump_opregion_trace(void)
+{
+    uacpi_u32 cursor, count, start, i;
+
+    cursor = uacpi_atomic_load32(&opregion_trace_cursor);
+    count = UACPI_MIN(cursor, UACPI_OPREGION_TRACE_RING_SIZE);
+    start = cursor - count;
+
+    uacpi_info("opregion access trace, %u most recent accesses:\n", count);
+
+    for (i = 0; i < count; ++i) {
+        struct opregion_trace_record *rec;
+        const uacpi_char *type_str;
+
+        rec = &opregion_trace_ring[
+            (start + i) & (UACPI_OPREGION_TRACE_RING_SIZE - 1)
+        ];
+
+        switch (rec->op) {
+        case UACPI_REGION_OP_READ:
+        case UACPI_REGION_OP_READ_MANY:
+            type_str = "read";
+            break;
+        case UACPI_REGION_OP_WRITE:
+        case UACPI_REGION_OP_WRITE_MANY:
+            type_str = "write";
+            break;
+        default:
+            type_str = "<INVALID-OP>";
+        }
+
+        uacpi_info(
+            "  #%02u %s %s[0x%016"UACPI_PRIX64"] width %d count %u "
+            "took %"UACPI_PRIu64"ns\n",
+            i, type_str, uacpi_address_space_to_string(rec->space),
+            UACPI_FMT64(rec->offset), rec->byte_width, rec->count,
+            UACPI_FMT64(rec->latency_ns)
+        );
+    }
+}
+
 static uacpi_bool space_needs_reg(enum uacpi_address_space space)
 {
     if (space == UACPI_ADDRESS_SPACE_SYSTEM_MEMORY ||
@@ -96,14 +178,29 @@ static uacpi_bool space_needs_reg(enum uacpi_address_space space)
     return UACPI_TRUE;
 }
 
-static uacpi_status region_run_reg(
-    uacpi_namespace_node *node, uacpi_u8 connection_code
+static uacpi_status allocate_reg_args(uacpi_object **args)
+{
+    args[0] = uacpi_create_object(UACPI_OBJECT_INTEGER);
+    if (uacpi_unlikely(args[0] == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    args[1] = uacpi_create_object(UACPI_OBJECT_INTEGER);
+    if (uacpi_unlikely(args[1] == UACPI_NULL)) {
+        uacpi_object_unref(args[0]);
+        return UACPI_STATUS_OUT_OF_MEMORY;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status region_run_reg_with_args(
+    uacpi_namespace_node *node, uacpi_u8 connection_code,
+    uacpi_object_array *method_args
 )
 {
     uacpi_status ret;
     uacpi_namespace_node *reg_node;
-    uacpi_object_array method_args;
-    uacpi_object *reg_obj, *args[2];
+    uacpi_object *reg_obj;
 
     ret = uacpi_namespace_node_resolve(
         node->parent, "_REG", UACPI_SHOULD_LOCK_NO,
@@ -118,27 +215,36 @@ static uacpi_status region_run_reg(
     if (uacpi_unlikely(reg_obj == UACPI_NULL))
         return UACPI_STATUS_OK;
 
-    args[0] = uacpi_create_object(UACPI_OBJECT_INTEGER);
-    if (uacpi_unlikely(args[0] == UACPI_NULL))
-        return UACPI_STATUS_OUT_OF_MEMORY;
-
-    args[1] = uacpi_create_object(UACPI_OBJECT_INTEGER);
-    if (uacpi_unlikely(args[1] == UACPI_NULL)) {
-        uacpi_object_unref(args[0]);
-        return UACPI_STATUS_OUT_OF_MEMORY;
-    }
-
-    args[0]->integer = uacpi_namespace_node_get_object(node)->op_region->space;
-    args[1]->integer = connection_code;
-    method_args.objects = args;
-    method_args.count = 2;
+    method_args->objects[0]->integer =
+        uacpi_namespace_node_get_object(node)->op_region->space;
+    method_args->objects[1]->integer = connection_code;
 
     ret = uacpi_execute_control_method(
-        reg_node, reg_obj->method, &method_args, UACPI_NULL
+        reg_node, reg_obj->method, method_args, UACPI_NULL
     );
     if (uacpi_unlikely_error(ret))
         uacpi_trace_region_error(node, "error during _REG execution for", ret);
 
+    return ret;
+}
+
+static uacpi_status region_run_reg(
+    uacpi_namespace_node *node, uacpi_u8 connection_code
+)
+{
+    uacpi_status ret;
+    uacpi_object_array method_args;
+    uacpi_object *args[2];
+
+    ret = allocate_reg_args(args);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    method_args.objects = args;
+    method_args.count = 2;
+
+    ret = region_run_reg_with_args(node, connection_code, &method_args);
+
     uacpi_object_unref(args[0]);
     uacpi_object_unref(args[1]);
     return ret;
@@ -205,7 +311,9 @@ static uacpi_operation_region *find_previous_region_link(
     return parent;
 }
 
-uacpi_status uacpi_opregion_attach(uacpi_namespace_node *node)
+static uacpi_status do_opregion_attach(
+    uacpi_namespace_node *node, uacpi_object **out_obj
+)
 {
     uacpi_object *obj;
     uacpi_operation_region *region;
@@ -222,6 +330,7 @@ uacpi_status uacpi_opregion_attach(uacpi_namespace_node *node)
     if (uacpi_unlikely(obj == UACPI_NULL))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
+    *out_obj = obj;
     region = obj->op_region;
 
     if (region->handler == UACPI_NULL)
@@ -250,6 +359,13 @@ uacpi_status uacpi_opregion_attach(uacpi_namespace_node *node)
     return ret;
 }
 
+uacpi_status uacpi_opregion_attach(uacpi_namespace_node *node)
+{
+    uacpi_object *obj;
+
+    return do_opregion_attach(node, &obj);
+}
+
 static void region_install_handler(
     uacpi_namespace_node *node, uacpi_address_space_handler *handler
 )
@@ -426,20 +542,23 @@ static uacpi_iteration_decision do_install_or_uninstall_handler(
     return UACPI_ITERATION_DECISION_CONTINUE;
 }
 
-struct reg_run_ctx {
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE(reg_node_array, uacpi_namespace_node*, 8)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(reg_node_array, uacpi_namespace_node*, static)
+
+struct reg_collect_ctx {
     uacpi_u8 space;
     uacpi_u8 connection_code;
-    uacpi_size reg_executed;
-    uacpi_size reg_errors;
+    struct reg_node_array nodes;
+    uacpi_bool oom;
 };
 
-static uacpi_iteration_decision do_run_reg(
+static uacpi_iteration_decision do_collect_reg_nodes(
     void *opaque, uacpi_namespace_node *node, uacpi_u32 depth
 )
 {
-    struct reg_run_ctx *ctx = opaque;
+    struct reg_collect_ctx *ctx = opaque;
     uacpi_operation_region *region;
-    uacpi_status ret;
+    uacpi_namespace_node **slot;
     uacpi_bool was_regged;
 
     UACPI_UNUSED(depth);
@@ -453,23 +572,14 @@ static uacpi_iteration_decision do_run_reg(
     if (was_regged == (ctx->connection_code == ACPI_REG_CONNECT))
         return UACPI_ITERATION_DECISION_CONTINUE;
 
-    ret = region_run_reg(node, ctx->connection_code);
-    if (ctx->connection_code == ACPI_REG_DISCONNECT)
-        region->state_flags &= ~UACPI_OP_REGION_STATE_REG_EXECUTED;
-
-    if (ret == UACPI_STATUS_NOT_FOUND)
-        return UACPI_ITERATION_DECISION_CONTINUE;
-
-    if (ctx->connection_code == ACPI_REG_CONNECT)
-        region->state_flags |= UACPI_OP_REGION_STATE_REG_EXECUTED;
-
-    ctx->reg_executed++;
-
-    if (uacpi_unlikely_error(ret)) {
-        ctx->reg_errors++;
-        return UACPI_ITERATION_DECISION_CONTINUE;
+    slot = reg_node_array_alloc(&ctx->nodes);
+    if (uacpi_unlikely(slot == UACPI_NULL)) {
+        ctx->oom = UACPI_TRUE;
+        return UACPI_ITERATION_DECISION_BREAK;
     }
 
+    uacpi_shareable_ref(node);
+    *slot = node;
     return UACPI_ITERATION_DECISION_CONTINUE;
 }
 
@@ -478,10 +588,14 @@ static uacpi_status reg_or_unreg_all_opregions(
     uacpi_u8 connection_code
 )
 {
+    uacpi_status ret = UACPI_STATUS_OK;
     uacpi_address_space_handlers *handlers;
     uacpi_bool is_connect;
     enum uacpi_permanent_only perm_only;
-    struct reg_run_ctx ctx = {
+    uacpi_size i, num_nodes, reg_executed = 0, reg_errors = 0;
+    uacpi_object_array method_args;
+    uacpi_object *args[2];
+    struct reg_collect_ctx ctx = {
         .space = space,
         .connection_code = connection_code,
     };
@@ -502,20 +616,85 @@ static uacpi_status reg_or_unreg_all_opregions(
      */
     perm_only = is_connect ? UACPI_PERMANENT_ONLY_YES : UACPI_PERMANENT_ONLY_NO;
 
+    /*
+     * Collect every affected region first: _REG methods are free to mutate
+     * the namespace, so we don't want any of them running in the middle of
+     * the subtree walk.
+     */
     uacpi_namespace_do_for_each_child(
-        device_node, do_run_reg, UACPI_NULL,
+        device_node, do_collect_reg_nodes, UACPI_NULL,
         UACPI_OBJECT_OPERATION_REGION_BIT, UACPI_MAX_DEPTH_ANY,
         UACPI_SHOULD_LOCK_NO, perm_only, &ctx
     );
+    if (uacpi_unlikely(ctx.oom)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    num_nodes = reg_node_array_size(&ctx.nodes);
+    if (num_nodes == 0)
+        goto out_trace;
+
+    // One shared set of argument objects for the entire batch
+    ret = allocate_reg_args(args);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    method_args.objects = args;
+    method_args.count = 2;
+
+    for (i = 0; i < num_nodes; ++i) {
+        uacpi_status reg_ret;
+        uacpi_namespace_node *node;
+        uacpi_operation_region *region;
+        uacpi_object *obj;
+
+        node = *reg_node_array_at(&ctx.nodes, i);
+
+        // An earlier _REG might have unloaded the table defining this region
+        obj = uacpi_namespace_node_get_object_typed(
+            node, UACPI_OBJECT_OPERATION_REGION_BIT
+        );
+        if (uacpi_unlikely(obj == UACPI_NULL ||
+                           uacpi_namespace_node_is_dangling(node)))
+            continue;
+        region = obj->op_region;
+
+        reg_ret = region_run_reg_with_args(node, connection_code, &method_args);
+        if (connection_code == ACPI_REG_DISCONNECT)
+            region->state_flags &= ~UACPI_OP_REGION_STATE_REG_EXECUTED;
+
+        if (reg_ret == UACPI_STATUS_NOT_FOUND)
+            continue;
 
+        if (connection_code == ACPI_REG_CONNECT)
+            region->state_flags |= UACPI_OP_REGION_STATE_REG_EXECUTED;
+
+        reg_executed++;
+
+        if (uacpi_unlikely_error(reg_ret))
+            reg_errors++;
+    }
+
+    uacpi_object_unref(args[0]);
+    uacpi_object_unref(args[1]);
+
+out_trace:
     uacpi_trace(
         "%sactivated all '%s' opregions controlled by '%.4s', "
         "%zu _REG() calls (%zu errors)\n",
         connection_code == ACPI_REG_CONNECT ? "" : "de",
         uacpi_address_space_to_string(space),
-        device_node->name.text, ctx.reg_executed, ctx.reg_errors
+        device_node->name.text, reg_executed, reg_errors
     );
-    return UACPI_STATUS_OK;
+
+out:
+    num_nodes = reg_node_array_size(&ctx.nodes);
+    for (i = 0; i < num_nodes; ++i)
+        uacpi_namespace_node_unref(*reg_node_array_at(&ctx.nodes, i));
+    reg_node_array_clear(&ctx.nodes);
+
+    return ret;
 }
 
 static uacpi_address_space_handlers *extract_handlers(
@@ -573,6 +752,59 @@ out:
     return ret;
 }
 
+struct reg_all_work_ctx {
+    uacpi_namespace_node *device_node;
+    enum uacpi_address_space space;
+    uacpi_reg_all_opregions_callback callback;
+    uacpi_handle user;
+};
+
+static void do_reg_all_opregions_work(uacpi_handle opaque)
+{
+    struct reg_all_work_ctx *ctx = opaque;
+    uacpi_status ret;
+
+    ret = uacpi_reg_all_opregions(ctx->device_node, ctx->space);
+    ctx->callback(ret, ctx->user);
+
+    uacpi_namespace_node_unref(ctx->device_node);
+    uacpi_free(ctx, sizeof(*ctx));
+}
+
+uacpi_status uacpi_reg_all_opregions_async(
+    uacpi_namespace_node *device_node, enum uacpi_address_space space,
+    uacpi_reg_all_opregions_callback callback, uacpi_handle user
+)
+{
+    uacpi_status ret;
+    struct reg_all_work_ctx *ctx;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    if (uacpi_unlikely(device_node == UACPI_NULL || callback == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    ctx = uacpi_kernel_alloc(sizeof(*ctx));
+    if (uacpi_unlikely(ctx == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    uacpi_shareable_ref(device_node);
+    ctx->device_node = device_node;
+    ctx->space = space;
+    ctx->callback = callback;
+    ctx->user = user;
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_NOTIFICATION, do_reg_all_opregions_work, ctx
+    );
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_namespace_node_unref(device_node);
+        uacpi_free(ctx, sizeof(*ctx));
+    }
+
+    return ret;
+}
+
 uacpi_status uacpi_install_address_space_handler_with_flags(
     uacpi_namespace_node *device_node, enum uacpi_address_space space,
     uacpi_region_handler handler, uacpi_handle handler_context,
@@ -791,7 +1023,7 @@ uacpi_status uacpi_dispatch_opregion_io(
     uacpi_operation_region *region;
     uacpi_address_space_handler *handler;
     uacpi_address_space space;
-    uacpi_u64 offset_end;
+    uacpi_u64 offset_end, begin_ts;
 
     uacpi_region_rw_data data = {
         .byte_width = byte_width,
@@ -802,7 +1034,7 @@ uacpi_status uacpi_dispatch_opregion_io(
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    ret = uacpi_opregion_attach(region_node);
+    ret = do_opregion_attach(region_node, &obj);
     if (uacpi_unlikely_error(ret)) {
         uacpi_trace_region_error(
             region_node, "unable to attach", ret
@@ -810,14 +1042,6 @@ uacpi_status uacpi_dispatch_opregion_io(
         goto out;
     }
 
-    obj = uacpi_namespace_node_get_object_typed(
-        region_node, UACPI_OBJECT_OPERATION_REGION_BIT
-    );
-    if (uacpi_unlikely(obj == UACPI_NULL)) {
-        ret = UACPI_STATUS_INVALID_ARGUMENT;
-        goto out;
-    }
-
     region = obj->op_region;
     space = region->space;
     handler = region->handler;
@@ -857,7 +1081,12 @@ uacpi_status uacpi_dispatch_opregion_io(
     uacpi_object_ref(obj);
     uacpi_namespace_write_unlock();
 
+    begin_ts = uacpi_kernel_get_nanoseconds_since_boot();
     ret = handler->callback(op, &data);
+    trace_opregion_access(
+        space, op, data.offset, byte_width, 1,
+        uacpi_kernel_get_nanoseconds_since_boot() - begin_ts
+    );
 
     uacpi_namespace_write_lock();
     uacpi_object_unref(obj);
@@ -879,3 +1108,141 @@ out:
     uacpi_recursive_lock_release(&g_opregion_lock);
     return ret;
 }
+
+uacpi_bool uacpi_opregion_supports_rw_many(uacpi_namespace_node *region_node)
+{
+    uacpi_object *obj;
+    uacpi_address_space_handler *handler;
+
+    obj = uacpi_namespace_node_get_object_typed(
+        region_node, UACPI_OBJECT_OPERATION_REGION_BIT
+    );
+    if (uacpi_unlikely(obj == UACPI_NULL))
+        return UACPI_FALSE;
+
+    handler = obj->op_region->handler;
+    if (handler == UACPI_NULL)
+        return UACPI_FALSE;
+
+    return (handler->flags & UACPI_ADDRESS_SPACE_HANDLER_RW_MANY) != 0;
+}
+
+static void trace_many_region_io(
+    uacpi_namespace_node *region_node, uacpi_address_space space,
+    uacpi_region_op op, uacpi_u64 base_offset, uacpi_u8 byte_width,
+    uacpi_u64 *values, uacpi_size count
+)
+{
+    uacpi_size i;
+
+    for (i = 0; i < count; ++i) {
+        uacpi_trace_region_io(
+            region_node, space, op,
+            base_offset + i * byte_width, byte_width, values[i]
+        );
+    }
+}
+
+uacpi_status uacpi_dispatch_opregion_rw_many(
+    uacpi_namespace_node *region_node, uacpi_u32 offset, uacpi_u8 byte_width,
+    uacpi_region_op op, uacpi_u64 *values, uacpi_size count
+)
+{
+    uacpi_status ret;
+    uacpi_object *obj;
+    uacpi_operation_region *region;
+    uacpi_address_space_handler *handler;
+    uacpi_address_space space;
+    uacpi_u64 offset_end, begin_ts;
+
+    uacpi_region_rw_many_data data = {
+        .byte_width = byte_width,
+        .offset = offset,
+        .values = values,
+        .count = count,
+    };
+
+    ret = upgrade_to_opregion_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = do_opregion_attach(region_node, &obj);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_trace_region_error(
+            region_node, "unable to attach", ret
+        );
+        goto out;
+    }
+
+    region = obj->op_region;
+    space = region->space;
+    handler = region->handler;
+
+    // The caller is expected to have verified this beforehand
+    if (uacpi_unlikely(!(handler->flags &
+                         UACPI_ADDRESS_SPACE_HANDLER_RW_MANY))) {
+        ret = UACPI_STATUS_UNIMPLEMENTED;
+        goto out;
+    }
+
+    offset_end = offset;
+    offset_end += (uacpi_u64)byte_width * count;
+    data.offset += region->offset;
+
+    if (uacpi_unlikely(region->length < offset_end ||
+        data.offset < offset)) {
+        const uacpi_char *path;
+
+        path = uacpi_namespace_node_generate_absolute_path(region_node);
+        uacpi_error(
+            "out-of-bounds access to opregion %s[0x%"UACPI_PRIX64"->"
+            "0x%"UACPI_PRIX64"] at 0x%"UACPI_PRIX64" (idx=%u, width=%d, "
+            "count=%zu)\n",
+            path, UACPI_FMT64(region->offset),
+            UACPI_FMT64(region->offset + region->length),
+            UACPI_FMT64(data.offset), offset, byte_width, count
+        );
+        uacpi_free_dynamic_string(path);
+        ret = UACPI_STATUS_AML_OUT_OF_BOUNDS_INDEX;
+        goto out;
+    }
+
+    data.handler_context = handler->user_context;
+    data.region_context = region->user_context;
+
+    if (op == UACPI_REGION_OP_WRITE_MANY) {
+        trace_many_region_io(
+            region_node, space, UACPI_REGION_OP_WRITE, data.offset,
+            byte_width, values, count
+        );
+    }
+
+    uacpi_object_ref(obj);
+    uacpi_namespace_write_unlock();
+
+    begin_ts = uacpi_kernel_get_nanoseconds_since_boot();
+    ret = handler->callback(op, &data);
+    trace_opregion_access(
+        space, op, data.offset, byte_width, count,
+        uacpi_kernel_get_nanoseconds_since_boot() - begin_ts
+    );
+
+    uacpi_namespace_write_lock();
+    uacpi_object_unref(obj);
+
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_trace_region_error(region_node, "unable to perform IO", ret);
+        goto out;
+    }
+
+    if (op == UACPI_REGION_OP_READ_MANY) {
+        trace_many_region_io(
+            region_node, space, UACPI_REGION_OP_READ, data.offset,
+            byte_width, values, count
+        );
+    }
+
+out:
+    uacpi_recursive_lock_release(&g_opregion_lock);
+    return ret;
+}
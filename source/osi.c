@@ -8,6 +8,10 @@
 
 struct registered_interface {
     const uacpi_char *name;
+
+    // Computed once at registration, _OSI lookups only strcmp on a hash match
+    uacpi_u32 name_hash;
+
     uacpi_u8 weight;
     uacpi_u8 kind;
 
@@ -21,11 +25,38 @@ struct registered_interface {
     struct registered_interface *next;
 };
 
+#define INTERFACE_BUCKET_COUNT 16
+
 static uacpi_handle interface_mutex;
-static struct registered_interface *registered_interfaces;
+
+/*
+ * All registered interfaces, predefined and host-installed alike, bucketed
+ * by name hash. Firmware tends to probe dozens of interface strings through
+ * _OSI during namespace load, so lookups shouldn't degenerate into a strcmp
+ * against every interface we know about.
+ */
+static struct registered_interface *interface_buckets[INTERFACE_BUCKET_COUNT];
 static uacpi_interface_handler interface_handler;
 static uacpi_u32 latest_queried_interface;
 
+static uacpi_u32 hash_interface_name(const uacpi_char *name)
+{
+    // FNV-1a
+    uacpi_u32 hash = 2166136261u;
+
+    while (*name) {
+        hash ^= (uacpi_u8)*name++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static struct registered_interface **bucket_of_hash(uacpi_u32 hash)
+{
+    return &interface_buckets[hash & (INTERFACE_BUCKET_COUNT - 1)];
+}
+
 #define WINDOWS(string, interface)                            \
     {                                                         \
         .name = "Windows "string,                             \
@@ -89,37 +120,49 @@ uacpi_status uacpi_initialize_interfaces(void)
 {
     uacpi_size i;
 
-    registered_interfaces = &predefined_interfaces[0];
-
     interface_mutex = uacpi_kernel_create_mutex();
     if (uacpi_unlikely(interface_mutex == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
-    for (i = 0; i < (UACPI_ARRAY_SIZE(predefined_interfaces) - 1); ++i)
-        predefined_interfaces[i].next = &predefined_interfaces[i + 1];
+    for (i = 0; i < UACPI_ARRAY_SIZE(predefined_interfaces); ++i) {
+        struct registered_interface *interface = &predefined_interfaces[i];
+        struct registered_interface **bucket;
+
+        interface->name_hash = hash_interface_name(interface->name);
+
+        bucket = bucket_of_hash(interface->name_hash);
+        interface->next = *bucket;
+        *bucket = interface;
+    }
 
     return UACPI_STATUS_OK;
 }
 
 void uacpi_deinitialize_interfaces(void)
 {
-    struct registered_interface *iface, *next_iface = registered_interfaces;
+    struct registered_interface *iface, *next_iface;
+    uacpi_size i;
 
-    while (next_iface) {
-        iface = next_iface;
-        next_iface = iface->next;
+    for (i = 0; i < INTERFACE_BUCKET_COUNT; ++i) {
+        next_iface = interface_buckets[i];
+        interface_buckets[i] = UACPI_NULL;
 
-        iface->next = UACPI_NULL;
+        while (next_iface) {
+            iface = next_iface;
+            next_iface = iface->next;
 
-        if (iface->dynamic) {
-            uacpi_free_dynamic_string(iface->name);
-            uacpi_free(iface, sizeof(*iface));
-            continue;
-        }
+            iface->next = UACPI_NULL;
+
+            if (iface->dynamic) {
+                uacpi_free_dynamic_string(iface->name);
+                uacpi_free(iface, sizeof(*iface));
+                continue;
+            }
 
-        // Only features are disabled by default
-        iface->disabled = iface->kind == UACPI_INTERFACE_KIND_FEATURE ?
-                UACPI_TRUE : UACPI_FALSE;
+            // Only features are disabled by default
+            iface->disabled = iface->kind == UACPI_INTERFACE_KIND_FEATURE ?
+                    UACPI_TRUE : UACPI_FALSE;
+        }
     }
 
     if (interface_mutex)
@@ -128,7 +171,6 @@ void uacpi_deinitialize_interfaces(void)
     interface_mutex = UACPI_NULL;
     interface_handler = UACPI_NULL;
     latest_queried_interface = 0;
-    registered_interfaces = UACPI_NULL;
 }
 
 uacpi_vendor_interface uacpi_latest_queried_vendor_interface(void)
@@ -140,10 +182,12 @@ static struct registered_interface *find_interface_unlocked(
     const uacpi_char *name
 )
 {
-    struct registered_interface *interface = registered_interfaces;
+    uacpi_u32 hash = hash_interface_name(name);
+    struct registered_interface *interface = *bucket_of_hash(hash);
 
     while (interface) {
-        if (uacpi_strcmp(interface->name, name) == 0)
+        if (interface->name_hash == hash &&
+            uacpi_strcmp(interface->name, name) == 0)
             return interface;
 
         interface = interface->next;
@@ -156,13 +200,15 @@ static struct registered_interface *find_host_interface_unlocked(
     uacpi_host_interface type
 )
 {
-    struct registered_interface *interface = registered_interfaces;
-
-    while (interface) {
-        if (interface->host_type == type)
-            return interface;
+    struct registered_interface *interface;
+    uacpi_size i;
 
-        interface = interface->next;
+    for (i = 0; i < INTERFACE_BUCKET_COUNT; ++i) {
+        for (interface = interface_buckets[i]; interface;
+             interface = interface->next) {
+            if (interface->host_type == type)
+                return interface;
+        }
     }
 
     return UACPI_NULL;
@@ -172,7 +218,7 @@ uacpi_status uacpi_install_interface(
     const uacpi_char *name, uacpi_interface_kind kind
 )
 {
-    struct registered_interface *interface;
+    struct registered_interface *interface, **bucket;
     uacpi_status ret;
     uacpi_char *name_copy;
     uacpi_size name_size;
@@ -208,13 +254,16 @@ uacpi_status uacpi_install_interface(
 
     uacpi_memcpy(name_copy, name, name_size);
     interface->name = name_copy;
+    interface->name_hash = hash_interface_name(name_copy);
     interface->weight = 0;
     interface->kind = kind;
     interface->host_type = 0;
     interface->disabled = 0;
     interface->dynamic = 1;
-    interface->next = registered_interfaces;
-    registered_interfaces = interface;
+
+    bucket = bucket_of_hash(interface->name_hash);
+    interface->next = *bucket;
+    *bucket = interface;
 
 out:
     uacpi_release_native_mutex(interface_mutex);
@@ -223,7 +272,8 @@ out:
 
 uacpi_status uacpi_uninstall_interface(const uacpi_char *name)
 {
-    struct registered_interface *cur, *prev;
+    struct registered_interface *cur, *prev, **bucket;
+    uacpi_u32 hash;
     uacpi_status ret;
 
     UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
@@ -232,12 +282,14 @@ uacpi_status uacpi_uninstall_interface(const uacpi_char *name)
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    cur = registered_interfaces;
+    hash = hash_interface_name(name);
+    bucket = bucket_of_hash(hash);
+    cur = *bucket;
     prev = cur;
 
     ret = UACPI_STATUS_NOT_FOUND;
     while (cur) {
-        if (uacpi_strcmp(cur->name, name) != 0) {
+        if (cur->name_hash != hash || uacpi_strcmp(cur->name, name) != 0) {
             prev = cur;
             cur = cur->next;
             continue;
@@ -245,7 +297,7 @@ uacpi_status uacpi_uninstall_interface(const uacpi_char *name)
 
         if (cur->dynamic) {
             if (prev == cur) {
-                registered_interfaces = cur->next;
+                *bucket = cur->next;
             } else {
                 prev->next = cur->next;
             }
@@ -338,6 +390,7 @@ uacpi_status uacpi_bulk_configure_interfaces(
 {
     uacpi_status ret;
     struct registered_interface *interface;
+    uacpi_size i;
 
     UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
 
@@ -345,12 +398,13 @@ uacpi_status uacpi_bulk_configure_interfaces(
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    interface = registered_interfaces;
-    while (interface) {
-        if (kind & interface->kind)
-            interface->disabled = (action == UACPI_INTERFACE_ACTION_DISABLE);
-
-        interface = interface->next;
+    for (i = 0; i < INTERFACE_BUCKET_COUNT; ++i) {
+        for (interface = interface_buckets[i]; interface;
+             interface = interface->next) {
+            if (kind & interface->kind)
+                interface->disabled =
+                    (action == UACPI_INTERFACE_ACTION_DISABLE);
+        }
     }
 
     uacpi_release_native_mutex(interface_mutex);
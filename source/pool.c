@@ -0,0 +1,274 @@
+#include <uacpi/internal/pool.h>
+#include <uacpi/internal/namespace.h>
+#include <uacpi/internal/types.h>
+#include <uacpi/internal/stdlib.h>
+#include <uacpi/kernel_api.h>
+
+// Attribute allocations in this file under UACPI_MEMORY_ACCOUNTING
+#undef UACPI_TRACKED_SUBSYSTEM
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_INTERPRETER
+
+/*
+ * Target size of one bulk refill from uacpi_kernel_alloc. Namespace load on a
+ * big DSDT allocates tens of thousands of nodes/objects, so we want refills to
+ * be reasonably rare, while a pool that ends up barely used shouldn't pin too
+ * much memory either.
+ */
+#define POOL_SLAB_TARGET_BYTES 4096
+
+struct uacpi_pool_slab {
+    struct uacpi_pool_slab *next;
+};
+
+static struct uacpi_pool namespace_node_pool;
+static struct uacpi_pool object_pool;
+
+struct uacpi_pool *uacpi_namespace_node_pool(void)
+{
+    return &namespace_node_pool;
+}
+
+struct uacpi_pool *uacpi_object_pool(void)
+{
+    return &object_pool;
+}
+
+static uacpi_size pool_slab_bytes(struct uacpi_pool *pool)
+{
+    return sizeof(struct uacpi_pool_slab) +
+           pool->object_size * pool->objects_per_slab;
+}
+
+static uacpi_status pool_init(struct uacpi_pool *pool, uacpi_size object_size)
+{
+    // Freed objects are linked through their first bytes
+    object_size = UACPI_MAX(object_size, sizeof(void*));
+    object_size = UACPI_ALIGN_UP(object_size, sizeof(void*), uacpi_size);
+
+    pool->object_size = object_size;
+    pool->objects_per_slab =
+        (POOL_SLAB_TARGET_BYTES - sizeof(struct uacpi_pool_slab)) / object_size;
+    if (uacpi_unlikely(pool->objects_per_slab == 0))
+        pool->objects_per_slab = 1;
+
+    pool->slabs = UACPI_NULL;
+    pool->free_list = UACPI_NULL;
+
+    pool->lock = uacpi_kernel_create_spinlock();
+    if (uacpi_unlikely(pool->lock == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    return UACPI_STATUS_OK;
+}
+
+static void pool_deinit(struct uacpi_pool *pool)
+{
+    struct uacpi_pool_slab *slab, *next;
+
+    for (slab = pool->slabs; slab != UACPI_NULL; slab = next) {
+        next = slab->next;
+        uacpi_free(slab, pool_slab_bytes(pool));
+    }
+
+    if (pool->lock != UACPI_NULL)
+        uacpi_kernel_free_spinlock(pool->lock);
+
+    uacpi_memzero(pool, sizeof(*pool));
+}
+
+/*
+ * Carve a fresh slab into free objects. Called with the pool lock held, but
+ * drops it around the slab allocation: the spinlock disables interrupts,
+ * while uacpi_kernel_alloc is allowed to sleep. Returns with the lock
+ * re-acquired and *flags updated accordingly.
+ */
+static uacpi_bool pool_refill(struct uacpi_pool *pool, uacpi_cpu_flags *flags)
+{
+    struct uacpi_pool_slab *slab;
+    uacpi_u8 *object;
+    uacpi_size i;
+
+    uacpi_kernel_unlock_spinlock(pool->lock, *flags);
+    slab = uacpi_kernel_alloc(pool_slab_bytes(pool));
+    *flags = uacpi_kernel_lock_spinlock(pool->lock);
+
+    // Another thread may have refilled while the lock was dropped
+    if (uacpi_unlikely(slab == UACPI_NULL))
+        return pool->free_list != UACPI_NULL;
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    object = (uacpi_u8*)(slab + 1);
+    for (i = 0; i < pool->objects_per_slab; i++) {
+        *(void**)object = pool->free_list;
+        pool->free_list = object;
+        object += pool->object_size;
+    }
+
+    return UACPI_TRUE;
+}
+
+void *uacpi_pool_alloc(struct uacpi_pool *pool)
+{
+    uacpi_cpu_flags flags;
+    void *object;
+
+    flags = uacpi_kernel_lock_spinlock(pool->lock);
+
+    if (pool->free_list == UACPI_NULL &&
+        uacpi_unlikely(!pool_refill(pool, &flags))) {
+        uacpi_kernel_unlock_spinlock(pool->lock, flags);
+        return UACPI_NULL;
+    }
+
+    object = pool->free_list;
+    pool->free_list = *(void**)object;
+
+    uacpi_kernel_unlock_spinlock(pool->lock, flags);
+    return object;
+}
+
+void *uacpi_pool_alloc_zeroed(struct uacpi_pool *pool)
+{
+    void *object;
+
+    object = uacpi_pool_alloc(pool);
+    if (uacpi_likely(object != UACPI_NULL))
+        uacpi_memzero(object, pool->object_size);
+
+    return object;
+}
+
+uacpi_bool uacpi_pool_alloc_zeroed_bulk(
+    struct uacpi_pool *pool, void **out_objects, uacpi_size count
+)
+{
+    uacpi_cpu_flags flags;
+    void *object;
+    uacpi_size i;
+
+    flags = uacpi_kernel_lock_spinlock(pool->lock);
+
+    for (i = 0; i < count; i++) {
+        if (pool->free_list == UACPI_NULL &&
+            uacpi_unlikely(!pool_refill(pool, &flags)))
+            goto out_of_memory;
+
+        object = pool->free_list;
+        pool->free_list = *(void**)object;
+        out_objects[i] = object;
+    }
+
+    uacpi_kernel_unlock_spinlock(pool->lock, flags);
+
+    for (i = 0; i < count; i++)
+        uacpi_memzero(out_objects[i], pool->object_size);
+
+    return UACPI_TRUE;
+
+out_of_memory:
+    while (i-- > 0) {
+        object = out_objects[i];
+        *(void**)object = pool->free_list;
+        pool->free_list = object;
+        out_objects[i] = UACPI_NULL;
+    }
+
+    uacpi_kernel_unlock_spinlock(pool->lock, flags);
+    return UACPI_FALSE;
+}
+
+void uacpi_pool_free(struct uacpi_pool *pool, void *object)
+{
+    uacpi_cpu_flags flags;
+
+    if (object == UACPI_NULL)
+        return;
+
+    flags = uacpi_kernel_lock_spinlock(pool->lock);
+    *(void**)object = pool->free_list;
+    pool->free_list = object;
+    uacpi_kernel_unlock_spinlock(pool->lock, flags);
+}
+
+// Target payload size of one arena chunk
+#define ARENA_CHUNK_TARGET_BYTES 4096
+
+// Everything handed out by the arena is at least this aligned
+#define ARENA_ALLOC_ALIGNMENT 16
+
+struct uacpi_arena_chunk {
+    struct uacpi_arena_chunk *next;
+    uacpi_size capacity;
+    uacpi_size used;
+};
+
+static uacpi_size arena_chunk_header_bytes(void)
+{
+    return UACPI_ALIGN_UP(
+        sizeof(struct uacpi_arena_chunk), ARENA_ALLOC_ALIGNMENT, uacpi_size
+    );
+}
+
+void *uacpi_arena_alloc(struct uacpi_arena *arena, uacpi_size size)
+{
+    struct uacpi_arena_chunk *chunk = arena->chunks;
+    void *ptr;
+
+    size = UACPI_ALIGN_UP(size, ARENA_ALLOC_ALIGNMENT, uacpi_size);
+
+    if (chunk == UACPI_NULL || (chunk->capacity - chunk->used) < size) {
+        uacpi_size capacity;
+
+        capacity = UACPI_MAX((uacpi_size)ARENA_CHUNK_TARGET_BYTES, size);
+
+        chunk = uacpi_kernel_alloc(arena_chunk_header_bytes() + capacity);
+        if (uacpi_unlikely(chunk == UACPI_NULL))
+            return UACPI_NULL;
+
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    ptr = (uacpi_u8*)chunk + arena_chunk_header_bytes() + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+void uacpi_arena_reset(struct uacpi_arena *arena)
+{
+    struct uacpi_arena_chunk *chunk, *next;
+
+    for (chunk = arena->chunks; chunk != UACPI_NULL; chunk = next) {
+        next = chunk->next;
+        uacpi_free(chunk, arena_chunk_header_bytes() + chunk->capacity);
+    }
+
+    arena->chunks = UACPI_NULL;
+}
+
+uacpi_status uacpi_initialize_pools(void)
+{
+    uacpi_status ret;
+
+    ret = pool_init(&namespace_node_pool, sizeof(uacpi_namespace_node));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = pool_init(&object_pool, sizeof(uacpi_object));
+    if (uacpi_unlikely_error(ret)) {
+        pool_deinit(&namespace_node_pool);
+        return ret;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+void uacpi_deinitialize_pools(void)
+{
+    pool_deinit(&namespace_node_pool);
+    pool_deinit(&object_pool);
+}
@@ -0,0 +1,273 @@
+#include <uacpi/internal/profiling.h>
+#include <uacpi/internal/dynamic_array.h>
+#include <uacpi/internal/log.h>
+#include <uacpi/internal/namespace.h>
+#include <uacpi/internal/stdlib.h>
+#include <uacpi/kernel_api.h>
+
+#ifdef UACPI_PROFILING
+
+struct opcode_counter {
+    uacpi_u64 hits;
+    uacpi_u64 total_ns;
+};
+
+/*
+ * Regular opcodes are indexed by their value directly, extended
+ * (0x5B-prefixed) opcodes by their second byte.
+ */
+static struct opcode_counter opcode_counters[0x100];
+static struct opcode_counter ext_opcode_counters[0x100];
+
+struct method_counter {
+    uacpi_namespace_node *node;
+    const uacpi_char *path;
+
+    uacpi_u64 calls;
+    uacpi_u64 total_ns;
+    uacpi_u64 min_ns;
+    uacpi_u64 max_ns;
+};
+
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE(
+    method_counter_array, struct method_counter, 16
+)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(
+    method_counter_array, struct method_counter, static
+)
+
+static struct method_counter_array method_counters;
+
+void uacpi_profile_op(uacpi_aml_op op, uacpi_u64 elapsed_ns)
+{
+    struct opcode_counter *counter;
+
+    if (op > 0xFF)
+        counter = &ext_opcode_counters[op & 0xFF];
+    else
+        counter = &opcode_counters[op];
+
+    counter->hits++;
+    counter->total_ns += elapsed_ns;
+}
+
+void uacpi_profile_method(uacpi_namespace_node *node, uacpi_u64 elapsed_ns)
+{
+    struct method_counter *counter;
+    uacpi_size i;
+
+    if (node == UACPI_NULL)
+        return;
+
+    for (i = 0; i < method_counter_array_size(&method_counters); ++i) {
+        counter = method_counter_array_at(&method_counters, i);
+        if (counter->node == node)
+            goto record;
+    }
+
+    counter = method_counter_array_calloc(&method_counters);
+    if (uacpi_unlikely(counter == UACPI_NULL))
+        return;
+
+    counter->node = node;
+
+    // A NULL path here is tolerated and ends up as-is in the snapshots
+    counter->path = uacpi_namespace_node_generate_absolute_path(node);
+
+record:
+    counter->calls++;
+    counter->total_ns += elapsed_ns;
+
+    if (counter->calls == 1 || elapsed_ns < counter->min_ns)
+        counter->min_ns = elapsed_ns;
+    if (elapsed_ns > counter->max_ns)
+        counter->max_ns = elapsed_ns;
+}
+
+static uacpi_size count_hit_opcodes(const struct opcode_counter *counters)
+{
+    uacpi_size i, count = 0;
+
+    for (i = 0; i < 0x100; ++i) {
+        if (counters[i].hits != 0)
+            count++;
+    }
+
+    return count;
+}
+
+static void fill_opcode_entries(
+    const struct opcode_counter *counters, uacpi_u16 op_base,
+    uacpi_opcode_profile_entry **entry
+)
+{
+    uacpi_size i;
+
+    for (i = 0; i < 0x100; ++i) {
+        uacpi_u16 op = op_base | i;
+
+        if (counters[i].hits == 0)
+            continue;
+
+        (*entry)->name = uacpi_op_spec_name(uacpi_get_op_spec(op));
+        (*entry)->op = op;
+        (*entry)->hits = counters[i].hits;
+        (*entry)->total_ns = counters[i].total_ns;
+        (*entry)++;
+    }
+}
+
+static const uacpi_char *duplicate_path(const uacpi_char *path)
+{
+    uacpi_char *copy;
+    uacpi_size size;
+
+    if (path == UACPI_NULL)
+        return UACPI_NULL;
+
+    size = uacpi_strlen(path) + 1;
+
+    copy = uacpi_kernel_alloc(size);
+    if (uacpi_unlikely(copy == UACPI_NULL))
+        return UACPI_NULL;
+
+    uacpi_memcpy(copy, path, size);
+    return copy;
+}
+
+void uacpi_free_profile_stats(uacpi_profile_stats *stats)
+{
+    uacpi_size i;
+
+    if (stats == UACPI_NULL)
+        return;
+
+    for (i = 0; i < stats->num_methods; ++i) {
+        const uacpi_char *path = stats->methods[i].path;
+
+        if (path != UACPI_NULL)
+            uacpi_free((void*)path, uacpi_strlen(path) + 1);
+    }
+
+    uacpi_free(
+        stats->opcodes, stats->num_opcodes * sizeof(*stats->opcodes)
+    );
+    uacpi_free(
+        stats->methods, stats->num_methods * sizeof(*stats->methods)
+    );
+    uacpi_free(stats, sizeof(*stats));
+}
+
+uacpi_status uacpi_get_profile_stats(uacpi_profile_stats **out_stats)
+{
+    uacpi_status ret;
+    uacpi_profile_stats *stats;
+    uacpi_opcode_profile_entry *op_entry;
+    uacpi_size i;
+
+    /*
+     * The counters are only ever mutated by the interpreter, which runs under
+     * the namespace write lock, so holding the read lock gives us a stable
+     * view of them.
+     */
+    ret = uacpi_namespace_read_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = UACPI_STATUS_OUT_OF_MEMORY;
+
+    stats = uacpi_kernel_alloc_zeroed(sizeof(*stats));
+    if (uacpi_unlikely(stats == UACPI_NULL))
+        goto out;
+
+    stats->num_opcodes = count_hit_opcodes(opcode_counters) +
+                         count_hit_opcodes(ext_opcode_counters);
+    if (stats->num_opcodes != 0) {
+        stats->opcodes = uacpi_kernel_alloc(
+            stats->num_opcodes * sizeof(*stats->opcodes)
+        );
+        if (uacpi_unlikely(stats->opcodes == UACPI_NULL)) {
+            stats->num_opcodes = 0;
+            goto out;
+        }
+
+        op_entry = stats->opcodes;
+        fill_opcode_entries(opcode_counters, 0x0000, &op_entry);
+        fill_opcode_entries(
+            ext_opcode_counters, UACPI_EXT_PREFIX << 8, &op_entry
+        );
+    }
+
+    stats->num_methods = method_counter_array_size(&method_counters);
+    if (stats->num_methods != 0) {
+        stats->methods = uacpi_kernel_alloc_zeroed(
+            stats->num_methods * sizeof(*stats->methods)
+        );
+        if (uacpi_unlikely(stats->methods == UACPI_NULL)) {
+            stats->num_methods = 0;
+            goto out;
+        }
+
+        for (i = 0; i < stats->num_methods; ++i) {
+            struct method_counter *counter;
+            uacpi_method_profile_entry *entry = &stats->methods[i];
+
+            counter = method_counter_array_at(&method_counters, i);
+
+            entry->path = duplicate_path(counter->path);
+            entry->calls = counter->calls;
+            entry->total_ns = counter->total_ns;
+            entry->min_ns = counter->min_ns;
+            entry->max_ns = counter->max_ns;
+        }
+    }
+
+    ret = UACPI_STATUS_OK;
+
+out:
+    uacpi_namespace_read_unlock();
+
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free_profile_stats(stats);
+        return ret;
+    }
+
+    *out_stats = stats;
+    return ret;
+}
+
+static void clear_all_counters(void)
+{
+    uacpi_size i;
+
+    uacpi_memzero(opcode_counters, sizeof(opcode_counters));
+    uacpi_memzero(ext_opcode_counters, sizeof(ext_opcode_counters));
+
+    for (i = 0; i < method_counter_array_size(&method_counters); ++i) {
+        uacpi_free_absolute_path(
+            method_counter_array_at(&method_counters, i)->path
+        );
+    }
+    method_counter_array_clear(&method_counters);
+}
+
+uacpi_status uacpi_reset_profile_stats(void)
+{
+    uacpi_status ret;
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    clear_all_counters();
+
+    uacpi_namespace_write_unlock();
+    return UACPI_STATUS_OK;
+}
+
+void uacpi_deinitialize_profiling(void)
+{
+    clear_all_counters();
+}
+
+#endif // UACPI_PROFILING
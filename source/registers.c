@@ -92,38 +92,72 @@ static const struct register_spec *get_reg(uacpi_u8 idx)
     return &registers[idx];
 }
 
+/*
+ * Accessors resolved once at initialization time: the GAS descriptor is
+ * validated and its I/O mapping created upfront and kept alive, so that hot
+ * register accesses (PM1 status/enable are hit on every fixed event and GPE
+ * dispatch) are a direct indexed I/O call instead of a validate/map/unmap
+ * round-trip per access.
+ *
+ * A zeroed entry (total_bit_width == 0) means the accessor is absent or
+ * couldn't be resolved upfront, in which case accesses take the unresolved
+ * fallback path below.
+ */
+static struct uacpi_mapped_gas resolved_registers[UACPI_REGISTER_MAX + 1][2];
+
+static struct uacpi_mapped_gas *resolved_accessor(
+    const struct register_spec *spec, uacpi_u8 which
+)
+{
+    return &resolved_registers[spec - registers][which];
+}
+
 static uacpi_status read_one(
-    enum register_kind kind, void *reg, uacpi_u8 byte_width,
-    uacpi_u64 *out_value
+    const struct register_spec *spec, uacpi_u8 which, uacpi_u64 *out_value
 )
 {
-    if (kind == REGISTER_KIND_GAS) {
+    void *reg = which ? spec->accessor1 : spec->accessor0;
+    struct uacpi_mapped_gas *resolved = resolved_accessor(spec, which);
+
+    if (resolved->total_bit_width != 0)
+        return uacpi_gas_read_mapped(resolved, out_value);
+
+    if (spec->kind == REGISTER_KIND_GAS) {
         struct acpi_gas *gas = reg;
 
         if (!gas->address)
             return UACPI_STATUS_OK;
 
-        return uacpi_gas_read(reg, out_value);
+        return uacpi_gas_read(gas, out_value);
     }
 
-    return uacpi_system_io_read(*(uacpi_u32*)reg, byte_width, out_value);
+    return uacpi_system_io_read(
+        *(uacpi_u32*)reg, spec->access_width, out_value
+    );
 }
 
 static uacpi_status write_one(
-    enum register_kind kind, void *reg, uacpi_u8 byte_width,
-    uacpi_u64 in_value
+    const struct register_spec *spec, uacpi_u8 which, uacpi_u64 in_value
 )
 {
-    if (kind == REGISTER_KIND_GAS) {
+    void *reg = which ? spec->accessor1 : spec->accessor0;
+    struct uacpi_mapped_gas *resolved = resolved_accessor(spec, which);
+
+    if (resolved->total_bit_width != 0)
+        return uacpi_gas_write_mapped(resolved, in_value);
+
+    if (spec->kind == REGISTER_KIND_GAS) {
         struct acpi_gas *gas = reg;
 
         if (!gas->address)
             return UACPI_STATUS_OK;
 
-        return uacpi_gas_write(reg, in_value);
+        return uacpi_gas_write(gas, in_value);
     }
 
-    return uacpi_system_io_write(*(uacpi_u32*)reg, byte_width, in_value);
+    return uacpi_system_io_write(
+        *(uacpi_u32*)reg, spec->access_width, in_value
+    );
 }
 
 static uacpi_status do_read_register(
@@ -133,12 +167,12 @@ static uacpi_status do_read_register(
     uacpi_status ret;
     uacpi_u64 value0, value1 = 0;
 
-    ret = read_one(reg->kind, reg->accessor0, reg->access_width, &value0);
+    ret = read_one(reg, 0, &value0);
     if (uacpi_unlikely_error(ret))
         return ret;
 
     if (reg->accessor1) {
-        ret = read_one(reg->kind, reg->accessor1, reg->access_width, &value1);
+        ret = read_one(reg, 1, &value1);
         if (uacpi_unlikely_error(ret))
             return ret;
     }
@@ -183,12 +217,12 @@ static uacpi_status do_write_register(
         }
     }
 
-    ret = write_one(reg->kind, reg->accessor0, reg->access_width, in_value);
+    ret = write_one(reg, 0, in_value);
     if (uacpi_unlikely_error(ret))
         return ret;
 
     if (reg->accessor1)
-        ret = write_one(reg->kind, reg->accessor1, reg->access_width, in_value);
+        ret = write_one(reg, 1, in_value);
 
     return ret;
 }
@@ -217,12 +251,12 @@ uacpi_status uacpi_write_registers(
     if (uacpi_unlikely(reg == UACPI_NULL))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
-    ret = write_one(reg->kind, reg->accessor0, reg->access_width, in_value0);
+    ret = write_one(reg, 0, in_value0);
     if (uacpi_unlikely_error(ret))
         return ret;
 
     if (reg->accessor1)
-        ret = write_one(reg->kind, reg->accessor1, reg->access_width, in_value1);
+        ret = write_one(reg, 1, in_value1);
 
     return ret;
 }
@@ -353,21 +387,64 @@ static const struct register_field fields[UACPI_REGISTER_FIELD_MAX + 1] = {
 
 static uacpi_handle g_reg_lock;
 
+static void resolve_accessor(const struct register_spec *spec, uacpi_u8 which)
+{
+    void *reg = which ? spec->accessor1 : spec->accessor0;
+    struct uacpi_mapped_gas *out = resolved_accessor(spec, which);
+
+    if (spec->kind == REGISTER_KIND_GAS) {
+        struct acpi_gas *gas = reg;
+
+        // Leave absent or unmappable accessors to the fallback path
+        if (gas->address)
+            uacpi_map_gas_noalloc(gas, out);
+        return;
+    }
+
+    if (*(uacpi_u32*)reg == 0)
+        return;
+
+    if (uacpi_kernel_io_map(
+            *(uacpi_u32*)reg, spec->access_width, &out->mapping.io
+        ) != UACPI_STATUS_OK)
+        return;
+
+    out->access_bit_width = spec->access_width * 8;
+    out->total_bit_width = spec->access_width * 8;
+    out->bit_offset = 0;
+    out->address_space_id = UACPI_ADDRESS_SPACE_SYSTEM_IO;
+}
+
 uacpi_status uacpi_ininitialize_registers(void)
 {
+    uacpi_size i;
+
     g_reg_lock = uacpi_kernel_create_spinlock();
     if (uacpi_unlikely(g_reg_lock == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
+    for (i = 0; i < UACPI_ARRAY_SIZE(registers); ++i) {
+        resolve_accessor(&registers[i], 0);
+        if (registers[i].accessor1 != UACPI_NULL)
+            resolve_accessor(&registers[i], 1);
+    }
+
     return UACPI_STATUS_OK;
 }
 
 void uacpi_deininitialize_registers(void)
 {
+    uacpi_size i;
+
     if (g_reg_lock != UACPI_NULL) {
         uacpi_kernel_free_spinlock(g_reg_lock);
         g_reg_lock = UACPI_NULL;
     }
+
+    for (i = 0; i < UACPI_ARRAY_SIZE(registers); ++i) {
+        uacpi_unmap_gas_nofree(&resolved_registers[i][0]);
+        uacpi_unmap_gas_nofree(&resolved_registers[i][1]);
+    }
 }
 
 uacpi_status uacpi_read_register_field(
@@ -1972,13 +1972,12 @@ static uacpi_status eval_resource_helper(
     );
 }
 
-uacpi_status uacpi_native_resources_from_aml(
-    uacpi_buffer *aml_buffer, uacpi_resources **out_resources
+static uacpi_status count_native_resource_bytes(
+    uacpi_buffer *aml_buffer, uacpi_size *out_size
 )
 {
     uacpi_status ret;
     struct resource_conversion_ctx ctx = { 0 };
-    uacpi_resources *resources;
 
     ret = uacpi_for_each_aml_resource(
         aml_buffer, accumulate_native_buffer_size, &ctx
@@ -1995,10 +1994,26 @@ uacpi_status uacpi_native_resources_from_aml(
         return UACPI_STATUS_INTERNAL_ERROR;
     }
 
-    resources = uacpi_kernel_alloc_zeroed(ctx.size + sizeof(uacpi_resources));
+    *out_size = ctx.size;
+    return UACPI_STATUS_OK;
+}
+
+uacpi_status uacpi_native_resources_from_aml(
+    uacpi_buffer *aml_buffer, uacpi_resources **out_resources
+)
+{
+    uacpi_status ret;
+    uacpi_size size;
+    uacpi_resources *resources;
+
+    ret = count_native_resource_bytes(aml_buffer, &size);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    resources = uacpi_kernel_alloc_zeroed(size + sizeof(uacpi_resources));
     if (uacpi_unlikely(resources == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
-    resources->length = ctx.size;
+    resources->length = size;
     resources->entries = UACPI_PTR_ADD(resources, sizeof(uacpi_resources));
 
     ret = aml_resources_to_native(aml_buffer, resources->entries);
@@ -2011,6 +2026,47 @@ uacpi_status uacpi_native_resources_from_aml(
     return ret;
 }
 
+uacpi_status uacpi_native_resources_from_aml_in(
+    uacpi_buffer *aml_buffer, uacpi_resource_arena *arena,
+    uacpi_resources *out_resources
+)
+{
+    uacpi_status ret;
+    uacpi_size size;
+
+    ret = count_native_resource_bytes(aml_buffer, &size);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (size > arena->capacity) {
+        if (arena->grow == UACPI_NULL)
+            return UACPI_STATUS_BUFFER_TOO_SMALL;
+
+        ret = arena->grow(arena, size);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        if (uacpi_unlikely(size > arena->capacity)) {
+            uacpi_error(
+                "arena grow callback didn't provide enough storage: "
+                "%zu < %zu\n", arena->capacity, size
+            );
+            return UACPI_STATUS_BUFFER_TOO_SMALL;
+        }
+    }
+
+    // The conversion code expects zeroed-out storage
+    uacpi_memzero(arena->buffer, size);
+
+    ret = aml_resources_to_native(aml_buffer, arena->buffer);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    out_resources->length = size;
+    out_resources->entries = arena->buffer;
+    return ret;
+}
+
 void uacpi_free_resources(uacpi_resources *resources)
 {
     if (resources == UACPI_NULL)
@@ -2051,6 +2107,44 @@ uacpi_status uacpi_get_possible_resources(
     return extract_native_resources_from_method(device, "_PRS", out_resources);
 }
 
+static uacpi_status extract_native_resources_from_method_in(
+    uacpi_namespace_node *device, const uacpi_char *method,
+    uacpi_resource_arena *arena, uacpi_resources *out_resources
+)
+{
+    uacpi_status ret;
+    uacpi_object *obj;
+
+    ret = eval_resource_helper(device, method, &obj);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = uacpi_native_resources_from_aml_in(obj->buffer, arena, out_resources);
+    uacpi_object_unref(obj);
+
+    return ret;
+}
+
+uacpi_status uacpi_get_current_resources_in(
+    uacpi_namespace_node *device, uacpi_resource_arena *arena,
+    uacpi_resources *out_resources
+)
+{
+    return extract_native_resources_from_method_in(
+        device, "_CRS", arena, out_resources
+    );
+}
+
+uacpi_status uacpi_get_possible_resources_in(
+    uacpi_namespace_node *device, uacpi_resource_arena *arena,
+    uacpi_resources *out_resources
+)
+{
+    return extract_native_resources_from_method_in(
+        device, "_PRS", arena, out_resources
+    );
+}
+
 uacpi_status uacpi_for_each_resource(
     uacpi_resources *resources, uacpi_resource_iteration_callback cb, void *user
 )
@@ -2109,6 +2203,115 @@ uacpi_status uacpi_for_each_device_resource(
     return ret;
 }
 
+uacpi_status uacpi_device_resource_iterator_init(
+    uacpi_namespace_node *device, const uacpi_char *method,
+    uacpi_resource_iterator *it
+)
+{
+    uacpi_status ret;
+    uacpi_object *obj;
+
+    ret = eval_resource_helper(device, method, &obj);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    it->aml_buffer_obj = obj;
+    it->cursor = obj->buffer->byte_data;
+    it->bytes_left = obj->buffer->size;
+    return UACPI_STATUS_OK;
+}
+
+struct single_resource_conversion_ctx {
+    uacpi_resource *out_resource;
+    uacpi_size capacity;
+    uacpi_size consumed;
+    uacpi_status st;
+};
+
+static uacpi_iteration_decision do_convert_resource_under_cursor(
+    void *opaque, uacpi_u8 *data, uacpi_u16 resource_size,
+    const struct uacpi_resource_spec *spec
+)
+{
+    struct single_resource_conversion_ctx *ctx = opaque;
+    struct resource_conversion_ctx conv_ctx = {
+        .buf = ctx->out_resource,
+    };
+    uacpi_size native_size;
+
+    native_size = native_size_for_aml_resource(data, resource_size, spec);
+    if (uacpi_unlikely(native_size == 0)) {
+        uacpi_error("invalid native size for aml resource: %zu\n",
+                    native_size);
+        ctx->st = UACPI_STATUS_AML_INVALID_RESOURCE;
+        return UACPI_ITERATION_DECISION_BREAK;
+    }
+
+    if (uacpi_unlikely(native_size > ctx->capacity)) {
+        ctx->st = UACPI_STATUS_BUFFER_TOO_SMALL;
+        return UACPI_ITERATION_DECISION_BREAK;
+    }
+
+    // The conversion code expects zeroed-out storage
+    uacpi_memzero(ctx->out_resource, native_size);
+
+    do_aml_resource_to_native(&conv_ctx, data, resource_size, spec);
+    ctx->st = conv_ctx.st;
+
+    ctx->consumed = resource_size;
+    ctx->consumed += aml_resource_kind_to_header_size[spec->resource_kind];
+
+    // We only wanted the one descriptor under the cursor, stop right away
+    return UACPI_ITERATION_DECISION_BREAK;
+}
+
+uacpi_status uacpi_resource_iterator_next(
+    uacpi_resource_iterator *it, uacpi_resource *out_resource,
+    uacpi_size capacity
+)
+{
+    uacpi_status ret;
+    struct single_resource_conversion_ctx ctx = {
+        .out_resource = out_resource,
+        .capacity = capacity,
+    };
+    uacpi_buffer view = { 0 };
+
+    if (it->bytes_left == 0)
+        return UACPI_STATUS_NOT_FOUND;
+
+    view.data = it->cursor;
+    view.size = it->bytes_left;
+
+    /*
+     * Reuse the regular walk machinery for all of the descriptor validation,
+     * the callback breaks out after the first (aka current) descriptor.
+     */
+    ret = uacpi_for_each_aml_resource(&view, do_convert_resource_under_cursor,
+                                      &ctx);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+    if (uacpi_unlikely_error(ctx.st))
+        return ctx.st;
+
+    if (out_resource->type == UACPI_RESOURCE_TYPE_END_TAG) {
+        it->bytes_left = 0;
+    } else {
+        it->cursor += ctx.consumed;
+        it->bytes_left -= ctx.consumed;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+void uacpi_resource_iterator_deinit(uacpi_resource_iterator *it)
+{
+    uacpi_object_unref(it->aml_buffer_obj);
+    it->aml_buffer_obj = UACPI_NULL;
+    it->cursor = UACPI_NULL;
+    it->bytes_left = 0;
+}
+
 static const struct uacpi_resource_spec *resource_spec_from_native(
         uacpi_resource *resource
 )
@@ -2479,6 +2682,258 @@ uacpi_status uacpi_native_resources_to_aml(
     return ret;
 }
 
+/*
+ * Compiled _SRS templates keyed by the device node, so that repeat
+ * uacpi_set_resources calls on the same device (e.g. an IRQ rebalancer
+ * flipping nothing but the interrupt number) don't pay for a full
+ * instruction-table conversion pass every time: fixed-size resources whose
+ * native representation didn't change since the last submission keep their
+ * template bytes as-is, only the ones that did change are re-converted in
+ * place at their recorded offset.
+ *
+ * A device's _SRS definition only ever changes alongside a dynamic table
+ * load, so entries are stamped with the generation counter such loads bump
+ * (same as the _PRT and device-ID caches) and dropped once their stamp no
+ * longer matches. The cache is guarded by the namespace write lock, which is
+ * never held across AML evaluation.
+ */
+struct srs_cache_entry {
+    struct srs_cache_entry *next;
+    uacpi_namespace_node *node;
+    uacpi_u32 generation;
+
+    // Raw compiled template of the last submission
+    uacpi_u8 *aml;
+    uacpi_size aml_size;
+
+    // Verbatim copy of the native resource stream 'aml' was compiled from
+    uacpi_u8 *native;
+    uacpi_size native_size;
+};
+
+static struct srs_cache_entry *srs_cache_head;
+
+static void srs_cache_drop(
+    struct srs_cache_entry *entry, struct srs_cache_entry **link
+)
+{
+    *link = entry->next;
+
+    uacpi_free(entry->aml, entry->aml_size);
+    uacpi_free(entry->native, entry->native_size);
+    uacpi_free(entry, sizeof(*entry));
+}
+
+void uacpi_free_srs_template_cache(void)
+{
+    while (srs_cache_head != UACPI_NULL)
+        srs_cache_drop(srs_cache_head, &srs_cache_head);
+}
+
+/*
+ * Walk the cached and the new native streams in lockstep, either verifying
+ * that in-place patching is possible (the sequence of resource types and
+ * sizes is unchanged), or actually performing it. Validation is a separate
+ * pass so that a bail-out never leaves the template half-patched.
+ */
+static uacpi_bool srs_cache_walk(
+    struct srs_cache_entry *entry, uacpi_resources *resources,
+    uacpi_bool commit
+)
+{
+    uacpi_u8 *old_bytes = entry->native;
+    uacpi_u8 *new_bytes = (uacpi_u8*)resources->entries;
+    uacpi_size bytes_left = resources->length;
+    uacpi_size aml_offset = 0;
+
+    if (entry->native_size != resources->length)
+        return UACPI_FALSE;
+
+    while (bytes_left) {
+        uacpi_resource *old_res = (uacpi_resource*)old_bytes;
+        uacpi_resource *new_res = (uacpi_resource*)new_bytes;
+        const struct uacpi_resource_spec *spec;
+        uacpi_size aml_size;
+
+        // Leave stream validation and error reporting to the full path
+        if (uacpi_unlikely(bytes_left < 4 ||
+                           new_res->type > UACPI_RESOURCE_TYPE_MAX ||
+                           new_res->length > bytes_left))
+            return UACPI_FALSE;
+
+        if (new_res->type != old_res->type ||
+            new_res->length != old_res->length)
+            return UACPI_FALSE;
+
+        spec = resource_spec_from_native(new_res);
+        aml_size = aml_size_for_native_resource(new_res, spec);
+
+        // In-place patching must not move any of the later resources
+        if (aml_size != aml_size_for_native_resource(old_res, spec) ||
+            uacpi_unlikely(aml_offset + aml_size > entry->aml_size))
+            return UACPI_FALSE;
+
+        /*
+         * Variable-size resources carry out-of-line data (source strings,
+         * vendor data) that a flat compare can't see, always re-convert
+         * those.
+         */
+        if (commit &&
+            (spec->size_for_aml != UACPI_NULL ||
+             uacpi_memcmp(old_res, new_res, new_res->length) != 0)) {
+            struct resource_conversion_ctx ctx = { 0 };
+
+            ctx.buf = entry->aml + aml_offset;
+
+            // The converter assumes a zeroed destination, bit fields are OR'd
+            uacpi_memzero(entry->aml + aml_offset, aml_size);
+
+            do_native_resource_to_aml(&ctx, new_res);
+            if (uacpi_unlikely_error(ctx.st))
+                return UACPI_FALSE;
+        }
+
+        aml_offset += aml_size;
+
+        if (new_res->type == UACPI_RESOURCE_TYPE_END_TAG)
+            break;
+
+        bytes_left -= new_res->length;
+        old_bytes += new_res->length;
+        new_bytes += new_res->length;
+    }
+
+    if (commit)
+        uacpi_memcpy(entry->native, resources->entries, entry->native_size);
+
+    return UACPI_TRUE;
+}
+
+static uacpi_status srs_template_from_cache(
+    uacpi_namespace_node *device, uacpi_resources *resources,
+    uacpi_object **out_template
+)
+{
+    uacpi_status ret;
+    struct srs_cache_entry *entry, **link;
+    uacpi_object *obj;
+    void *buf;
+
+    // The cache is purely best-effort, any failure means the full path
+    if (uacpi_unlikely_error(uacpi_namespace_write_lock()))
+        return UACPI_STATUS_NOT_FOUND;
+
+    for (link = &srs_cache_head; (entry = *link) != UACPI_NULL;
+         link = &entry->next) {
+        if (entry->node == device)
+            break;
+    }
+
+    ret = UACPI_STATUS_NOT_FOUND;
+    if (entry == UACPI_NULL)
+        goto out;
+
+    if (entry->generation != uacpi_dynamic_load_generation()) {
+        srs_cache_drop(entry, link);
+        goto out;
+    }
+
+    if (!srs_cache_walk(entry, resources, UACPI_FALSE))
+        goto out;
+
+    // Allocate the outgoing copy first so failure leaves the entry untouched
+    buf = uacpi_kernel_alloc(entry->aml_size);
+    if (uacpi_unlikely(buf == UACPI_NULL))
+        goto out;
+
+    obj = uacpi_create_object(UACPI_OBJECT_BUFFER);
+    if (uacpi_unlikely(obj == UACPI_NULL)) {
+        uacpi_free(buf, entry->aml_size);
+        goto out;
+    }
+
+    if (uacpi_unlikely(!srs_cache_walk(entry, resources, UACPI_TRUE))) {
+        // A conversion error mid-patch, the template is garbage now
+        srs_cache_drop(entry, link);
+        uacpi_free(buf, entry->aml_size);
+        uacpi_object_unref(obj);
+        goto out;
+    }
+
+    uacpi_memcpy(buf, entry->aml, entry->aml_size);
+    obj->buffer->data = buf;
+    obj->buffer->size = entry->aml_size;
+
+    *out_template = obj;
+    ret = UACPI_STATUS_OK;
+
+out:
+    uacpi_namespace_write_unlock();
+    return ret;
+}
+
+static void srs_cache_insert(
+    uacpi_namespace_node *device, uacpi_resources *resources,
+    uacpi_object *res_template
+)
+{
+    struct srs_cache_entry *entry;
+    uacpi_size aml_size = res_template->buffer->size;
+    uacpi_u8 *aml_clone, *native_clone;
+
+    if (uacpi_unlikely(resources->length == 0 || aml_size == 0))
+        return;
+
+    aml_clone = uacpi_kernel_alloc(aml_size);
+    if (uacpi_unlikely(aml_clone == UACPI_NULL))
+        return;
+
+    native_clone = uacpi_kernel_alloc(resources->length);
+    if (uacpi_unlikely(native_clone == UACPI_NULL)) {
+        uacpi_free(aml_clone, aml_size);
+        return;
+    }
+
+    uacpi_memcpy(aml_clone, res_template->buffer->data, aml_size);
+    uacpi_memcpy(native_clone, resources->entries, resources->length);
+
+    if (uacpi_unlikely_error(uacpi_namespace_write_lock())) {
+        uacpi_free(aml_clone, aml_size);
+        uacpi_free(native_clone, resources->length);
+        return;
+    }
+
+    for (entry = srs_cache_head; entry != UACPI_NULL; entry = entry->next) {
+        if (entry->node == device)
+            break;
+    }
+
+    if (entry == UACPI_NULL) {
+        entry = uacpi_kernel_alloc_zeroed(sizeof(*entry));
+        if (uacpi_unlikely(entry == UACPI_NULL)) {
+            uacpi_namespace_write_unlock();
+            uacpi_free(aml_clone, aml_size);
+            uacpi_free(native_clone, resources->length);
+            return;
+        }
+
+        entry->node = device;
+        entry->next = srs_cache_head;
+        srs_cache_head = entry;
+    } else {
+        uacpi_free(entry->aml, entry->aml_size);
+        uacpi_free(entry->native, entry->native_size);
+    }
+
+    entry->aml = aml_clone;
+    entry->aml_size = aml_size;
+    entry->native = native_clone;
+    entry->native_size = resources->length;
+    entry->generation = uacpi_dynamic_load_generation();
+
+    uacpi_namespace_write_unlock();
+}
+
 uacpi_status uacpi_set_resources(
     uacpi_namespace_node *device, uacpi_resources *resources
 )
@@ -2487,9 +2942,14 @@ uacpi_status uacpi_set_resources(
     uacpi_object *res_template;
     uacpi_object_array args;
 
-    ret = uacpi_native_resources_to_aml(resources, &res_template);
-    if (uacpi_unlikely_error(ret))
-        return ret;
+    ret = srs_template_from_cache(device, resources, &res_template);
+    if (ret == UACPI_STATUS_NOT_FOUND) {
+        ret = uacpi_native_resources_to_aml(resources, &res_template);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        srs_cache_insert(device, resources, res_template);
+    }
 
     args.objects = &res_template;
     args.count = 1;
@@ -2,6 +2,7 @@
 #include <uacpi/platform/atomic.h>
 
 #define BUGGED_REFCOUNT 0xFFFFFFFF
+#define PERMANENT_REFCOUNT 0xFFFFFFFE
 
 void uacpi_shareable_init(uacpi_handle handle)
 {
@@ -9,6 +10,18 @@ void uacpi_shareable_init(uacpi_handle handle)
     shareable->reference_count = 1;
 }
 
+static uacpi_bool shareable_is_permanent(struct uacpi_shareable *shareable)
+{
+    return uacpi_atomic_load32(&shareable->reference_count) ==
+           PERMANENT_REFCOUNT;
+}
+
+void uacpi_make_shareable_permanent(uacpi_handle handle)
+{
+    struct uacpi_shareable *shareable = handle;
+    uacpi_atomic_store32(&shareable->reference_count, PERMANENT_REFCOUNT);
+}
+
 uacpi_bool uacpi_bugged_shareable(uacpi_handle handle)
 {
     struct uacpi_shareable *shareable = handle;
@@ -32,6 +45,14 @@ uacpi_u32 uacpi_shareable_ref(uacpi_handle handle)
     if (uacpi_unlikely(uacpi_bugged_shareable(shareable)))
         return BUGGED_REFCOUNT;
 
+    /*
+     * Permanent objects are among the hottest shared ones (e.g. the
+     * predefined namespace nodes), skipping the read-modify-write here keeps
+     * their cache line from ping-ponging between cores.
+     */
+    if (shareable_is_permanent(shareable))
+        return PERMANENT_REFCOUNT;
+
     return uacpi_atomic_inc32(&shareable->reference_count) - 1;
 }
 
@@ -42,6 +63,9 @@ uacpi_u32 uacpi_shareable_unref(uacpi_handle handle)
     if (uacpi_unlikely(uacpi_bugged_shareable(shareable)))
         return BUGGED_REFCOUNT;
 
+    if (shareable_is_permanent(shareable))
+        return PERMANENT_REFCOUNT;
+
     return uacpi_atomic_dec32(&shareable->reference_count) + 1;
 }
 
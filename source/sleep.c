@@ -212,6 +212,10 @@ static uacpi_status get_slp_type_for_state(
         goto out;
     }
 
+    ret = uacpi_package_materialize(ret_obj->package);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
     switch (ret_obj->package->count) {
     case 0:
         uacpi_error("empty package while evaluating %s!\n", path);
@@ -263,6 +267,55 @@ out:
     return ret;
 }
 
+static uacpi_status slp_type_for_state(uacpi_u8 state, uacpi_u8 *a, uacpi_u8 *b)
+{
+    struct uacpi_sleep_plan *plan = &g_uacpi_rt_ctx.sleep_plans[state];
+
+    if (plan->valid) {
+        *a = plan->sleep_typ_a;
+        *b = plan->sleep_typ_b;
+        return UACPI_STATUS_OK;
+    }
+
+    return get_slp_type_for_state(state, a, b);
+}
+
+uacpi_status uacpi_precompute_sleep_plan(uacpi_sleep_state state_enum)
+{
+    uacpi_u8 state = state_enum;
+    uacpi_status ret;
+    struct uacpi_sleep_plan *plan;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_INITIALIZED);
+
+    if (uacpi_unlikely(state > UACPI_SLEEP_STATE_S5))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    plan = &g_uacpi_rt_ctx.sleep_plans[state];
+    ret = get_slp_type_for_state(state, &plan->sleep_typ_a, &plan->sleep_typ_b);
+    if (ret != UACPI_STATUS_OK)
+        return ret;
+
+    plan->valid = UACPI_TRUE;
+
+    /*
+     * \_S0 is consumed by the wake path of every transition, cache it as well
+     * (including a negative result, its absence is handled gracefully on
+     * wake) so that preparing this state doesn't go back to the interpreter
+     * for it either.
+     */
+    plan = &g_uacpi_rt_ctx.sleep_plans[UACPI_SLEEP_STATE_S0];
+    if (state != UACPI_SLEEP_STATE_S0 && !plan->valid) {
+        ret = get_slp_type_for_state(
+            UACPI_SLEEP_STATE_S0, &plan->sleep_typ_a, &plan->sleep_typ_b
+        );
+        if (ret == UACPI_STATUS_OK || ret == UACPI_STATUS_NOT_FOUND)
+            plan->valid = UACPI_TRUE;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
 static uacpi_status eval_sleep_helper(
     uacpi_namespace_node *parent, const uacpi_char *path, uacpi_u8 value
 )
@@ -361,7 +414,7 @@ uacpi_status uacpi_prepare_for_sleep_state(enum uacpi_sleep_state state_enum)
     if (uacpi_unlikely(state > UACPI_SLEEP_STATE_S5))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
-    ret = get_slp_type_for_state(
+    ret = slp_type_for_state(
         state,
         &g_uacpi_rt_ctx.last_sleep_typ_a,
         &g_uacpi_rt_ctx.last_sleep_typ_b
@@ -369,7 +422,7 @@ uacpi_status uacpi_prepare_for_sleep_state(enum uacpi_sleep_state state_enum)
     if (ret != UACPI_STATUS_OK)
         return ret;
 
-    ret = get_slp_type_for_state(
+    ret = slp_type_for_state(
         0,
         &g_uacpi_rt_ctx.s0_sleep_typ_a,
         &g_uacpi_rt_ctx.s0_sleep_typ_b
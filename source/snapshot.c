@@ -0,0 +1,1650 @@
+#include <uacpi/snapshot.h>
+#include <uacpi/internal/types.h>
+#include <uacpi/internal/namespace.h>
+#include <uacpi/internal/tables.h>
+#include <uacpi/internal/context.h>
+#include <uacpi/internal/dynamic_array.h>
+#include <uacpi/internal/stdlib.h>
+#include <uacpi/internal/log.h>
+#include <uacpi/internal/event.h>
+#include <uacpi/internal/utilities.h>
+#include <uacpi/kernel_api.h>
+
+/*
+ * Namespace snapshot image layout:
+ *
+ * [snapshot_header]
+ * [snapshot_table] * num_tables
+ * [u64 size + data] * num_buffers
+ * [snapshot_object + type-specific payload] * num_objects
+ * [snapshot_node] * num_nodes
+ *
+ * Objects are emitted depth-first, so any object index embedded in an object
+ * record always refers to an earlier record. Field unit links are the only
+ * exception: those reference namespace nodes that may come later in tree
+ * order, and are resolved in a fixup pass once the entire tree is rebuilt.
+ * Nodes are emitted in preorder, so a node's parent always precedes it.
+ */
+
+#define SNAPSHOT_SIGNATURE "uACPIsnp"
+#define SNAPSHOT_VERSION 1
+
+#define SNAPSHOT_INVALID_IDX 0xFFFFFFFF
+
+// The parent of this node is a predefined node, index is the predefined id
+#define SNAPSHOT_PARENT_PREDEFINED (1u << 31)
+
+// This node is an alias, index refers to the node it aliases
+#define SNAPSHOT_OBJECT_ALIAS (1u << 31)
+
+/*
+ * A hard cap on every count in the header, as well as the object nesting
+ * depth the serializer is willing to follow. Real namespaces are a few
+ * thousand nodes at most, this exists purely to reject corrupted images
+ * before any allocations are sized from them.
+ */
+#define SNAPSHOT_MAX_COUNT (1u << 22)
+#define SNAPSHOT_MAX_OBJECT_DEPTH 32
+
+UACPI_PACKED(struct snapshot_header {
+    uacpi_char signature[8];
+    uacpi_u32 version;
+    uacpi_u32 num_tables;
+    uacpi_u32 num_buffers;
+    uacpi_u32 num_objects;
+    uacpi_u32 num_nodes;
+    uacpi_u64 total_size;
+})
+
+UACPI_PACKED(struct snapshot_table {
+    uacpi_char signature[4];
+    uacpi_char oemid[6];
+    uacpi_char oem_table_id[8];
+    uacpi_u32 length;
+    uacpi_u8 revision;
+    uacpi_u8 checksum;
+    uacpi_u8 reserved[2];
+})
+
+UACPI_PACKED(struct snapshot_object {
+    uacpi_u8 type;
+    uacpi_u8 flags;
+    uacpi_u16 reserved;
+})
+
+UACPI_PACKED(struct snapshot_method {
+    uacpi_u8 args;
+    uacpi_u8 sync_level;
+    uacpi_u8 is_serialized;
+    uacpi_u8 named_objects_persist;
+    uacpi_u8 owns_code;
+    uacpi_u8 reserved[3];
+    uacpi_u32 code_size;
+    /*
+     * Followed by code_size bytes of AML if owns_code is set, or by a
+     * snapshot_code_ref otherwise.
+     */
+})
+
+UACPI_PACKED(struct snapshot_code_ref {
+    uacpi_u32 table_idx;
+    uacpi_u32 offset;
+})
+
+UACPI_PACKED(struct snapshot_op_region {
+    uacpi_u16 space;
+    uacpi_u8 reserved[6];
+    uacpi_u64 offset;
+    uacpi_u64 length;
+})
+
+UACPI_PACKED(struct snapshot_field_unit {
+    uacpi_u8 kind;
+    uacpi_u8 lock_rule;
+    uacpi_u8 update_rule;
+    uacpi_u8 attributes;
+    uacpi_u8 bit_offset_within_first_byte;
+    uacpi_u8 access_width_bytes;
+    uacpi_u8 access_length;
+    uacpi_u8 reserved;
+    uacpi_u32 byte_offset;
+    uacpi_u32 bit_length;
+
+    /*
+     * Node indices, interpretation depends on 'kind':
+     * NORMAL: link0 = region
+     * INDEX: link0 = index field, link1 = data field
+     * BANK: link0 = bank region, link1 = bank selection field
+     */
+    uacpi_u32 link0;
+    uacpi_u32 link1;
+    uacpi_u64 bank_value;
+
+    // Object index of the connection buffer, if any
+    uacpi_u32 connection;
+})
+
+UACPI_PACKED(struct snapshot_buffer_field {
+    uacpi_u32 backing;
+    uacpi_u32 bit_length;
+    uacpi_u64 bit_index;
+    uacpi_u8 force_buffer;
+    uacpi_u8 reserved[3];
+})
+
+UACPI_PACKED(struct snapshot_processor {
+    uacpi_u8 id;
+    uacpi_u8 block_length;
+    uacpi_u8 reserved[2];
+    uacpi_u32 block_address;
+})
+
+UACPI_PACKED(struct snapshot_power_resource {
+    uacpi_u8 system_level;
+    uacpi_u8 reserved;
+    uacpi_u16 resource_order;
+})
+
+UACPI_PACKED(struct snapshot_node {
+    uacpi_u32 name_id;
+    uacpi_u32 parent;
+    uacpi_u32 object;
+})
+
+/*
+ * ========================
+ * Serialization (save)
+ * ========================
+ */
+
+struct snapshot_writer {
+    uacpi_u8 *data;
+    uacpi_size size;
+    uacpi_size capacity;
+};
+
+static uacpi_status writer_append(
+    struct snapshot_writer *writer, const void *bytes, uacpi_size size
+)
+{
+    if (writer->size + size > writer->capacity) {
+        uacpi_size new_capacity;
+        void *new_data;
+
+        new_capacity = UACPI_MAX(writer->capacity * 2, (uacpi_size)128);
+        while (new_capacity < writer->size + size)
+            new_capacity *= 2;
+
+        new_data = uacpi_kernel_alloc(new_capacity);
+        if (uacpi_unlikely(new_data == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        uacpi_memcpy(new_data, writer->data, writer->size);
+        uacpi_free(writer->data, writer->capacity);
+
+        writer->data = new_data;
+        writer->capacity = new_capacity;
+    }
+
+    uacpi_memcpy(writer->data + writer->size, bytes, size);
+    writer->size += size;
+    return UACPI_STATUS_OK;
+}
+
+static void writer_free(struct snapshot_writer *writer)
+{
+    uacpi_free(writer->data, writer->capacity);
+    writer->data = UACPI_NULL;
+    writer->size = 0;
+    writer->capacity = 0;
+}
+
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE(pointer_array, void*, 8)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(pointer_array, void*, static)
+
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE(table_idx_array, uacpi_size, 8)
+DYNAMIC_ARRAY_WITH_INLINE_STORAGE_IMPL(table_idx_array, uacpi_size, static)
+
+struct snapshot_save_state {
+    struct snapshot_writer tables;
+    struct snapshot_writer buffers;
+    struct snapshot_writer objects;
+    struct snapshot_writer nodes;
+
+    // Pointer of every serialized entity, position matching its record index
+    struct pointer_array node_map;
+    struct pointer_array object_map;
+    struct pointer_array buffer_map;
+    struct table_idx_array table_map;
+};
+
+static uacpi_u32 map_find(struct pointer_array *map, void *ptr)
+{
+    uacpi_size i;
+
+    for (i = 0; i < pointer_array_size(map); ++i) {
+        if (*pointer_array_at(map, i) == ptr)
+            return i;
+    }
+
+    return SNAPSHOT_INVALID_IDX;
+}
+
+static uacpi_status map_append(
+    struct pointer_array *map, void *ptr, uacpi_u32 *out_idx
+)
+{
+    void **slot;
+
+    slot = pointer_array_alloc(map);
+    if (uacpi_unlikely(slot == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    *slot = ptr;
+    if (out_idx != UACPI_NULL)
+        *out_idx = pointer_array_size(map) - 1;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_iteration_decision record_loaded_table(
+    void *user, struct uacpi_installed_table *tbl, uacpi_size idx
+)
+{
+    struct snapshot_save_state *state = user;
+    struct snapshot_table record = { 0 };
+    uacpi_size *slot;
+
+    if (!(tbl->flags & UACPI_TABLE_LOADED))
+        return UACPI_ITERATION_DECISION_CONTINUE;
+
+    uacpi_memcpy(record.signature, tbl->hdr.signature,
+                 sizeof(record.signature));
+    uacpi_memcpy(record.oemid, tbl->hdr.oemid, sizeof(record.oemid));
+    uacpi_memcpy(record.oem_table_id, tbl->hdr.oem_table_id,
+                 sizeof(record.oem_table_id));
+    record.length = tbl->hdr.length;
+    record.revision = tbl->hdr.revision;
+    record.checksum = tbl->hdr.checksum;
+
+    slot = table_idx_array_alloc(&state->table_map);
+    if (uacpi_unlikely(slot == UACPI_NULL))
+        return UACPI_ITERATION_DECISION_BREAK;
+    *slot = idx;
+
+    if (uacpi_unlikely_error(
+            writer_append(&state->tables, &record, sizeof(record))))
+        return UACPI_ITERATION_DECISION_BREAK;
+
+    return UACPI_ITERATION_DECISION_CONTINUE;
+}
+
+struct code_search_ctx {
+    uacpi_u8 *code;
+    uacpi_size idx;
+    void *ptr;
+    uacpi_bool found;
+};
+
+static uacpi_iteration_decision find_code_table(
+    void *user, struct uacpi_installed_table *tbl, uacpi_size idx
+)
+{
+    struct code_search_ctx *search = user;
+    uacpi_u8 *start = tbl->ptr;
+
+    if (start == UACPI_NULL || !(tbl->flags & UACPI_TABLE_LOADED))
+        return UACPI_ITERATION_DECISION_CONTINUE;
+
+    if (search->code >= start && search->code < start + tbl->hdr.length) {
+        search->idx = idx;
+        search->ptr = start;
+        search->found = UACPI_TRUE;
+        return UACPI_ITERATION_DECISION_BREAK;
+    }
+
+    return UACPI_ITERATION_DECISION_CONTINUE;
+}
+
+static uacpi_status save_code_ref(
+    struct snapshot_save_state *state, uacpi_u8 *code,
+    struct snapshot_code_ref *out_ref
+)
+{
+    struct code_search_ctx search = { .code = code };
+    uacpi_size i;
+
+    uacpi_for_each_table(0, find_code_table, &search);
+    if (uacpi_unlikely(!search.found)) {
+        uacpi_warn(
+            "unable to snapshot method@%p: code lies outside of any "
+            "loaded table\n", code
+        );
+        return UACPI_STATUS_UNIMPLEMENTED;
+    }
+
+    for (i = 0; i < table_idx_array_size(&state->table_map); ++i) {
+        if (*table_idx_array_at(&state->table_map, i) == search.idx)
+            break;
+    }
+    if (uacpi_unlikely(i == table_idx_array_size(&state->table_map)))
+        return UACPI_STATUS_INTERNAL_ERROR;
+
+    out_ref->table_idx = i;
+    out_ref->offset = code - (uacpi_u8*)search.ptr;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status save_buffer(
+    struct snapshot_save_state *state, uacpi_buffer *buffer, uacpi_u32 *out_idx
+)
+{
+    uacpi_status ret;
+    uacpi_u64 size = buffer->size;
+    uacpi_u32 idx;
+
+    idx = map_find(&state->buffer_map, buffer);
+    if (idx != SNAPSHOT_INVALID_IDX) {
+        *out_idx = idx;
+        return UACPI_STATUS_OK;
+    }
+
+    ret = writer_append(&state->buffers, &size, sizeof(size));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (buffer->size != 0) {
+        ret = writer_append(&state->buffers, buffer->data, buffer->size);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    }
+
+    return map_append(&state->buffer_map, buffer, out_idx);
+}
+
+static uacpi_u32 find_field_unit_node(
+    struct snapshot_save_state *state, uacpi_field_unit *field
+)
+{
+    uacpi_size i;
+
+    for (i = 0; i < pointer_array_size(&state->node_map); ++i) {
+        uacpi_namespace_node *node = *pointer_array_at(&state->node_map, i);
+        uacpi_object *obj = uacpi_namespace_node_get_object(node);
+
+        if (obj != UACPI_NULL && obj->type == UACPI_OBJECT_FIELD_UNIT &&
+            obj->field_unit == field)
+            return i;
+    }
+
+    return SNAPSHOT_INVALID_IDX;
+}
+
+static uacpi_status save_object(
+    struct snapshot_save_state *state, uacpi_object *obj,
+    uacpi_u32 *out_idx, uacpi_u32 depth
+);
+
+static uacpi_status save_method(
+    struct snapshot_save_state *state, uacpi_control_method *method,
+    struct snapshot_writer *payload
+)
+{
+    uacpi_status ret;
+    struct snapshot_method record = { 0 };
+
+    if (uacpi_unlikely(method->native_call)) {
+        uacpi_warn("unable to snapshot a native method@%p\n", method);
+        return UACPI_STATUS_UNIMPLEMENTED;
+    }
+
+    record.args = method->args;
+    record.sync_level = method->sync_level;
+    record.is_serialized = method->is_serialized;
+    record.named_objects_persist = method->named_objects_persist;
+    record.owns_code = method->owns_code;
+    record.code_size = method->size;
+
+    ret = writer_append(payload, &record, sizeof(record));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    // Nothing follows the record for an empty method
+    if (method->size == 0)
+        return UACPI_STATUS_OK;
+
+    if (method->owns_code)
+        return writer_append(payload, method->code, method->size);
+
+    {
+        struct snapshot_code_ref code_ref = { 0 };
+
+        ret = save_code_ref(state, method->code, &code_ref);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        return writer_append(payload, &code_ref, sizeof(code_ref));
+    }
+}
+
+static uacpi_status save_field_unit(
+    struct snapshot_save_state *state, uacpi_field_unit *field,
+    struct snapshot_writer *payload, uacpi_u32 depth
+)
+{
+    uacpi_status ret;
+    struct snapshot_field_unit record = { 0 };
+
+    record.kind = field->kind;
+    record.lock_rule = field->lock_rule;
+    record.update_rule = field->update_rule;
+    record.attributes = field->attributes;
+    record.bit_offset_within_first_byte = field->bit_offset_within_first_byte;
+    record.access_width_bytes = field->access_width_bytes;
+    record.access_length = field->access_length;
+    record.byte_offset = field->byte_offset;
+    record.bit_length = field->bit_length;
+    record.link0 = SNAPSHOT_INVALID_IDX;
+    record.link1 = SNAPSHOT_INVALID_IDX;
+    record.connection = SNAPSHOT_INVALID_IDX;
+
+    switch (field->kind) {
+    case UACPI_FIELD_UNIT_KIND_NORMAL:
+        record.link0 = map_find(&state->node_map, field->region);
+        break;
+    case UACPI_FIELD_UNIT_KIND_INDEX:
+        record.link0 = find_field_unit_node(state, field->index);
+        record.link1 = find_field_unit_node(state, field->data);
+        break;
+    case UACPI_FIELD_UNIT_KIND_BANK:
+        record.link0 = map_find(&state->node_map, field->bank_region);
+        record.link1 = find_field_unit_node(state, field->bank_selection);
+        record.bank_value = field->bank_value;
+        break;
+    default:
+        return UACPI_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (uacpi_unlikely(record.link0 == SNAPSHOT_INVALID_IDX ||
+                       (field->kind != UACPI_FIELD_UNIT_KIND_NORMAL &&
+                        record.link1 == SNAPSHOT_INVALID_IDX))) {
+        uacpi_warn(
+            "unable to snapshot field unit@%p: linked node is not part "
+            "of the namespace\n", field
+        );
+        return UACPI_STATUS_UNIMPLEMENTED;
+    }
+
+    if (field->connection != UACPI_NULL) {
+        uacpi_u32 connection_idx;
+
+        ret = save_object(state, field->connection, &connection_idx,
+                          depth + 1);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        record.connection = connection_idx;
+    }
+
+    return writer_append(payload, &record, sizeof(record));
+}
+
+static uacpi_status save_package(
+    struct snapshot_save_state *state, uacpi_package *pkg,
+    struct snapshot_writer *payload, uacpi_u32 depth
+)
+{
+    uacpi_status ret;
+    uacpi_u32 count = pkg->count;
+    uacpi_size i;
+
+    ret = uacpi_package_materialize(pkg);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = writer_append(payload, &count, sizeof(count));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (i = 0; i < pkg->count; ++i) {
+        uacpi_u32 idx;
+
+        ret = save_object(state, pkg->objects[i], &idx, depth + 1);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        ret = writer_append(payload, &idx, sizeof(idx));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status save_object(
+    struct snapshot_save_state *state, uacpi_object *obj,
+    uacpi_u32 *out_idx, uacpi_u32 depth
+)
+{
+    uacpi_status ret;
+    struct snapshot_object record = { 0 };
+    struct snapshot_writer payload = { 0 };
+    uacpi_u32 idx;
+
+    idx = map_find(&state->object_map, obj);
+    if (idx != SNAPSHOT_INVALID_IDX) {
+        *out_idx = idx;
+        return UACPI_STATUS_OK;
+    }
+
+    if (uacpi_unlikely(depth > SNAPSHOT_MAX_OBJECT_DEPTH)) {
+        uacpi_warn("unable to snapshot object@%p: nested too deep\n", obj);
+        return UACPI_STATUS_UNIMPLEMENTED;
+    }
+
+    record.type = obj->type;
+    record.flags = obj->flags;
+
+    switch (obj->type) {
+    case UACPI_OBJECT_UNINITIALIZED:
+    case UACPI_OBJECT_DEVICE:
+    case UACPI_OBJECT_THERMAL_ZONE:
+    case UACPI_OBJECT_EVENT:
+        break;
+    case UACPI_OBJECT_INTEGER:
+        ret = writer_append(&payload, &obj->integer, sizeof(obj->integer));
+        goto out_payload;
+    case UACPI_OBJECT_STRING:
+    case UACPI_OBJECT_BUFFER: {
+        uacpi_u32 buffer_idx;
+
+        ret = save_buffer(state, obj->buffer, &buffer_idx);
+        if (uacpi_unlikely_error(ret))
+            goto out_payload;
+
+        ret = writer_append(&payload, &buffer_idx, sizeof(buffer_idx));
+        goto out_payload;
+    }
+    case UACPI_OBJECT_BUFFER_FIELD: {
+        struct snapshot_buffer_field field = { 0 };
+        uacpi_u32 backing_idx;
+
+        ret = save_buffer(state, obj->buffer_field.backing, &backing_idx);
+        if (uacpi_unlikely_error(ret))
+            goto out_payload;
+
+        field.backing = backing_idx;
+        field.bit_index = obj->buffer_field.bit_index;
+        field.bit_length = obj->buffer_field.bit_length;
+        field.force_buffer = obj->buffer_field.force_buffer;
+
+        ret = writer_append(&payload, &field, sizeof(field));
+        goto out_payload;
+    }
+    case UACPI_OBJECT_PACKAGE:
+        ret = save_package(state, obj->package, &payload, depth);
+        goto out_payload;
+    case UACPI_OBJECT_METHOD:
+        ret = save_method(state, obj->method, &payload);
+        goto out_payload;
+    case UACPI_OBJECT_MUTEX: {
+        uacpi_u8 sync_level = obj->mutex->sync_level;
+
+        ret = writer_append(&payload, &sync_level, sizeof(sync_level));
+        goto out_payload;
+    }
+    case UACPI_OBJECT_OPERATION_REGION: {
+        struct snapshot_op_region region = { 0 };
+
+        if (uacpi_unlikely(
+                obj->op_region->space == UACPI_ADDRESS_SPACE_TABLE_DATA)) {
+            uacpi_warn(
+                "unable to snapshot a DataTableRegion-backed region@%p\n",
+                obj->op_region
+            );
+            ret = UACPI_STATUS_UNIMPLEMENTED;
+            goto out_payload;
+        }
+
+        region.space = obj->op_region->space;
+        region.offset = obj->op_region->offset;
+        region.length = obj->op_region->length;
+
+        ret = writer_append(&payload, &region, sizeof(region));
+        goto out_payload;
+    }
+    case UACPI_OBJECT_FIELD_UNIT:
+        ret = save_field_unit(state, obj->field_unit, &payload, depth);
+        goto out_payload;
+    case UACPI_OBJECT_PROCESSOR: {
+        struct snapshot_processor processor = { 0 };
+
+        processor.id = obj->processor->id;
+        processor.block_address = obj->processor->block_address;
+        processor.block_length = obj->processor->block_length;
+
+        ret = writer_append(&payload, &processor, sizeof(processor));
+        goto out_payload;
+    }
+    case UACPI_OBJECT_POWER_RESOURCE: {
+        struct snapshot_power_resource power_resource = { 0 };
+
+        power_resource.system_level = obj->power_resource.system_level;
+        power_resource.resource_order = obj->power_resource.resource_order;
+
+        ret = writer_append(&payload, &power_resource,
+                            sizeof(power_resource));
+        goto out_payload;
+    }
+    default:
+        uacpi_warn(
+            "unable to snapshot an object@%p of type %s\n",
+            obj, uacpi_object_type_to_string(obj->type)
+        );
+        return UACPI_STATUS_UNIMPLEMENTED;
+    }
+
+    ret = UACPI_STATUS_OK;
+
+out_payload:
+    if (uacpi_likely_success(ret)) {
+        ret = writer_append(&state->objects, &record, sizeof(record));
+        if (uacpi_likely_success(ret) && payload.size != 0)
+            ret = writer_append(&state->objects, payload.data, payload.size);
+        if (uacpi_likely_success(ret))
+            ret = map_append(&state->object_map, obj, out_idx);
+    }
+
+    writer_free(&payload);
+    return ret;
+}
+
+static uacpi_status collect_nodes(
+    struct snapshot_save_state *state, uacpi_namespace_node *parent
+)
+{
+    uacpi_status ret;
+    uacpi_namespace_node *node;
+
+    for (node = parent->child; node != UACPI_NULL; node = node->next) {
+        if (!uacpi_namespace_node_is_predefined(node)) {
+            ret = map_append(&state->node_map, node, UACPI_NULL);
+            if (uacpi_unlikely_error(ret))
+                return ret;
+        }
+
+        ret = collect_nodes(state, node);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_u32 encode_parent(
+    struct snapshot_save_state *state, uacpi_namespace_node *parent
+)
+{
+    if (uacpi_namespace_node_is_predefined(parent)) {
+        uacpi_predefined_namespace ns;
+
+        for (ns = 0; ns <= UACPI_PREDEFINED_NAMESPACE_MAX; ns++) {
+            if (uacpi_namespace_get_predefined(ns) == parent)
+                return SNAPSHOT_PARENT_PREDEFINED | (uacpi_u32)ns;
+        }
+
+        return SNAPSHOT_INVALID_IDX;
+    }
+
+    return map_find(&state->node_map, parent);
+}
+
+static uacpi_status save_node(
+    struct snapshot_save_state *state, uacpi_namespace_node *node,
+    uacpi_u32 node_idx
+)
+{
+    uacpi_status ret;
+    struct snapshot_node record = { 0 };
+
+    record.name_id = node->name.id;
+
+    record.parent = encode_parent(state, node->parent);
+    if (uacpi_unlikely(record.parent == SNAPSHOT_INVALID_IDX))
+        return UACPI_STATUS_INTERNAL_ERROR;
+
+    if (node->flags & UACPI_NAMESPACE_NODE_FLAG_ALIAS) {
+        uacpi_u32 target;
+
+        /*
+         * Aliases share the object of the node they alias, find it so that
+         * the loader can re-link them. AML guarantees the target was created
+         * (and thus serialized) before the alias.
+         */
+        for (target = 0; target < node_idx; ++target) {
+            uacpi_namespace_node *other;
+
+            other = *pointer_array_at(&state->node_map, target);
+            if (other->object == node->object &&
+                !(other->flags & UACPI_NAMESPACE_NODE_FLAG_ALIAS))
+                break;
+        }
+        if (uacpi_unlikely(target == node_idx)) {
+            uacpi_warn(
+                "unable to snapshot alias %.4s: target is not part of the "
+                "namespace\n", node->name.text
+            );
+            return UACPI_STATUS_UNIMPLEMENTED;
+        }
+
+        record.object = SNAPSHOT_OBJECT_ALIAS | target;
+    } else {
+        uacpi_object *obj;
+        uacpi_u32 object_idx;
+
+        obj = uacpi_namespace_node_get_object(node);
+        if (uacpi_unlikely(obj == UACPI_NULL)) {
+            uacpi_warn(
+                "unable to snapshot node %.4s: no object attached\n",
+                node->name.text
+            );
+            return UACPI_STATUS_UNIMPLEMENTED;
+        }
+
+        ret = save_object(state, obj, &object_idx, 0);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        record.object = object_idx;
+    }
+
+    return writer_append(&state->nodes, &record, sizeof(record));
+}
+
+static void save_state_free(struct snapshot_save_state *state)
+{
+    writer_free(&state->tables);
+    writer_free(&state->buffers);
+    writer_free(&state->objects);
+    writer_free(&state->nodes);
+    pointer_array_clear(&state->node_map);
+    pointer_array_clear(&state->object_map);
+    pointer_array_clear(&state->buffer_map);
+    table_idx_array_clear(&state->table_map);
+}
+
+uacpi_status uacpi_namespace_snapshot_save(
+    void **out_image, uacpi_size *out_size
+)
+{
+    uacpi_status ret;
+    struct snapshot_save_state state = { 0 };
+    struct snapshot_header header = { 0 };
+    uacpi_size i, total_size, offset;
+    uacpi_u8 *image;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    if (uacpi_unlikely(out_image == UACPI_NULL || out_size == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    /*
+     * An exclusive lock even though the tree itself is only read:
+     * saving a package materializes its deferred elements in place, which
+     * must not race against another writer (or another concurrent save).
+     */
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = uacpi_for_each_table(0, record_loaded_table, &state);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    // The table callback has no way to propagate its errors directly
+    if (uacpi_unlikely(table_idx_array_size(&state.table_map) !=
+                       state.tables.size / sizeof(struct snapshot_table))) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    ret = collect_nodes(&state, uacpi_namespace_root());
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
+    for (i = 0; i < pointer_array_size(&state.node_map); ++i) {
+        ret = save_node(&state, *pointer_array_at(&state.node_map, i), i);
+        if (uacpi_unlikely_error(ret))
+            goto out;
+    }
+
+    uacpi_memcpy(header.signature, SNAPSHOT_SIGNATURE,
+                 sizeof(header.signature));
+    header.version = SNAPSHOT_VERSION;
+    header.num_tables = table_idx_array_size(&state.table_map);
+    header.num_buffers = pointer_array_size(&state.buffer_map);
+    header.num_objects = pointer_array_size(&state.object_map);
+    header.num_nodes = pointer_array_size(&state.node_map);
+
+    total_size = sizeof(header) + state.tables.size + state.buffers.size +
+                 state.objects.size + state.nodes.size;
+    header.total_size = total_size;
+
+    image = uacpi_kernel_alloc(total_size);
+    if (uacpi_unlikely(image == UACPI_NULL)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    uacpi_memcpy(image, &header, sizeof(header));
+    offset = sizeof(header);
+    uacpi_memcpy(image + offset, state.tables.data, state.tables.size);
+    offset += state.tables.size;
+    uacpi_memcpy(image + offset, state.buffers.data, state.buffers.size);
+    offset += state.buffers.size;
+    uacpi_memcpy(image + offset, state.objects.data, state.objects.size);
+    offset += state.objects.size;
+    uacpi_memcpy(image + offset, state.nodes.data, state.nodes.size);
+
+    uacpi_info(
+        "saved a namespace snapshot: %u nodes, %u objects, %zu bytes\n",
+        header.num_nodes, header.num_objects, total_size
+    );
+
+    *out_image = image;
+    *out_size = total_size;
+
+out:
+    save_state_free(&state);
+    uacpi_namespace_write_unlock();
+    return ret;
+}
+
+void uacpi_namespace_snapshot_free(void *image, uacpi_size size)
+{
+    UACPI_UNUSED(size);
+
+    if (image == UACPI_NULL)
+        return;
+
+    uacpi_free(image, size);
+}
+
+/*
+ * ========================
+ * Reconstruction (load)
+ * ========================
+ */
+
+struct snapshot_buffer_slot {
+    uacpi_buffer *buffer;
+
+    // Set once the first user has adopted the creation reference
+    uacpi_bool owned;
+};
+
+struct snapshot_field_fixup {
+    uacpi_field_unit *field;
+    uacpi_u8 kind;
+    uacpi_u32 link0;
+    uacpi_u32 link1;
+};
+
+struct snapshot_loader {
+    const uacpi_u8 *cursor;
+    const uacpi_u8 *end;
+
+    struct snapshot_header header;
+
+    uacpi_table *tables;
+    struct snapshot_buffer_slot *buffers;
+    uacpi_object **objects;
+    uacpi_namespace_node **nodes;
+
+    uacpi_u32 num_buffers;
+    uacpi_u32 num_objects;
+    uacpi_u32 num_nodes;
+
+    struct snapshot_field_fixup *fixups;
+    uacpi_u32 num_fixups;
+};
+
+static uacpi_status loader_read(
+    struct snapshot_loader *loader, void *out, uacpi_size size
+)
+{
+    if (uacpi_unlikely(size > (uacpi_size)(loader->end - loader->cursor)))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    uacpi_memcpy(out, loader->cursor, size);
+    loader->cursor += size;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status loader_read_bytes(
+    struct snapshot_loader *loader, const uacpi_u8 **out, uacpi_size size
+)
+{
+    if (uacpi_unlikely(size > (uacpi_size)(loader->end - loader->cursor)))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    *out = loader->cursor;
+    loader->cursor += size;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status load_tables(struct snapshot_loader *loader)
+{
+    uacpi_status ret;
+    uacpi_u32 i;
+
+    for (i = 0; i < loader->header.num_tables; ++i) {
+        struct snapshot_table record;
+        uacpi_table_identifiers id = { 0 };
+        uacpi_table tbl;
+
+        ret = loader_read(loader, &record, sizeof(record));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        uacpi_memcpy(&id.signature, record.signature, sizeof(id.signature));
+        uacpi_memcpy(id.oemid, record.oemid, sizeof(id.oemid));
+        uacpi_memcpy(id.oem_table_id, record.oem_table_id,
+                     sizeof(id.oem_table_id));
+
+        ret = uacpi_table_find(&id, &tbl);
+        while (ret == UACPI_STATUS_OK) {
+            if (tbl.hdr->length == record.length &&
+                tbl.hdr->revision == record.revision &&
+                tbl.hdr->checksum == record.checksum &&
+                uacpi_memcmp(tbl.hdr->oemid, record.oemid,
+                             sizeof(record.oemid)) == 0 &&
+                uacpi_memcmp(tbl.hdr->oem_table_id, record.oem_table_id,
+                             sizeof(record.oem_table_id)) == 0)
+                break;
+
+            ret = uacpi_table_find_next_with_same_signature(&tbl);
+        }
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_error(
+                "snapshot table '%.4s' (OEM ID '%.6s') does not match any "
+                "installed table\n", record.signature, record.oemid
+            );
+            return UACPI_STATUS_NOT_FOUND;
+        }
+
+        /*
+         * Keep the reference returned by the find, it is what keeps the
+         * mapping (and thus any method code inside) alive, same as a real
+         * table load would.
+         */
+        loader->tables[i] = tbl;
+        uacpi_table_mark_as_loaded(tbl.index);
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status load_buffers(struct snapshot_loader *loader)
+{
+    uacpi_status ret;
+    uacpi_u32 i;
+
+    for (i = 0; i < loader->header.num_buffers; ++i) {
+        uacpi_u64 size;
+        const uacpi_u8 *data;
+        uacpi_buffer *buffer;
+
+        ret = loader_read(loader, &size, sizeof(size));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        if (uacpi_unlikely(size > (uacpi_u64)(loader->end - loader->cursor)))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        ret = loader_read_bytes(loader, &data, size);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        buffer = uacpi_kernel_alloc_zeroed(sizeof(*buffer));
+        if (uacpi_unlikely(buffer == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+        uacpi_shareable_init(buffer);
+
+        buffer->data = uacpi_kernel_alloc(UACPI_MAX(size, 1));
+        if (uacpi_unlikely(buffer->data == UACPI_NULL)) {
+            uacpi_free(buffer, sizeof(*buffer));
+            return UACPI_STATUS_OUT_OF_MEMORY;
+        }
+
+        uacpi_memcpy(buffer->data, data, size);
+        buffer->size = size;
+
+        loader->buffers[i].buffer = buffer;
+        loader->num_buffers++;
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_buffer *adopt_buffer(
+    struct snapshot_loader *loader, uacpi_u32 idx
+)
+{
+    struct snapshot_buffer_slot *slot;
+
+    if (uacpi_unlikely(idx >= loader->num_buffers))
+        return UACPI_NULL;
+
+    slot = &loader->buffers[idx];
+    if (slot->owned)
+        uacpi_shareable_ref(slot->buffer);
+    else
+        slot->owned = UACPI_TRUE;
+
+    return slot->buffer;
+}
+
+static uacpi_object *loaded_object_at(
+    struct snapshot_loader *loader, uacpi_u32 idx
+)
+{
+    if (uacpi_unlikely(idx >= loader->num_objects))
+        return UACPI_NULL;
+
+    return loader->objects[idx];
+}
+
+static uacpi_status load_method(
+    struct snapshot_loader *loader, uacpi_object *obj
+)
+{
+    uacpi_status ret;
+    struct snapshot_method record;
+    uacpi_control_method *method = obj->method;
+
+    ret = loader_read(loader, &record, sizeof(record));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    method->args = record.args & 0b111;
+    method->sync_level = record.sync_level & 0b1111;
+    method->is_serialized = record.is_serialized & 1;
+    method->named_objects_persist = record.named_objects_persist & 1;
+    method->size = record.code_size;
+
+    if (record.code_size == 0)
+        return UACPI_STATUS_OK;
+
+    if (record.owns_code) {
+        const uacpi_u8 *code;
+
+        ret = loader_read_bytes(loader, &code, record.code_size);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        method->code = uacpi_kernel_alloc(record.code_size);
+        if (uacpi_unlikely(method->code == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        uacpi_memcpy(method->code, code, record.code_size);
+        method->owns_code = 1;
+        return UACPI_STATUS_OK;
+    }
+
+    {
+        struct snapshot_code_ref code_ref;
+        uacpi_table *tbl;
+
+        ret = loader_read(loader, &code_ref, sizeof(code_ref));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        if (uacpi_unlikely(code_ref.table_idx >= loader->header.num_tables))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        tbl = &loader->tables[code_ref.table_idx];
+        if (uacpi_unlikely(code_ref.offset >= tbl->hdr->length ||
+                           record.code_size >
+                               tbl->hdr->length - code_ref.offset))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        method->code = (uacpi_u8*)tbl->ptr + code_ref.offset;
+        return UACPI_STATUS_OK;
+    }
+}
+
+static uacpi_status load_field_unit(
+    struct snapshot_loader *loader, uacpi_object *obj
+)
+{
+    uacpi_status ret;
+    struct snapshot_field_unit record;
+    uacpi_field_unit *field = obj->field_unit;
+    struct snapshot_field_fixup *fixup;
+
+    ret = loader_read(loader, &record, sizeof(record));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    field->kind = record.kind & 0b11;
+    field->lock_rule = record.lock_rule & 1;
+    field->update_rule = record.update_rule & 0b11;
+    field->attributes = record.attributes & 0b1111;
+    field->bit_offset_within_first_byte =
+        record.bit_offset_within_first_byte;
+    field->access_width_bytes = record.access_width_bytes;
+    field->access_length = record.access_length;
+    field->byte_offset = record.byte_offset;
+    field->bit_length = record.bit_length;
+
+    if (field->kind == UACPI_FIELD_UNIT_KIND_BANK)
+        field->bank_value = record.bank_value;
+
+    if (record.connection != SNAPSHOT_INVALID_IDX) {
+        uacpi_object *connection;
+
+        connection = loaded_object_at(loader, record.connection);
+        if (uacpi_unlikely(connection == UACPI_NULL))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        field->connection = connection;
+        uacpi_object_ref(connection);
+    }
+
+    /*
+     * The linked nodes don't exist yet, remember this field so that the
+     * links can be wired up once the tree is fully rebuilt.
+     */
+    fixup = &loader->fixups[loader->num_fixups++];
+    fixup->field = field;
+    fixup->kind = field->kind;
+    fixup->link0 = record.link0;
+    fixup->link1 = record.link1;
+
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status load_package(
+    struct snapshot_loader *loader, uacpi_object *obj
+)
+{
+    uacpi_status ret;
+    uacpi_u32 count, i;
+
+    ret = loader_read(loader, &count, sizeof(count));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (uacpi_unlikely(count > SNAPSHOT_MAX_COUNT))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    if (!uacpi_package_fill(obj->package, count, UACPI_PREALLOC_OBJECTS_NO))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    for (i = 0; i < count; ++i) {
+        uacpi_u32 idx;
+        uacpi_object *element;
+
+        ret = loader_read(loader, &idx, sizeof(idx));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        element = loaded_object_at(loader, idx);
+        if (uacpi_unlikely(element == UACPI_NULL))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        obj->package->objects[i] = element;
+        uacpi_object_ref(element);
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_status load_object(struct snapshot_loader *loader)
+{
+    uacpi_status ret;
+    struct snapshot_object record;
+    uacpi_object *obj;
+
+    ret = loader_read(loader, &record, sizeof(record));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    switch (record.type) {
+    /*
+     * Buffer-backed objects attach a shared buffer loaded earlier, so they
+     * are created typeless here to avoid the default constructor allocating
+     * storage that would have to be thrown away.
+     */
+    case UACPI_OBJECT_STRING:
+    case UACPI_OBJECT_BUFFER:
+    case UACPI_OBJECT_BUFFER_FIELD:
+    case UACPI_OBJECT_POWER_RESOURCE:
+        obj = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
+        break;
+    case UACPI_OBJECT_UNINITIALIZED:
+    case UACPI_OBJECT_INTEGER:
+    case UACPI_OBJECT_PACKAGE:
+    case UACPI_OBJECT_METHOD:
+    case UACPI_OBJECT_MUTEX:
+    case UACPI_OBJECT_EVENT:
+    case UACPI_OBJECT_OPERATION_REGION:
+    case UACPI_OBJECT_FIELD_UNIT:
+    case UACPI_OBJECT_PROCESSOR:
+    case UACPI_OBJECT_DEVICE:
+    case UACPI_OBJECT_THERMAL_ZONE:
+        obj = uacpi_create_object(record.type);
+        break;
+    default:
+        return UACPI_STATUS_INVALID_ARGUMENT;
+    }
+    if (uacpi_unlikely(obj == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    loader->objects[loader->num_objects++] = obj;
+
+    switch (record.type) {
+    case UACPI_OBJECT_UNINITIALIZED:
+    case UACPI_OBJECT_DEVICE:
+    case UACPI_OBJECT_THERMAL_ZONE:
+    case UACPI_OBJECT_EVENT:
+        return UACPI_STATUS_OK;
+    case UACPI_OBJECT_INTEGER:
+        return loader_read(loader, &obj->integer, sizeof(obj->integer));
+    case UACPI_OBJECT_STRING:
+    case UACPI_OBJECT_BUFFER: {
+        uacpi_u32 buffer_idx;
+
+        ret = loader_read(loader, &buffer_idx, sizeof(buffer_idx));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        obj->buffer = adopt_buffer(loader, buffer_idx);
+        if (uacpi_unlikely(obj->buffer == UACPI_NULL))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        obj->type = record.type;
+        obj->flags = record.flags;
+        return UACPI_STATUS_OK;
+    }
+    case UACPI_OBJECT_BUFFER_FIELD: {
+        struct snapshot_buffer_field field;
+
+        ret = loader_read(loader, &field, sizeof(field));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        obj->buffer_field.backing = adopt_buffer(loader, field.backing);
+        if (uacpi_unlikely(obj->buffer_field.backing == UACPI_NULL))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        obj->buffer_field.bit_index = field.bit_index;
+        obj->buffer_field.bit_length = field.bit_length;
+        obj->buffer_field.force_buffer = field.force_buffer & 1;
+        obj->type = record.type;
+        return UACPI_STATUS_OK;
+    }
+    case UACPI_OBJECT_PACKAGE:
+        return load_package(loader, obj);
+    case UACPI_OBJECT_METHOD:
+        return load_method(loader, obj);
+    case UACPI_OBJECT_MUTEX: {
+        uacpi_u8 sync_level;
+
+        ret = loader_read(loader, &sync_level, sizeof(sync_level));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        obj->mutex->sync_level = sync_level & 0b1111;
+        return UACPI_STATUS_OK;
+    }
+    case UACPI_OBJECT_OPERATION_REGION: {
+        struct snapshot_op_region region;
+
+        ret = loader_read(loader, &region, sizeof(region));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        obj->op_region->space = region.space;
+        obj->op_region->offset = region.offset;
+        obj->op_region->length = region.length;
+        return UACPI_STATUS_OK;
+    }
+    case UACPI_OBJECT_FIELD_UNIT:
+        return load_field_unit(loader, obj);
+    case UACPI_OBJECT_PROCESSOR: {
+        struct snapshot_processor processor;
+
+        ret = loader_read(loader, &processor, sizeof(processor));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        obj->processor->id = processor.id;
+        obj->processor->block_address = processor.block_address;
+        obj->processor->block_length = processor.block_length;
+        return UACPI_STATUS_OK;
+    }
+    case UACPI_OBJECT_POWER_RESOURCE: {
+        struct snapshot_power_resource power_resource;
+
+        ret = loader_read(loader, &power_resource, sizeof(power_resource));
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        obj->power_resource.system_level = power_resource.system_level;
+        obj->power_resource.resource_order = power_resource.resource_order;
+        obj->type = record.type;
+        return UACPI_STATUS_OK;
+    }
+    default:
+        return UACPI_STATUS_INVALID_ARGUMENT;
+    }
+}
+
+static uacpi_status load_node(struct snapshot_loader *loader)
+{
+    uacpi_status ret;
+    struct snapshot_node record;
+    uacpi_namespace_node *node, *parent;
+    uacpi_object_name name;
+
+    ret = loader_read(loader, &record, sizeof(record));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (record.parent & SNAPSHOT_PARENT_PREDEFINED) {
+        uacpi_u32 ns = record.parent & ~SNAPSHOT_PARENT_PREDEFINED;
+
+        if (uacpi_unlikely(ns > UACPI_PREDEFINED_NAMESPACE_MAX))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        parent = uacpi_namespace_get_predefined(ns);
+    } else {
+        if (uacpi_unlikely(record.parent >= loader->num_nodes))
+            return UACPI_STATUS_INVALID_ARGUMENT;
+
+        parent = loader->nodes[record.parent];
+    }
+
+    name.id = record.name_id;
+    node = uacpi_namespace_node_alloc(name);
+    if (uacpi_unlikely(node == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    if (record.object & SNAPSHOT_OBJECT_ALIAS) {
+        uacpi_u32 target = record.object & ~SNAPSHOT_OBJECT_ALIAS;
+
+        if (uacpi_unlikely(target >= loader->num_nodes)) {
+            uacpi_namespace_node_unref(node);
+            return UACPI_STATUS_INVALID_ARGUMENT;
+        }
+
+        node->object = loader->nodes[target]->object;
+        node->flags = UACPI_NAMESPACE_NODE_FLAG_ALIAS;
+        uacpi_object_ref(node->object);
+    } else {
+        uacpi_object *obj;
+
+        obj = loaded_object_at(loader, record.object);
+        if (uacpi_unlikely(obj == UACPI_NULL)) {
+            uacpi_namespace_node_unref(node);
+            return UACPI_STATUS_INVALID_ARGUMENT;
+        }
+
+        node->object = uacpi_create_internal_reference(
+            UACPI_REFERENCE_KIND_NAMED, obj
+        );
+        if (uacpi_unlikely(node->object == UACPI_NULL)) {
+            uacpi_namespace_node_unref(node);
+            return UACPI_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    ret = uacpi_namespace_node_install(parent, node);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_namespace_node_unref(node);
+        return ret;
+    }
+
+    loader->nodes[loader->num_nodes++] = node;
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_field_unit *fixup_field_at(
+    struct snapshot_loader *loader, uacpi_u32 idx
+)
+{
+    uacpi_object *obj;
+
+    if (uacpi_unlikely(idx >= loader->num_nodes))
+        return UACPI_NULL;
+
+    obj = uacpi_namespace_node_get_object(loader->nodes[idx]);
+    if (uacpi_unlikely(obj == UACPI_NULL ||
+                       obj->type != UACPI_OBJECT_FIELD_UNIT))
+        return UACPI_NULL;
+
+    return obj->field_unit;
+}
+
+static uacpi_status apply_field_fixups(struct snapshot_loader *loader)
+{
+    uacpi_u32 i;
+
+    for (i = 0; i < loader->num_fixups; ++i) {
+        struct snapshot_field_fixup *fixup = &loader->fixups[i];
+        uacpi_field_unit *field = fixup->field;
+
+        switch (fixup->kind) {
+        case UACPI_FIELD_UNIT_KIND_NORMAL:
+            if (uacpi_unlikely(fixup->link0 >= loader->num_nodes))
+                return UACPI_STATUS_INVALID_ARGUMENT;
+
+            field->region = loader->nodes[fixup->link0];
+            uacpi_shareable_ref(field->region);
+            break;
+        case UACPI_FIELD_UNIT_KIND_INDEX:
+            field->index = fixup_field_at(loader, fixup->link0);
+            field->data = fixup_field_at(loader, fixup->link1);
+            if (uacpi_unlikely(field->index == UACPI_NULL ||
+                               field->data == UACPI_NULL)) {
+                // Make sure the destructor doesn't chase invalid links
+                field->kind = UACPI_FIELD_UNIT_KIND_NORMAL;
+                field->region = UACPI_NULL;
+                return UACPI_STATUS_INVALID_ARGUMENT;
+            }
+
+            uacpi_shareable_ref(field->index);
+            uacpi_shareable_ref(field->data);
+            break;
+        case UACPI_FIELD_UNIT_KIND_BANK:
+            if (uacpi_unlikely(fixup->link0 >= loader->num_nodes))
+                return UACPI_STATUS_INVALID_ARGUMENT;
+
+            field->bank_selection = fixup_field_at(loader, fixup->link1);
+            if (uacpi_unlikely(field->bank_selection == UACPI_NULL)) {
+                field->kind = UACPI_FIELD_UNIT_KIND_NORMAL;
+                field->region = UACPI_NULL;
+                return UACPI_STATUS_INVALID_ARGUMENT;
+            }
+
+            field->bank_region = loader->nodes[fixup->link0];
+            uacpi_shareable_ref(field->bank_region);
+            uacpi_shareable_ref(field->bank_selection);
+            break;
+        default:
+            return UACPI_STATUS_INVALID_ARGUMENT;
+        }
+    }
+
+    return UACPI_STATUS_OK;
+}
+
+static void loader_free(struct snapshot_loader *loader)
+{
+    uacpi_free(loader->tables,
+               UACPI_MAX(loader->header.num_tables, 1u) *
+                   sizeof(*loader->tables));
+    uacpi_free(loader->buffers,
+               UACPI_MAX(loader->header.num_buffers, 1u) *
+                   sizeof(*loader->buffers));
+    uacpi_free(loader->objects,
+               UACPI_MAX(loader->header.num_objects, 1u) *
+                   sizeof(*loader->objects));
+    uacpi_free(loader->nodes,
+               UACPI_MAX(loader->header.num_nodes, 1u) *
+                   sizeof(*loader->nodes));
+    uacpi_free(loader->fixups,
+               UACPI_MAX(loader->header.num_objects, 1u) *
+                   sizeof(*loader->fixups));
+}
+
+static void loader_drop_creation_refs(struct snapshot_loader *loader)
+{
+    uacpi_u32 i;
+
+    for (i = 0; i < loader->num_objects; ++i)
+        uacpi_object_unref(loader->objects[i]);
+
+    for (i = 0; i < loader->num_buffers; ++i) {
+        struct snapshot_buffer_slot *slot = &loader->buffers[i];
+
+        if (slot->owned)
+            continue;
+
+        uacpi_free(slot->buffer->data, UACPI_MAX(slot->buffer->size, 1));
+        uacpi_free(slot->buffer, sizeof(*slot->buffer));
+    }
+}
+
+uacpi_status uacpi_namespace_snapshot_load(const void *image, uacpi_size size)
+{
+    uacpi_status ret;
+    struct snapshot_loader loader = { 0 };
+    uacpi_u64 begin_ts, end_ts;
+    uacpi_bool namespace_locked = UACPI_FALSE;
+
+    UACPI_ENSURE_INIT_LEVEL_IS(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
+
+    if (uacpi_unlikely(image == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    begin_ts = uacpi_kernel_get_nanoseconds_since_boot();
+
+    loader.cursor = image;
+    loader.end = loader.cursor + size;
+
+    ret = loader_read(&loader, &loader.header, sizeof(loader.header));
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (uacpi_memcmp(loader.header.signature, SNAPSHOT_SIGNATURE,
+                     sizeof(loader.header.signature)) != 0)
+        return UACPI_STATUS_INVALID_SIGNATURE;
+    if (loader.header.version != SNAPSHOT_VERSION)
+        return UACPI_STATUS_UNIMPLEMENTED;
+    if (loader.header.total_size != size ||
+        loader.header.num_tables > SNAPSHOT_MAX_COUNT ||
+        loader.header.num_buffers > SNAPSHOT_MAX_COUNT ||
+        loader.header.num_objects > SNAPSHOT_MAX_COUNT ||
+        loader.header.num_nodes > SNAPSHOT_MAX_COUNT)
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    // The UACPI_MAX is to avoid zero-sized allocations for empty sections
+    loader.tables = uacpi_kernel_alloc_zeroed(
+        UACPI_MAX(loader.header.num_tables, 1u) * sizeof(*loader.tables));
+    loader.buffers = uacpi_kernel_alloc_zeroed(
+        UACPI_MAX(loader.header.num_buffers, 1u) * sizeof(*loader.buffers));
+    loader.objects = uacpi_kernel_alloc_zeroed(
+        UACPI_MAX(loader.header.num_objects, 1u) * sizeof(*loader.objects));
+    loader.nodes = uacpi_kernel_alloc_zeroed(
+        UACPI_MAX(loader.header.num_nodes, 1u) * sizeof(*loader.nodes));
+    loader.fixups = uacpi_kernel_alloc_zeroed(
+        UACPI_MAX(loader.header.num_objects, 1u) * sizeof(*loader.fixups));
+    if (uacpi_unlikely(loader.tables == UACPI_NULL ||
+                       loader.buffers == UACPI_NULL ||
+                       loader.objects == UACPI_NULL ||
+                       loader.nodes == UACPI_NULL ||
+                       loader.fixups == UACPI_NULL)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out_fatal_error;
+    }
+
+    ret = load_tables(&loader);
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
+    ret = load_buffers(&loader);
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
+    {
+        uacpi_u32 i;
+
+        for (i = 0; i < loader.header.num_objects; ++i) {
+            ret = load_object(&loader);
+            if (uacpi_unlikely_error(ret))
+                goto out_fatal_error;
+        }
+    }
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+    namespace_locked = UACPI_TRUE;
+
+    {
+        uacpi_u32 i;
+
+        for (i = 0; i < loader.header.num_nodes; ++i) {
+            ret = load_node(&loader);
+            if (uacpi_unlikely_error(ret))
+                goto out_fatal_error;
+        }
+    }
+
+    ret = apply_field_fixups(&loader);
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
+    uacpi_namespace_write_unlock();
+    namespace_locked = UACPI_FALSE;
+
+    loader_drop_creation_refs(&loader);
+    loader_free(&loader);
+
+    /*
+     * Event bring-up pokes PM1 registers that are only ours once the
+     * hardware has fully entered ACPI mode, same as in a regular
+     * uacpi_namespace_load().
+     */
+    uacpi_join_acpi_mode_transition();
+
+    ret = uacpi_initialize_events();
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_error("event initialization failed: %s\n",
+                    uacpi_status_to_string(ret));
+        uacpi_state_reset();
+        return ret;
+    }
+
+    end_ts = uacpi_kernel_get_nanoseconds_since_boot();
+    uacpi_info(
+        "restored a namespace snapshot: %u nodes, %u objects in "
+        "%"UACPI_PRIu64"ms\n", loader.header.num_nodes,
+        loader.header.num_objects,
+        UACPI_FMT64((end_ts - begin_ts) / (1000ull * 1000ull))
+    );
+
+    g_uacpi_rt_ctx.init_level = UACPI_INIT_LEVEL_NAMESPACE_LOADED;
+    return UACPI_STATUS_OK;
+
+out_fatal_error:
+    if (namespace_locked)
+        uacpi_namespace_write_unlock();
+
+    loader_drop_creation_refs(&loader);
+    loader_free(&loader);
+    uacpi_state_reset();
+    return ret;
+}
@@ -1,6 +1,8 @@
 #include <uacpi/internal/stdlib.h>
 #include <uacpi/internal/utilities.h>
+#include <uacpi/memory.h>
 #include <uacpi/platform/config.h>
+#include <uacpi/platform/atomic.h>
 
 #ifndef uacpi_memcpy
 void *uacpi_memcpy(void *dest, const void *src, size_t count)
@@ -8,6 +10,33 @@ void *uacpi_memcpy(void *dest, const void *src, size_t count)
     uacpi_char *cd = dest;
     const uacpi_char *cs = src;
 
+    /*
+     * Move word-sized chunks if the two cursors can be co-aligned, going
+     * byte-by-byte only for the tails on either side. The 16-byte inner loop
+     * is trivially vectorizable for compilers targeting SIMD-capable hosts.
+     */
+    if (((uacpi_uintptr)cd & 7) == ((uacpi_uintptr)cs & 7)) {
+        while (count && ((uacpi_uintptr)cd & 7)) {
+            *cd++ = *cs++;
+            count--;
+        }
+
+        while (count >= 16) {
+            *(uacpi_u64*)cd = *(const uacpi_u64*)cs;
+            *(uacpi_u64*)(cd + 8) = *(const uacpi_u64*)(cs + 8);
+            cd += 16;
+            cs += 16;
+            count -= 16;
+        }
+
+        if (count >= 8) {
+            *(uacpi_u64*)cd = *(const uacpi_u64*)cs;
+            cd += 8;
+            cs += 8;
+            count -= 8;
+        }
+    }
+
     while (count--)
         *cd++ = *cs++;
 
@@ -41,6 +70,29 @@ void *uacpi_memset(void *dest, uacpi_i32 ch, uacpi_size count)
 {
     uacpi_u8 fill = ch;
     uacpi_u8 *cdest = dest;
+    uacpi_u64 fill_word = fill;
+
+    fill_word |= fill_word << 8;
+    fill_word |= fill_word << 16;
+    fill_word |= fill_word << 32;
+
+    while (count && ((uacpi_uintptr)cdest & 7)) {
+        *cdest++ = fill;
+        count--;
+    }
+
+    while (count >= 16) {
+        *(uacpi_u64*)cdest = fill_word;
+        *(uacpi_u64*)(cdest + 8) = fill_word;
+        cdest += 16;
+        count -= 16;
+    }
+
+    if (count >= 8) {
+        *(uacpi_u64*)cdest = fill_word;
+        cdest += 8;
+        count -= 8;
+    }
 
     while (count--)
         *cdest++ = fill;
@@ -54,11 +106,36 @@ uacpi_i32 uacpi_memcmp(const void *lhs, const void *rhs, uacpi_size count)
 {
     const uacpi_u8 *byte_lhs = lhs;
     const uacpi_u8 *byte_rhs = rhs;
-    uacpi_size i;
 
-    for (i = 0; i < count; ++i) {
-        if (byte_lhs[i] != byte_rhs[i])
-            return byte_lhs[i] - byte_rhs[i];
+    /*
+     * Scan word-at-a-time if the two cursors can be co-aligned, falling back
+     * to the byte loop below to pinpoint the mismatch (which also keeps the
+     * return value endianness-agnostic).
+     */
+    if (((uacpi_uintptr)byte_lhs & 7) == ((uacpi_uintptr)byte_rhs & 7)) {
+        while (count && ((uacpi_uintptr)byte_lhs & 7)) {
+            if (*byte_lhs != *byte_rhs)
+                return *byte_lhs - *byte_rhs;
+
+            byte_lhs++;
+            byte_rhs++;
+            count--;
+        }
+
+        while (count >= 8 &&
+               *(const uacpi_u64*)byte_lhs == *(const uacpi_u64*)byte_rhs) {
+            byte_lhs += 8;
+            byte_rhs += 8;
+            count -= 8;
+        }
+    }
+
+    while (count--) {
+        if (*byte_lhs != *byte_rhs)
+            return *byte_lhs - *byte_rhs;
+
+        byte_lhs++;
+        byte_rhs++;
     }
 
     return 0;
@@ -664,8 +741,212 @@ uacpi_u8 uacpi_popcount(uacpi_u64 value)
 #endif
 }
 
+const uacpi_char uacpi_hex_chars[16] = "0123456789ABCDEF";
+static const uacpi_char hex_chars_lower[16] = "0123456789abcdef";
+
+uacpi_size uacpi_u64_to_hex_string(
+    uacpi_u64 value, uacpi_char *buf, uacpi_bool uppercase
+)
+{
+    const uacpi_char *chars = uppercase ? uacpi_hex_chars : hex_chars_lower;
+    uacpi_size len, i;
+
+    // bit_scan_backward(0) is 0, so a lone zero still gets one digit
+    len = (uacpi_size)(uacpi_bit_scan_backward(value | 1) + 3) / 4;
+
+    for (i = len; i-- > 0;) {
+        buf[i] = chars[value & 0xF];
+        value >>= 4;
+    }
+
+    return len;
+}
+
+static const uacpi_char decimal_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+uacpi_size uacpi_u64_to_dec_string(uacpi_u64 value, uacpi_char *buf)
+{
+    uacpi_char tmp[20];
+    uacpi_size idx = sizeof(tmp);
+
+    /*
+     * Emit two digits per division so half of them come straight out of the
+     * pair table, with the divisions by constant 100 compiled down to
+     * multiply-shift sequences.
+     */
+    while (value >= 100) {
+        uacpi_u64 rem = value % 100;
+
+        value /= 100;
+        idx -= 2;
+        uacpi_memcpy(&tmp[idx], &decimal_pairs[rem * 2], 2);
+    }
+
+    if (value >= 10) {
+        idx -= 2;
+        uacpi_memcpy(&tmp[idx], &decimal_pairs[value * 2], 2);
+    } else {
+        tmp[--idx] = '0' + value;
+    }
+
+    uacpi_memcpy(buf, &tmp[idx], sizeof(tmp) - idx);
+    return sizeof(tmp) - idx;
+}
+
 #ifndef UACPI_FORMATTED_LOGGING
 
+/*
+ * Deferred log sink: records are formatted into a fixed lock-free ring at the
+ * call site and handed to uacpi_kernel_log later from uacpi_flush_deferred_log,
+ * so a slow console (e.g. serial) never stalls the logging thread. The ring
+ * follows the same claim/publish scheme as the notification queue.
+ */
+#define LOG_SLOT_PHASE_EMPTY 0
+#define LOG_SLOT_PHASE_READY 1
+
+struct deferred_log_slot {
+    uacpi_u32 state;
+    uacpi_log_level level;
+    uacpi_char message[UACPI_PLAIN_LOG_BUFFER_SIZE];
+};
+
+static struct deferred_log_slot deferred_log_ring[UACPI_DEFERRED_LOG_RING_SIZE];
+
+// Producer claim cursor, only ever grows. The slot for a claim is its
+// value modulo the ring size.
+static uacpi_u32 deferred_log_head;
+
+// Consumer cursor, only ever written under the flush guard
+static uacpi_u32 deferred_log_tail;
+
+// Makes sure there's only one consumer draining the ring at any given time
+static uacpi_u32 deferred_log_flush_guard;
+
+static uacpi_u32 deferred_log_dropped;
+static uacpi_u32 deferred_log_enabled;
+
+// Set while a background flush work item is pending, to avoid piling them up
+static uacpi_u32 deferred_log_flush_scheduled;
+
+static void do_deferred_log_flush(uacpi_handle opaque)
+{
+    UACPI_UNUSED(opaque);
+
+    uacpi_atomic_store32(&deferred_log_flush_scheduled, 0);
+    uacpi_flush_deferred_log();
+}
+
+/*
+ * Hand the draining of the ring to a host work item so that record producers
+ * (e.g. the interpreter spamming Debug object stores from a tight vendor AML
+ * loop) never serialize on uacpi_kernel_log themselves. If scheduling isn't
+ * possible the records simply stay in the ring until the next explicit
+ * uacpi_flush_deferred_log call.
+ */
+static void schedule_deferred_log_flush(void)
+{
+    uacpi_u32 expected = 0;
+
+    if (!uacpi_atomic_cmpxchg32(&deferred_log_flush_scheduled, &expected, 1))
+        return;
+
+    if (uacpi_unlikely_error(uacpi_kernel_schedule_work(
+            UACPI_WORK_NOTIFICATION, do_deferred_log_flush, UACPI_NULL)))
+        uacpi_atomic_store32(&deferred_log_flush_scheduled, 0);
+}
+
+static void defer_log(uacpi_log_level lvl, const uacpi_char *buf)
+{
+    struct deferred_log_slot *slot;
+    uacpi_u32 head, tail;
+
+    for (;;) {
+        head = uacpi_atomic_load32(&deferred_log_head);
+        tail = uacpi_atomic_load32(&deferred_log_tail);
+
+        if (head - tail >= UACPI_DEFERRED_LOG_RING_SIZE) {
+            // The ring is full, drop the record instead of blocking
+            uacpi_atomic_inc32(&deferred_log_dropped);
+            schedule_deferred_log_flush();
+            return;
+        }
+
+        if (uacpi_atomic_cmpxchg32(&deferred_log_head, &head, head + 1))
+            break;
+    }
+
+    slot = &deferred_log_ring[head % UACPI_DEFERRED_LOG_RING_SIZE];
+    slot->level = lvl;
+    uacpi_memcpy(slot->message, buf, uacpi_strlen(buf) + 1);
+
+    uacpi_atomic_store32(&slot->state, LOG_SLOT_PHASE_READY);
+    schedule_deferred_log_flush();
+}
+
+void uacpi_flush_deferred_log(void)
+{
+    uacpi_u32 expected = 0, dropped;
+
+    if (!uacpi_atomic_cmpxchg32(&deferred_log_flush_guard, &expected, 1))
+        return;
+
+    for (;;) {
+        struct deferred_log_slot *slot;
+
+        slot = &deferred_log_ring[
+            deferred_log_tail % UACPI_DEFERRED_LOG_RING_SIZE
+        ];
+
+        /*
+         * Either the ring is drained, or a producer claimed this slot but
+         * hasn't published it yet. Don't wait it out, the record is going to
+         * be picked up by the next flush.
+         */
+        if (uacpi_atomic_load32(&slot->state) != LOG_SLOT_PHASE_READY)
+            break;
+
+        uacpi_kernel_log(slot->level, slot->message);
+
+        // Hand the slot back before publishing the new tail
+        uacpi_atomic_store32(&slot->state, LOG_SLOT_PHASE_EMPTY);
+        uacpi_atomic_store32(&deferred_log_tail, deferred_log_tail + 1);
+    }
+
+    dropped = uacpi_atomic_load32(&deferred_log_dropped);
+    while (dropped != 0 &&
+           !uacpi_atomic_cmpxchg32(&deferred_log_dropped, &dropped, 0))
+        ;
+
+    if (uacpi_unlikely(dropped != 0)) {
+        uacpi_char buf[64];
+
+        uacpi_snprintf(
+            buf, sizeof(buf), "dropped %u deferred log record(s)\n", dropped
+        );
+        uacpi_kernel_log(UACPI_LOG_WARN, buf);
+    }
+
+    uacpi_atomic_store32(&deferred_log_flush_guard, 0);
+}
+
+void uacpi_context_set_deferred_logging(uacpi_bool enabled)
+{
+    uacpi_atomic_store32(&deferred_log_enabled, enabled);
+
+    if (!enabled)
+        uacpi_flush_deferred_log();
+}
+
 void uacpi_log(uacpi_log_level lvl, const uacpi_char *str, ...)
 {
     uacpi_char buf[UACPI_PLAIN_LOG_BUFFER_SIZE];
@@ -690,12 +971,201 @@ void uacpi_log(uacpi_log_level lvl, const uacpi_char *str, ...)
         buf[UACPI_PLAIN_LOG_BUFFER_SIZE - 2] = '\n';
     }
 
-    uacpi_kernel_log(lvl, buf);
+    if (uacpi_atomic_load32(&deferred_log_enabled))
+        defer_log(lvl, buf);
+    else
+        uacpi_kernel_log(lvl, buf);
 
     uacpi_va_end(vlist);
 }
+#else
+
+/*
+ * Deferred logging relies on pre-formatting records into fixed-size ring
+ * slots, which a formatted-logging host bypasses by design.
+ */
+void uacpi_context_set_deferred_logging(uacpi_bool enabled)
+{
+    if (enabled)
+        uacpi_warn(
+            "deferred logging is incompatible with UACPI_FORMATTED_LOGGING\n"
+        );
+}
+
+void uacpi_flush_deferred_log(void)
+{
+}
 #endif
 
+const uacpi_char *uacpi_memory_subsystem_to_string(
+    uacpi_memory_subsystem subsystem
+)
+{
+    switch (subsystem) {
+    case UACPI_MEMORY_SUBSYSTEM_OBJECTS:
+        return "objects";
+    case UACPI_MEMORY_SUBSYSTEM_NAMESPACE:
+        return "namespace";
+    case UACPI_MEMORY_SUBSYSTEM_TABLES:
+        return "tables";
+    case UACPI_MEMORY_SUBSYSTEM_INTERPRETER:
+        return "interpreter";
+    case UACPI_MEMORY_SUBSYSTEM_EVENTS:
+        return "events";
+    case UACPI_MEMORY_SUBSYSTEM_OTHER:
+        return "other";
+    default:
+        return "<invalid>";
+    }
+}
+
+#ifdef UACPI_MEMORY_ACCOUNTING
+
+// Call into the real (host-provided) allocation API below
+#undef uacpi_kernel_alloc
+#undef uacpi_kernel_alloc_zeroed
+#undef uacpi_free
+
+/*
+ * Prepended to every allocation so that the free path knows the exact size
+ * and subsystem without trusting the caller. The union keeps the user
+ * pointer aligned to 16 bytes.
+ */
+union tracked_allocation_header {
+    struct {
+        uacpi_size size;
+        uacpi_u32 subsystem;
+    } info;
+    uacpi_u64 padding[2];
+};
+
+struct memory_counters {
+    uacpi_u64 bytes_in_use;
+    uacpi_u64 peak_bytes_in_use;
+    uacpi_u64 live_allocations;
+    uacpi_u64 total_allocations;
+};
+
+static struct memory_counters memory_counters[UACPI_MEMORY_SUBSYSTEM_COUNT];
+static struct memory_counters total_memory_counters;
+
+static void account_alloc(struct memory_counters *counters, uacpi_size size)
+{
+    uacpi_u64 bytes, peak;
+
+    bytes = uacpi_atomic_load64(&counters->bytes_in_use);
+    while (!uacpi_atomic_cmpxchg64(
+        &counters->bytes_in_use, &bytes, bytes + size
+    ));
+    bytes += size;
+
+    peak = uacpi_atomic_load64(&counters->peak_bytes_in_use);
+    while (peak < bytes && !uacpi_atomic_cmpxchg64(
+        &counters->peak_bytes_in_use, &peak, bytes
+    ));
+
+    uacpi_atomic_inc64(&counters->live_allocations);
+    uacpi_atomic_inc64(&counters->total_allocations);
+}
+
+static void account_free(struct memory_counters *counters, uacpi_size size)
+{
+    uacpi_u64 bytes;
+
+    bytes = uacpi_atomic_load64(&counters->bytes_in_use);
+    while (!uacpi_atomic_cmpxchg64(
+        &counters->bytes_in_use, &bytes, bytes - size
+    ));
+
+    uacpi_atomic_dec64(&counters->live_allocations);
+}
+
+void *uacpi_tracked_alloc(uacpi_memory_subsystem subsystem, uacpi_size size)
+{
+    union tracked_allocation_header *hdr;
+
+    hdr = uacpi_kernel_alloc(sizeof(*hdr) + size);
+    if (uacpi_unlikely(hdr == UACPI_NULL))
+        return UACPI_NULL;
+
+    hdr->info.size = size;
+    hdr->info.subsystem = subsystem;
+
+    account_alloc(&memory_counters[subsystem], size);
+    account_alloc(&total_memory_counters, size);
+
+    return hdr + 1;
+}
+
+void *uacpi_tracked_alloc_zeroed(
+    uacpi_memory_subsystem subsystem, uacpi_size size
+)
+{
+    void *ptr;
+
+    ptr = uacpi_tracked_alloc(subsystem, size);
+    if (uacpi_unlikely(ptr == UACPI_NULL))
+        return ptr;
+
+    uacpi_memzero(ptr, size);
+    return ptr;
+}
+
+void uacpi_tracked_free(void *mem, uacpi_size size_hint)
+{
+    union tracked_allocation_header *hdr;
+
+    if (mem == UACPI_NULL)
+        return;
+
+    hdr = (union tracked_allocation_header*)mem - 1;
+
+    if (uacpi_unlikely(size_hint != hdr->info.size)) {
+        uacpi_warn(
+            "freeing %p with a bad size hint %zu (expected %zu)\n",
+            mem, size_hint, hdr->info.size
+        );
+    }
+
+    account_free(&memory_counters[hdr->info.subsystem], hdr->info.size);
+    account_free(&total_memory_counters, hdr->info.size);
+
+#ifdef UACPI_SIZED_FREES
+    uacpi_kernel_free(hdr, sizeof(*hdr) + hdr->info.size);
+#else
+    uacpi_kernel_free(hdr);
+#endif
+}
+
+static void fill_subsystem_stats(
+    uacpi_memory_subsystem_stats *out, struct memory_counters *counters
+)
+{
+    out->bytes_in_use = uacpi_atomic_load64(&counters->bytes_in_use);
+    out->peak_bytes_in_use =
+        uacpi_atomic_load64(&counters->peak_bytes_in_use);
+    out->live_allocations =
+        uacpi_atomic_load64(&counters->live_allocations);
+    out->total_allocations =
+        uacpi_atomic_load64(&counters->total_allocations);
+}
+
+uacpi_status uacpi_get_memory_stats(uacpi_memory_stats *out_stats)
+{
+    uacpi_size i;
+
+    if (uacpi_unlikely(out_stats == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    for (i = 0; i < UACPI_MEMORY_SUBSYSTEM_COUNT; ++i)
+        fill_subsystem_stats(&out_stats->subsystems[i], &memory_counters[i]);
+
+    fill_subsystem_stats(&out_stats->total, &total_memory_counters);
+    return UACPI_STATUS_OK;
+}
+
+#endif // UACPI_MEMORY_ACCOUNTING
+
 #ifndef UACPI_NATIVE_ALLOC_ZEROED
 void *uacpi_kernel_alloc_zeroed(uacpi_size size)
 {
@@ -5,6 +5,10 @@
 #include <uacpi/platform/config.h>
 #include <uacpi/internal/mutex.h>
 
+// Attribute allocations in this file under UACPI_MEMORY_ACCOUNTING
+#undef UACPI_TRACKED_SUBSYSTEM
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_TABLES
+
 DYNAMIC_ARRAY_WITH_INLINE_STORAGE(
     table_array, struct uacpi_installed_table, UACPI_STATIC_TABLE_ARRAY_LEN
 )
@@ -17,6 +21,165 @@ static uacpi_bool early_table_access;
 static uacpi_table_installation_handler installation_handler;
 static uacpi_handle table_mutex;
 
+/*
+ * Bumped under the table lock whenever a table is installed or invalidated,
+ * lets uacpi_table_ref_snapshot detect stale snapshot descriptors.
+ */
+static uacpi_u32 table_generation;
+
+// A deferred checksum sweep has been scheduled but hasn't run yet
+static uacpi_bool csum_sweep_pending;
+
+/*
+ * A small open-addressing index into 'tables' keyed on the 4-byte table
+ * signature, so that by-signature lookups don't rescan the entire array.
+ * Every slot holds the array index (offset by one, zero meaning an empty
+ * slot) of the first table with that signature, any duplicates (e.g.
+ * multiple SSDTs) hang off of it in installation order via 'next_same_sig'.
+ *
+ * The index is statically sized so that it keeps working during early table
+ * access, where no allocations are allowed. In the unlikely case firmware
+ * manages to exhaust it, the index is abandoned and lookups fall back to a
+ * linear scan. Tables are never erased from the array (only marked invalid),
+ * so no slot ever has to be deleted.
+ */
+#define SIGNATURE_INDEX_ORDER 6
+#define SIGNATURE_INDEX_SLOTS (1u << SIGNATURE_INDEX_ORDER)
+
+static uacpi_u16 signature_index[SIGNATURE_INDEX_SLOTS];
+static uacpi_bool signature_index_overflown;
+
+static uacpi_u16 *signature_index_find_slot(const void *signature)
+{
+    uacpi_u32 sig, slot;
+    uacpi_size i;
+
+    uacpi_memcpy(&sig, signature, sizeof(sig));
+    slot = (sig * 2654435769u) >> (32 - SIGNATURE_INDEX_ORDER);
+
+    for (i = 0; i < SIGNATURE_INDEX_SLOTS; ++i) {
+        uacpi_u16 *head = &signature_index[slot];
+
+        if (*head == 0)
+            return head;
+
+        if (uacpi_signatures_match(
+                table_array_at(&tables, *head - 1)->hdr.signature, signature
+            ))
+            return head;
+
+        slot = (slot + 1) & (SIGNATURE_INDEX_SLOTS - 1);
+    }
+
+    return UACPI_NULL;
+}
+
+static void signature_index_insert(
+    struct uacpi_installed_table *tbl, uacpi_size idx
+)
+{
+    uacpi_u16 *head;
+    struct uacpi_installed_table *chain;
+
+    tbl->next_same_sig = 0;
+
+    if (signature_index_overflown || uacpi_unlikely(idx >= 0xFFFF))
+        return;
+
+    head = signature_index_find_slot(tbl->hdr.signature);
+    if (uacpi_unlikely(head == UACPI_NULL)) {
+        uacpi_warn(
+            "too many distinct table signatures, disabling signature index\n"
+        );
+        signature_index_overflown = UACPI_TRUE;
+        return;
+    }
+
+    if (*head == 0) {
+        *head = idx + 1;
+        return;
+    }
+
+    // Append at the tail so that chains stay in installation order
+    chain = table_array_at(&tables, *head - 1);
+    while (chain->next_same_sig != 0)
+        chain = table_array_at(&tables, chain->next_same_sig - 1);
+
+    chain->next_same_sig = idx + 1;
+}
+
+#if UACPI_TABLE_MAPPING_CACHE_SIZE > 0
+/*
+ * Mappings of physically-backed tables whose last reference was dropped, most
+ * recently used first (values are array indices offset by one, zero meaning
+ * an empty slot). A table in here is still mapped and can be handed back out
+ * on the next reference without paying for a remap; the least recently used
+ * mapping is evicted once the cache overflows.
+ */
+static uacpi_u16 mapping_cache[UACPI_TABLE_MAPPING_CACHE_SIZE];
+
+static uacpi_bool mapping_cache_take(uacpi_size idx)
+{
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_TABLE_MAPPING_CACHE_SIZE; ++i) {
+        if (mapping_cache[i] != idx + 1)
+            continue;
+
+        for (; i < UACPI_TABLE_MAPPING_CACHE_SIZE - 1; ++i)
+            mapping_cache[i] = mapping_cache[i + 1];
+        mapping_cache[UACPI_TABLE_MAPPING_CACHE_SIZE - 1] = 0;
+
+        return UACPI_TRUE;
+    }
+
+    return UACPI_FALSE;
+}
+
+static void mapping_cache_put(struct uacpi_installed_table *tbl, uacpi_size idx)
+{
+    uacpi_u16 evicted;
+    uacpi_size i;
+
+    if (uacpi_unlikely(idx >= 0xFFFF)) {
+        uacpi_kernel_unmap(tbl->ptr, tbl->hdr.length);
+        tbl->ptr = UACPI_NULL;
+        return;
+    }
+
+    evicted = mapping_cache[UACPI_TABLE_MAPPING_CACHE_SIZE - 1];
+    for (i = UACPI_TABLE_MAPPING_CACHE_SIZE - 1; i > 0; --i)
+        mapping_cache[i] = mapping_cache[i - 1];
+    mapping_cache[0] = idx + 1;
+
+    if (evicted != 0) {
+        struct uacpi_installed_table *victim;
+
+        victim = table_array_at(&tables, evicted - 1);
+        uacpi_kernel_unmap(victim->ptr, victim->hdr.length);
+        victim->ptr = UACPI_NULL;
+    }
+}
+
+static void mapping_cache_drop_all(void)
+{
+    uacpi_size i;
+
+    for (i = 0; i < UACPI_TABLE_MAPPING_CACHE_SIZE; ++i) {
+        struct uacpi_installed_table *tbl;
+
+        if (mapping_cache[i] == 0)
+            continue;
+
+        tbl = table_array_at(&tables, mapping_cache[i] - 1);
+        uacpi_kernel_unmap(tbl->ptr, tbl->hdr.length);
+        tbl->ptr = UACPI_NULL;
+
+        mapping_cache[i] = 0;
+    }
+}
+#endif
+
 static uacpi_status table_install_physical_with_origin_unlocked(
     uacpi_phys_addr phys, enum uacpi_table_origin origin,
     const uacpi_char *expected_signature, uacpi_table *out_table
@@ -279,6 +442,14 @@ void uacpi_deinitialize_tables(void)
 {
     uacpi_size i;
 
+    // A deferred checksum sweep may still be in flight, let it finish first
+    if (uacpi_check_flag(UACPI_FLAG_DEFERRED_TBL_CSUM))
+        uacpi_kernel_wait_for_work_completion();
+
+#if UACPI_TABLE_MAPPING_CACHE_SIZE > 0
+    mapping_cache_drop_all();
+#endif
+
     for (i = 0; i < table_array_size(&tables); ++i) {
         struct uacpi_installed_table *tbl = table_array_at(&tables, i);
 
@@ -303,6 +474,14 @@ void uacpi_deinitialize_tables(void)
         table_array_clear(&tables);
     }
 
+    uacpi_memzero(signature_index, sizeof(signature_index));
+    signature_index_overflown = UACPI_FALSE;
+
+    // Invalidate any snapshot descriptors taken before the teardown
+    table_generation++;
+
+    csum_sweep_pending = UACPI_FALSE;
+
     if (table_mutex)
         uacpi_kernel_free_mutex(table_mutex);
 
@@ -336,10 +515,49 @@ static uacpi_u8 table_checksum(void *table, uacpi_size size)
 {
     uacpi_u8 *bytes = table;
     uacpi_u8 csum = 0;
-    uacpi_size i;
+    uacpi_size i = 0;
+
+    /*
+     * Since all we need is the sum of every byte modulo 256, the bulk of the
+     * table can be summed a word at a time: the even and odd bytes of each
+     * word are accumulated into 16-bit-wide lanes of two separate
+     * accumulators, which are then folded into the running sum. A lane
+     * overflows after at worst 257 byte additions, so accumulators are
+     * flushed every CSUM_WORDS_PER_FLUSH words.
+     *
+     * This sums 8 bytes per iteration with no per-byte shifting, without
+     * requiring any SIMD support from the target or the compiler (tables get
+     * checksummed at early boot, where e.g. x86 kernels usually have vector
+     * registers compiled out entirely).
+     */
+#define CSUM_BYTE_LANES 0x00FF00FF00FF00FFull
+#define CSUM_WORDS_PER_FLUSH 256
+
+    while ((UACPI_PTR_TO_VIRT_ADDR(&bytes[i]) & (sizeof(uacpi_u64) - 1)) &&
+           i < size)
+        csum += bytes[i++];
+
+    while ((size - i) >= sizeof(uacpi_u64)) {
+        uacpi_u64 even = 0, odd = 0, word;
+        uacpi_size words;
+
+        words = (size - i) / sizeof(uacpi_u64);
+        if (words > CSUM_WORDS_PER_FLUSH)
+            words = CSUM_WORDS_PER_FLUSH;
+
+        while (words--) {
+            uacpi_memcpy(&word, &bytes[i], sizeof(word));
+            even += word & CSUM_BYTE_LANES;
+            odd += (word >> 8) & CSUM_BYTE_LANES;
+            i += sizeof(word);
+        }
 
-    for (i = 0; i < size; ++i)
-        csum += bytes[i];
+        csum += (uacpi_u8)(even + (even >> 16) + (even >> 32) + (even >> 48));
+        csum += (uacpi_u8)(odd + (odd >> 16) + (odd >> 32) + (odd >> 48));
+    }
+
+    while (i < size)
+        csum += bytes[i++];
 
     return csum;
 }
@@ -413,6 +631,8 @@ static uacpi_status table_alloc(
     if (uacpi_unlikely(tbl == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
 
+    table_generation++;
+
     *out_tbl = tbl;
     *out_idx = table_array_size(&tables) - 1;
     return UACPI_STATUS_OK;
@@ -434,7 +654,9 @@ static uacpi_status get_external_table_header(
     return UACPI_STATUS_OK;
 }
 
-static uacpi_status table_ref_unlocked(struct uacpi_installed_table *tbl)
+static uacpi_status table_ref_unlocked(
+    struct uacpi_installed_table *tbl, uacpi_size idx
+)
 {
     switch (tbl->reference_count) {
     case 0: {
@@ -447,6 +669,14 @@ static uacpi_status table_ref_unlocked(struct uacpi_installed_table *tbl)
             tbl->origin != UACPI_TABLE_ORIGIN_FIRMWARE_PHYSICAL)
             break;
 
+#if UACPI_TABLE_MAPPING_CACHE_SIZE > 0
+        // The mapping from the last time this table was used is still around
+        if (mapping_cache_take(idx))
+            break;
+#else
+        UACPI_UNUSED(idx);
+#endif
+
         tbl->ptr = uacpi_kernel_map(tbl->phys_addr, tbl->hdr.length);
         if (uacpi_unlikely(tbl->ptr == UACPI_NULL))
             return UACPI_STATUS_MAPPING_FAILED;
@@ -457,6 +687,7 @@ static uacpi_status table_ref_unlocked(struct uacpi_installed_table *tbl)
                 uacpi_kernel_unmap(tbl->ptr, tbl->hdr.length);
                 tbl->flags |= UACPI_TABLE_INVALID;
                 tbl->ptr = UACPI_NULL;
+                table_generation++;
                 return ret;
             }
 
@@ -479,7 +710,9 @@ static uacpi_status table_ref_unlocked(struct uacpi_installed_table *tbl)
     return UACPI_STATUS_OK;
 }
 
-static uacpi_status table_unref_unlocked(struct uacpi_installed_table *tbl)
+static uacpi_status table_unref_unlocked(
+    struct uacpi_installed_table *tbl, uacpi_size idx
+)
 {
     switch (tbl->reference_count) {
     case 0:
@@ -493,8 +726,14 @@ static uacpi_status table_unref_unlocked(struct uacpi_installed_table *tbl)
             tbl->origin != UACPI_TABLE_ORIGIN_FIRMWARE_PHYSICAL)
             break;
 
+#if UACPI_TABLE_MAPPING_CACHE_SIZE > 0
+        // Keep the mapping around in case this table is needed again soon
+        mapping_cache_put(tbl, idx);
+#else
+        UACPI_UNUSED(idx);
         uacpi_kernel_unmap(tbl->ptr, tbl->hdr.length);
         tbl->ptr = UACPI_NULL;
+#endif
         break;
     case 0xFFFF:
         /*
@@ -510,6 +749,91 @@ static uacpi_status table_unref_unlocked(struct uacpi_installed_table *tbl)
     return UACPI_STATUS_OK;
 }
 
+static void do_deferred_csum_sweep(uacpi_handle opaque)
+{
+    uacpi_status ret;
+    uacpi_size idx;
+
+    UACPI_UNUSED(opaque);
+
+    ret = uacpi_acquire_native_mutex_may_be_null(table_mutex);
+    if (uacpi_unlikely_error(ret))
+        return;
+
+    csum_sweep_pending = UACPI_FALSE;
+
+    for (idx = 0; idx < table_array_size(&tables); ++idx) {
+        struct uacpi_installed_table *tbl;
+
+        tbl = table_array_at(&tables, idx);
+        if (tbl->flags & (UACPI_TABLE_CSUM_VERIFIED | UACPI_TABLE_INVALID))
+            continue;
+
+        if (tbl->origin != UACPI_TABLE_ORIGIN_HOST_PHYSICAL &&
+            tbl->origin != UACPI_TABLE_ORIGIN_FIRMWARE_PHYSICAL) {
+            // Virtual tables are always mapped, sum them in place
+            ret = uacpi_verify_table_checksum(tbl->ptr, tbl->hdr.length);
+            if (uacpi_unlikely_error(ret)) {
+                tbl->flags |= UACPI_TABLE_INVALID;
+                table_generation++;
+                continue;
+            }
+
+            tbl->flags |= UACPI_TABLE_CSUM_VERIFIED;
+            continue;
+        }
+
+        /*
+         * Take and immediately drop a reference: the first reference maps the
+         * table and runs the normal lazy checksum verification, invalidating
+         * the table via the usual bad-checksum path on failure.
+         */
+        if (uacpi_likely_success(table_ref_unlocked(tbl, idx)))
+            table_unref_unlocked(tbl, idx);
+    }
+
+    uacpi_release_native_mutex_may_be_null(table_mutex);
+}
+
+void uacpi_tables_schedule_deferred_verification(void)
+{
+    uacpi_status ret;
+
+    if (!uacpi_check_flag(UACPI_FLAG_DEFERRED_TBL_CSUM))
+        return;
+
+    /*
+     * Boot-time installs are swept in one batch once the subsystem (and with
+     * it the host work queue) is known to be fully operational.
+     */
+    if (g_uacpi_rt_ctx.init_level < UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED)
+        return;
+
+    ret = uacpi_acquire_native_mutex_may_be_null(table_mutex);
+    if (uacpi_unlikely_error(ret))
+        return;
+
+    if (csum_sweep_pending) {
+        uacpi_release_native_mutex_may_be_null(table_mutex);
+        return;
+    }
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_NOTIFICATION, do_deferred_csum_sweep, UACPI_NULL
+    );
+    if (uacpi_likely_success(ret))
+        csum_sweep_pending = UACPI_TRUE;
+
+    uacpi_release_native_mutex_may_be_null(table_mutex);
+
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_warn(
+            "unable to schedule deferred table verification: %s\n",
+            uacpi_status_to_string(ret)
+        );
+    }
+}
+
 static uacpi_status verify_and_install_table(
     struct acpi_sdt_hdr *hdr, uacpi_phys_addr phys_addr, void *virt_addr,
     enum uacpi_table_origin origin, uacpi_table *out_table
@@ -529,7 +853,8 @@ static uacpi_status verify_and_install_table(
      */
     if (uacpi_signatures_match(hdr->signature, ACPI_FACS_SIGNATURE)) {
         flags |= UACPI_TABLE_CSUM_VERIFIED;
-    } else if (uacpi_check_flag(UACPI_FLAG_PROACTIVE_TBL_CSUM) || is_fadt ||
+    } else if ((uacpi_check_flag(UACPI_FLAG_PROACTIVE_TBL_CSUM) &&
+                !uacpi_check_flag(UACPI_FLAG_DEFERRED_TBL_CSUM)) || is_fadt ||
                out_table != UACPI_NULL) {
         void *mapping = virt_addr;
 
@@ -568,6 +893,7 @@ static uacpi_status verify_and_install_table(
     table->ptr = virt_addr;
     table->flags = flags;
     table->origin = origin;
+    signature_index_insert(table, idx);
 
     if (out_table == UACPI_NULL)
         return UACPI_STATUS_OK;
@@ -695,6 +1021,9 @@ uacpi_status uacpi_table_install_physical_with_origin(
     );
     uacpi_release_native_mutex_may_be_null(table_mutex);
 
+    if (uacpi_likely_success(ret))
+        uacpi_tables_schedule_deferred_verification();
+
     return ret;
 }
 
@@ -761,6 +1090,10 @@ uacpi_status uacpi_table_install_with_origin(
     ret = table_install_with_origin_unlocked(virt, origin, out_table);
 
     uacpi_release_native_mutex_may_be_null(table_mutex);
+
+    if (uacpi_likely_success(ret))
+        uacpi_tables_schedule_deferred_verification();
+
     return ret;
 }
 
@@ -817,6 +1150,88 @@ uacpi_status uacpi_for_each_table(
     return ret;
 }
 
+uacpi_status uacpi_table_snapshot(
+    uacpi_size base_idx, struct uacpi_table_descriptor *out_entries,
+    uacpi_size *in_out_count
+)
+{
+    uacpi_status ret;
+    uacpi_size idx, count = 0;
+    struct uacpi_installed_table *tbl;
+
+    if (!early_table_access)
+        UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
+
+    ret = uacpi_acquire_native_mutex_may_be_null(table_mutex);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (idx = base_idx; idx < table_array_size(&tables); ++idx) {
+        struct uacpi_table_descriptor *desc;
+
+        tbl = table_array_at(&tables, idx);
+
+        if (tbl->flags & UACPI_TABLE_INVALID)
+            continue;
+
+        if (count == *in_out_count) {
+            ret = UACPI_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        desc = &out_entries[count++];
+        uacpi_memcpy(
+            desc->signature, tbl->hdr.signature, sizeof(desc->signature)
+        );
+        desc->phys_addr = tbl->phys_addr;
+        desc->length = tbl->hdr.length;
+        desc->idx = idx;
+        desc->generation = table_generation;
+    }
+
+    uacpi_release_native_mutex_may_be_null(table_mutex);
+
+    *in_out_count = count;
+    return ret;
+}
+
+uacpi_status uacpi_table_ref_snapshot(
+    const struct uacpi_table_descriptor *desc, uacpi_table *out_table
+)
+{
+    uacpi_status ret;
+    struct uacpi_installed_table *tbl;
+
+    if (!early_table_access)
+        UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
+
+    ret = uacpi_acquire_native_mutex_may_be_null(table_mutex);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (uacpi_unlikely(desc->generation != table_generation ||
+                       desc->idx >= table_array_size(&tables))) {
+        ret = UACPI_STATUS_NOT_FOUND;
+        goto out;
+    }
+
+    tbl = table_array_at(&tables, desc->idx);
+    if (uacpi_unlikely(tbl->flags & UACPI_TABLE_INVALID)) {
+        ret = UACPI_STATUS_NOT_FOUND;
+        goto out;
+    }
+
+    ret = table_ref_unlocked(tbl, desc->idx);
+    if (uacpi_likely_success(ret)) {
+        out_table->ptr = tbl->ptr;
+        out_table->index = desc->idx;
+    }
+
+out:
+    uacpi_release_native_mutex_may_be_null(table_mutex);
+    return ret;
+}
+
 enum search_type {
     SEARCH_TYPE_BY_ID,
     SEARCH_TYPE_MATCH,
@@ -869,7 +1284,7 @@ static uacpi_iteration_decision do_search_tables(
         return UACPI_ITERATION_DECISION_BREAK;
     }
 
-    ret = table_ref_unlocked(tbl);
+    ret = table_ref_unlocked(tbl, idx);
     if (uacpi_likely_success(ret)) {
         out_table = ctx->out_table;
         out_table->ptr = tbl->ptr;
@@ -914,6 +1329,7 @@ static uacpi_status find_table(
 )
 {
     uacpi_status ret;
+    uacpi_u16 *head, next;
     struct table_search_ctx ctx = {
         .id = id,
         .out_table = out_table,
@@ -921,10 +1337,37 @@ static uacpi_status find_table(
         .status = UACPI_STATUS_NOT_FOUND,
     };
 
-    ret = uacpi_for_each_table(base_idx, do_search_tables, &ctx);
+    if (uacpi_unlikely(signature_index_overflown)) {
+        ret = uacpi_for_each_table(base_idx, do_search_tables, &ctx);
+        if (uacpi_unlikely_error(ret))
+            return ret;
+
+        return ctx.status;
+    }
+
+    ret = uacpi_acquire_native_mutex_may_be_null(table_mutex);
     if (uacpi_unlikely_error(ret))
         return ret;
 
+    // Only walk the (usually one entry long) chain for this signature
+    head = signature_index_find_slot(&id->signature);
+    next = head != UACPI_NULL ? *head : 0;
+
+    while (next != 0) {
+        uacpi_size idx = next - 1;
+        struct uacpi_installed_table *tbl = table_array_at(&tables, idx);
+
+        next = tbl->next_same_sig;
+
+        if (idx < base_idx || (tbl->flags & UACPI_TABLE_INVALID))
+            continue;
+
+        if (do_search_tables(&ctx, tbl, idx) ==
+            UACPI_ITERATION_DECISION_BREAK)
+            break;
+    }
+
+    uacpi_release_native_mutex_may_be_null(table_mutex);
     return ctx.status;
 }
 
@@ -1046,7 +1489,7 @@ static uacpi_status table_ctl(uacpi_size idx, struct table_ctl_request *req)
     }
 
     if (req->type & TABLE_CTL_GET) {
-        ret = table_ref_unlocked(tbl);
+        ret = table_ref_unlocked(tbl, idx);
         if (uacpi_unlikely_error(ret))
             goto out;
 
@@ -1054,7 +1497,7 @@ static uacpi_status table_ctl(uacpi_size idx, struct table_ctl_request *req)
     }
 
     if (req->type & TABLE_CTL_PUT) {
-        ret = table_unref_unlocked(tbl);
+        ret = table_unref_unlocked(tbl, idx);
         if (uacpi_unlikely_error(ret))
             goto out;
     }
@@ -1085,7 +1528,7 @@ uacpi_status uacpi_table_load_with_cause(
     if (uacpi_unlikely_error(ret))
         return ret;
 
-    ret = uacpi_execute_table(req.out_tbl, cause);
+    ret = uacpi_execute_table(req.out_tbl, idx, cause);
 
     req.type = TABLE_CTL_PUT;
     table_ctl(idx, &req);
@@ -1097,6 +1540,52 @@ uacpi_status uacpi_table_load(uacpi_size idx)
     return uacpi_table_load_with_cause(idx, UACPI_TABLE_LOAD_CAUSE_HOST);
 }
 
+struct async_table_load_request {
+    uacpi_size idx;
+    uacpi_table_load_callback callback;
+    uacpi_handle user;
+};
+
+static void do_async_table_load(uacpi_handle opaque)
+{
+    struct async_table_load_request req;
+
+    uacpi_memcpy(&req, opaque, sizeof(req));
+    uacpi_free(opaque, sizeof(req));
+
+    req.callback(
+        uacpi_table_load_with_cause(req.idx, UACPI_TABLE_LOAD_CAUSE_HOST),
+        req.user
+    );
+}
+
+uacpi_status uacpi_table_load_async(
+    uacpi_size idx, uacpi_table_load_callback callback, uacpi_handle user
+)
+{
+    uacpi_status ret;
+    struct async_table_load_request *req;
+
+    if (uacpi_unlikely(callback == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    req = uacpi_kernel_alloc(sizeof(*req));
+    if (uacpi_unlikely(req == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    req->idx = idx;
+    req->callback = callback;
+    req->user = user;
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_NAMESPACE_LOAD, do_async_table_load, req
+    );
+    if (uacpi_unlikely_error(ret))
+        uacpi_free(req, sizeof(*req));
+
+    return ret;
+}
+
 void uacpi_table_mark_as_loaded(uacpi_size idx)
 {
     table_ctl(idx, &(struct table_ctl_request) {
@@ -6,8 +6,14 @@
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/namespace.h>
 #include <uacpi/internal/tables.h>
+#include <uacpi/internal/interpreter.h>
+#include <uacpi/internal/pool.h>
 #include <uacpi/kernel_api.h>
 
+// Attribute allocations in this file under UACPI_MEMORY_ACCOUNTING
+#undef UACPI_TRACKED_SUBSYSTEM
+#define UACPI_TRACKED_SUBSYSTEM UACPI_MEMORY_SUBSYSTEM_OBJECTS
+
 const uacpi_char *uacpi_object_type_to_string(uacpi_object_type type)
 {
     switch (type) {
@@ -138,11 +144,19 @@ uacpi_bool uacpi_package_fill(
     pkg->count = num_elements;
 
     if (prealloc_objects == UACPI_PREALLOC_OBJECTS_YES) {
-        for (i = 0; i < num_elements; ++i) {
-            pkg->objects[i] = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
+        /*
+         * Deep package copies preallocate every destination element, grab
+         * them all from the object pool in one go instead of paying for a
+         * lock round-trip per element.
+         */
+        if (uacpi_unlikely(!uacpi_pool_alloc_zeroed_bulk(
+                uacpi_object_pool(), (void**)pkg->objects, num_elements
+            )))
+            return UACPI_FALSE;
 
-            if (uacpi_unlikely(pkg->objects[i] == UACPI_NULL))
-                return UACPI_FALSE;
+        for (i = 0; i < num_elements; ++i) {
+            uacpi_shareable_init(pkg->objects[i]);
+            pkg->objects[i]->type = UACPI_OBJECT_UNINITIALIZED;
         }
     }
 
@@ -327,7 +341,7 @@ uacpi_object *uacpi_create_object(uacpi_object_type type)
     uacpi_object *ret;
     object_ctor ctor;
 
-    ret = uacpi_kernel_alloc_zeroed(sizeof(*ret));
+    ret = uacpi_pool_alloc_zeroed(uacpi_object_pool());
     if (uacpi_unlikely(ret == UACPI_NULL))
         return ret;
 
@@ -339,18 +353,47 @@ uacpi_object *uacpi_create_object(uacpi_object_type type)
         return ret;
 
     if (uacpi_unlikely(!ctor(ret))) {
-        uacpi_free(ret, sizeof(*ret));
+        uacpi_pool_free(uacpi_object_pool(), ret);
         return UACPI_NULL;
     }
 
     return ret;
 }
 
+static void buffer_release_table_alias(uacpi_buffer *buf)
+{
+    uacpi_table tbl = { 0 };
+
+    tbl.index = buf->aliased_table_idx;
+    uacpi_table_unref(&tbl);
+    buf->aliases_table = UACPI_FALSE;
+}
+
+uacpi_status uacpi_buffer_ensure_mutable(uacpi_buffer *buf)
+{
+    void *data;
+
+    if (uacpi_likely(!buf->aliases_table))
+        return UACPI_STATUS_OK;
+
+    data = uacpi_kernel_alloc(buf->size);
+    if (uacpi_unlikely(data == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    uacpi_memcpy(data, buf->data, buf->size);
+    buffer_release_table_alias(buf);
+    buf->data = data;
+
+    return UACPI_STATUS_OK;
+}
+
 static void free_buffer(uacpi_handle handle)
 {
     uacpi_buffer *buf = handle;
 
-    if (buf->data != UACPI_NULL)
+    if (buf->aliases_table)
+        buffer_release_table_alias(buf);
+    else if (buf->data != UACPI_NULL)
         /*
          * If buffer has a size of 0 but a valid data pointer it's probably an
          * "empty" buffer allocated by the interpreter in make_null_buffer
@@ -395,7 +438,7 @@ static void free_plain_no_recurse(uacpi_object *obj, struct free_queue *queue)
         }
 
         // Don't call free_object here as that will recurse
-        uacpi_free(obj, sizeof(*obj));
+        uacpi_pool_free(uacpi_object_pool(), obj);
         break;
     default:
         /*
@@ -426,7 +469,7 @@ static void unref_chain_no_recurse(uacpi_object *obj, struct free_queue *queue)
             goto do_next;
 
         if (obj->type == UACPI_OBJECT_REFERENCE) {
-            uacpi_free(obj, sizeof(*obj));
+            uacpi_pool_free(uacpi_object_pool(), obj);
         } else {
             free_plain_no_recurse(obj, queue);
         }
@@ -447,6 +490,24 @@ static void unref_object_no_recurse(uacpi_object *obj, struct free_queue *queue)
     unref_plain_no_recurse(obj, queue);
 }
 
+void uacpi_package_release_deferred(uacpi_package *pkg)
+{
+    uacpi_table tbl = { 0 };
+
+    if (pkg->deferred == UACPI_NULL)
+        return;
+
+    tbl.index = pkg->deferred->table_idx;
+    uacpi_table_unref(&tbl);
+
+    uacpi_free(
+        pkg->deferred,
+        sizeof(*pkg->deferred) +
+        pkg->count * sizeof(pkg->deferred->elements[0])
+    );
+    pkg->deferred = UACPI_NULL;
+}
+
 static void free_package(uacpi_handle handle)
 {
     struct free_queue queue = { 0 };
@@ -469,7 +530,8 @@ static void free_package(uacpi_handle handle)
             unref_object_no_recurse(obj, &queue);
         }
 
-        // 2. Release the object array
+        // 2. Release the deferred element ranges (if any) and the object array
+        uacpi_package_release_deferred(pkg);
         uacpi_free(pkg->objects, sizeof(*pkg->objects) * pkg->count);
 
         // 3. Release the package itself
@@ -629,6 +691,8 @@ static void free_method(uacpi_handle handle)
 
     if (!method->native_call && method->owns_code)
        uacpi_free(method->code, method->size);
+
+    uacpi_method_decode_cache_free(method);
     uacpi_free(method, sizeof(*method));
 }
 
@@ -694,7 +758,7 @@ static void free_object_storage(uacpi_object *obj)
 static void free_object(uacpi_object *obj)
 {
     free_object_storage(obj);
-    uacpi_free(obj, sizeof(*obj));
+    uacpi_pool_free(uacpi_object_pool(), obj);
 }
 
 static void make_chain_bugged(uacpi_object *obj)
@@ -815,6 +879,40 @@ static uacpi_bool pkg_copy_reqs_push(
     return UACPI_TRUE;
 }
 
+/*
+ * Deep copies inherit still-deferred elements as-is instead of decoding them:
+ * the clone gets its own copy of the range array along with its own reference
+ * on the aliased table. Notably, this doesn't mutate the source package, so
+ * it's safe to run with only the namespace read lock held.
+ */
+static uacpi_status package_clone_deferred(
+    uacpi_package *dst, uacpi_package *src
+)
+{
+    struct uacpi_deferred_package_data *deferred;
+    uacpi_table tbl = { 0 };
+    uacpi_status ret;
+    uacpi_size size;
+
+    size = sizeof(*deferred) + src->count * sizeof(deferred->elements[0]);
+
+    deferred = uacpi_kernel_alloc(size);
+    if (uacpi_unlikely(deferred == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    uacpi_memcpy(deferred, src->deferred, size);
+
+    tbl.index = deferred->table_idx;
+    ret = uacpi_table_ref(&tbl);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free(deferred, size);
+        return ret;
+    }
+
+    dst->deferred = deferred;
+    return UACPI_STATUS_OK;
+}
+
 static uacpi_status deep_copy_package_no_recurse(
     uacpi_object *dst, uacpi_package *src,
     struct pkg_copy_reqs *reqs
@@ -830,11 +928,24 @@ static uacpi_status deep_copy_package_no_recurse(
     dst->type = UACPI_OBJECT_PACKAGE;
     dst_package = dst->package;
 
+    if (src->deferred != UACPI_NULL) {
+        uacpi_status st;
+
+        st = package_clone_deferred(dst_package, src);
+        if (uacpi_unlikely_error(st))
+            return st;
+    }
+
     for (i = 0; i < src->count; ++i) {
         uacpi_status st;
         uacpi_object *src_obj = src->objects[i];
         uacpi_object *dst_obj = dst_package->objects[i];
 
+        // Deferred elements stay deferred, the copy has its own range array
+        if (src->deferred != UACPI_NULL &&
+            src->deferred->elements[i].size != 0)
+            continue;
+
         // Don't copy the internal package index reference
         if (src_obj->type == UACPI_OBJECT_REFERENCE &&
             src_obj->flags == UACPI_REFERENCE_KIND_PKG_INDEX)
@@ -1210,8 +1321,14 @@ uacpi_status uacpi_object_get_package(
     uacpi_object *obj, uacpi_object_array *out
 )
 {
+    uacpi_status ret;
+
     TYPE_CHECK_USER_OBJ(obj, UACPI_OBJECT_PACKAGE_BIT);
 
+    ret = uacpi_package_materialize(obj->package);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
     out->objects = obj->package->objects;
     out->count = obj->package->count;
     return UACPI_STATUS_OK;
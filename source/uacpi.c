@@ -12,20 +12,37 @@
 #include <uacpi/internal/registers.h>
 #include <uacpi/internal/event.h>
 #include <uacpi/internal/notify.h>
+#include <uacpi/internal/resources.h>
 #include <uacpi/internal/osi.h>
+#include <uacpi/internal/pool.h>
+#include <uacpi/internal/mutex.h>
 #include <uacpi/internal/registers.h>
+#include <uacpi/internal/profiling.h>
 
 struct uacpi_runtime_context g_uacpi_rt_ctx = { 0 };
 
+static uacpi_status initialize_async_eval(void);
+static void deinitialize_async_eval(void);
+
 void uacpi_state_reset(void)
 {
+    uacpi_join_acpi_mode_transition();
+    deinitialize_async_eval();
+    uacpi_free_device_id_index();
+    uacpi_free_pci_routing_table_cache();
+    uacpi_free_srs_template_cache();
+    uacpi_free_id_string_cache();
     uacpi_deinitialize_namespace();
     uacpi_deinitialize_interfaces();
     uacpi_deinitialize_events();
     uacpi_deinitialize_notify();
     uacpi_deinitialize_opregion();
+    uacpi_deinitialize_default_address_space_handlers();
     uacpi_deininitialize_registers();
     uacpi_deinitialize_tables();
+    uacpi_deinitialize_interpreter();
+    uacpi_deinitialize_profiling();
+    uacpi_deinitialize_pools();
 
 #ifndef UACPI_REDUCED_HARDWARE
     if (g_uacpi_rt_ctx.global_lock_event)
@@ -131,6 +148,10 @@ const uacpi_char *uacpi_status_to_string(uacpi_status st)
         return "the requested action has been overridden";
     case UACPI_STATUS_DENIED:
         return "the requested action has been denied";
+    case UACPI_STATUS_BUFFER_TOO_SMALL:
+        return "provided buffer is too small";
+    case UACPI_STATUS_SUSPENDED:
+        return "the evaluation has been suspended";
 
     case UACPI_STATUS_AML_UNDEFINED_REFERENCE:
         return "AML referenced an undefined object";
@@ -271,6 +292,57 @@ uacpi_init_level uacpi_get_current_init_level(void)
     return g_uacpi_rt_ctx.init_level;
 }
 
+/*
+ * Signaled by the worker once the ACPI mode transition kicked off by
+ * UACPI_FLAG_ASYNC_ACPI_MODE is done. Non-NULL only while a transition is
+ * in flight.
+ */
+static uacpi_handle acpi_mode_transition_event;
+
+static void do_async_enter_acpi_mode(uacpi_handle opaque)
+{
+    // Not critical here either, any failure has already been logged
+    uacpi_enter_acpi_mode();
+    uacpi_kernel_signal_event(opaque);
+}
+
+static void schedule_acpi_mode_transition(void)
+{
+    uacpi_status ret;
+    uacpi_handle event;
+
+    event = uacpi_kernel_create_event();
+    if (uacpi_unlikely(event == UACPI_NULL))
+        goto out_inline;
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_NOTIFICATION, do_async_enter_acpi_mode, event
+    );
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_kernel_free_event(event);
+        goto out_inline;
+    }
+
+    acpi_mode_transition_event = event;
+    return;
+
+out_inline:
+    // This is not critical, so just ignore the return status
+    uacpi_enter_acpi_mode();
+}
+
+void uacpi_join_acpi_mode_transition(void)
+{
+    if (acpi_mode_transition_event == UACPI_NULL)
+        return;
+
+    while (!uacpi_kernel_wait_for_event(acpi_mode_transition_event, 0xFFFF))
+        ;
+
+    uacpi_kernel_free_event(acpi_mode_transition_event);
+    acpi_mode_transition_event = UACPI_NULL;
+}
+
 uacpi_status uacpi_initialize(uacpi_u64 flags)
 {
     uacpi_status ret;
@@ -297,6 +369,14 @@ uacpi_status uacpi_initialize(uacpi_u64 flags)
     if (g_uacpi_rt_ctx.max_call_stack_depth == 0)
         uacpi_context_set_max_call_stack_depth(UACPI_DEFAULT_MAX_CALL_STACK_DEPTH);
 
+    ret = uacpi_initialize_pools();
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
+    ret = uacpi_initialize_interpreter();
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
     ret = uacpi_initialize_tables();
     if (uacpi_unlikely_error(ret))
         goto out_fatal_error;
@@ -325,12 +405,25 @@ uacpi_status uacpi_initialize(uacpi_u64 flags)
     if (uacpi_unlikely_error(ret))
         goto out_fatal_error;
 
+    ret = initialize_async_eval();
+    if (uacpi_unlikely_error(ret))
+        goto out_fatal_error;
+
     uacpi_install_default_address_space_handlers();
 
     if (!uacpi_check_flag(UACPI_FLAG_NO_ACPI_MODE)) {
-        // This is not critical, so just ignore the return status
-        uacpi_enter_acpi_mode();
+        if (uacpi_check_flag(UACPI_FLAG_ASYNC_ACPI_MODE) &&
+            !uacpi_is_hardware_reduced()) {
+            schedule_acpi_mode_transition();
+        } else {
+            // This is not critical, so just ignore the return status
+            uacpi_enter_acpi_mode();
+        }
     }
+
+    // Kick off verification of any tables installed with their checksum pending
+    uacpi_tables_schedule_deferred_verification();
+
     return UACPI_STATUS_OK;
 
 out_fatal_error:
@@ -443,6 +536,13 @@ uacpi_status uacpi_namespace_load(void)
         );
     }
 
+    /*
+     * SCI and fixed event bring-up below pokes PM1 registers that are only
+     * ours once the hardware has fully entered ACPI mode, so an in-flight
+     * asynchronous mode transition has to be joined first.
+     */
+    uacpi_join_acpi_mode_transition();
+
     ret = uacpi_initialize_events();
     if (uacpi_unlikely_error(ret)) {
         uacpi_error("event initialization failed: %s\n",
@@ -450,6 +550,8 @@ uacpi_status uacpi_namespace_load(void)
         goto out_fatal_error;
     }
 
+    uacpi_namespace_prime_flat_index();
+
     g_uacpi_rt_ctx.init_level = UACPI_INIT_LEVEL_NAMESPACE_LOADED;
     return UACPI_STATUS_OK;
 
@@ -552,6 +654,146 @@ static uacpi_iteration_decision do_sta_ini(
     return UACPI_ITERATION_DECISION_CONTINUE;
 }
 
+/*
+ * Tree levels walked synchronously in concurrent mode. The first two levels
+ * are almost exclusively scope-like nodes (\_SB_, PCI root bridges), anything
+ * below that is dispatched to the host work queue as an independent subtree.
+ */
+#define NS_INIT_DISPATCH_DEPTH 2
+
+struct ns_init_subtree_work {
+    struct ns_init_context ctx;
+    uacpi_namespace_node *node;
+    struct ns_init_subtree_work *next;
+};
+
+struct ns_init_dispatch_context {
+    struct ns_init_context *sync_ctx;
+    struct ns_init_subtree_work *work_head;
+};
+
+static void do_sta_ini_subtree_work(uacpi_handle opaque)
+{
+    struct ns_init_subtree_work *work = opaque;
+
+    uacpi_namespace_for_each_child(
+        work->node, do_sta_ini, UACPI_NULL,
+        UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, &work->ctx
+    );
+}
+
+static uacpi_iteration_decision do_sta_ini_dispatch(
+    void *opaque, uacpi_namespace_node *node, uacpi_u32 depth
+)
+{
+    struct ns_init_dispatch_context *ctx = opaque;
+    uacpi_iteration_decision decision;
+    struct ns_init_subtree_work *work;
+    uacpi_status ret;
+
+    // Parent-before-child: the node itself is always evaluated synchronously
+    decision = do_sta_ini(ctx->sync_ctx, node, depth);
+
+    if (decision != UACPI_ITERATION_DECISION_CONTINUE ||
+        depth != NS_INIT_DISPATCH_DEPTH || node->child == UACPI_NULL)
+        return decision;
+
+    work = uacpi_kernel_alloc_zeroed(sizeof(*work));
+    if (uacpi_unlikely(work == UACPI_NULL)) {
+        // Not fatal, just walk this subtree inline into the sync context
+        uacpi_namespace_for_each_child(
+            node, do_sta_ini, UACPI_NULL,
+            UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, ctx->sync_ctx
+        );
+        return UACPI_ITERATION_DECISION_NEXT_PEER;
+    }
+
+    work->node = node;
+    work->next = ctx->work_head;
+    ctx->work_head = work;
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_NAMESPACE_INIT, do_sta_ini_subtree_work, work
+    );
+    if (uacpi_unlikely_error(ret))
+        do_sta_ini_subtree_work(work);
+
+    return UACPI_ITERATION_DECISION_NEXT_PEER;
+}
+
+static void do_sta_ini_concurrent(
+    struct ns_init_context *ctx, uacpi_namespace_node *root
+)
+{
+    struct ns_init_dispatch_context dispatch_ctx = { 0 };
+    struct ns_init_subtree_work *work, *next;
+
+    dispatch_ctx.sync_ctx = ctx;
+
+    uacpi_namespace_for_each_child(
+        root, do_sta_ini_dispatch, UACPI_NULL,
+        UACPI_OBJECT_ANY_BIT, NS_INIT_DISPATCH_DEPTH, &dispatch_ctx
+    );
+
+    uacpi_kernel_wait_for_work_completion();
+
+    for (work = dispatch_ctx.work_head; work != UACPI_NULL; work = next) {
+        next = work->next;
+
+        ctx->ini_executed += work->ctx.ini_executed;
+        ctx->ini_errors += work->ctx.ini_errors;
+        ctx->sta_executed += work->ctx.sta_executed;
+        ctx->sta_errors += work->ctx.sta_errors;
+        ctx->devices += work->ctx.devices;
+        ctx->thermal_zones += work->ctx.thermal_zones;
+
+        uacpi_free(work, sizeof(*work));
+    }
+}
+
+struct async_namespace_load_request {
+    uacpi_namespace_load_callback callback;
+    uacpi_handle user;
+};
+
+static void do_async_namespace_load(uacpi_handle opaque)
+{
+    struct async_namespace_load_request req;
+
+    uacpi_memcpy(&req, opaque, sizeof(req));
+    uacpi_free(opaque, sizeof(req));
+
+    req.callback(uacpi_namespace_load(), req.user);
+}
+
+uacpi_status uacpi_namespace_load_async(
+    uacpi_namespace_load_callback callback, uacpi_handle user
+)
+{
+    uacpi_status ret;
+    struct async_namespace_load_request *req;
+
+    UACPI_ENSURE_INIT_LEVEL_IS(UACPI_INIT_LEVEL_SUBSYSTEM_INITIALIZED);
+
+    if (uacpi_unlikely(callback == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    req = uacpi_kernel_alloc(sizeof(*req));
+    if (uacpi_unlikely(req == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    req->callback = callback;
+    req->user = user;
+
+    ret = uacpi_kernel_schedule_work(
+        UACPI_WORK_NAMESPACE_LOAD, do_async_namespace_load, req
+    );
+    if (uacpi_unlikely_error(ret))
+        uacpi_free(req, sizeof(*req));
+
+    return ret;
+}
+
 uacpi_status uacpi_namespace_initialize(void)
 {
     struct ns_init_context ctx = { 0 };
@@ -604,10 +846,14 @@ uacpi_status uacpi_namespace_initialize(void)
     }
 
     // Step 4 - Run all other _STA and _INI methods
-    uacpi_namespace_for_each_child(
-        root, do_sta_ini, UACPI_NULL,
-        UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, &ctx
-    );
+    if (uacpi_check_flag(UACPI_FLAG_CONCURRENT_NS_INIT)) {
+        do_sta_ini_concurrent(&ctx, root);
+    } else {
+        uacpi_namespace_for_each_child(
+            root, do_sta_ini, UACPI_NULL,
+            UACPI_OBJECT_ANY_BIT, UACPI_MAX_DEPTH_ANY, &ctx
+        );
+    }
 
     end_ts = uacpi_kernel_get_nanoseconds_since_boot();
 
@@ -712,6 +958,32 @@ out_no_write_lock:
     return ret;
 }
 
+uacpi_status uacpi_eval_take_args(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    uacpi_object_array *args, uacpi_object **out_obj
+)
+{
+    uacpi_status ret;
+
+    ret = uacpi_eval(parent, path, args, out_obj);
+
+    /*
+     * Arguments are passed into the method by reference, so all that is left
+     * of the transfer is consuming the caller's refcounts. This is done on
+     * the error path as well, ownership is taken unconditionally.
+     */
+    if (args != UACPI_NULL) {
+        uacpi_size i;
+
+        for (i = 0; i < args->count; ++i) {
+            uacpi_object_unref(args->objects[i]);
+            args->objects[i] = UACPI_NULL;
+        }
+    }
+
+    return ret;
+}
+
 uacpi_status uacpi_eval_simple(
     uacpi_namespace_node *parent, const uacpi_char *path, uacpi_object **ret
 )
@@ -734,6 +1006,583 @@ uacpi_status uacpi_execute_simple(
     return uacpi_eval(parent, path, UACPI_NULL, UACPI_NULL);
 }
 
+struct uacpi_eval_continuation {
+    struct execution_context *exec_ctx;
+    uacpi_control_method *method;
+};
+
+uacpi_status uacpi_eval_suspendable(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_eval_continuation **out_cont,
+    uacpi_object **out_obj
+)
+{
+    struct uacpi_namespace_node *node;
+    struct execution_context *exec_ctx = UACPI_NULL;
+    uacpi_eval_continuation *cont;
+    uacpi_control_method *method;
+    uacpi_object *obj;
+    uacpi_status ret = UACPI_STATUS_INVALID_ARGUMENT;
+
+    if (uacpi_unlikely(out_cont == UACPI_NULL))
+        return ret;
+    if (uacpi_unlikely(parent == UACPI_NULL && path == UACPI_NULL))
+        return ret;
+
+    ret = uacpi_namespace_read_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (path != UACPI_NULL) {
+        ret = uacpi_namespace_node_resolve(
+            parent, path, UACPI_SHOULD_LOCK_NO,
+            UACPI_MAY_SEARCH_ABOVE_PARENT_NO, UACPI_PERMANENT_ONLY_YES,
+            &node
+        );
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_namespace_read_unlock();
+            return ret;
+        }
+    } else {
+        node = parent;
+    }
+
+    obj = uacpi_namespace_node_get_object(node);
+    if (obj == UACPI_NULL || obj->type != UACPI_OBJECT_METHOD) {
+        // Nothing to suspend here, let the plain eval deal with it
+        uacpi_namespace_read_unlock();
+        return uacpi_eval(parent, path, args, out_obj);
+    }
+
+    method = obj->method;
+    uacpi_shareable_ref(method);
+    uacpi_namespace_read_unlock();
+
+    // Upgrade to a write-lock since we're about to run a method
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        goto out_no_write_lock;
+
+    ret = uacpi_execute_control_method_suspendable(
+        node, method, args, out_obj, &exec_ctx
+    );
+    if (ret != UACPI_STATUS_SUSPENDED) {
+        uacpi_namespace_write_unlock();
+        goto out_no_write_lock;
+    }
+
+    cont = uacpi_kernel_alloc(sizeof(*cont));
+    if (uacpi_unlikely(cont == UACPI_NULL)) {
+        uacpi_abort_suspended_control_method(exec_ctx);
+        uacpi_namespace_write_unlock();
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out_no_write_lock;
+    }
+    uacpi_namespace_write_unlock();
+
+    cont->exec_ctx = exec_ctx;
+    cont->method = method;
+    *out_cont = cont;
+    return ret;
+
+out_no_write_lock:
+    uacpi_method_unref(method);
+    return ret;
+}
+
+uacpi_status uacpi_eval_resume(
+    uacpi_eval_continuation *cont, uacpi_object **out_obj
+)
+{
+    uacpi_status ret;
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    ret = uacpi_resume_control_method(cont->exec_ctx, out_obj);
+    uacpi_namespace_write_unlock();
+
+    // Parked again, the continuation stays valid as-is
+    if (ret == UACPI_STATUS_SUSPENDED)
+        return ret;
+
+    uacpi_method_unref(cont->method);
+    uacpi_free(cont, sizeof(*cont));
+    return ret;
+}
+
+uacpi_u64 uacpi_eval_continuation_wake_deadline(uacpi_eval_continuation *cont)
+{
+    return uacpi_suspended_control_method_wake_deadline(cont->exec_ctx);
+}
+
+void uacpi_eval_continuation_abort(uacpi_eval_continuation *cont)
+{
+    uacpi_status ret;
+
+    ret = uacpi_namespace_write_lock();
+    uacpi_abort_suspended_control_method(cont->exec_ctx);
+    if (uacpi_likely_success(ret))
+        uacpi_namespace_write_unlock();
+
+    uacpi_method_unref(cont->method);
+    uacpi_free(cont, sizeof(*cont));
+}
+
+/*
+ * Asynchronous evaluation requests are parked on a bounded FIFO queue and
+ * drained one by one from a worker scheduled via uacpi_kernel_schedule_work,
+ * so that slow firmware methods never occupy the submitting thread.
+ */
+#define ASYNC_EVAL_QUEUE_MAX_DEPTH 32
+
+struct uacpi_async_eval {
+    struct uacpi_async_eval *next;
+
+    uacpi_namespace_node *parent;
+    uacpi_char *path;
+    uacpi_object_array args;
+
+    uacpi_eval_async_callback callback;
+    void *user;
+};
+
+static uacpi_handle async_eval_mutex;
+static struct uacpi_async_eval *async_eval_head, *async_eval_tail;
+static uacpi_size async_eval_depth;
+static uacpi_bool async_eval_worker_scheduled;
+
+static uacpi_status initialize_async_eval(void)
+{
+    async_eval_mutex = uacpi_kernel_create_mutex();
+    if (uacpi_unlikely(async_eval_mutex == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    return UACPI_STATUS_OK;
+}
+
+static void free_async_eval(struct uacpi_async_eval *request)
+{
+    uacpi_size i;
+
+    for (i = 0; i < request->args.count; ++i)
+        uacpi_object_unref(request->args.objects[i]);
+    uacpi_free(
+        request->args.objects,
+        request->args.count * sizeof(*request->args.objects)
+    );
+
+    if (request->parent != UACPI_NULL)
+        uacpi_namespace_node_unref(request->parent);
+
+    uacpi_free_dynamic_string(request->path);
+    uacpi_free(request, sizeof(*request));
+}
+
+static void deinitialize_async_eval(void)
+{
+    struct uacpi_async_eval *request, *next_request;
+
+    if (async_eval_mutex == UACPI_NULL)
+        return;
+
+    // Let an in-flight worker finish before tearing anything down
+    uacpi_kernel_wait_for_work_completion();
+
+    request = async_eval_head;
+    while (request != UACPI_NULL) {
+        next_request = request->next;
+        free_async_eval(request);
+        request = next_request;
+    }
+
+    async_eval_head = async_eval_tail = UACPI_NULL;
+    async_eval_depth = 0;
+    async_eval_worker_scheduled = UACPI_FALSE;
+
+    uacpi_kernel_free_mutex(async_eval_mutex);
+    async_eval_mutex = UACPI_NULL;
+}
+
+static void do_async_evals(uacpi_handle opaque)
+{
+    uacpi_status ret;
+    struct uacpi_async_eval *request;
+    uacpi_object *ret_obj;
+
+    UACPI_UNUSED(opaque);
+
+    for (;;) {
+        ret = uacpi_acquire_native_mutex(async_eval_mutex);
+        if (uacpi_unlikely_error(ret))
+            return;
+
+        request = async_eval_head;
+        if (request != UACPI_NULL) {
+            async_eval_head = request->next;
+            if (async_eval_head == UACPI_NULL)
+                async_eval_tail = UACPI_NULL;
+            async_eval_depth--;
+        } else {
+            async_eval_worker_scheduled = UACPI_FALSE;
+        }
+
+        uacpi_release_native_mutex(async_eval_mutex);
+
+        if (request == UACPI_NULL)
+            return;
+
+        ret_obj = UACPI_NULL;
+        ret = uacpi_eval(
+            request->parent, request->path,
+            request->args.count ? &request->args : UACPI_NULL, &ret_obj
+        );
+
+        request->callback(request->user, ret, ret_obj);
+
+        if (ret_obj != UACPI_NULL)
+            uacpi_object_unref(ret_obj);
+        free_async_eval(request);
+    }
+}
+
+uacpi_status uacpi_eval_async(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    const uacpi_object_array *args, uacpi_eval_async_callback callback,
+    void *user, uacpi_async_eval **out_request
+)
+{
+    uacpi_status ret;
+    struct uacpi_async_eval *request;
+    uacpi_size i;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    if (uacpi_unlikely(callback == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+    if (uacpi_unlikely(parent == UACPI_NULL && path == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    request = uacpi_kernel_alloc_zeroed(sizeof(*request));
+    if (uacpi_unlikely(request == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    request->callback = callback;
+    request->user = user;
+
+    if (path != UACPI_NULL) {
+        uacpi_size path_size;
+
+        path_size = uacpi_strlen(path) + 1;
+        request->path = uacpi_kernel_alloc(path_size);
+        if (uacpi_unlikely(request->path == UACPI_NULL)) {
+            ret = UACPI_STATUS_OUT_OF_MEMORY;
+            goto out_free;
+        }
+        uacpi_memcpy(request->path, path, path_size);
+    }
+
+    if (args != UACPI_NULL && args->count != 0) {
+        request->args.objects = uacpi_kernel_alloc(
+            args->count * sizeof(*request->args.objects)
+        );
+        if (uacpi_unlikely(request->args.objects == UACPI_NULL)) {
+            ret = UACPI_STATUS_OUT_OF_MEMORY;
+            goto out_free;
+        }
+
+        request->args.count = args->count;
+        for (i = 0; i < args->count; ++i) {
+            request->args.objects[i] = args->objects[i];
+            uacpi_object_ref(args->objects[i]);
+        }
+    }
+
+    if (parent != UACPI_NULL) {
+        uacpi_shareable_ref(parent);
+        request->parent = parent;
+    }
+
+    ret = uacpi_acquire_native_mutex(async_eval_mutex);
+    if (uacpi_unlikely_error(ret))
+        goto out_free;
+
+    if (async_eval_depth >= ASYNC_EVAL_QUEUE_MAX_DEPTH) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out_release;
+    }
+
+    if (async_eval_tail != UACPI_NULL)
+        async_eval_tail->next = request;
+    else
+        async_eval_head = request;
+    async_eval_tail = request;
+    async_eval_depth++;
+
+    if (!async_eval_worker_scheduled) {
+        ret = uacpi_kernel_schedule_work(
+            UACPI_WORK_NOTIFICATION, do_async_evals, UACPI_NULL
+        );
+        if (uacpi_unlikely_error(ret)) {
+            // We appended under this same mutex hold, so we're the tail
+            if (async_eval_head == request) {
+                async_eval_head = async_eval_tail = UACPI_NULL;
+            } else {
+                struct uacpi_async_eval *prev_request;
+
+                for (prev_request = async_eval_head;
+                     prev_request->next != request;
+                     prev_request = prev_request->next);
+
+                prev_request->next = UACPI_NULL;
+                async_eval_tail = prev_request;
+            }
+            async_eval_depth--;
+            goto out_release;
+        }
+
+        async_eval_worker_scheduled = UACPI_TRUE;
+    }
+
+    if (out_request != UACPI_NULL)
+        *out_request = request;
+
+    uacpi_release_native_mutex(async_eval_mutex);
+    return UACPI_STATUS_OK;
+
+out_release:
+    uacpi_release_native_mutex(async_eval_mutex);
+out_free:
+    free_async_eval(request);
+    return ret;
+}
+
+uacpi_status uacpi_eval_async_cancel(uacpi_async_eval *request)
+{
+    uacpi_status ret;
+    struct uacpi_async_eval *cur, *prev = UACPI_NULL;
+
+    ret = uacpi_acquire_native_mutex(async_eval_mutex);
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (cur = async_eval_head; cur != UACPI_NULL; prev = cur, cur = cur->next) {
+        if (cur != request)
+            continue;
+
+        if (prev != UACPI_NULL)
+            prev->next = cur->next;
+        else
+            async_eval_head = cur->next;
+        if (async_eval_tail == cur)
+            async_eval_tail = prev;
+        async_eval_depth--;
+        break;
+    }
+
+    uacpi_release_native_mutex(async_eval_mutex);
+
+    // Too late, the worker has already picked this request up
+    if (cur == UACPI_NULL)
+        return UACPI_STATUS_NOT_FOUND;
+
+    free_async_eval(cur);
+    return UACPI_STATUS_OK;
+}
+
+struct uacpi_method_handle {
+    uacpi_namespace_node *node;
+    uacpi_control_method *method;
+};
+
+uacpi_status uacpi_method_handle_acquire(
+    uacpi_namespace_node *parent, const uacpi_char *path,
+    uacpi_method_handle **out_handle
+)
+{
+    struct uacpi_namespace_node *node;
+    uacpi_method_handle *handle;
+    uacpi_object *obj;
+    uacpi_status ret = UACPI_STATUS_INVALID_ARGUMENT;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    if (uacpi_unlikely(parent == UACPI_NULL && path == UACPI_NULL))
+        return ret;
+
+    ret = uacpi_namespace_read_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    if (path != UACPI_NULL) {
+        ret = uacpi_namespace_node_resolve(
+            parent, path, UACPI_SHOULD_LOCK_NO,
+            UACPI_MAY_SEARCH_ABOVE_PARENT_NO, UACPI_PERMANENT_ONLY_YES,
+            &node
+        );
+        if (uacpi_unlikely_error(ret))
+            goto out;
+    } else {
+        node = parent;
+    }
+
+    obj = uacpi_namespace_node_get_object(node);
+    if (uacpi_unlikely(obj == UACPI_NULL)) {
+        ret = UACPI_STATUS_INVALID_ARGUMENT;
+        goto out;
+    }
+
+    if (obj->type != UACPI_OBJECT_METHOD) {
+        ret = UACPI_STATUS_TYPE_MISMATCH;
+        goto out;
+    }
+
+    handle = uacpi_kernel_alloc(sizeof(*handle));
+    if (uacpi_unlikely(handle == UACPI_NULL)) {
+        ret = UACPI_STATUS_OUT_OF_MEMORY;
+        goto out;
+    }
+
+    uacpi_shareable_ref(node);
+    uacpi_shareable_ref(obj->method);
+    handle->node = node;
+    handle->method = obj->method;
+
+    *out_handle = handle;
+    ret = UACPI_STATUS_OK;
+
+out:
+    uacpi_namespace_read_unlock();
+    return ret;
+}
+
+void uacpi_method_handle_release(uacpi_method_handle *handle)
+{
+    if (handle == UACPI_NULL)
+        return;
+
+    uacpi_namespace_node_unref(handle->node);
+    uacpi_method_unref(handle->method);
+    uacpi_free(handle, sizeof(*handle));
+}
+
+uacpi_status uacpi_eval_prepared(
+    uacpi_method_handle *handle, const uacpi_object_array *args,
+    uacpi_object **out_obj
+)
+{
+    uacpi_status ret;
+
+    if (uacpi_unlikely(handle == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    /*
+     * The node might have been uninstalled since the handle was prepared, the
+     * references we hold only keep the memory valid, not the namespace entry.
+     */
+    if (uacpi_unlikely(uacpi_namespace_node_is_dangling(handle->node))) {
+        uacpi_namespace_write_unlock();
+        return UACPI_STATUS_NAMESPACE_NODE_DANGLING;
+    }
+
+    ret = uacpi_execute_control_method(
+        handle->node, handle->method, args, out_obj
+    );
+    uacpi_namespace_write_unlock();
+    return ret;
+}
+
+static uacpi_status do_batch_entry(uacpi_eval_batch_entry *entry)
+{
+    struct uacpi_namespace_node *node;
+    uacpi_control_method *method;
+    uacpi_object *obj;
+    uacpi_status ret = UACPI_STATUS_INVALID_ARGUMENT;
+
+    if (uacpi_unlikely(entry->parent == UACPI_NULL &&
+                       entry->path == UACPI_NULL))
+        return ret;
+
+    if (entry->path != UACPI_NULL) {
+        ret = uacpi_namespace_node_resolve(
+            entry->parent, entry->path, UACPI_SHOULD_LOCK_NO,
+            UACPI_MAY_SEARCH_ABOVE_PARENT_NO, UACPI_PERMANENT_ONLY_YES,
+            &node
+        );
+        if (uacpi_unlikely_error(ret))
+            return ret;
+    } else {
+        node = entry->parent;
+    }
+
+    obj = uacpi_namespace_node_get_object(node);
+    if (uacpi_unlikely(obj == UACPI_NULL))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    if (obj->type != UACPI_OBJECT_METHOD) {
+        uacpi_object *new_obj;
+
+        new_obj = uacpi_create_object(UACPI_OBJECT_UNINITIALIZED);
+        if (uacpi_unlikely(new_obj == UACPI_NULL))
+            return UACPI_STATUS_OUT_OF_MEMORY;
+
+        ret = uacpi_object_assign(
+            new_obj, obj, UACPI_ASSIGN_BEHAVIOR_DEEP_COPY
+        );
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_object_unref(new_obj);
+            return ret;
+        }
+
+        entry->ret = new_obj;
+        return UACPI_STATUS_OK;
+    }
+
+    method = obj->method;
+    uacpi_shareable_ref(method);
+
+    ret = uacpi_execute_control_method(
+        node, method, entry->args, &entry->ret
+    );
+
+    uacpi_method_unref(method);
+    return ret;
+}
+
+uacpi_status uacpi_eval_batch(
+    uacpi_eval_batch_entry *entries, uacpi_size num_entries
+)
+{
+    uacpi_status ret;
+    uacpi_size i;
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    if (uacpi_unlikely(entries == UACPI_NULL || num_entries == 0))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    /*
+     * Any entry might end up being a method, so grab the write lock upfront
+     * for the entire batch instead of upgrading per-entry.
+     */
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    for (i = 0; i < num_entries; ++i) {
+        entries[i].ret = UACPI_NULL;
+        entries[i].status = do_batch_entry(&entries[i]);
+    }
+
+    uacpi_namespace_write_unlock();
+    return UACPI_STATUS_OK;
+}
+
 #define TRACE_BAD_RET(path_fmt, type, ...)                                 \
     uacpi_warn(                                                            \
         "unexpected '%s' object returned by method "path_fmt               \
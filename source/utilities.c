@@ -6,6 +6,7 @@
 #include <uacpi/internal/utilities.h>
 #include <uacpi/internal/log.h>
 #include <uacpi/internal/namespace.h>
+#include <uacpi/internal/shareable.h>
 
 void uacpi_eisa_id_to_string(uacpi_u32 id, uacpi_char *out_string)
 {
@@ -307,7 +308,7 @@ uacpi_status uacpi_string_to_integer(
 {
     uacpi_status ret = UACPI_STATUS_INVALID_ARGUMENT;
     uacpi_bool negative = UACPI_FALSE;
-    uacpi_u64 next, value = 0;
+    uacpi_u64 cutoff, cutlim, next, value = 0;
     uacpi_char c = '\0';
 
     while (consume_if(&str, &max_chars, CHAR_TYPE_SPACE));
@@ -327,6 +328,13 @@ uacpi_status uacpi_string_to_integer(
         }
     }
 
+    /*
+     * Hoist the overflow boundary out of the loop so that the per-digit
+     * accumulation below is division-free.
+     */
+    cutoff = 0xFFFFFFFFFFFFFFFF / base;
+    cutlim = 0xFFFFFFFFFFFFFFFF % base;
+
     while (consume_one(&str, &max_chars, &c)) {
         switch (ascii_map[(uacpi_u8)c] & (CHAR_TYPE_DIGIT | CHAR_TYPE_ALHEX)) {
         case CHAR_TYPE_DIGIT | CHAR_TYPE_HEX_DIGIT:
@@ -344,13 +352,13 @@ uacpi_status uacpi_string_to_integer(
             goto out;
         }
 
-        next = (value * base) + next;
-        if ((next / base) != value) {
+        if (uacpi_unlikely(value > cutoff ||
+                           (value == cutoff && next > cutlim))) {
             value = 0xFFFFFFFFFFFFFFFF;
             goto out;
         }
 
-        value = next;
+        value = (value * base) + next;
     }
 
 out:
@@ -366,12 +374,188 @@ out:
 
 #define PNP_ID_LENGTH 8
 
+/*
+ * Every uacpi_id_string/uacpi_pnp_id_list handed out to the client is
+ * allocated with a hidden refcount header in front of it, so that interned
+ * ID results can be shared between the cache below and any number of
+ * callers, with uacpi_free_id_string/uacpi_free_pnp_id_list dropping a
+ * reference instead of always releasing the memory.
+ */
+struct id_box {
+    struct uacpi_shareable shareable;
+
+    // Total allocation size, including this header
+    uacpi_u32 size;
+};
+
+static void *id_box_alloc(uacpi_u32 public_size)
+{
+    struct id_box *box;
+    uacpi_u32 size = sizeof(*box) + public_size;
+
+    box = uacpi_kernel_alloc(size);
+    if (uacpi_unlikely(box == UACPI_NULL))
+        return UACPI_NULL;
+
+    uacpi_shareable_init(box);
+    box->size = size;
+    return UACPI_PTR_ADD(box, sizeof(*box));
+}
+
+static struct id_box *id_box_of(void *public_ptr)
+{
+    return (struct id_box*)((uacpi_u8*)public_ptr - sizeof(struct id_box));
+}
+
+static void free_id_box(uacpi_handle handle)
+{
+    struct id_box *box = handle;
+
+    uacpi_free(box, box->size);
+}
+
+/*
+ * Interned results of _HID/_UID/_CID evaluation, keyed by the device node.
+ *
+ * Bus enumeration layers tend to re-query the same IDs for the same nodes
+ * over and over, so evaluate once and hand out extra references to the
+ * shared result afterwards. Entries follow the same lazy invalidation
+ * scheme as the _PRT cache below: each is stamped with the namespace
+ * generation that dynamic table loads bump, and is re-evaluated once its
+ * stamp no longer matches.
+ *
+ * The cache is guarded by the namespace write lock, which is never held
+ * across AML evaluation.
+ */
+enum id_cache_slot {
+    ID_CACHE_HID = 0,
+    ID_CACHE_UID,
+    ID_CACHE_CID,
+};
+
+struct id_cache_entry {
+    struct id_cache_entry *next;
+    uacpi_namespace_node *node;
+    uacpi_u32 generation;
+    uacpi_u8 slot;
+
+    // Either a uacpi_id_string or a uacpi_pnp_id_list depending on the slot
+    void *id;
+};
+
+static struct id_cache_entry *id_cache_head;
+
+// Bumped by dynamic table loads, see uacpi_bump_namespace_generation below
+static uacpi_u32 namespace_generation;
+
+void uacpi_free_id_string_cache(void)
+{
+    struct id_cache_entry *entry, *next_entry;
+
+    entry = id_cache_head;
+    while (entry != UACPI_NULL) {
+        next_entry = entry->next;
+
+        uacpi_shareable_unref_and_delete_if_last(
+            id_box_of(entry->id), free_id_box
+        );
+        uacpi_free(entry, sizeof(*entry));
+
+        entry = next_entry;
+    }
+
+    id_cache_head = UACPI_NULL;
+}
+
+static uacpi_status id_cache_lookup(
+    uacpi_namespace_node *node, enum id_cache_slot slot, void **out_id,
+    uacpi_u32 *out_generation
+)
+{
+    uacpi_status ret;
+    struct id_cache_entry *entry;
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    *out_generation = namespace_generation;
+
+    ret = UACPI_STATUS_NOT_FOUND;
+    for (entry = id_cache_head; entry != UACPI_NULL; entry = entry->next) {
+        if (entry->node != node || entry->slot != slot)
+            continue;
+
+        if (entry->generation == namespace_generation) {
+            uacpi_shareable_ref(id_box_of(entry->id));
+            *out_id = entry->id;
+            ret = UACPI_STATUS_OK;
+        }
+        break;
+    }
+
+    uacpi_namespace_write_unlock();
+    return ret;
+}
+
+static void id_cache_insert(
+    uacpi_namespace_node *node, enum id_cache_slot slot, void *id,
+    uacpi_u32 generation
+)
+{
+    struct id_cache_entry *entry;
+
+    // The cache is purely best-effort, give up on any failure below
+    if (uacpi_unlikely_error(uacpi_namespace_write_lock()))
+        return;
+
+    for (entry = id_cache_head; entry != UACPI_NULL; entry = entry->next) {
+        if (entry->node == node && entry->slot == slot)
+            break;
+    }
+
+    if (entry == UACPI_NULL) {
+        entry = uacpi_kernel_alloc_zeroed(sizeof(*entry));
+        if (uacpi_unlikely(entry == UACPI_NULL)) {
+            uacpi_namespace_write_unlock();
+            return;
+        }
+
+        entry->node = node;
+        entry->slot = slot;
+        entry->next = id_cache_head;
+        id_cache_head = entry;
+    } else {
+        uacpi_shareable_unref_and_delete_if_last(
+            id_box_of(entry->id), free_id_box
+        );
+    }
+
+    uacpi_shareable_ref(id_box_of(id));
+    entry->id = id;
+
+    /*
+     * Stamp with the generation observed before the ID was evaluated: if a
+     * dynamic load raced with us, the entry is immediately considered stale
+     * instead of masking the new value until the next bump.
+     */
+    entry->generation = generation;
+
+    uacpi_namespace_write_unlock();
+}
+
 uacpi_status uacpi_eval_hid(uacpi_namespace_node *node, uacpi_id_string **out_id)
 {
     uacpi_status ret;
     uacpi_object *hid_ret;
     uacpi_id_string *id = UACPI_NULL;
-    uacpi_u32 size;
+    uacpi_u32 size, generation = 0;
+
+    ret = id_cache_lookup(
+        node, ID_CACHE_HID, (void**)out_id, &generation
+    );
+    if (ret != UACPI_STATUS_NOT_FOUND)
+        return ret;
 
     ret = uacpi_eval_typed(
         node, "_HID", UACPI_NULL,
@@ -397,7 +581,7 @@ uacpi_status uacpi_eval_hid(uacpi_namespace_node *node, uacpi_id_string **out_id
             break;
         }
 
-        id = uacpi_kernel_alloc(size);
+        id = id_box_alloc(size);
         if (uacpi_unlikely(id == UACPI_NULL)) {
             ret = UACPI_STATUS_OUT_OF_MEMORY;
             break;
@@ -413,7 +597,7 @@ uacpi_status uacpi_eval_hid(uacpi_namespace_node *node, uacpi_id_string **out_id
     case UACPI_OBJECT_INTEGER:
         size += PNP_ID_LENGTH;
 
-        id = uacpi_kernel_alloc(size);
+        id = id_box_alloc(size);
         if (uacpi_unlikely(id == UACPI_NULL)) {
             ret = UACPI_STATUS_OUT_OF_MEMORY;
             break;
@@ -426,8 +610,10 @@ uacpi_status uacpi_eval_hid(uacpi_namespace_node *node, uacpi_id_string **out_id
     }
 
     uacpi_object_unref(hid_ret);
-    if (uacpi_likely_success(ret))
+    if (uacpi_likely_success(ret)) {
+        id_cache_insert(node, ID_CACHE_HID, id, generation);
         *out_id = id;
+    }
     return ret;
 }
 
@@ -436,7 +622,7 @@ void uacpi_free_id_string(uacpi_id_string *id)
     if (id == UACPI_NULL)
         return;
 
-    uacpi_free(id, sizeof(uacpi_id_string) + id->size);
+    uacpi_shareable_unref_and_delete_if_last(id_box_of(id), free_id_box);
 }
 
 uacpi_status uacpi_eval_cid(
@@ -447,11 +633,17 @@ uacpi_status uacpi_eval_cid(
     uacpi_object *object, *cid_ret;
     uacpi_object **objects;
     uacpi_size num_ids, i;
-    uacpi_u32 size;
+    uacpi_u32 size, generation = 0;
     uacpi_id_string *id;
     uacpi_char *id_buffer;
     uacpi_pnp_id_list *list;
 
+    ret = id_cache_lookup(
+        node, ID_CACHE_CID, (void**)out_list, &generation
+    );
+    if (ret != UACPI_STATUS_NOT_FOUND)
+        return ret;
+
     ret = uacpi_eval_typed(
         node, "_CID", UACPI_NULL,
         UACPI_OBJECT_INTEGER_BIT | UACPI_OBJECT_STRING_BIT |
@@ -463,6 +655,12 @@ uacpi_status uacpi_eval_cid(
 
     switch (cid_ret->type) {
     case UACPI_OBJECT_PACKAGE:
+        ret = uacpi_package_materialize(cid_ret->package);
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_object_unref(cid_ret);
+            return ret;
+        }
+
         objects = cid_ret->package->objects;
         num_ids = cid_ret->package->count;
         break;
@@ -515,7 +713,7 @@ uacpi_status uacpi_eval_cid(
         }
     }
 
-    list = uacpi_kernel_alloc(size);
+    list = id_box_alloc(size);
     if (uacpi_unlikely(list == UACPI_NULL))
         return UACPI_STATUS_OUT_OF_MEMORY;
     list->num_ids = num_ids;
@@ -551,6 +749,7 @@ uacpi_status uacpi_eval_cid(
     }
 
     uacpi_object_unref(cid_ret);
+    id_cache_insert(node, ID_CACHE_CID, list, generation);
     *out_list = list;
     return ret;
 }
@@ -560,7 +759,7 @@ void uacpi_free_pnp_id_list(uacpi_pnp_id_list *list)
     if (list == UACPI_NULL)
         return;
 
-    uacpi_free(list, sizeof(uacpi_pnp_id_list) + list->size);
+    uacpi_shareable_unref_and_delete_if_last(id_box_of(list), free_id_box);
 }
 
 uacpi_status uacpi_eval_sta(uacpi_namespace_node *node, uacpi_u32 *flags)
@@ -624,11 +823,16 @@ uacpi_status uacpi_eval_cls(
         return ret;
 
     pkg = obj->package;
+
+    ret = uacpi_package_materialize(pkg);
+    if (uacpi_unlikely_error(ret))
+        goto out;
+
     class_codes[0] = extract_package_byte_or_zero(pkg, 0);
     class_codes[1] = extract_package_byte_or_zero(pkg, 1);
     class_codes[2] = extract_package_byte_or_zero(pkg, 2);
 
-    id_string = uacpi_kernel_alloc(sizeof(uacpi_id_string) + CLS_REPR_SIZE);
+    id_string = id_box_alloc(sizeof(uacpi_id_string) + CLS_REPR_SIZE);
     if (uacpi_unlikely(id_string == UACPI_NULL)) {
         ret = UACPI_STATUS_OUT_OF_MEMORY;
         goto out;
@@ -657,7 +861,13 @@ uacpi_status uacpi_eval_uid(
     uacpi_status ret;
     uacpi_object *obj;
     uacpi_id_string *id_string;
-    uacpi_u32 size;
+    uacpi_u32 size, generation = 0;
+
+    ret = id_cache_lookup(
+        node, ID_CACHE_UID, (void**)out_uid, &generation
+    );
+    if (ret != UACPI_STATUS_NOT_FOUND)
+        return ret;
 
     ret = uacpi_eval_typed(
         node, "_UID", UACPI_NULL,
@@ -683,7 +893,7 @@ uacpi_status uacpi_eval_uid(
         ) + 1;
     }
 
-    id_string = uacpi_kernel_alloc(sizeof(uacpi_id_string) + size);
+    id_string = id_box_alloc(sizeof(uacpi_id_string) + size);
     if (uacpi_unlikely(id_string == UACPI_NULL)) {
         ret = UACPI_STATUS_OUT_OF_MEMORY;
         goto out;
@@ -703,8 +913,10 @@ uacpi_status uacpi_eval_uid(
     }
 
 out:
-    if (uacpi_likely_success(ret))
+    if (uacpi_likely_success(ret)) {
+        id_cache_insert(node, ID_CACHE_UID, id_string, generation);
         *out_uid = id_string;
+    }
 
     uacpi_object_unref(obj);
     return ret;
@@ -781,14 +993,15 @@ static uacpi_status uacpi_eval_dstate_method_template(
         uacpi_memzero(&info->name, sizeof(*name));     \
     }                                                  \
 
-uacpi_status uacpi_get_namespace_node_info(
-    uacpi_namespace_node *node, uacpi_namespace_node_info **out_info
+static uacpi_status do_get_namespace_node_info(
+    uacpi_namespace_node *node, uacpi_namespace_node_info *user_info,
+    uacpi_u32 capacity, uacpi_namespace_node_info **out_info
 )
 {
     uacpi_status ret = UACPI_STATUS_OK;
     uacpi_u32 size = sizeof(uacpi_namespace_node_info);
     uacpi_object *obj;
-    uacpi_namespace_node_info *info;
+    uacpi_namespace_node_info *info = UACPI_NULL;
     uacpi_id_string *hid = UACPI_NULL, *uid = UACPI_NULL, *cls = UACPI_NULL;
     uacpi_pnp_id_list *cid = UACPI_NULL;
     uacpi_char *cursor;
@@ -826,10 +1039,20 @@ uacpi_status uacpi_get_namespace_node_info(
             flags |= UACPI_NS_NODE_INFO_HAS_SXW;
     }
 
-    info = uacpi_kernel_alloc(size);
-    if (uacpi_unlikely(info == UACPI_NULL)) {
-        ret = UACPI_STATUS_OUT_OF_MEMORY;
-        goto out;
+    if (out_info != UACPI_NULL) {
+        info = uacpi_kernel_alloc(size);
+        if (uacpi_unlikely(info == UACPI_NULL)) {
+            ret = UACPI_STATUS_OUT_OF_MEMORY;
+            goto out;
+        }
+    } else {
+        info = user_info;
+        if (uacpi_unlikely(capacity < size)) {
+            // Let the caller know how much room the node actually needs
+            info->size = size;
+            ret = UACPI_STATUS_BUFFER_TOO_SMALL;
+            goto out;
+        }
     }
     info->size = size;
     cursor = UACPI_PTR_ADD(info, sizeof(uacpi_namespace_node_info));
@@ -871,7 +1094,8 @@ uacpi_status uacpi_get_namespace_node_info(
 out:
     if (uacpi_likely_success(ret)) {
         info->flags = flags;
-        *out_info = info;
+        if (out_info != UACPI_NULL)
+            *out_info = info;
     }
 
     uacpi_free_id_string(hid);
@@ -881,6 +1105,25 @@ out:
     return ret;
 }
 
+uacpi_status uacpi_get_namespace_node_info(
+    uacpi_namespace_node *node, uacpi_namespace_node_info **out_info
+)
+{
+    return do_get_namespace_node_info(node, UACPI_NULL, 0, out_info);
+}
+
+uacpi_status uacpi_get_namespace_node_info_into(
+    uacpi_namespace_node *node, uacpi_namespace_node_info *info,
+    uacpi_u32 capacity
+)
+{
+    if (uacpi_unlikely(info == UACPI_NULL ||
+                       capacity < sizeof(uacpi_namespace_node_info)))
+        return UACPI_STATUS_INVALID_ARGUMENT;
+
+    return do_get_namespace_node_info(node, info, capacity, UACPI_NULL);
+}
+
 void uacpi_free_namespace_node_info(uacpi_namespace_node_info *info)
 {
     if (info == UACPI_NULL)
@@ -922,6 +1165,276 @@ out:
     return ret;
 }
 
+/*
+ * The device-ID index is a hash multimap from a PNP/ACPI ID string to every
+ * device node that advertises it via _HID or _CID. It is built on explicit
+ * host request and lets find_devices answer repeated by-ID queries without
+ * re-evaluating _HID/_CID across the entire subtree every time.
+ *
+ * Dynamic table loads may define new devices, so any such load marks the
+ * index out-of-date, and lookups fall back to a full walk until it is
+ * rebuilt. Nothing ever removes permanent nodes outside of a full state
+ * reset, thus entries never go stale in the other direction.
+ */
+#define DEVICE_ID_INDEX_BUCKETS 64
+
+struct device_id_index_entry {
+    struct device_id_index_entry *next;
+    uacpi_namespace_node *node;
+
+    // Size of the id string, including the null terminator
+    uacpi_u32 id_size;
+    uacpi_char id[];
+};
+
+struct device_id_index {
+    uacpi_size num_entries;
+    struct device_id_index_entry *buckets[DEVICE_ID_INDEX_BUCKETS];
+};
+
+static struct device_id_index *device_id_index;
+static uacpi_bool device_id_index_up_to_date;
+
+static uacpi_u32 device_id_hash(const uacpi_char *id)
+{
+    // 32-bit FNV-1a
+    uacpi_u32 hash = 2166136261u;
+
+    while (*id) {
+        hash ^= (uacpi_u8)*id++;
+        hash *= 16777619u;
+    }
+
+    return hash & (DEVICE_ID_INDEX_BUCKETS - 1);
+}
+
+static uacpi_status device_id_index_insert(
+    struct device_id_index *index, uacpi_namespace_node *node,
+    uacpi_id_string *id
+)
+{
+    struct device_id_index_entry *entry;
+    uacpi_u32 slot;
+
+    entry = uacpi_kernel_alloc(sizeof(*entry) + id->size);
+    if (uacpi_unlikely(entry == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    entry->node = node;
+    entry->id_size = id->size;
+    uacpi_memcpy(entry->id, id->value, id->size);
+
+    slot = device_id_hash(entry->id);
+    entry->next = index->buckets[slot];
+    index->buckets[slot] = entry;
+    index->num_entries++;
+
+    return UACPI_STATUS_OK;
+}
+
+struct device_id_index_build_ctx {
+    struct device_id_index *index;
+    uacpi_status ret;
+};
+
+static uacpi_iteration_decision index_one_device(
+    void *opaque, uacpi_namespace_node *node, uacpi_u32 depth
+)
+{
+    struct device_id_index_build_ctx *ctx = opaque;
+    uacpi_status ret = UACPI_STATUS_OK;
+    uacpi_id_string *id = UACPI_NULL;
+    uacpi_pnp_id_list *id_list = UACPI_NULL;
+
+    UACPI_UNUSED(depth);
+
+    if (uacpi_eval_hid(node, &id) == UACPI_STATUS_OK) {
+        ret = device_id_index_insert(ctx->index, node, id);
+        if (uacpi_unlikely_error(ret))
+            goto out;
+    }
+
+    if (uacpi_eval_cid(node, &id_list) == UACPI_STATUS_OK) {
+        uacpi_size i;
+
+        for (i = 0; i < id_list->num_ids; ++i) {
+            ret = device_id_index_insert(ctx->index, node, &id_list->ids[i]);
+            if (uacpi_unlikely_error(ret))
+                goto out;
+        }
+    }
+
+out:
+    uacpi_free_id_string(id);
+    uacpi_free_pnp_id_list(id_list);
+
+    if (uacpi_unlikely_error(ret)) {
+        ctx->ret = ret;
+        return UACPI_ITERATION_DECISION_BREAK;
+    }
+
+    return UACPI_ITERATION_DECISION_CONTINUE;
+}
+
+void uacpi_free_device_id_index(void)
+{
+    uacpi_size i;
+    struct device_id_index_entry *entry, *next_entry;
+
+    if (device_id_index == UACPI_NULL)
+        return;
+
+    for (i = 0; i < DEVICE_ID_INDEX_BUCKETS; ++i) {
+        entry = device_id_index->buckets[i];
+
+        while (entry != UACPI_NULL) {
+            next_entry = entry->next;
+            uacpi_free(entry, sizeof(*entry) + entry->id_size);
+            entry = next_entry;
+        }
+    }
+
+    uacpi_free(device_id_index, sizeof(*device_id_index));
+    device_id_index = UACPI_NULL;
+    device_id_index_up_to_date = UACPI_FALSE;
+}
+
+void uacpi_invalidate_device_id_index(void)
+{
+    device_id_index_up_to_date = UACPI_FALSE;
+}
+
+uacpi_status uacpi_build_device_id_index(void)
+{
+    uacpi_status ret;
+    struct device_id_index_build_ctx ctx = { 0 };
+
+    UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
+
+    uacpi_free_device_id_index();
+
+    ctx.index = uacpi_kernel_alloc_zeroed(sizeof(*ctx.index));
+    if (uacpi_unlikely(ctx.index == UACPI_NULL))
+        return UACPI_STATUS_OUT_OF_MEMORY;
+
+    ret = uacpi_namespace_for_each_child(
+        uacpi_namespace_root(), index_one_device, UACPI_NULL,
+        UACPI_OBJECT_DEVICE_BIT, UACPI_MAX_DEPTH_ANY, &ctx
+    );
+    if (ret == UACPI_STATUS_OK)
+        ret = ctx.ret;
+
+    device_id_index = ctx.index;
+
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_free_device_id_index();
+        return ret;
+    }
+
+    device_id_index_up_to_date = UACPI_TRUE;
+    uacpi_trace(
+        "built a device ID index of %zu entries\n",
+        device_id_index->num_entries
+    );
+    return UACPI_STATUS_OK;
+}
+
+static uacpi_bool device_id_index_node_matches(
+    struct device_id_index *index, uacpi_namespace_node *node,
+    const uacpi_char *id
+)
+{
+    struct device_id_index_entry *entry;
+
+    entry = index->buckets[device_id_hash(id)];
+    for (; entry != UACPI_NULL; entry = entry->next) {
+        if (entry->node == node && uacpi_strcmp(entry->id, id) == 0)
+            return UACPI_TRUE;
+    }
+
+    return UACPI_FALSE;
+}
+
+/*
+ * Computes the depth of 'node' relative to 'parent' (a direct child being at
+ * depth 1, same as the namespace walk would report it), or returns
+ * UACPI_FALSE if 'node' is not within the subtree of 'parent' at all.
+ */
+static uacpi_bool device_id_index_relative_depth(
+    uacpi_namespace_node *parent, uacpi_namespace_node *node,
+    uacpi_u32 *out_depth
+)
+{
+    uacpi_u32 depth = 1;
+
+    if (node == parent)
+        return UACPI_FALSE;
+
+    for (node = node->parent; node != UACPI_NULL; node = node->parent) {
+        if (node == parent) {
+            *out_depth = depth;
+            return UACPI_TRUE;
+        }
+
+        depth++;
+    }
+
+    return UACPI_FALSE;
+}
+
+static uacpi_status find_devices_via_index(
+    uacpi_namespace_node *parent, const uacpi_char *const *ids,
+    uacpi_iteration_callback cb, void *user
+)
+{
+    struct device_id_index *index = device_id_index;
+    struct device_id_index_entry *entry;
+    uacpi_status ret;
+    uacpi_size i, j;
+    uacpi_u32 depth, flags;
+
+    for (i = 0; ids[i]; ++i) {
+        entry = index->buckets[device_id_hash(ids[i])];
+
+        for (; entry != UACPI_NULL; entry = entry->next) {
+            uacpi_bool already_reported = UACPI_FALSE;
+
+            if (uacpi_strcmp(entry->id, ids[i]) != 0)
+                continue;
+
+            /*
+             * A device advertising multiple of the requested ids is only
+             * reported once, for the first id that it matches.
+             */
+            for (j = 0; j < i; ++j) {
+                if (device_id_index_node_matches(index, entry->node, ids[j])) {
+                    already_reported = UACPI_TRUE;
+                    break;
+                }
+            }
+            if (already_reported)
+                continue;
+
+            if (!device_id_index_relative_depth(parent, entry->node, &depth))
+                continue;
+
+            ret = uacpi_eval_sta(entry->node, &flags);
+            if (uacpi_unlikely_error(ret))
+                continue;
+
+            if (!(flags & ACPI_STA_RESULT_DEVICE_PRESENT) &&
+                !(flags & ACPI_STA_RESULT_DEVICE_FUNCTIONING))
+                continue;
+
+            if (cb(user, entry->node, depth) ==
+                UACPI_ITERATION_DECISION_BREAK)
+                return UACPI_STATUS_OK;
+        }
+    }
+
+    return UACPI_STATUS_OK;
+}
+
 struct device_find_ctx {
     const uacpi_char *const *target_hids;
     void *user;
@@ -958,6 +1471,9 @@ uacpi_status uacpi_find_devices_at(
 {
     UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
 
+    if (device_id_index_up_to_date && parent != UACPI_NULL)
+        return find_devices_via_index(parent, hids, cb, user);
+
     struct device_find_ctx ctx = {
         .target_hids = hids,
         .user = user,
@@ -1006,6 +1522,153 @@ uacpi_status uacpi_set_interrupt_model(uacpi_interrupt_model model)
     return ret;
 }
 
+/*
+ * Cached results of _PRT evaluation, keyed by the bridge device node.
+ *
+ * A routing table only ever changes alongside a dynamic table load (e.g. as
+ * part of a hotplug event), so every cached entry is stamped with a namespace
+ * generation counter that such loads bump, and is lazily re-converted once
+ * its stamp no longer matches. Keying by raw node pointers is fine here as
+ * permanent nodes are never removed outside of a full state reset.
+ *
+ * The cache itself is guarded by the namespace write lock, which is never
+ * held across AML evaluation.
+ */
+struct prt_cache_entry {
+    struct prt_cache_entry *next;
+    uacpi_namespace_node *node;
+    uacpi_u32 generation;
+    uacpi_pci_routing_table *table;
+};
+
+static struct prt_cache_entry *prt_cache_head;
+
+void uacpi_bump_namespace_generation(void)
+{
+    namespace_generation++;
+}
+
+uacpi_u32 uacpi_dynamic_load_generation(void)
+{
+    return namespace_generation;
+}
+
+void uacpi_free_pci_routing_table_cache(void)
+{
+    struct prt_cache_entry *entry, *next_entry;
+
+    entry = prt_cache_head;
+    while (entry != UACPI_NULL) {
+        next_entry = entry->next;
+
+        uacpi_free_pci_routing_table(entry->table);
+        uacpi_free(entry, sizeof(*entry));
+
+        entry = next_entry;
+    }
+
+    prt_cache_head = UACPI_NULL;
+}
+
+static uacpi_pci_routing_table *pci_routing_table_clone(
+    uacpi_pci_routing_table *table
+)
+{
+    uacpi_pci_routing_table *clone;
+    uacpi_size size;
+
+    size = sizeof(uacpi_pci_routing_table) +
+           table->num_entries * sizeof(uacpi_pci_routing_table_entry);
+
+    clone = uacpi_kernel_alloc(size);
+    if (uacpi_unlikely(clone == UACPI_NULL))
+        return UACPI_NULL;
+
+    uacpi_memcpy(clone, table, size);
+    return clone;
+}
+
+static uacpi_status prt_cache_lookup(
+    uacpi_namespace_node *node, uacpi_pci_routing_table **out_table,
+    uacpi_u32 *out_generation
+)
+{
+    uacpi_status ret;
+    struct prt_cache_entry *entry;
+
+    ret = uacpi_namespace_write_lock();
+    if (uacpi_unlikely_error(ret))
+        return ret;
+
+    *out_generation = namespace_generation;
+
+    ret = UACPI_STATUS_NOT_FOUND;
+    for (entry = prt_cache_head; entry != UACPI_NULL; entry = entry->next) {
+        if (entry->node != node)
+            continue;
+
+        if (entry->generation == *out_generation) {
+            *out_table = pci_routing_table_clone(entry->table);
+            ret = *out_table != UACPI_NULL ?
+                UACPI_STATUS_OK : UACPI_STATUS_OUT_OF_MEMORY;
+        }
+        break;
+    }
+
+    uacpi_namespace_write_unlock();
+    return ret;
+}
+
+static void prt_cache_insert(
+    uacpi_namespace_node *node, uacpi_pci_routing_table *table,
+    uacpi_u32 generation
+)
+{
+    struct prt_cache_entry *entry;
+    uacpi_pci_routing_table *clone;
+
+    // The cache is purely best-effort, give up on any failure below
+    clone = pci_routing_table_clone(table);
+    if (uacpi_unlikely(clone == UACPI_NULL))
+        return;
+
+    if (uacpi_unlikely_error(uacpi_namespace_write_lock())) {
+        uacpi_free_pci_routing_table(clone);
+        return;
+    }
+
+    for (entry = prt_cache_head; entry != UACPI_NULL; entry = entry->next) {
+        if (entry->node == node)
+            break;
+    }
+
+    if (entry == UACPI_NULL) {
+        entry = uacpi_kernel_alloc_zeroed(sizeof(*entry));
+        if (uacpi_unlikely(entry == UACPI_NULL)) {
+            uacpi_namespace_write_unlock();
+            uacpi_free_pci_routing_table(clone);
+            return;
+        }
+
+        entry->node = node;
+        entry->next = prt_cache_head;
+        prt_cache_head = entry;
+    } else {
+        uacpi_free_pci_routing_table(entry->table);
+    }
+
+    entry->table = clone;
+
+    /*
+     * Stamp with the generation observed before _PRT was evaluated: if a
+     * dynamic load raced with us, the entry is immediately considered stale
+     * instead of masking the new table until the next bump.
+     */
+    entry->generation = generation;
+
+    uacpi_namespace_write_unlock();
+}
+
 uacpi_status uacpi_get_pci_routing_table(
     uacpi_namespace_node *parent, uacpi_pci_routing_table **out_table
 )
@@ -1016,6 +1679,7 @@ uacpi_status uacpi_get_pci_routing_table(
     uacpi_pci_routing_table_entry *entry;
     uacpi_pci_routing_table *table;
     uacpi_size size, i;
+    uacpi_u32 generation = 0;
 
     UACPI_ENSURE_INIT_LEVEL_AT_LEAST(UACPI_INIT_LEVEL_NAMESPACE_LOADED);
 
@@ -1023,6 +1687,10 @@ uacpi_status uacpi_get_pci_routing_table(
     if (uacpi_unlikely(obj == UACPI_NULL || obj->type != UACPI_OBJECT_DEVICE))
         return UACPI_STATUS_INVALID_ARGUMENT;
 
+    ret = prt_cache_lookup(parent, out_table, &generation);
+    if (ret != UACPI_STATUS_NOT_FOUND)
+        return ret;
+
     ret = uacpi_eval_typed(
         parent, "_PRT", UACPI_NULL, UACPI_OBJECT_PACKAGE_BIT, &obj
     );
@@ -1030,6 +1698,13 @@ uacpi_status uacpi_get_pci_routing_table(
         return ret;
 
     table_pkg = obj->package;
+
+    ret = uacpi_package_materialize(table_pkg);
+    if (uacpi_unlikely_error(ret)) {
+        uacpi_object_unref(obj);
+        return ret;
+    }
+
     if (uacpi_unlikely(table_pkg->count == 0 || table_pkg->count > 1024)) {
         uacpi_error("invalid number of _PRT entries: %zu\n", table_pkg->count);
         uacpi_object_unref(obj);
@@ -1054,6 +1729,14 @@ uacpi_status uacpi_get_pci_routing_table(
         }
 
         entry_pkg = entry_obj->package;
+
+        ret = uacpi_package_materialize(entry_pkg);
+        if (uacpi_unlikely_error(ret)) {
+            uacpi_free_pci_routing_table(table);
+            uacpi_object_unref(obj);
+            return ret;
+        }
+
         if (uacpi_unlikely(entry_pkg->count != 4)) {
             uacpi_error("invalid _PRT sub-package entry count %zu\n",
                         entry_pkg->count);
@@ -1109,6 +1792,8 @@ uacpi_status uacpi_get_pci_routing_table(
     }
 
     uacpi_object_unref(obj);
+    prt_cache_insert(parent, table, generation);
+
     *out_table = table;
     return UACPI_STATUS_OK;
 
@@ -0,0 +1,288 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "helpers.h"
+#include "argparser.h"
+#include <uacpi/context.h>
+#include <uacpi/namespace.h>
+#include <uacpi/resources.h>
+#include <uacpi/tables.h>
+#include <uacpi/uacpi.h>
+#include <uacpi/utilities.h>
+
+static void ensure_ok_status(uacpi_status st)
+{
+    if (st == UACPI_STATUS_OK)
+        return;
+
+    auto msg = uacpi_status_to_string(st);
+    throw std::runtime_error(std::string("uACPI error: ") + msg);
+}
+
+struct bench_result {
+    std::string name;
+    uint64_t iterations;
+    double ns_per_call;
+    double ops_per_sec;
+};
+
+template <typename BodyT>
+static bench_result run_one_bench(
+    const char *name, uint64_t iterations, BodyT body
+)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Warm up caches and any lazily-populated uACPI state first
+    for (uint64_t i = 0; i < iterations / 10 + 1; ++i)
+        body();
+
+    auto begin = clock::now();
+    for (uint64_t i = 0; i < iterations; ++i)
+        body();
+    auto end = clock::now();
+
+    auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - begin
+    ).count();
+
+    bench_result res;
+    res.name = name;
+    res.iterations = iterations;
+    res.ns_per_call = static_cast<double>(total_ns) / iterations;
+    res.ops_per_sec = res.ns_per_call != 0.0 ? 1e9 / res.ns_per_call : 0.0;
+    return res;
+}
+
+static std::vector<bench_result> run_benchmarks(uint64_t iterations)
+{
+    std::vector<bench_result> results;
+
+    results.push_back(run_one_bench(
+        "method-invocation", iterations, [] {
+            ensure_ok_status(uacpi_execute(UACPI_NULL, "\\MNOP", UACPI_NULL));
+        }
+    ));
+
+    {
+        uacpi_object *objects[2];
+        uacpi_object_array args;
+
+        objects[0] = uacpi_object_create_integer(1);
+        objects[1] = uacpi_object_create_integer(2);
+        args.objects = objects;
+        args.count = 2;
+
+        results.push_back(run_one_bench(
+            "method-invocation-args", iterations, [&args] {
+                uacpi_object *ret = UACPI_NULL;
+
+                ensure_ok_status(
+                    uacpi_eval(UACPI_NULL, "\\MADD", &args, &ret)
+                );
+                uacpi_object_unref(ret);
+            }
+        ));
+
+        uacpi_object_unref(objects[0]);
+        uacpi_object_unref(objects[1]);
+    }
+
+    results.push_back(run_one_bench(
+        "name-resolution", iterations, [] {
+            uacpi_namespace_node *node;
+
+            ensure_ok_status(uacpi_namespace_node_find(
+                UACPI_NULL, "\\DEV0.NST0.NST1.NST2.LEAF", &node
+            ));
+        }
+    ));
+
+    results.push_back(run_one_bench(
+        "buffer-field-io", iterations, [] {
+            uacpi_object *ret = UACPI_NULL;
+
+            ensure_ok_status(
+                uacpi_eval(UACPI_NULL, "\\MBFR", UACPI_NULL, &ret)
+            );
+            uacpi_object_unref(ret);
+        }
+    ));
+
+    {
+        uacpi_namespace_node *dev;
+
+        ensure_ok_status(
+            uacpi_namespace_node_find(UACPI_NULL, "\\DEV0", &dev)
+        );
+
+        results.push_back(run_one_bench(
+            "crs-parsing", iterations, [dev] {
+                uacpi_resources *res;
+
+                ensure_ok_status(uacpi_get_current_resources(dev, &res));
+                uacpi_free_resources(res);
+            }
+        ));
+    }
+
+    return results;
+}
+
+static std::vector<bench_result> run_bench_suite(
+    std::string_view dsdt_path, uint64_t iterations
+)
+{
+    acpi_rsdp rsdp {};
+
+    memcpy(&rsdp.signature, ACPI_RSDP_SIGNATURE, sizeof(ACPI_RSDP_SIGNATURE) - 1);
+    set_oem(rsdp.oemid);
+
+    auto *xsdt = new (std::calloc(sizeof(full_xsdt), 1)) full_xsdt();
+    set_oem(xsdt->hdr.oemid);
+    set_oem_table_id(xsdt->hdr.oem_table_id);
+
+    auto xsdt_delete = ScopeGuard(
+        [&xsdt] {
+            uacpi_state_reset();
+
+            if (xsdt->fadt) {
+                delete[] reinterpret_cast<uint8_t*>(
+                    static_cast<uintptr_t>(xsdt->fadt->x_dsdt)
+                );
+                delete reinterpret_cast<acpi_facs*>(
+                    static_cast<uintptr_t>(xsdt->fadt->x_firmware_ctrl)
+                );
+                delete xsdt->fadt;
+            }
+
+            xsdt->~full_xsdt();
+            std::free(xsdt);
+        }
+    );
+    build_xsdt(*xsdt, rsdp, dsdt_path, {});
+
+    g_rsdp = reinterpret_cast<uacpi_phys_addr>(&rsdp);
+
+    auto st = uacpi_initialize(UACPI_FLAG_NO_ACPI_MODE);
+    ensure_ok_status(st);
+
+    // Same table mapping disambiguation dance as the test runner
+    uacpi_table tbl;
+    uacpi_table_find_by_signature(ACPI_DSDT_SIGNATURE, &tbl);
+    g_expect_virtual_addresses = false;
+
+    st = uacpi_namespace_load();
+    ensure_ok_status(st);
+
+    st = uacpi_namespace_initialize();
+    ensure_ok_status(st);
+
+    return run_benchmarks(iterations);
+}
+
+static void dump_json(
+    std::FILE *out, std::string_view fixture,
+    const std::vector<bench_result>& results
+)
+{
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"fixture\": \"%s\",\n", fixture.data());
+    std::fprintf(out, "  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto& res = results[i];
+
+        std::fprintf(
+            out,
+            "    { \"name\": \"%s\", \"iterations\": %" PRIu64 ", "
+            "\"ns_per_call\": %.2f, \"ops_per_sec\": %.2f }%s\n",
+            res.name.c_str(), res.iterations, res.ns_per_call,
+            res.ops_per_sec, i + 1 == results.size() ? "" : ","
+        );
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+}
+
+static uacpi_log_level log_level_from_string(std::string_view arg)
+{
+    static std::pair<std::string_view, uacpi_log_level> log_levels[] = {
+        { "debug", UACPI_LOG_DEBUG },
+        { "trace", UACPI_LOG_TRACE },
+        { "info", UACPI_LOG_INFO },
+        { "warning", UACPI_LOG_WARN },
+        { "error", UACPI_LOG_ERROR },
+    };
+
+    for (auto& lvl : log_levels) {
+        if (lvl.first == arg)
+            return lvl.second;
+    }
+
+    throw std::runtime_error(std::string("invalid log level ") + arg.data());
+}
+
+int main(int argc, char** argv)
+{
+    auto args = ArgParser {};
+    args.add_positional(
+            "dsdt-path", "path to the (compiled) DSDT fixture to benchmark"
+        )
+        .add_param(
+            "iterations", 'n', "number of timed iterations per workload"
+        )
+        .add_param(
+            "log-level", 'l',
+            "log level to set, one of: debug, trace, info, warning, error"
+        )
+        .add_param(
+            "output", 'o',
+            "write the JSON report to this file instead of stdout"
+        )
+        .add_help(
+            "help", 'h', "Display this menu and exit",
+            [&]() { std::cout << "uACPI benchmark:\n" << args; }
+        );
+
+    try {
+        args.parse(argc, argv);
+
+        // Logging skews the numbers, keep it to errors unless asked otherwise
+        auto log_level = UACPI_LOG_ERROR;
+        if (args.is_set('l'))
+            log_level = log_level_from_string(args.get('l'));
+        uacpi_context_set_log_level(log_level);
+
+        auto dsdt_path = args.get("dsdt-path");
+        auto results = run_bench_suite(
+            dsdt_path, args.get_uint_or("iterations", 10000)
+        );
+
+        /*
+         * uACPI logs also end up on stdout, so when the report is meant to be
+         * machine-consumed it has to go into its own file to stay valid JSON.
+         */
+        auto *out = stdout;
+        if (args.is_set('o')) {
+            out = std::fopen(args.get('o').data(), "w");
+            if (out == nullptr)
+                throw std::runtime_error(
+                    std::string("unable to open ") + args.get('o').data()
+                );
+        }
+
+        dump_json(out, dsdt_path, results);
+        if (out != stdout)
+            std::fclose(out);
+    } catch (const std::exception& ex) {
+        std::cerr << "unexpected error: " << ex.what() << std::endl;
+        return 1;
+    }
+}
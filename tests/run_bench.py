@@ -0,0 +1,124 @@
+#!/usr/bin/python3
+import argparse
+import os
+import platform
+import subprocess
+import sys
+from typing import List
+
+from utilities.asl import ASLSource
+
+
+def abs_path_to_current_dir() -> str:
+    return os.path.dirname(os.path.abspath(__file__))
+
+
+def bench_relpath(*args: str) -> str:
+    return os.path.join(abs_path_to_current_dir(), *args)
+
+
+def bench_binary() -> str:
+    out = "uacpi-bench"
+
+    if platform.system() == "Windows":
+        out += ".exe"
+
+    return out
+
+
+def build_bench(bitness: int) -> str:
+    build_dir = f"build-{platform.system().lower()}-{bitness}bits"
+    bench_build_dir = bench_relpath("bench", build_dir)
+    bench_exe = os.path.join(bench_build_dir, bench_binary())
+    use_ninja = False
+
+    if platform.system() != "Windows":
+        try:
+            subprocess.run(["ninja", "--version"], check=True,
+                           stdout=subprocess.DEVNULL)
+            use_ninja = True
+        except FileNotFoundError:
+            pass
+
+    cmake_args: List[str] = ["cmake"]
+
+    if use_ninja:
+        cmake_args.extend(["-G", "Ninja"])
+
+    cmake_args.append("..")
+
+    if bitness == 32:
+        if platform.system() == "Windows":
+            cmake_args.extend(["-A", "Win32"])
+        else:
+            cmake_args.extend([
+                "-DCMAKE_CXX_FLAGS=-m32",
+                "-DCMAKE_C_FLAGS=-m32"
+            ])
+
+    if not os.path.isdir(bench_build_dir):
+        os.makedirs(bench_build_dir, exist_ok=True)
+        subprocess.run(cmake_args, cwd=bench_build_dir, check=True)
+
+    subprocess.run(["cmake", "--build", "."], cwd=bench_build_dir, check=True)
+    return bench_exe
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Run uACPI micro-benchmarks")
+    parser.add_argument("--asl-compiler",
+                        help="Compiler to use to build the bench fixture",
+                        default="iasl")
+    parser.add_argument("--bench-runner",
+                        help="The benchmark binary to invoke")
+    parser.add_argument("--binary-directory",
+                        default=bench_relpath("bin"),
+                        help="The directory to store intermediate files in, "
+                             "defaults to 'bin' in the same directory")
+    parser.add_argument("--bitness", default=64, choices=[32, 64], type=int,
+                        help="uACPI build bitness")
+    parser.add_argument("--iterations", type=int, default=10000,
+                        help="Number of timed iterations per workload")
+    parser.add_argument("--dsdt",
+                        help="A pre-compiled DSDT to benchmark against "
+                             "instead of the canned fixture")
+    parser.add_argument("--output",
+                        help="Write the JSON report to this file instead of "
+                             "stdout (useful for diffing runs across releases)")
+    args = parser.parse_args()
+
+    bench = args.bench_runner
+    if bench is None:
+        bench = build_bench(args.bitness)
+
+    os.makedirs(args.binary_directory, exist_ok=True)
+
+    dsdt = args.dsdt
+    if dsdt is None:
+        dsdt = ASLSource.compile(
+            bench_relpath("bench", "bench.asl"),
+            args.asl_compiler, args.binary_directory
+        )
+
+    # Always have the runner write the report to a file: its stdout also
+    # carries uACPI log output, which would corrupt the JSON.
+    report = args.output
+    if report is None:
+        report = os.path.join(args.binary_directory, "bench-report.json")
+
+    proc = subprocess.run(
+        [bench, dsdt, "--iterations", str(args.iterations),
+         "--output", report],
+    )
+    if proc.returncode != 0:
+        return proc.returncode
+
+    if args.output is None:
+        with open(report) as f:
+            print(f.read(), end="")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,108 @@
+#!/usr/bin/python3
+import argparse
+import os
+import platform
+import subprocess
+import sys
+from typing import List
+
+from utilities.asl import ASLSource
+
+
+def abs_path_to_current_dir() -> str:
+    return os.path.dirname(os.path.abspath(__file__))
+
+
+def snapshot_relpath(*args: str) -> str:
+    return os.path.join(abs_path_to_current_dir(), *args)
+
+
+def snapshot_binary() -> str:
+    out = "uacpi-snapshot-tests"
+
+    if platform.system() == "Windows":
+        out += ".exe"
+
+    return out
+
+
+def build_snapshot_tests(bitness: int) -> str:
+    build_dir = f"build-{platform.system().lower()}-{bitness}bits"
+    snapshot_build_dir = snapshot_relpath("snapshot", build_dir)
+    snapshot_exe = os.path.join(snapshot_build_dir, snapshot_binary())
+    use_ninja = False
+
+    if platform.system() != "Windows":
+        try:
+            subprocess.run(["ninja", "--version"], check=True,
+                           stdout=subprocess.DEVNULL)
+            use_ninja = True
+        except FileNotFoundError:
+            pass
+
+    cmake_args: List[str] = ["cmake"]
+
+    if use_ninja:
+        cmake_args.extend(["-G", "Ninja"])
+
+    cmake_args.append("..")
+
+    if bitness == 32:
+        if platform.system() == "Windows":
+            cmake_args.extend(["-A", "Win32"])
+        else:
+            cmake_args.extend([
+                "-DCMAKE_CXX_FLAGS=-m32",
+                "-DCMAKE_C_FLAGS=-m32"
+            ])
+
+    if not os.path.isdir(snapshot_build_dir):
+        os.makedirs(snapshot_build_dir, exist_ok=True)
+        subprocess.run(cmake_args, cwd=snapshot_build_dir, check=True)
+
+    subprocess.run(["cmake", "--build", "."], cwd=snapshot_build_dir,
+                   check=True)
+    return snapshot_exe
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description="Run uACPI namespace snapshot round-trip & "
+                    "malformed-input tests"
+    )
+    parser.add_argument("--asl-compiler",
+                        help="Compiler to use to build the test fixture",
+                        default="iasl")
+    parser.add_argument("--test-runner",
+                        help="The snapshot test binary to invoke")
+    parser.add_argument("--binary-directory",
+                        default=snapshot_relpath("bin"),
+                        help="The directory to store intermediate files in, "
+                             "defaults to 'bin' in the same directory")
+    parser.add_argument("--bitness", default=64, choices=[32, 64], type=int,
+                        help="uACPI build bitness")
+    parser.add_argument("--dsdt",
+                        help="A pre-compiled DSDT to snapshot instead of the "
+                             "canned fixture")
+    args = parser.parse_args()
+
+    runner = args.test_runner
+    if runner is None:
+        runner = build_snapshot_tests(args.bitness)
+
+    os.makedirs(args.binary_directory, exist_ok=True)
+
+    # Any DSDT works here, so reuse the benchmark fixture: it covers methods,
+    # fields, packages and resource templates without needing its own copy.
+    dsdt = args.dsdt
+    if dsdt is None:
+        dsdt = ASLSource.compile(
+            snapshot_relpath("bench", "bench.asl"),
+            args.asl_compiler, args.binary_directory
+        )
+
+    return subprocess.run([runner, dsdt]).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,357 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "helpers.h"
+#include "argparser.h"
+#include <uacpi/context.h>
+#include <uacpi/namespace.h>
+#include <uacpi/snapshot.h>
+#include <uacpi/tables.h>
+#include <uacpi/uacpi.h>
+
+static void ensure_ok_status(uacpi_status st)
+{
+    if (st == UACPI_STATUS_OK)
+        return;
+
+    auto msg = uacpi_status_to_string(st);
+    throw std::runtime_error(std::string("uACPI error: ") + msg);
+}
+
+static uacpi_u8 gen_checksum(void *table, uacpi_size size)
+{
+    uacpi_u8 *bytes = reinterpret_cast<uacpi_u8*>(table);
+    uacpi_u8 csum = 0;
+    uacpi_size i;
+
+    for (i = 0; i < size; ++i)
+        csum += bytes[i];
+
+    return 256 - csum;
+}
+
+static int g_failures;
+
+static void expect_status(
+    const char *name, uacpi_status got, uacpi_status want
+)
+{
+    if (got == want) {
+        std::printf("[PASS] %s\n", name);
+        return;
+    }
+
+    std::printf(
+        "[FAIL] %s: expected %s, got %s\n", name,
+        uacpi_status_to_string(want), uacpi_status_to_string(got)
+    );
+    g_failures++;
+}
+
+static void expect_any_error(const char *name, uacpi_status got)
+{
+    if (got != UACPI_STATUS_OK) {
+        std::printf("[PASS] %s (%s)\n", name, uacpi_status_to_string(got));
+        return;
+    }
+
+    std::printf("[FAIL] %s: malformed image was accepted\n", name);
+    g_failures++;
+}
+
+static void expect_true(const char *name, bool value, const char *why)
+{
+    if (value) {
+        std::printf("[PASS] %s\n", name);
+        return;
+    }
+
+    std::printf("[FAIL] %s: %s\n", name, why);
+    g_failures++;
+}
+
+// One (path, type) entry per namespace node, in depth-first order
+using namespace_dump = std::vector<std::pair<std::string, uacpi_object_type>>;
+
+static namespace_dump dump_namespace()
+{
+    namespace_dump dump;
+
+    ensure_ok_status(uacpi_namespace_for_each_child_simple(
+        uacpi_namespace_root(),
+        [](void *user, uacpi_namespace_node *node, uacpi_u32) {
+            auto *dump = static_cast<namespace_dump*>(user);
+            uacpi_object_type type;
+            const uacpi_char *path;
+
+            if (uacpi_namespace_node_type(node, &type) != UACPI_STATUS_OK)
+                type = UACPI_OBJECT_UNINITIALIZED;
+
+            path = uacpi_namespace_node_generate_absolute_path(node);
+            dump->emplace_back(path ? path : "<no-memory>", type);
+            uacpi_free_absolute_path(path);
+
+            return UACPI_ITERATION_DECISION_CONTINUE;
+        },
+        &dump
+    ));
+
+    return dump;
+}
+
+/*
+ * Offsets into struct snapshot_header (source/snapshot.c), which is the
+ * on-disk format this harness deliberately pokes at to build corrupt images.
+ */
+constexpr size_t header_signature_offset = 0;
+constexpr size_t header_version_offset = 8;
+constexpr size_t header_num_nodes_offset = 24;
+constexpr size_t header_total_size_offset = 28;
+constexpr size_t header_size = 36;
+
+static std::vector<uint8_t> clone_image(const void *image, size_t size)
+{
+    auto *bytes = static_cast<const uint8_t*>(image);
+    return { bytes, bytes + size };
+}
+
+static void run_malformed_image_tests(const void *image, size_t size)
+{
+    // Every case here must be rejected before the namespace is touched
+    expect_status(
+        "zero-sized-image",
+        uacpi_namespace_snapshot_load(image, 0),
+        UACPI_STATUS_INVALID_ARGUMENT
+    );
+    expect_status(
+        "truncated-header",
+        uacpi_namespace_snapshot_load(image, header_size - 1),
+        UACPI_STATUS_INVALID_ARGUMENT
+    );
+    expect_status(
+        "truncated-image",
+        uacpi_namespace_snapshot_load(image, size - 1),
+        UACPI_STATUS_INVALID_ARGUMENT
+    );
+
+    {
+        auto copy = clone_image(image, size);
+
+        copy[header_signature_offset] ^= 0xFF;
+        expect_status(
+            "corrupted-signature",
+            uacpi_namespace_snapshot_load(copy.data(), copy.size()),
+            UACPI_STATUS_INVALID_SIGNATURE
+        );
+    }
+
+    {
+        auto copy = clone_image(image, size);
+
+        copy[header_version_offset] += 1;
+        expect_status(
+            "unknown-version",
+            uacpi_namespace_snapshot_load(copy.data(), copy.size()),
+            UACPI_STATUS_UNIMPLEMENTED
+        );
+    }
+
+    {
+        auto copy = clone_image(image, size);
+        uint32_t bogus_count = 0xFFFFFFFE;
+
+        std::memcpy(
+            &copy[header_num_nodes_offset], &bogus_count, sizeof(bogus_count)
+        );
+        expect_status(
+            "node-count-overflow",
+            uacpi_namespace_snapshot_load(copy.data(), copy.size()),
+            UACPI_STATUS_INVALID_ARGUMENT
+        );
+    }
+}
+
+static void run_truncated_payload_test(const void *image, size_t size)
+{
+    /*
+     * Cut the image in half but keep the header consistent with the new
+     * size, so that rejection has to come from a section read running off
+     * the end of the buffer rather than from the header checks.
+     *
+     * NOTE: a failure this deep into loading resets the library state, the
+     * caller is responsible for bringing uACPI back up afterwards.
+     */
+    auto copy = clone_image(image, size / 2);
+    uint64_t new_size = copy.size();
+
+    std::memcpy(
+        &copy[header_total_size_offset], &new_size, sizeof(new_size)
+    );
+    expect_any_error(
+        "truncated-payload",
+        uacpi_namespace_snapshot_load(copy.data(), copy.size())
+    );
+}
+
+static void bring_up_to_subsystem_initialized()
+{
+    // Table installation maps XSDT pointers, which are virtual addresses here
+    g_expect_virtual_addresses = true;
+    ensure_ok_status(uacpi_initialize(UACPI_FLAG_NO_ACPI_MODE));
+
+    // Same table mapping disambiguation dance as the test runner
+    uacpi_table tbl;
+    uacpi_table_find_by_signature(ACPI_DSDT_SIGNATURE, &tbl);
+    g_expect_virtual_addresses = false;
+}
+
+static void run_snapshot_tests(std::string_view dsdt_path)
+{
+    acpi_rsdp rsdp {};
+
+    memcpy(&rsdp.signature, ACPI_RSDP_SIGNATURE, sizeof(ACPI_RSDP_SIGNATURE) - 1);
+    set_oem(rsdp.oemid);
+
+    auto *xsdt = new (std::calloc(sizeof(full_xsdt), 1)) full_xsdt();
+    set_oem(xsdt->hdr.oemid);
+    set_oem_table_id(xsdt->hdr.oem_table_id);
+
+    auto xsdt_delete = ScopeGuard(
+        [&xsdt] {
+            uacpi_state_reset();
+
+            if (xsdt->fadt) {
+                delete[] reinterpret_cast<uint8_t*>(
+                    static_cast<uintptr_t>(xsdt->fadt->x_dsdt)
+                );
+                delete reinterpret_cast<acpi_facs*>(
+                    static_cast<uintptr_t>(xsdt->fadt->x_firmware_ctrl)
+                );
+                delete xsdt->fadt;
+            }
+
+            xsdt->~full_xsdt();
+            std::free(xsdt);
+        }
+    );
+    build_xsdt(*xsdt, rsdp, dsdt_path, {});
+
+    /*
+     * Flip the FADT into hardware-reduced mode: this harness tears uACPI
+     * down and brings it back up several times, which the mocked fixed
+     * event registers (reads always return all ones, so disabling an event
+     * never takes effect) cannot survive in full hardware mode.
+     */
+    xsdt->fadt->flags |= ACPI_HW_REDUCED_ACPI;
+    xsdt->fadt->hdr.checksum = 0;
+    xsdt->fadt->hdr.checksum = gen_checksum(
+        xsdt->fadt, sizeof(*xsdt->fadt)
+    );
+
+    g_rsdp = reinterpret_cast<uacpi_phys_addr>(&rsdp);
+
+    // Take the reference snapshot off a regularly interpreted namespace
+    bring_up_to_subsystem_initialized();
+    ensure_ok_status(uacpi_namespace_load());
+
+    void *image = UACPI_NULL;
+    uacpi_size image_size = 0;
+
+    ensure_ok_status(uacpi_namespace_snapshot_save(&image, &image_size));
+    auto image_free = ScopeGuard(
+        [&image, &image_size] {
+            uacpi_namespace_snapshot_free(image, image_size);
+        }
+    );
+
+    auto reference = dump_namespace();
+
+    // Now restart from scratch and feed the loader hostile input first
+    uacpi_state_reset();
+    bring_up_to_subsystem_initialized();
+
+    run_malformed_image_tests(image, image_size);
+
+    run_truncated_payload_test(image, image_size);
+    bring_up_to_subsystem_initialized();
+
+    expect_status(
+        "round-trip-load",
+        uacpi_namespace_snapshot_load(image, image_size),
+        UACPI_STATUS_OK
+    );
+
+    auto restored = dump_namespace();
+    expect_true(
+        "round-trip-namespace-match", restored == reference,
+        "restored namespace differs from the interpreted one"
+    );
+
+    expect_status(
+        "round-trip-initialize", uacpi_namespace_initialize(),
+        UACPI_STATUS_OK
+    );
+}
+
+int main(int argc, char** argv)
+{
+    auto args = ArgParser {};
+    args.add_positional(
+            "dsdt-path", "path to the (compiled) DSDT fixture to test against"
+        )
+        .add_param(
+            "log-level", 'l',
+            "log level to set, one of: debug, trace, info, warning, error"
+        )
+        .add_help(
+            "help", 'h', "Display this menu and exit",
+            [&]() { std::cout << "uACPI snapshot tests:\n" << args; }
+        );
+
+    try {
+        args.parse(argc, argv);
+
+        auto log_level = UACPI_LOG_ERROR;
+        if (args.is_set('l')) {
+            static std::pair<std::string_view, uacpi_log_level> log_levels[] = {
+                { "debug", UACPI_LOG_DEBUG },
+                { "trace", UACPI_LOG_TRACE },
+                { "info", UACPI_LOG_INFO },
+                { "warning", UACPI_LOG_WARN },
+                { "error", UACPI_LOG_ERROR },
+            };
+            bool found = false;
+
+            for (auto& lvl : log_levels) {
+                if (lvl.first == args.get('l')) {
+                    log_level = lvl.second;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+                throw std::runtime_error(
+                    std::string("invalid log level ") + args.get('l').data()
+                );
+        }
+        uacpi_context_set_log_level(log_level);
+
+        run_snapshot_tests(args.get("dsdt-path"));
+    } catch (const std::exception& ex) {
+        std::cerr << "unexpected error: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    if (g_failures != 0) {
+        std::printf("%d snapshot test(s) FAILED\n", g_failures);
+        return 1;
+    }
+
+    std::printf("all snapshot tests passed\n");
+    return 0;
+}
@@ -0,0 +1,399 @@
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "helpers.h"
+#include "argparser.h"
+#include <uacpi/context.h>
+#include <uacpi/event.h>
+#include <uacpi/namespace.h>
+#include <uacpi/tables.h>
+#include <uacpi/uacpi.h>
+
+static void ensure_ok_status(uacpi_status st)
+{
+    if (st == UACPI_STATUS_OK)
+        return;
+
+    auto msg = uacpi_status_to_string(st);
+    throw std::runtime_error(std::string("uACPI error: ") + msg);
+}
+
+constexpr size_t NUM_DISJOINT_SCOPES = 8;
+
+// GPE0 block in the canned FADT is 0x20 bytes -> 128 events
+constexpr uint32_t NUM_GPES = 128;
+
+struct stress_point {
+    uint32_t threads;
+    uint64_t total_iterations;
+    double ops_per_sec;
+};
+
+struct stress_result {
+    std::string name;
+    std::vector<stress_point> points;
+};
+
+/*
+ * Runs 'body(thread_index)' from 'threads' workers for 'duration' and reports
+ * the combined throughput. Workers spin on an atomic flag first so that they
+ * ramp up together instead of measuring thread creation.
+ */
+static stress_point run_one_point(
+    uint32_t threads, std::chrono::milliseconds duration,
+    const std::function<void(uint32_t)>& body
+)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::atomic<bool> go { false };
+    std::atomic<bool> stop { false };
+    std::atomic<uint64_t> total { 0 };
+    std::vector<std::thread> workers;
+
+    for (uint32_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i] {
+            uint64_t iterations = 0;
+
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                body(i);
+                iterations++;
+            }
+
+            total.fetch_add(iterations, std::memory_order_relaxed);
+        });
+    }
+
+    auto begin = clock::now();
+    go.store(true, std::memory_order_release);
+
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order_relaxed);
+
+    for (auto& worker : workers)
+        worker.join();
+    auto end = clock::now();
+
+    auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - begin
+    ).count();
+
+    stress_point point;
+    point.threads = threads;
+    point.total_iterations = total.load();
+    point.ops_per_sec = total_ns ? point.total_iterations * (1e9 / total_ns)
+                                 : 0.0;
+    return point;
+}
+
+static stress_result run_one_workload(
+    const char *name, uint32_t max_threads, std::chrono::milliseconds duration,
+    const std::function<void(uint32_t)>& body
+)
+{
+    stress_result res;
+    res.name = name;
+
+    std::printf("%s:\n", name);
+
+    for (uint32_t threads = 1;; threads *= 2) {
+        threads = std::min(threads, max_threads);
+
+        auto point = run_one_point(threads, duration, body);
+        std::printf(
+            "  %3" PRIu32 " thread(s): %.0f ops/s\n",
+            point.threads, point.ops_per_sec
+        );
+        res.points.push_back(point);
+
+        if (threads == max_threads)
+            break;
+    }
+
+    return res;
+}
+
+static uacpi_interrupt_ret noop_gpe_handler(
+    uacpi_handle, uacpi_namespace_node*, uacpi_u16
+)
+{
+    return UACPI_INTERRUPT_HANDLED;
+}
+
+static std::vector<stress_result> run_workloads(
+    uint32_t max_threads, std::chrono::milliseconds duration
+)
+{
+    std::vector<stress_result> results;
+    uacpi_namespace_node *disjoint[NUM_DISJOINT_SCOPES];
+
+    for (size_t i = 0; i < NUM_DISJOINT_SCOPES; ++i) {
+        char path[6];
+
+        std::snprintf(path, sizeof(path), "\\DJ%02zu", i);
+        ensure_ok_status(uacpi_namespace_node_find(
+            UACPI_NULL, path, &disjoint[i]
+        ));
+    }
+
+    auto eval_add = [](uacpi_namespace_node *parent, const char *path) {
+        uacpi_object *objects[2];
+        uacpi_object_array args;
+        uacpi_object *ret = UACPI_NULL;
+
+        objects[0] = uacpi_object_create_integer(1);
+        objects[1] = uacpi_object_create_integer(2);
+        args.objects = objects;
+        args.count = 2;
+
+        ensure_ok_status(uacpi_eval(parent, path, &args, &ret));
+
+        uacpi_object_unref(ret);
+        uacpi_object_unref(objects[0]);
+        uacpi_object_unref(objects[1]);
+    };
+
+    results.push_back(run_one_workload(
+        "eval-shared", max_threads, duration, [&eval_add](uint32_t) {
+            eval_add(UACPI_NULL, "\\SHRD");
+        }
+    ));
+
+    results.push_back(run_one_workload(
+        "eval-disjoint", max_threads, duration,
+        [&eval_add, &disjoint](uint32_t thread) {
+            eval_add(disjoint[thread % NUM_DISJOINT_SCOPES], "MTHD");
+        }
+    ));
+
+    results.push_back(run_one_workload(
+        "table-find", max_threads, duration, [](uint32_t) {
+            uacpi_table tbl;
+
+            ensure_ok_status(
+                uacpi_table_find_by_signature(ACPI_DSDT_SIGNATURE, &tbl)
+            );
+            uacpi_table_unref(&tbl);
+        }
+    ));
+
+    /*
+     * There is no way to raise a real SCI from here, so GPE-lock contention
+     * is generated through the control path instead: every enable/disable
+     * toggle takes the event locks and reads & writes the (mocked) hardware
+     * GPE registers, same as the dispatch side of an actual event.
+     */
+    for (uint32_t i = 0; i < NUM_GPES; ++i) {
+        ensure_ok_status(uacpi_install_gpe_handler(
+            UACPI_NULL, i, UACPI_GPE_TRIGGERING_EDGE,
+            noop_gpe_handler, UACPI_NULL
+        ));
+    }
+
+    results.push_back(run_one_workload(
+        "gpe-toggle", std::min(max_threads, NUM_GPES), duration,
+        [](uint32_t thread) {
+            ensure_ok_status(uacpi_enable_gpe(UACPI_NULL, thread));
+            ensure_ok_status(uacpi_clear_gpe(UACPI_NULL, thread));
+            ensure_ok_status(uacpi_disable_gpe(UACPI_NULL, thread));
+        }
+    ));
+
+    for (uint32_t i = 0; i < NUM_GPES; ++i) {
+        ensure_ok_status(uacpi_uninstall_gpe_handler(
+            UACPI_NULL, i, noop_gpe_handler
+        ));
+    }
+
+    return results;
+}
+
+static std::vector<stress_result> run_stress_suite(
+    std::string_view dsdt_path, uint32_t max_threads,
+    std::chrono::milliseconds duration
+)
+{
+    acpi_rsdp rsdp {};
+
+    memcpy(&rsdp.signature, ACPI_RSDP_SIGNATURE, sizeof(ACPI_RSDP_SIGNATURE) - 1);
+    set_oem(rsdp.oemid);
+
+    auto *xsdt = new (std::calloc(sizeof(full_xsdt), 1)) full_xsdt();
+    set_oem(xsdt->hdr.oemid);
+    set_oem_table_id(xsdt->hdr.oem_table_id);
+
+    auto xsdt_delete = ScopeGuard(
+        [&xsdt] {
+            uacpi_state_reset();
+
+            if (xsdt->fadt) {
+                delete[] reinterpret_cast<uint8_t*>(
+                    static_cast<uintptr_t>(xsdt->fadt->x_dsdt)
+                );
+                delete reinterpret_cast<acpi_facs*>(
+                    static_cast<uintptr_t>(xsdt->fadt->x_firmware_ctrl)
+                );
+                delete xsdt->fadt;
+            }
+
+            xsdt->~full_xsdt();
+            std::free(xsdt);
+        }
+    );
+    build_xsdt(*xsdt, rsdp, dsdt_path, {});
+
+    g_rsdp = reinterpret_cast<uacpi_phys_addr>(&rsdp);
+
+    auto st = uacpi_initialize(UACPI_FLAG_NO_ACPI_MODE);
+    ensure_ok_status(st);
+
+    // Same table mapping disambiguation dance as the test runner
+    uacpi_table tbl;
+    uacpi_table_find_by_signature(ACPI_DSDT_SIGNATURE, &tbl);
+    g_expect_virtual_addresses = false;
+
+    st = uacpi_namespace_load();
+    ensure_ok_status(st);
+
+    st = uacpi_namespace_initialize();
+    ensure_ok_status(st);
+
+    st = uacpi_finalize_gpe_initialization();
+    ensure_ok_status(st);
+
+    return run_workloads(max_threads, duration);
+}
+
+static void dump_json(
+    std::FILE *out, std::string_view fixture,
+    const std::vector<stress_result>& results
+)
+{
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"fixture\": \"%s\",\n", fixture.data());
+    std::fprintf(out, "  \"workloads\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto& res = results[i];
+
+        std::fprintf(out, "    { \"name\": \"%s\", \"points\": [\n",
+                     res.name.c_str());
+
+        for (size_t j = 0; j < res.points.size(); ++j) {
+            auto& point = res.points[j];
+
+            std::fprintf(
+                out,
+                "      { \"threads\": %" PRIu32 ", \"iterations\": %" PRIu64
+                ", \"ops_per_sec\": %.2f }%s\n",
+                point.threads, point.total_iterations, point.ops_per_sec,
+                j + 1 == res.points.size() ? "" : ","
+            );
+        }
+
+        std::fprintf(out, "    ] }%s\n",
+                     i + 1 == results.size() ? "" : ",");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+}
+
+static uacpi_log_level log_level_from_string(std::string_view arg)
+{
+    static std::pair<std::string_view, uacpi_log_level> log_levels[] = {
+        { "debug", UACPI_LOG_DEBUG },
+        { "trace", UACPI_LOG_TRACE },
+        { "info", UACPI_LOG_INFO },
+        { "warning", UACPI_LOG_WARN },
+        { "error", UACPI_LOG_ERROR },
+    };
+
+    for (auto& lvl : log_levels) {
+        if (lvl.first == arg)
+            return lvl.second;
+    }
+
+    throw std::runtime_error(std::string("invalid log level ") + arg.data());
+}
+
+int main(int argc, char** argv)
+{
+    auto args = ArgParser {};
+    args.add_positional(
+            "dsdt-path", "path to the (compiled) DSDT fixture to stress"
+        )
+        .add_param(
+            "threads", 't',
+            "maximum number of worker threads (default: hardware concurrency)"
+        )
+        .add_param(
+            "duration", 'd', "milliseconds to time each data point for"
+        )
+        .add_param(
+            "log-level", 'l',
+            "log level to set, one of: debug, trace, info, warning, error"
+        )
+        .add_param(
+            "output", 'o',
+            "write the JSON report to this file instead of stdout"
+        )
+        .add_help(
+            "help", 'h', "Display this menu and exit",
+            [&]() { std::cout << "uACPI stress:\n" << args; }
+        );
+
+    try {
+        args.parse(argc, argv);
+
+        // Logging from dozens of threads skews the numbers even more than
+        // usual, keep it to errors unless asked otherwise
+        auto log_level = UACPI_LOG_ERROR;
+        if (args.is_set('l'))
+            log_level = log_level_from_string(args.get('l'));
+        uacpi_context_set_log_level(log_level);
+
+        auto max_threads = static_cast<uint32_t>(
+            args.get_uint_or("threads", std::thread::hardware_concurrency())
+        );
+        if (max_threads == 0)
+            max_threads = 1;
+
+        auto dsdt_path = args.get("dsdt-path");
+        auto results = run_stress_suite(
+            dsdt_path, max_threads,
+            std::chrono::milliseconds(args.get_uint_or("duration", 250))
+        );
+
+        /*
+         * uACPI logs also end up on stdout, so when the report is meant to be
+         * machine-consumed it has to go into its own file to stay valid JSON.
+         */
+        auto *out = stdout;
+        if (args.is_set('o')) {
+            out = std::fopen(args.get('o').data(), "w");
+            if (out == nullptr)
+                throw std::runtime_error(
+                    std::string("unable to open ") + args.get('o').data()
+                );
+        }
+
+        dump_json(out, dsdt_path, results);
+        if (out != stdout)
+            std::fclose(out);
+    } catch (const std::exception& ex) {
+        std::cerr << "unexpected error: " << ex.what() << std::endl;
+        return 1;
+    }
+}